@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include "kindr/Core"
+
+namespace pose = kindr;
+
+/* Pose composition and point transformation. */
+static void BM_PoseComposition(benchmark::State& state) {
+  pose::HomTransformQuatD pose1(pose::Position3D(1.0, 2.0, 3.0), pose::RotationQuaternionD().setRandom());
+  pose::HomTransformQuatD pose2(pose::Position3D(-2.0, 0.5, 1.0), pose::RotationQuaternionD().setRandom());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pose1*pose2);
+  }
+}
+BENCHMARK(BM_PoseComposition);
+
+static void BM_PoseTransform(benchmark::State& state) {
+  pose::HomTransformQuatD pose1(pose::Position3D(1.0, 2.0, 3.0), pose::RotationQuaternionD().setRandom());
+  const pose::Position3D position(0.3, -1.5, 0.6);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pose1.transform(position));
+  }
+}
+BENCHMARK(BM_PoseTransform);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <benchmark/benchmark.h>
+
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/rotations/RotationBatch.hpp"
+
+namespace rot = kindr;
+
+/* Conversion benchmarks covering every ConversionTraits pair.
+ * Run with --benchmark_format=json to diff throughput across releases.
+ */
+template<typename Dest_, typename Source_>
+static void BM_Conversion(benchmark::State& state) {
+  rot::RotationQuaternion<typename Source_::Scalar> randomQuat;
+  randomQuat.setRandom();
+  Source_ source(randomQuat);
+  for (auto _ : state) {
+    Dest_ dest(source);
+    benchmark::DoNotOptimize(dest);
+  }
+}
+
+#define KINDR_BENCHMARK_CONVERSION(Dest, Source) \
+  BENCHMARK_TEMPLATE(BM_Conversion, rot::Dest<double>, rot::Source<double>)->Name("Conversion/" #Source "To" #Dest)
+
+KINDR_BENCHMARK_CONVERSION(AngleAxis, RotationVector);
+KINDR_BENCHMARK_CONVERSION(AngleAxis, RotationQuaternion);
+KINDR_BENCHMARK_CONVERSION(AngleAxis, RotationMatrix);
+KINDR_BENCHMARK_CONVERSION(AngleAxis, EulerAnglesZyx);
+KINDR_BENCHMARK_CONVERSION(AngleAxis, EulerAnglesXyz);
+KINDR_BENCHMARK_CONVERSION(RotationVector, AngleAxis);
+KINDR_BENCHMARK_CONVERSION(RotationVector, RotationQuaternion);
+KINDR_BENCHMARK_CONVERSION(RotationVector, RotationMatrix);
+KINDR_BENCHMARK_CONVERSION(RotationVector, EulerAnglesZyx);
+KINDR_BENCHMARK_CONVERSION(RotationVector, EulerAnglesXyz);
+KINDR_BENCHMARK_CONVERSION(RotationQuaternion, AngleAxis);
+KINDR_BENCHMARK_CONVERSION(RotationQuaternion, RotationVector);
+KINDR_BENCHMARK_CONVERSION(RotationQuaternion, RotationMatrix);
+KINDR_BENCHMARK_CONVERSION(RotationQuaternion, EulerAnglesZyx);
+KINDR_BENCHMARK_CONVERSION(RotationQuaternion, EulerAnglesXyz);
+KINDR_BENCHMARK_CONVERSION(RotationMatrix, AngleAxis);
+KINDR_BENCHMARK_CONVERSION(RotationMatrix, RotationVector);
+KINDR_BENCHMARK_CONVERSION(RotationMatrix, RotationQuaternion);
+KINDR_BENCHMARK_CONVERSION(RotationMatrix, EulerAnglesZyx);
+KINDR_BENCHMARK_CONVERSION(RotationMatrix, EulerAnglesXyz);
+KINDR_BENCHMARK_CONVERSION(EulerAnglesZyx, AngleAxis);
+KINDR_BENCHMARK_CONVERSION(EulerAnglesZyx, RotationVector);
+KINDR_BENCHMARK_CONVERSION(EulerAnglesZyx, RotationQuaternion);
+KINDR_BENCHMARK_CONVERSION(EulerAnglesZyx, RotationMatrix);
+KINDR_BENCHMARK_CONVERSION(EulerAnglesZyx, EulerAnglesXyz);
+KINDR_BENCHMARK_CONVERSION(EulerAnglesXyz, AngleAxis);
+KINDR_BENCHMARK_CONVERSION(EulerAnglesXyz, RotationVector);
+KINDR_BENCHMARK_CONVERSION(EulerAnglesXyz, RotationQuaternion);
+KINDR_BENCHMARK_CONVERSION(EulerAnglesXyz, RotationMatrix);
+KINDR_BENCHMARK_CONVERSION(EulerAnglesXyz, EulerAnglesZyx);
+
+/* rotate() on column batches of varying widths. */
+static void BM_RotateMatrix3X(benchmark::State& state) {
+  rot::RotationQuaternionD rotQuat;
+  rotQuat.setRandom();
+  const int cols = state.range(0);
+  Eigen::Matrix<double, 3, Eigen::Dynamic> matrix = Eigen::Matrix<double, 3, Eigen::Dynamic>::Random(3, cols);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rotQuat.rotate(matrix).eval());
+  }
+  state.SetItemsProcessed(state.iterations()*cols);
+}
+BENCHMARK(BM_RotateMatrix3X)->Arg(8)->Arg(64)->Arg(1024)->Arg(16384)->Arg(131072);
+
+/* Structure-of-arrays batch rotation for comparison with rotate(Matrix3X). */
+static void BM_RotateBatchSoA(benchmark::State& state) {
+  rot::RotationQuaternionD rotQuat;
+  rotQuat.setRandom();
+  const int size = state.range(0);
+  rot::VectorBatch3D input(size), output(size);
+  for (auto _ : state) {
+    rot::rotateBatch(rotQuat, input, output);
+    benchmark::DoNotOptimize(output.x());
+  }
+  state.SetItemsProcessed(state.iterations()*size);
+}
+BENCHMARK(BM_RotateBatchSoA)->Arg(8)->Arg(64)->Arg(1024)->Arg(16384)->Arg(131072);
+
+/* Rotation composition and box operations. */
+static void BM_RotationComposition(benchmark::State& state) {
+  rot::RotationQuaternionD rotQuat1, rotQuat2;
+  rotQuat1.setRandom();
+  rotQuat2.setRandom();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rotQuat1*rotQuat2);
+  }
+}
+BENCHMARK(BM_RotationComposition);
+
+static void BM_BoxPlus(benchmark::State& state) {
+  rot::RotationQuaternionD rotQuat;
+  rotQuat.setRandom();
+  const Eigen::Vector3d vector(0.1, -0.2, 0.3);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rotQuat.boxPlus(vector));
+  }
+}
+BENCHMARK(BM_BoxPlus);
+
+static void BM_BoxMinus(benchmark::State& state) {
+  rot::RotationQuaternionD rotQuat1, rotQuat2;
+  rotQuat1.setRandom();
+  rotQuat2.setRandom();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rotQuat1.boxMinus(rotQuat2));
+  }
+}
+BENCHMARK(BM_BoxMinus);
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+/*! \file CoreInstantiations.hpp
+ *  \brief List of the template instantiations precompiled into the kindr_core library.
+ *
+ *  The list is an X-macro so that the extern template declarations (kindr/Core with
+ *  KINDR_EXTERN_TEMPLATES defined) and the explicit instantiation definitions
+ *  (src/kindr_core.cpp) cannot drift apart. The entries are the double/float typedefs
+ *  from Rotation.hpp, Quaternion.hpp, Pose.hpp, Wrench.hpp and PhysicalQuantities.hpp
+ *  that dominate instantiation time in client translation units.
+ */
+
+//! Applies KINDR_INSTANTIATE to every precompiled specialization.
+#define KINDR_CORE_INSTANTIATION_LIST(KINDR_INSTANTIATE) \
+  KINDR_INSTANTIATE(kindr::Quaternion<double>) \
+  KINDR_INSTANTIATE(kindr::Quaternion<float>) \
+  KINDR_INSTANTIATE(kindr::UnitQuaternion<double>) \
+  KINDR_INSTANTIATE(kindr::UnitQuaternion<float>) \
+  KINDR_INSTANTIATE(kindr::AngleAxis<double>) \
+  KINDR_INSTANTIATE(kindr::AngleAxis<float>) \
+  KINDR_INSTANTIATE(kindr::RotationVector<double>) \
+  KINDR_INSTANTIATE(kindr::RotationVector<float>) \
+  KINDR_INSTANTIATE(kindr::RotationQuaternion<double>) \
+  KINDR_INSTANTIATE(kindr::RotationQuaternion<float>) \
+  KINDR_INSTANTIATE(kindr::RotationMatrix<double>) \
+  KINDR_INSTANTIATE(kindr::RotationMatrix<float>) \
+  KINDR_INSTANTIATE(kindr::EulerAnglesZyx<double>) \
+  KINDR_INSTANTIATE(kindr::EulerAnglesZyx<float>) \
+  KINDR_INSTANTIATE(kindr::EulerAnglesXyz<double>) \
+  KINDR_INSTANTIATE(kindr::EulerAnglesXyz<float>) \
+  KINDR_INSTANTIATE(kindr::HomogeneousTransformation<double, kindr::Position<double, 3>, kindr::RotationQuaternion<double>>) \
+  KINDR_INSTANTIATE(kindr::HomogeneousTransformation<float, kindr::Position<float, 3>, kindr::RotationQuaternion<float>>) \
+  KINDR_INSTANTIATE(kindr::Wrench6<double>) \
+  KINDR_INSTANTIATE(kindr::Wrench6<float>) \
+  KINDR_INSTANTIATE(kindr::Vector<kindr::PhysicalType::Typeless, double, 3>) \
+  KINDR_INSTANTIATE(kindr::Vector<kindr::PhysicalType::Typeless, float, 3>) \
+  KINDR_INSTANTIATE(kindr::Vector<kindr::PhysicalType::Position, double, 3>) \
+  KINDR_INSTANTIATE(kindr::Vector<kindr::PhysicalType::Position, float, 3>) \
+  KINDR_INSTANTIATE(kindr::Vector<kindr::PhysicalType::Velocity, double, 3>) \
+  KINDR_INSTANTIATE(kindr::Vector<kindr::PhysicalType::Velocity, float, 3>) \
+  KINDR_INSTANTIATE(kindr::Vector<kindr::PhysicalType::Acceleration, double, 3>) \
+  KINDR_INSTANTIATE(kindr::Vector<kindr::PhysicalType::Acceleration, float, 3>) \
+  KINDR_INSTANTIATE(kindr::Vector<kindr::PhysicalType::AngularVelocity, double, 3>) \
+  KINDR_INSTANTIATE(kindr::Vector<kindr::PhysicalType::AngularVelocity, float, 3>) \
+  KINDR_INSTANTIATE(kindr::Vector<kindr::PhysicalType::Force, double, 3>) \
+  KINDR_INSTANTIATE(kindr::Vector<kindr::PhysicalType::Force, float, 3>) \
+  KINDR_INSTANTIATE(kindr::Vector<kindr::PhysicalType::Torque, double, 3>) \
+  KINDR_INSTANTIATE(kindr::Vector<kindr::PhysicalType::Torque, float, 3>)
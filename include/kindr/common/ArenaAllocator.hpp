@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <Eigen/StdVector>
+
+#include "kindr/common/assert_macros.hpp"
+
+namespace kindr {
+
+/*! \file ArenaAllocator.hpp
+ *  \brief Bump allocation for graphs of small fixed-size kindr objects.
+ *
+ *  Heap-allocating pose-graph nodes one by one scatters 56-byte objects across
+ *  the heap, and traversals pay a cache miss per node. MemoryArena carves
+ *  objects out of large blocks with a bump pointer, so nodes allocated together
+ *  are adjacent in memory and the whole graph is freed wholesale by dropping
+ *  the arena (or recycled with reset()). ArenaAllocator adapts an arena to the
+ *  STL allocator interface, and aligned_vector is the Eigen-aligned vector
+ *  spelled out across the poses and physical-quantities headers.
+ */
+
+/*! \brief Contiguous std::vector with Eigen-compatible alignment.
+ *
+ *  The container to use for any kindr or Eigen value type (poses, twists,
+ *  wrenches, vectors); aligned_vector<PoseD> replaces the
+ *  std::vector<PoseD, Eigen::aligned_allocator<PoseD>> spelling.
+ */
+template<typename Type_>
+using aligned_vector = std::vector<Type_, Eigen::aligned_allocator<Type_>>;
+
+/*! \class MemoryArena
+ * \brief Block-based bump allocator; individual objects are never freed.
+ *
+ *  Allocations bump a pointer within the current block and fall through to a
+ *  new block when it is full; blocks are recycled by reset() and released by
+ *  the destructor. There is no per-object deallocate and no destructor is run,
+ *  so only trivially destructible types may be created — which all kindr pose
+ *  and physical-quantity types are.
+ */
+class MemoryArena {
+ public:
+  /*! \brief Constructor.
+   *  \param blockSize   size of each block in bytes; allocations larger than this get their own block
+   */
+  explicit MemoryArena(std::size_t blockSize = 64u*1024u)
+    : blockSize_(blockSize), currentBlock_(0u), offset_(0u), allocatedBytes_(0u) {
+    KINDR_ASSERT_TRUE(std::runtime_error, blockSize > 0u, "Block size must be positive.");
+  }
+
+  MemoryArena(const MemoryArena&) = delete;
+  MemoryArena& operator=(const MemoryArena&) = delete;
+
+  /*! \brief Allocates raw storage from the arena.
+   *  \param size        number of bytes
+   *  \param alignment   required alignment, a power of two
+   *  \returns pointer to the storage; valid until reset() or destruction
+   */
+  void* allocate(std::size_t size, std::size_t alignment) {
+    while (currentBlock_ < blocks_.size()) {
+      Block& block = blocks_[currentBlock_];
+      const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(block.data.get());
+      const std::uintptr_t aligned = (base + offset_ + (alignment - 1u)) & ~static_cast<std::uintptr_t>(alignment - 1u);
+      if (aligned + size <= base + block.size) {
+        offset_ = aligned + size - base;
+        allocatedBytes_ += size;
+        return reinterpret_cast<void*>(aligned);
+      }
+      currentBlock_++;
+      offset_ = 0u;
+    }
+    // over-allocate by the alignment so the aligned cut always fits
+    Block block;
+    block.size = std::max(blockSize_, size + alignment);
+    block.data.reset(new char[block.size]);
+    blocks_.push_back(std::move(block));
+    currentBlock_ = blocks_.size() - 1u;
+    offset_ = 0u;
+    return allocate(size, alignment);
+  }
+
+  /*! \brief Allocates and constructs one object in the arena.
+   *
+   *  The object is never destroyed individually; its storage is reclaimed
+   *  wholesale by reset() or the arena destructor.
+   *  \param args   constructor arguments
+   *  \returns pointer to the constructed object
+   */
+  template<typename Type_, typename... Args_>
+  Type_* create(Args_&&... args) {
+    static_assert(std::is_trivially_destructible<Type_>::value,
+                  "MemoryArena never runs destructors; only trivially destructible types may be created.");
+    return new (allocate(sizeof(Type_), alignof(Type_))) Type_(std::forward<Args_>(args)...);
+  }
+
+  /*! \brief Frees all objects wholesale; the blocks are kept for reuse. */
+  void reset() {
+    currentBlock_ = 0u;
+    offset_ = 0u;
+    allocatedBytes_ = 0u;
+  }
+
+  //! Number of bytes handed out since construction or the last reset().
+  std::size_t getAllocatedBytes() const {
+    return allocatedBytes_;
+  }
+
+  //! Total capacity of the blocks currently held.
+  std::size_t getCapacityBytes() const {
+    std::size_t capacity = 0u;
+    for (const Block& block : blocks_) {
+      capacity += block.size;
+    }
+    return capacity;
+  }
+
+ private:
+  struct Block {
+    std::unique_ptr<char[]> data;
+    std::size_t size;
+  };
+
+  std::size_t blockSize_;
+  std::vector<Block> blocks_;
+  std::size_t currentBlock_;
+  std::size_t offset_;
+  std::size_t allocatedBytes_;
+};
+
+/*! \class ArenaAllocator
+ * \brief STL allocator adapter over a MemoryArena.
+ *
+ *  Lets standard containers place their storage in an arena, e.g.
+ *  std::vector<PoseD, ArenaAllocator<PoseD>>; deallocate is a no-op, the
+ *  memory is reclaimed when the arena is reset or destroyed. The arena must
+ *  outlive every container using it.
+ *
+ *  \tparam Type_ the allocated value type
+ */
+template<typename Type_>
+class ArenaAllocator {
+ public:
+  typedef Type_ value_type;
+  typedef Type_* pointer;
+  typedef const Type_* const_pointer;
+  typedef Type_& reference;
+  typedef const Type_& const_reference;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+
+  template<typename Other_>
+  struct rebind {
+    typedef ArenaAllocator<Other_> other;
+  };
+
+  explicit ArenaAllocator(MemoryArena& arena) : arena_(&arena) {
+  }
+
+  template<typename Other_>
+  ArenaAllocator(const ArenaAllocator<Other_>& other) : arena_(other.getArena()) {
+  }
+
+  Type_* allocate(std::size_t count) {
+    return static_cast<Type_*>(arena_->allocate(count*sizeof(Type_), alignof(Type_)));
+  }
+
+  void deallocate(Type_*, std::size_t) {
+    // arena memory is reclaimed wholesale
+  }
+
+  template<typename Other_, typename... Args_>
+  void construct(Other_* object, Args_&&... args) {
+    new (object) Other_(std::forward<Args_>(args)...);
+  }
+
+  template<typename Other_>
+  void destroy(Other_* object) {
+    object->~Other_();
+  }
+
+  MemoryArena* getArena() const {
+    return arena_;
+  }
+
+  bool operator==(const ArenaAllocator& other) const {
+    return arena_ == other.arena_;
+  }
+
+  bool operator!=(const ArenaAllocator& other) const {
+    return arena_ != other.arena_;
+  }
+
+ private:
+  MemoryArena* arena_;
+};
+
+} // namespace kindr
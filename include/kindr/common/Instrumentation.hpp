@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+/*! \file Instrumentation.hpp
+ *  \brief Opt-in counters for hidden parameterization conversions.
+ *
+ *  Every cross-parameterization constructor and assignment in kindr runs a
+ *  ConversionTraits conversion, which makes redundant conversion chains
+ *  (e.g. Euler -> quaternion performed three times per frame) invisible
+ *  without a profiler. Compiling with KINDR_ENABLE_CONVERSION_COUNTERS
+ *  activates per-(source, dest) conversion counters and per-operation
+ *  counters for rotate()/operator*, exportable with
+ *  getConversionCountTable(). Without the define, all hooks compile to
+ *  nothing and the library is unchanged.
+ *
+ *  The counters are incremented with relaxed atomics; the registry lookup
+ *  happens once per call site through a function-local static.
+ */
+
+#ifdef KINDR_ENABLE_CONVERSION_COUNTERS
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#ifdef __GNUG__
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+
+namespace kindr {
+//! Opt-in conversion and operation counters (only for developers)
+namespace instrumentation {
+
+/*! \brief Returns a human-readable type name where the compiler supports it. */
+inline std::string demangle(const char* name) {
+#ifdef __GNUG__
+  int status = 0;
+  char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+  if (status == 0 && demangled != nullptr) {
+    std::string result(demangled);
+    std::free(demangled);
+    return result;
+  }
+#endif
+  return std::string(name);
+}
+
+//! One labeled event counter.
+struct Counter {
+  explicit Counter(const std::string& label_in) : label(label_in), count(0u) {}
+  std::string label;
+  std::atomic<uint64_t> count;
+};
+
+/*! \brief Process-wide registry of all active counters. */
+class Registry {
+ public:
+  static Registry& instance() {
+    static Registry registry;
+    return registry;
+  }
+
+  /*! \brief Returns the counter with the given label, creating it on first use. */
+  Counter& getCounter(const std::string& label) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iterator = countersByLabel_.find(label);
+    if (iterator == countersByLabel_.end()) {
+      counters_.emplace_back(label);
+      iterator = countersByLabel_.insert({label, &counters_.back()}).first;
+    }
+    return *iterator->second;
+  }
+
+  /*! \brief Formats all non-zero counters as a table, sorted by count. */
+  std::string getTable() const {
+    std::vector<std::pair<uint64_t, std::string>> rows;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (const Counter& counter : counters_) {
+        const uint64_t count = counter.count.load(std::memory_order_relaxed);
+        if (count > 0u) {
+          rows.push_back({count, counter.label});
+        }
+      }
+    }
+    std::sort(rows.begin(), rows.end(), [](const std::pair<uint64_t, std::string>& lhs,
+                                           const std::pair<uint64_t, std::string>& rhs) {
+      return lhs.first > rhs.first;
+    });
+    std::ostringstream stream;
+    for (const auto& row : rows) {
+      stream << row.first << "\t" << row.second << "\n";
+    }
+    return stream.str();
+  }
+
+  /*! \brief Resets all counters to zero. */
+  void reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (Counter& counter : counters_) {
+      counter.count.store(0u, std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  Registry() = default;
+  mutable std::mutex mutex_;
+  //! deque keeps counter addresses stable while new counters are registered
+  std::deque<Counter> counters_;
+  std::map<std::string, Counter*> countersByLabel_;
+};
+
+/*! \brief Counter for the conversion from Source_ to Dest_ (one per pair). */
+template<typename Dest_, typename Source_>
+inline Counter& conversionCounter() {
+  static Counter& counter = Registry::instance().getCounter(
+      demangle(typeid(Source_).name()) + " -> " + demangle(typeid(Dest_).name()));
+  return counter;
+}
+
+/*! \brief Counter for an operation (rotate, inverseRotate, multiply) on Rotation_. */
+template<typename Rotation_>
+inline Counter& operationCounter(const char* name) {
+  return Registry::instance().getCounter(
+      std::string(name) + "<" + demangle(typeid(Rotation_).name()) + ">");
+}
+
+} // namespace instrumentation
+
+/*! \brief Returns all conversion/operation counts as a tab-separated table. */
+inline std::string getConversionCountTable() {
+  return instrumentation::Registry::instance().getTable();
+}
+
+/*! \brief Resets all conversion/operation counters. */
+inline void resetConversionCounters() {
+  instrumentation::Registry::instance().reset();
+}
+
+} // namespace kindr
+
+//! Counts one conversion from Source to Dest (used in conversion constructors/assignments).
+#define KINDR_COUNT_CONVERSION(Dest, Source) \
+  ::kindr::instrumentation::conversionCounter<Dest, Source>().count.fetch_add(1u, ::std::memory_order_relaxed)
+
+//! Counts one named operation on the given rotation type.
+#define KINDR_COUNT_ROTATION_OPERATION(name, Type) \
+  do { \
+    static ::kindr::instrumentation::Counter& kindrOperationCounter = \
+        ::kindr::instrumentation::operationCounter<Type>(name); \
+    kindrOperationCounter.count.fetch_add(1u, ::std::memory_order_relaxed); \
+  } while (false)
+
+#else // KINDR_ENABLE_CONVERSION_COUNTERS
+
+#include <string>
+
+namespace kindr {
+
+//! Stub when instrumentation is compiled out.
+inline std::string getConversionCountTable() {
+  return std::string();
+}
+
+//! Stub when instrumentation is compiled out.
+inline void resetConversionCounters() {
+}
+
+} // namespace kindr
+
+#define KINDR_COUNT_CONVERSION(Dest, Source) static_cast<void>(0)
+#define KINDR_COUNT_ROTATION_OPERATION(name, Type) static_cast<void>(0)
+
+#endif // KINDR_ENABLE_CONVERSION_COUNTERS
@@ -0,0 +1,419 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/poses/Pose.hpp"
+
+namespace kindr {
+
+/*! \file SoAVector.hpp
+ *  \brief Structure-of-arrays containers for batches of kindr types.
+ *
+ *  std::vector<RotationQuaternionD> interleaves w,x,y,z in memory (AoS), so any
+ *  batch kernel touching one component strides over the others and defeats
+ *  vectorization. SoAVector stores each component in its own 64-byte-aligned
+ *  contiguous array — one cache line, one component — and yields proxy references
+ *  with the normal kindr value API for element access. The raw component pointers
+ *  feed the batch kernels directly.
+ */
+
+namespace internal {
+
+/*! \brief Minimal aligned allocator (64-byte by default) for the SoA component arrays. */
+template<typename Scalar_, std::size_t Alignment_ = 64>
+class AlignedAllocator {
+ public:
+  typedef Scalar_ value_type;
+  typedef Scalar_* pointer;
+  typedef const Scalar_* const_pointer;
+  typedef Scalar_& reference;
+  typedef const Scalar_& const_reference;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+
+  template<typename Other_>
+  struct rebind {
+    typedef AlignedAllocator<Other_, Alignment_> other;
+  };
+
+  AlignedAllocator() = default;
+  template<typename Other_>
+  AlignedAllocator(const AlignedAllocator<Other_, Alignment_>&) {}
+
+  Scalar_* allocate(std::size_t count) {
+    void* memory = nullptr;
+    if (posix_memalign(&memory, Alignment_, count*sizeof(Scalar_)) != 0) {
+      throw std::bad_alloc();
+    }
+    return static_cast<Scalar_*>(memory);
+  }
+
+  void deallocate(Scalar_* memory, std::size_t) {
+    std::free(memory);
+  }
+
+  bool operator==(const AlignedAllocator&) const { return true; }
+  bool operator!=(const AlignedAllocator&) const { return false; }
+};
+
+template<typename Scalar_>
+using AlignedScalarVector = std::vector<Scalar_, AlignedAllocator<Scalar_>>;
+
+} // namespace internal
+
+template<typename Type_>
+class SoAVector;
+
+/*! \class SoAVector<RotationQuaternion>
+ * \brief Batch of rotation quaternions with one aligned array per component.
+ */
+template<typename PrimType_>
+class SoAVector<RotationQuaternion<PrimType_>> {
+ public:
+  typedef PrimType_ Scalar;
+  typedef RotationQuaternion<PrimType_> value_type;
+
+  /*! \brief Writable view of one element; converts to and assigns from the kindr value type. */
+  class Proxy {
+   public:
+    Proxy(SoAVector& container, std::size_t index) : container_(container), index_(index) {}
+    operator value_type() const { return container_.get(index_); }
+    Proxy& operator=(const value_type& value) { container_.set(index_, value); return *this; }
+   private:
+    SoAVector& container_;
+    std::size_t index_;
+  };
+
+  class iterator {
+   public:
+    iterator(SoAVector& container, std::size_t index) : container_(container), index_(index) {}
+    Proxy operator*() const { return Proxy(container_, index_); }
+    iterator& operator++() { index_++; return *this; }
+    bool operator==(const iterator& other) const { return index_ == other.index_; }
+    bool operator!=(const iterator& other) const { return index_ != other.index_; }
+   private:
+    SoAVector& container_;
+    std::size_t index_;
+  };
+
+  class const_iterator {
+   public:
+    const_iterator(const SoAVector& container, std::size_t index) : container_(container), index_(index) {}
+    value_type operator*() const { return container_.get(index_); }
+    const_iterator& operator++() { index_++; return *this; }
+    bool operator==(const const_iterator& other) const { return index_ == other.index_; }
+    bool operator!=(const const_iterator& other) const { return index_ != other.index_; }
+   private:
+    const SoAVector& container_;
+    std::size_t index_;
+  };
+
+  SoAVector() = default;
+
+  explicit SoAVector(std::size_t count) {
+    resize(count);
+  }
+
+  std::size_t size() const { return w_.size(); }
+  bool empty() const { return w_.empty(); }
+
+  void reserve(std::size_t count) {
+    w_.reserve(count); x_.reserve(count); y_.reserve(count); z_.reserve(count);
+  }
+
+  //! \brief Resizes the batch; new elements are identity rotations.
+  void resize(std::size_t count) {
+    w_.resize(count, PrimType_(1.0));
+    x_.resize(count, PrimType_(0.0));
+    y_.resize(count, PrimType_(0.0));
+    z_.resize(count, PrimType_(0.0));
+  }
+
+  void clear() {
+    w_.clear(); x_.clear(); y_.clear(); z_.clear();
+  }
+
+  void push_back(const value_type& rotation) {
+    w_.push_back(rotation.w());
+    x_.push_back(rotation.x());
+    y_.push_back(rotation.y());
+    z_.push_back(rotation.z());
+  }
+
+  value_type get(std::size_t index) const {
+    return value_type(w_[index], x_[index], y_[index], z_[index]);
+  }
+
+  void set(std::size_t index, const value_type& rotation) {
+    w_[index] = rotation.w();
+    x_[index] = rotation.x();
+    y_[index] = rotation.y();
+    z_[index] = rotation.z();
+  }
+
+  value_type operator[](std::size_t index) const { return get(index); }
+  Proxy operator[](std::size_t index) { return Proxy(*this, index); }
+
+  iterator begin() { return iterator(*this, 0); }
+  iterator end() { return iterator(*this, size()); }
+  const_iterator begin() const { return const_iterator(*this, 0); }
+  const_iterator end() const { return const_iterator(*this, size()); }
+
+  //! Raw component arrays for the batch kernels (64-byte aligned).
+  const PrimType_* wData() const { return w_.data(); }
+  const PrimType_* xData() const { return x_.data(); }
+  const PrimType_* yData() const { return y_.data(); }
+  const PrimType_* zData() const { return z_.data(); }
+  PrimType_* wData() { return w_.data(); }
+  PrimType_* xData() { return x_.data(); }
+  PrimType_* yData() { return y_.data(); }
+  PrimType_* zData() { return z_.data(); }
+
+ private:
+  internal::AlignedScalarVector<PrimType_> w_;
+  internal::AlignedScalarVector<PrimType_> x_;
+  internal::AlignedScalarVector<PrimType_> y_;
+  internal::AlignedScalarVector<PrimType_> z_;
+};
+
+/*! \class SoAVector<Position>
+ * \brief Batch of 3D positions with one aligned array per component.
+ */
+template<typename PrimType_>
+class SoAVector<Position<PrimType_, 3>> {
+ public:
+  typedef PrimType_ Scalar;
+  typedef Position<PrimType_, 3> value_type;
+
+  class Proxy {
+   public:
+    Proxy(SoAVector& container, std::size_t index) : container_(container), index_(index) {}
+    operator value_type() const { return container_.get(index_); }
+    Proxy& operator=(const value_type& value) { container_.set(index_, value); return *this; }
+   private:
+    SoAVector& container_;
+    std::size_t index_;
+  };
+
+  class iterator {
+   public:
+    iterator(SoAVector& container, std::size_t index) : container_(container), index_(index) {}
+    Proxy operator*() const { return Proxy(container_, index_); }
+    iterator& operator++() { index_++; return *this; }
+    bool operator==(const iterator& other) const { return index_ == other.index_; }
+    bool operator!=(const iterator& other) const { return index_ != other.index_; }
+   private:
+    SoAVector& container_;
+    std::size_t index_;
+  };
+
+  class const_iterator {
+   public:
+    const_iterator(const SoAVector& container, std::size_t index) : container_(container), index_(index) {}
+    value_type operator*() const { return container_.get(index_); }
+    const_iterator& operator++() { index_++; return *this; }
+    bool operator==(const const_iterator& other) const { return index_ == other.index_; }
+    bool operator!=(const const_iterator& other) const { return index_ != other.index_; }
+   private:
+    const SoAVector& container_;
+    std::size_t index_;
+  };
+
+  SoAVector() = default;
+
+  explicit SoAVector(std::size_t count) {
+    resize(count);
+  }
+
+  std::size_t size() const { return x_.size(); }
+  bool empty() const { return x_.empty(); }
+
+  void reserve(std::size_t count) {
+    x_.reserve(count); y_.reserve(count); z_.reserve(count);
+  }
+
+  //! \brief Resizes the batch; new elements are zero.
+  void resize(std::size_t count) {
+    x_.resize(count, PrimType_(0.0));
+    y_.resize(count, PrimType_(0.0));
+    z_.resize(count, PrimType_(0.0));
+  }
+
+  void clear() {
+    x_.clear(); y_.clear(); z_.clear();
+  }
+
+  void push_back(const value_type& position) {
+    x_.push_back(position.x());
+    y_.push_back(position.y());
+    z_.push_back(position.z());
+  }
+
+  value_type get(std::size_t index) const {
+    return value_type(x_[index], y_[index], z_[index]);
+  }
+
+  void set(std::size_t index, const value_type& position) {
+    x_[index] = position.x();
+    y_[index] = position.y();
+    z_[index] = position.z();
+  }
+
+  value_type operator[](std::size_t index) const { return get(index); }
+  Proxy operator[](std::size_t index) { return Proxy(*this, index); }
+
+  iterator begin() { return iterator(*this, 0); }
+  iterator end() { return iterator(*this, size()); }
+  const_iterator begin() const { return const_iterator(*this, 0); }
+  const_iterator end() const { return const_iterator(*this, size()); }
+
+  //! Raw component arrays for the batch kernels (64-byte aligned).
+  const PrimType_* xData() const { return x_.data(); }
+  const PrimType_* yData() const { return y_.data(); }
+  const PrimType_* zData() const { return z_.data(); }
+  PrimType_* xData() { return x_.data(); }
+  PrimType_* yData() { return y_.data(); }
+  PrimType_* zData() { return z_.data(); }
+
+ private:
+  internal::AlignedScalarVector<PrimType_> x_;
+  internal::AlignedScalarVector<PrimType_> y_;
+  internal::AlignedScalarVector<PrimType_> z_;
+};
+
+/*! \class SoAVector<HomogeneousTransformation>
+ * \brief Batch of poses stored as a position SoA plus a quaternion SoA.
+ */
+template<typename PrimType_>
+class SoAVector<HomogeneousTransformation<PrimType_, Position<PrimType_, 3>, RotationQuaternion<PrimType_>>> {
+ public:
+  typedef PrimType_ Scalar;
+  typedef HomogeneousTransformation<PrimType_, Position<PrimType_, 3>, RotationQuaternion<PrimType_>> value_type;
+  typedef SoAVector<Position<PrimType_, 3>> Positions;
+  typedef SoAVector<RotationQuaternion<PrimType_>> Rotations;
+
+  class Proxy {
+   public:
+    Proxy(SoAVector& container, std::size_t index) : container_(container), index_(index) {}
+    operator value_type() const { return container_.get(index_); }
+    Proxy& operator=(const value_type& value) { container_.set(index_, value); return *this; }
+   private:
+    SoAVector& container_;
+    std::size_t index_;
+  };
+
+  class iterator {
+   public:
+    iterator(SoAVector& container, std::size_t index) : container_(container), index_(index) {}
+    Proxy operator*() const { return Proxy(container_, index_); }
+    iterator& operator++() { index_++; return *this; }
+    bool operator==(const iterator& other) const { return index_ == other.index_; }
+    bool operator!=(const iterator& other) const { return index_ != other.index_; }
+   private:
+    SoAVector& container_;
+    std::size_t index_;
+  };
+
+  class const_iterator {
+   public:
+    const_iterator(const SoAVector& container, std::size_t index) : container_(container), index_(index) {}
+    value_type operator*() const { return container_.get(index_); }
+    const_iterator& operator++() { index_++; return *this; }
+    bool operator==(const const_iterator& other) const { return index_ == other.index_; }
+    bool operator!=(const const_iterator& other) const { return index_ != other.index_; }
+   private:
+    const SoAVector& container_;
+    std::size_t index_;
+  };
+
+  SoAVector() = default;
+
+  explicit SoAVector(std::size_t count) {
+    resize(count);
+  }
+
+  std::size_t size() const { return positions_.size(); }
+  bool empty() const { return positions_.empty(); }
+
+  void reserve(std::size_t count) {
+    positions_.reserve(count);
+    rotations_.reserve(count);
+  }
+
+  //! \brief Resizes the batch; new elements are identity poses.
+  void resize(std::size_t count) {
+    positions_.resize(count);
+    rotations_.resize(count);
+  }
+
+  void clear() {
+    positions_.clear();
+    rotations_.clear();
+  }
+
+  void push_back(const value_type& pose) {
+    positions_.push_back(pose.getPosition());
+    rotations_.push_back(pose.getRotation());
+  }
+
+  value_type get(std::size_t index) const {
+    return value_type(positions_.get(index), rotations_.get(index));
+  }
+
+  void set(std::size_t index, const value_type& pose) {
+    positions_.set(index, pose.getPosition());
+    rotations_.set(index, pose.getRotation());
+  }
+
+  value_type operator[](std::size_t index) const { return get(index); }
+  Proxy operator[](std::size_t index) { return Proxy(*this, index); }
+
+  iterator begin() { return iterator(*this, 0); }
+  iterator end() { return iterator(*this, size()); }
+  const_iterator begin() const { return const_iterator(*this, 0); }
+  const_iterator end() const { return const_iterator(*this, size()); }
+
+  //! Component sub-containers for the batch kernels.
+  const Positions& positions() const { return positions_; }
+  Positions& positions() { return positions_; }
+  const Rotations& rotations() const { return rotations_; }
+  Rotations& rotations() { return rotations_; }
+
+ private:
+  Positions positions_;
+  Rotations rotations_;
+};
+
+} // namespace kindr
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace kindr {
+
+/*! \class SpscRingBuffer
+ *  \brief Lock-free single-producer single-consumer ring buffer.
+ *
+ *  Fixed-size wait-free queue for streaming kindr state (e.g. HomogeneousTransformation
+ *  or Twist samples) from a real-time thread to logging or monitoring threads.
+ *  All storage is embedded in the object, elements are constructed in place on
+ *  push, and the head and tail indices live on separate cache lines, so
+ *  publication on the producer side neither allocates, blocks, nor shares a
+ *  line with the consumer. Exactly one thread may push and one thread may pop;
+ *  no other concurrent access is allowed.
+ *
+ *  \tparam Type_      element type (must be copy-constructible)
+ *  \tparam Capacity_  maximum number of buffered elements
+ *  \ingroup common
+ */
+template<typename Type_, std::size_t Capacity_>
+class SpscRingBuffer {
+ private:
+  static_assert(Capacity_ > 0, "The capacity must be positive.");
+
+  //! Number of slots; one slot stays empty to distinguish full from empty
+  static constexpr std::size_t NumSlots = Capacity_ + 1;
+
+  //! Assumed size of a cache line for separating producer and consumer state
+  static constexpr std::size_t CacheLineSize = 64;
+
+ public:
+  //! The element type
+  typedef Type_ Item;
+
+  SpscRingBuffer()
+    : head_(0), tail_(0) {
+  }
+
+  //! The ring buffer is tied to its storage and must not be copied.
+  SpscRingBuffer(const SpscRingBuffer&) = delete;
+  SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+  ~SpscRingBuffer() {
+    // only the owning thread is left; drain the remaining elements
+    std::size_t head = head_.load(std::memory_order_relaxed);
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    while (head != tail) {
+      slot(head)->~Type_();
+      head = next(head);
+    }
+  }
+
+  /*! \brief Maximum number of buffered elements.
+   *  \returns capacity
+   */
+  static constexpr std::size_t capacity() {
+    return Capacity_;
+  }
+
+  /*! \brief Publishes an element (producer thread only).
+   *  Constructs the element in place; wait-free and allocation-free.
+   *  \param item   element to publish
+   *  \returns false if the buffer is full and the element was dropped
+   */
+  bool push(const Type_& item) {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    const std::size_t nextTail = next(tail);
+    if (nextTail == head_.load(std::memory_order_acquire)) {
+      return false; // full
+    }
+    ::new (static_cast<void*>(slot(tail))) Type_(item);
+    tail_.store(nextTail, std::memory_order_release);
+    return true;
+  }
+
+  /*! \brief Publishes an element constructed from the given arguments (producer thread only).
+   *  \param args   constructor arguments
+   *  \returns false if the buffer is full and the element was dropped
+   */
+  template<typename... Args_>
+  bool emplace(Args_&&... args) {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    const std::size_t nextTail = next(tail);
+    if (nextTail == head_.load(std::memory_order_acquire)) {
+      return false; // full
+    }
+    ::new (static_cast<void*>(slot(tail))) Type_(std::forward<Args_>(args)...);
+    tail_.store(nextTail, std::memory_order_release);
+    return true;
+  }
+
+  /*! \brief Retrieves the oldest element (consumer thread only).
+   *  \param item   overwritten with the retrieved element
+   *  \returns false if the buffer is empty
+   */
+  bool pop(Type_& item) {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) {
+      return false; // empty
+    }
+    item = *slot(head);
+    slot(head)->~Type_();
+    head_.store(next(head), std::memory_order_release);
+    return true;
+  }
+
+  /*! \brief Checks whether the buffer is empty (approximate under concurrency).
+   *  \returns true if empty
+   */
+  bool empty() const {
+    return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+  }
+
+  /*! \brief Number of buffered elements (approximate under concurrency).
+   *  \returns element count
+   */
+  std::size_t size() const {
+    const std::size_t head = head_.load(std::memory_order_acquire);
+    const std::size_t tail = tail_.load(std::memory_order_acquire);
+    return (tail >= head) ? (tail - head) : (NumSlots - head + tail);
+  }
+
+ private:
+  //! Advances a slot index with wrap-around
+  static std::size_t next(std::size_t index) {
+    return (index + 1 == NumSlots) ? 0 : (index + 1);
+  }
+
+  //! Typed access to a storage slot
+  Type_* slot(std::size_t index) {
+    return reinterpret_cast<Type_*>(&storage_[index]);
+  }
+
+  //! Uninitialized, correctly aligned element storage
+  typename std::aligned_storage<sizeof(Type_), alignof(Type_)>::type storage_[NumSlots];
+
+  //! Read index, on its own cache line so the consumer does not invalidate producer state
+  alignas(CacheLineSize) std::atomic<std::size_t> head_;
+
+  //! Write index, on its own cache line so the producer does not invalidate consumer state
+  alignas(CacheLineSize) std::atomic<std::size_t> tail_;
+};
+
+} // namespace kindr
@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "kindr/common/assert_macros.hpp"
+
+namespace kindr {
+
+/*! \file TaskPool.hpp
+ *  \brief Shared execution context for the parallel batch kernels.
+ *
+ *  Every batched sweep (compose, exp/log map, conversions, preintegration)
+ *  is a data-parallel loop, and each one growing its own thread pool would
+ *  leave N pools fighting over the same cores. All parallel kindr kernels
+ *  instead split their ranges through one process-wide Executor. By default
+ *  that is the sequential executor, which runs the range inline — the
+ *  header-only single-threaded behavior is unchanged until the application
+ *  installs a pool with setDefaultExecutor(). WorkStealingTaskPool is the
+ *  provided implementation: persistent workers own contiguous slices of the
+ *  range and steal chunks from the slices of busy workers when their own
+ *  runs dry, so uneven per-element cost does not serialize the sweep.
+ */
+
+/*! \class Executor
+ * \brief Interface the parallel kernels submit their ranges to.
+ *
+ *  Implementations split [begin, end) into chunks of at least grainSize
+ *  iterations and invoke the task once per chunk, potentially concurrently.
+ *  The task must not throw and must tolerate any chunking of the range.
+ */
+class Executor {
+ public:
+  virtual ~Executor() = default;
+
+  /*! \brief Runs a data-parallel loop over [begin, end).
+   *  \param begin       first index
+   *  \param end         one past the last index
+   *  \param grainSize   minimum number of iterations per chunk
+   *  \param task        invoked as task(chunkBegin, chunkEnd) for disjoint chunks covering the range
+   */
+  virtual void parallelFor(std::size_t begin, std::size_t end, std::size_t grainSize,
+                           const std::function<void(std::size_t, std::size_t)>& task) = 0;
+};
+
+/*! \class SequentialExecutor
+ * \brief Default executor; runs the whole range inline on the calling thread.
+ */
+class SequentialExecutor : public Executor {
+ public:
+  void parallelFor(std::size_t begin, std::size_t end, std::size_t /*grainSize*/,
+                   const std::function<void(std::size_t, std::size_t)>& task) override {
+    if (begin < end) {
+      task(begin, end);
+    }
+  }
+};
+
+namespace internal {
+
+/*! \brief The executor the kernels use when none is installed. (only for advanced users) */
+inline SequentialExecutor& getSequentialExecutor() {
+  static SequentialExecutor executor;
+  return executor;
+}
+
+/*! \brief Slot holding the installed executor. (only for advanced users) */
+inline std::atomic<Executor*>& getInstalledExecutor() {
+  static std::atomic<Executor*> executor(nullptr);
+  return executor;
+}
+
+} // namespace internal
+
+/*! \brief Installs the executor all parallel kernels submit to.
+ *
+ *  The executor must outlive every kernel call; passing nullptr restores the
+ *  sequential default.
+ *  \param executor   executor to install, or nullptr
+ */
+inline void setDefaultExecutor(Executor* executor) {
+  internal::getInstalledExecutor().store(executor, std::memory_order_release);
+}
+
+/*! \brief Returns the installed executor, or the sequential default. */
+inline Executor& getDefaultExecutor() {
+  Executor* executor = internal::getInstalledExecutor().load(std::memory_order_acquire);
+  return (executor != nullptr) ? *executor : internal::getSequentialExecutor();
+}
+
+/*! \brief Runs a data-parallel loop on the installed executor.
+ *
+ *  The entry point the batch kernels use; sequential unless an executor was
+ *  installed with setDefaultExecutor().
+ *  \param begin       first index
+ *  \param end         one past the last index
+ *  \param grainSize   minimum number of iterations per chunk
+ *  \param task        invoked as task(chunkBegin, chunkEnd) for disjoint chunks covering the range
+ */
+inline void parallelFor(std::size_t begin, std::size_t end, std::size_t grainSize,
+                        const std::function<void(std::size_t, std::size_t)>& task) {
+  getDefaultExecutor().parallelFor(begin, end, grainSize, task);
+}
+
+/*! \class WorkStealingTaskPool
+ * \brief Work-stealing executor with persistent worker threads.
+ *
+ *  parallelFor() deals every participant (the workers plus the calling
+ *  thread) a contiguous slice of the range, tracked by an atomic cursor.
+ *  Participants bite grainSize-sized chunks off their own slice and, once it
+ *  is exhausted, steal chunks from the slices of the others, so a few
+ *  expensive elements do not leave the remaining threads idle. One
+ *  parallelFor() runs at a time; concurrent callers are serialized.
+ */
+class WorkStealingTaskPool : public Executor {
+ public:
+  /*! \brief Constructor starting the worker threads.
+   *  \param numThreads   total number of threads working a range, including the caller;
+   *                      0 picks the hardware concurrency
+   */
+  explicit WorkStealingTaskPool(std::size_t numThreads = 0u)
+    : generation_(0u), remaining_(0u), shutdown_(false) {
+    if (numThreads == 0u) {
+      numThreads = std::thread::hardware_concurrency();
+      if (numThreads == 0u) {
+        numThreads = 1u;
+      }
+    }
+    numSlices_ = numThreads;
+    slices_.reset(new Slice[numThreads]);
+    // the caller participates, so one worker less than threads
+    for (std::size_t i = 0; i + 1u < numThreads; i++) {
+      workers_.emplace_back(&WorkStealingTaskPool::workerLoop, this, i);
+    }
+  }
+
+  ~WorkStealingTaskPool() override {
+    {
+      std::lock_guard<std::mutex> lock(jobMutex_);
+      shutdown_ = true;
+      generation_++;
+    }
+    jobStart_.notify_all();
+    for (std::thread& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  std::size_t getNumThreads() const {
+    return workers_.size() + 1u;
+  }
+
+  void parallelFor(std::size_t begin, std::size_t end, std::size_t grainSize,
+                   const std::function<void(std::size_t, std::size_t)>& task) override {
+    if (begin >= end) {
+      return;
+    }
+    if (grainSize == 0u) {
+      grainSize = 1u;
+    }
+    const std::size_t count = end - begin;
+    if (count <= grainSize || workers_.empty()) {
+      task(begin, end);
+      return;
+    }
+    // one parallel loop at a time; concurrent callers queue up here
+    std::lock_guard<std::mutex> serialize(callerMutex_);
+    const std::size_t participants = workers_.size() + 1u;
+    task_ = &task;
+    grainSize_ = grainSize;
+    // deal every participant a contiguous slice of the range
+    const std::size_t sliceSize = (count + participants - 1u)/participants;
+    for (std::size_t i = 0; i < participants; i++) {
+      const std::size_t sliceBegin = begin + std::min(count, i*sliceSize);
+      const std::size_t sliceEnd = begin + std::min(count, (i + 1u)*sliceSize);
+      slices_[i].cursor.store(sliceBegin, std::memory_order_relaxed);
+      slices_[i].end = sliceEnd;
+    }
+    {
+      std::lock_guard<std::mutex> lock(jobMutex_);
+      remaining_.store(workers_.size(), std::memory_order_relaxed);
+      generation_++;
+    }
+    jobStart_.notify_all();
+    work(workers_.size());
+    std::unique_lock<std::mutex> lock(jobMutex_);
+    jobDone_.wait(lock, [this] { return remaining_.load(std::memory_order_acquire) == 0u; });
+    task_ = nullptr;
+  }
+
+ private:
+  //! Atomic progress cursor of one participant's slice, padded against false sharing.
+  struct Slice {
+    std::atomic<std::size_t> cursor;
+    std::size_t end;
+    char padding[64u - 2u*sizeof(std::size_t)];
+  };
+
+  void workerLoop(std::size_t self) {
+    std::uint64_t seenGeneration = 0u;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(jobMutex_);
+        jobStart_.wait(lock, [this, seenGeneration] { return generation_ != seenGeneration; });
+        seenGeneration = generation_;
+        if (shutdown_) {
+          return;
+        }
+      }
+      work(self);
+      if (remaining_.fetch_sub(1u, std::memory_order_acq_rel) == 1u) {
+        std::lock_guard<std::mutex> lock(jobMutex_);
+        jobDone_.notify_one();
+      }
+    }
+  }
+
+  /*! \brief Drains the own slice, then steals chunks from the others. */
+  void work(std::size_t self) {
+    const std::function<void(std::size_t, std::size_t)>& task = *task_;
+    const std::size_t grain = grainSize_;
+    drain(slices_[self], grain, task);
+    for (std::size_t offset = 1u; offset < numSlices_; offset++) {
+      drain(slices_[(self + offset) % numSlices_], grain, task);
+    }
+  }
+
+  static void drain(Slice& slice, std::size_t grain,
+                    const std::function<void(std::size_t, std::size_t)>& task) {
+    while (true) {
+      const std::size_t chunkBegin = slice.cursor.fetch_add(grain, std::memory_order_relaxed);
+      if (chunkBegin >= slice.end) {
+        return;
+      }
+      task(chunkBegin, std::min(chunkBegin + grain, slice.end));
+    }
+  }
+
+  std::vector<std::thread> workers_;
+  std::unique_ptr<Slice[]> slices_;
+  std::size_t numSlices_;
+  const std::function<void(std::size_t, std::size_t)>* task_;
+  std::size_t grainSize_;
+  std::mutex callerMutex_;
+  std::mutex jobMutex_;
+  std::condition_variable jobStart_;
+  std::condition_variable jobDone_;
+  std::uint64_t generation_;
+  std::atomic<std::size_t> remaining_;
+  bool shutdown_;
+};
+
+} // namespace kindr
@@ -0,0 +1,457 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#include "kindr/poses/HomogeneousTransformation.hpp"
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/vectors/Vector.hpp"
+
+namespace kindr {
+
+/*! \file TextFormat.hpp
+ *  \brief Allocation-free text formatting and parsing for kindr types.
+ *
+ *  operator<< goes through iostreams, whose locale facets are looked up and
+ *  locked per operation, and reading text back required stringstreams; both
+ *  dominate the CPU cost of converting large text logs. TextWriter and
+ *  TextReader work on caller-provided character buffers instead: formatting
+ *  is one snprintf per scalar (with the decimal separator normalized to '.'),
+ *  parsing is a hand-rolled locale-independent scanner whose fast path
+ *  converts digits exactly via a power-of-ten table, and nothing allocates.
+ *  parseCsvLine() scans a whole delimiter-separated line of scalars in one
+ *  pass for bulk log replay.
+ */
+
+namespace internal {
+
+//! Powers of ten that are exactly representable as doubles (10^0 .. 10^22).
+inline const double* getExactPowersOfTen() {
+  static const double powers[23] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  return powers;
+}
+
+/*! \brief Parses one scalar from [cursor, end), advancing the cursor. (only for advanced users)
+ *
+ *  Accepts the usual fixed and scientific forms plus nan/inf, with '.' as the
+ *  decimal separator independent of the locale. Mantissa and exponent within
+ *  the double range are converted exactly through the power-of-ten table
+ *  (Clinger's fast path); the rare remainder falls back to strtod on a stack
+ *  copy of the token.
+ */
+inline bool parseScalarText(const char*& cursor, const char* end, double& value) {
+  const char* p = cursor;
+  while (p < end && (*p == ' ' || *p == '\t')) {
+    p++;
+  }
+  const char* tokenBegin = p;
+  bool negative = false;
+  if (p < end && (*p == '+' || *p == '-')) {
+    negative = (*p == '-');
+    p++;
+  }
+  if (p < end && (*p == 'n' || *p == 'N' || *p == 'i' || *p == 'I')) {
+    if (end - p >= 3 && (p[0] == 'n' || p[0] == 'N') && (p[1] == 'a' || p[1] == 'A') && (p[2] == 'n' || p[2] == 'N')) {
+      value = std::numeric_limits<double>::quiet_NaN();
+      cursor = p + 3;
+      return true;
+    }
+    if (end - p >= 3 && (p[0] == 'i' || p[0] == 'I') && (p[1] == 'n' || p[1] == 'N') && (p[2] == 'f' || p[2] == 'F')) {
+      value = negative ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+      cursor = p + 3;
+      return true;
+    }
+    return false;
+  }
+
+  std::uint64_t mantissa = 0u;
+  int digits = 0; // significant digits only; leading zeros do not consume the budget
+  int droppedDigits = 0;
+  int fractionDigits = 0;
+  bool anyDigit = false;
+  bool droppedFraction = false;
+  for (; p < end && *p >= '0' && *p <= '9'; p++) {
+    anyDigit = true;
+    if (digits < 19) {
+      mantissa = mantissa*10u + static_cast<std::uint64_t>(*p - '0');
+      if (mantissa != 0u) {
+        digits++;
+      }
+    } else {
+      droppedDigits++;
+    }
+  }
+  if (p < end && *p == '.') {
+    p++;
+    for (; p < end && *p >= '0' && *p <= '9'; p++) {
+      anyDigit = true;
+      if (digits < 19) {
+        mantissa = mantissa*10u + static_cast<std::uint64_t>(*p - '0');
+        fractionDigits++;
+        if (mantissa != 0u) {
+          digits++;
+        }
+      } else {
+        droppedFraction = true;
+      }
+    }
+  }
+  if (!anyDigit) {
+    return false;
+  }
+  int exponent = 0;
+  if (p < end && (*p == 'e' || *p == 'E')) {
+    const char* exponentBegin = p;
+    p++;
+    bool exponentNegative = false;
+    if (p < end && (*p == '+' || *p == '-')) {
+      exponentNegative = (*p == '-');
+      p++;
+    }
+    bool anyExponentDigit = false;
+    for (; p < end && *p >= '0' && *p <= '9'; p++) {
+      anyExponentDigit = true;
+      if (exponent < 100000) {
+        exponent = exponent*10 + (*p - '0');
+      }
+    }
+    if (!anyExponentDigit) {
+      p = exponentBegin; // a trailing 'e' belongs to the next token, not the number
+      exponent = 0;
+    } else if (exponentNegative) {
+      exponent = -exponent;
+    }
+  }
+
+  const int totalExponent = exponent - fractionDigits + droppedDigits;
+  if (droppedDigits == 0 && !droppedFraction && mantissa < (std::uint64_t(1) << 53)
+      && totalExponent >= -22 && totalExponent <= 22) {
+    // both factors are exact, so the single rounding of the multiply/divide is correct
+    double result = static_cast<double>(mantissa);
+    if (totalExponent >= 0) {
+      result *= getExactPowersOfTen()[totalExponent];
+    } else {
+      result /= getExactPowersOfTen()[-totalExponent];
+    }
+    value = negative ? -result : result;
+  } else {
+    char token[64];
+    const std::size_t length = static_cast<std::size_t>(p - tokenBegin);
+    if (length < sizeof(token)) {
+      std::memcpy(token, tokenBegin, length);
+      token[length] = '\0';
+    } else {
+      // absurdly long token: rebuild it from the 19 retained significant digits
+      // and the accumulated exponent, losing at most the final rounding digit
+      std::snprintf(token, sizeof(token), "%s%llue%d", negative ? "-" : "",
+                    static_cast<unsigned long long>(mantissa), totalExponent);
+    }
+    value = std::strtod(token, nullptr);
+    if (negative && value == 0.0) {
+      value = -0.0;
+    }
+  }
+  cursor = p;
+  return true;
+}
+
+} // namespace internal
+
+/*! \class TextWriter
+ * \brief Formats scalars into a caller-provided character buffer without allocating.
+ *
+ *  Scalars are written delimiter-separated; finish() NUL-terminates the buffer
+ *  and returns the length. If the buffer runs out the writer sets its overflow
+ *  flag and drops further output instead of truncating mid-number.
+ */
+class TextWriter {
+ public:
+  /*! \brief Constructor.
+   *  \param buffer      output buffer
+   *  \param size        size of the buffer in bytes, including the terminator
+   *  \param precision   significant digits per scalar; the default round-trips doubles
+   *  \param delimiter   character written between scalars
+   */
+  TextWriter(char* buffer, std::size_t size,
+             int precision = std::numeric_limits<double>::max_digits10,
+             char delimiter = ',')
+    : begin_(buffer), cursor_(buffer), end_(buffer + size), precision_(precision),
+      delimiter_(delimiter), first_(true), overflow_(size == 0u) {
+  }
+
+  /*! \brief Appends one scalar, preceded by the delimiter unless it is the first.
+   *  \param value   value to format
+   *  \returns true if the scalar fit into the buffer
+   */
+  bool writeScalar(double value) {
+    if (overflow_) {
+      return false;
+    }
+    char* mark = cursor_;
+    if (!first_ && !writeChar(delimiter_)) {
+      return false;
+    }
+    const std::size_t space = static_cast<std::size_t>(end_ - cursor_);
+    const int written = std::snprintf(cursor_, space, "%.*g", precision_, value);
+    if (written < 0 || static_cast<std::size_t>(written) >= space) {
+      cursor_ = mark;
+      overflow_ = true;
+      return false;
+    }
+    // normalize a locale-dependent decimal separator to '.'
+    for (char* c = cursor_; c != cursor_ + written; c++) {
+      if (*c == ',') {
+        *c = '.';
+      }
+    }
+    cursor_ += written;
+    first_ = false;
+    return true;
+  }
+
+  /*! \brief Appends one raw character (e.g. a newline between CSV records).
+   *  \param c   character to append
+   *  \returns true if the character fit into the buffer
+   */
+  bool writeChar(char c) {
+    if (overflow_ || cursor_ + 1 >= end_) {
+      overflow_ = true;
+      return false;
+    }
+    *cursor_++ = c;
+    return true;
+  }
+
+  //! Returns true if any output was dropped for lack of space.
+  bool hasOverflowed() const {
+    return overflow_;
+  }
+
+  //! Number of characters written so far.
+  std::size_t length() const {
+    return static_cast<std::size_t>(cursor_ - begin_);
+  }
+
+  /*! \brief NUL-terminates the buffer.
+   *  \returns number of characters written, excluding the terminator
+   */
+  std::size_t finish() {
+    if (begin_ != end_) {
+      *cursor_ = '\0';
+    }
+    return length();
+  }
+
+ private:
+  char* begin_;
+  char* cursor_;
+  char* end_;
+  int precision_;
+  char delimiter_;
+  bool first_;
+  bool overflow_;
+};
+
+/*! \class TextReader
+ * \brief Parses delimiter-separated scalars from a character range without allocating.
+ */
+class TextReader {
+ public:
+  /*! \brief Constructor.
+   *  \param buffer      input characters (need not be NUL-terminated)
+   *  \param size        number of characters
+   *  \param delimiter   character accepted between scalars
+   */
+  TextReader(const char* buffer, std::size_t size, char delimiter = ',')
+    : cursor_(buffer), end_(buffer + size), delimiter_(delimiter), first_(true) {
+  }
+
+  /*! \brief Reads the next scalar, consuming one delimiter before it unless it is the first.
+   *  \param value   parsed value
+   *  \returns true on success; on failure the cursor does not advance
+   */
+  bool readScalar(double& value) {
+    const char* p = cursor_;
+    while (p < end_ && (*p == ' ' || *p == '\t')) {
+      p++;
+    }
+    if (!first_) {
+      if (p == end_ || *p != delimiter_) {
+        return false;
+      }
+      p++;
+    }
+    if (!internal::parseScalarText(p, end_, value)) {
+      return false;
+    }
+    cursor_ = p;
+    first_ = false;
+    return true;
+  }
+
+  //! Returns true once only trailing whitespace remains.
+  bool isAtEnd() const {
+    const char* p = cursor_;
+    while (p < end_ && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) {
+      p++;
+    }
+    return p == end_;
+  }
+
+ private:
+  const char* cursor_;
+  const char* end_;
+  char delimiter_;
+  bool first_;
+};
+
+/*! \brief Writes a vector as delimiter-separated coefficients.
+ *  \param writer   destination writer
+ *  \param vector   vector to format
+ *  \returns true if everything fit into the buffer
+ */
+template<enum PhysicalType PhysicalType_, typename PrimType_, int Dimension_>
+bool writeText(TextWriter& writer, const Vector<PhysicalType_, PrimType_, Dimension_>& vector) {
+  bool good = true;
+  for (int i = 0; i < vector.toImplementation().size(); i++) {
+    good = writer.writeScalar(static_cast<double>(vector(i))) && good;
+  }
+  return good;
+}
+
+/*! \brief Writes a rotation quaternion as w,x,y,z.
+ *  \param writer     destination writer
+ *  \param rotation   rotation to format
+ *  \returns true if everything fit into the buffer
+ */
+template<typename PrimType_>
+bool writeText(TextWriter& writer, const RotationQuaternion<PrimType_>& rotation) {
+  bool good = writer.writeScalar(static_cast<double>(rotation.w()));
+  good = writer.writeScalar(static_cast<double>(rotation.x())) && good;
+  good = writer.writeScalar(static_cast<double>(rotation.y())) && good;
+  good = writer.writeScalar(static_cast<double>(rotation.z())) && good;
+  return good;
+}
+
+/*! \brief Writes a pose as px,py,pz,qw,qx,qy,qz.
+ *  \param writer   destination writer
+ *  \param pose     pose to format
+ *  \returns true if everything fit into the buffer
+ */
+template<typename PrimType_>
+bool writeText(TextWriter& writer, const HomogeneousTransformationPosition3RotationQuaternion<PrimType_>& pose) {
+  bool good = writer.writeScalar(static_cast<double>(pose.getPosition().x()));
+  good = writer.writeScalar(static_cast<double>(pose.getPosition().y())) && good;
+  good = writer.writeScalar(static_cast<double>(pose.getPosition().z())) && good;
+  return writeText(writer, pose.getRotation()) && good;
+}
+
+/*! \brief Reads a vector written by writeText().
+ *  \param reader   source reader
+ *  \param vector   parsed vector
+ *  \returns true on success
+ */
+template<enum PhysicalType PhysicalType_, typename PrimType_, int Dimension_>
+bool readText(TextReader& reader, Vector<PhysicalType_, PrimType_, Dimension_>& vector) {
+  for (int i = 0; i < vector.toImplementation().size(); i++) {
+    double value;
+    if (!reader.readScalar(value)) {
+      return false;
+    }
+    vector(i) = static_cast<PrimType_>(value);
+  }
+  return true;
+}
+
+/*! \brief Reads a rotation quaternion written by writeText().
+ *  \param reader     source reader
+ *  \param rotation   parsed rotation
+ *  \returns true on success
+ */
+template<typename PrimType_>
+bool readText(TextReader& reader, RotationQuaternion<PrimType_>& rotation) {
+  double w, x, y, z;
+  if (!reader.readScalar(w) || !reader.readScalar(x) || !reader.readScalar(y) || !reader.readScalar(z)) {
+    return false;
+  }
+  rotation = RotationQuaternion<PrimType_>(static_cast<PrimType_>(w), static_cast<PrimType_>(x),
+                                           static_cast<PrimType_>(y), static_cast<PrimType_>(z));
+  return true;
+}
+
+/*! \brief Reads a pose written by writeText().
+ *  \param reader   source reader
+ *  \param pose     parsed pose
+ *  \returns true on success
+ */
+template<typename PrimType_>
+bool readText(TextReader& reader, HomogeneousTransformationPosition3RotationQuaternion<PrimType_>& pose) {
+  typedef HomogeneousTransformationPosition3RotationQuaternion<PrimType_> Pose;
+  double x, y, z;
+  if (!reader.readScalar(x) || !reader.readScalar(y) || !reader.readScalar(z)) {
+    return false;
+  }
+  typename Pose::Rotation rotation;
+  if (!readText(reader, rotation)) {
+    return false;
+  }
+  pose = Pose(typename Pose::Position(static_cast<PrimType_>(x), static_cast<PrimType_>(y), static_cast<PrimType_>(z)),
+              rotation);
+  return true;
+}
+
+/*! \brief Parses one delimiter-separated line of scalars in a single pass.
+ *  \param line       line characters, without the newline
+ *  \param size       number of characters
+ *  \param values     output array
+ *  \param capacity   size of the output array
+ *  \param delimiter  character between scalars
+ *  \returns number of scalars parsed; parsing stops at the first malformed field or at capacity
+ */
+template<typename PrimType_>
+std::size_t parseCsvLine(const char* line, std::size_t size, PrimType_* values, std::size_t capacity,
+                         char delimiter = ',') {
+  TextReader reader(line, size, delimiter);
+  std::size_t count = 0u;
+  double value;
+  while (count < capacity && reader.readScalar(value)) {
+    values[count++] = static_cast<PrimType_>(value);
+  }
+  return count;
+}
+
+} // namespace kindr
@@ -100,6 +100,116 @@ namespace kindr {
     kindr::internal::kindr_throw_exception<exceptionType>("[" #exceptionType "] ", SourceFilePos, kindr_assert_stringstream.str()); \
   }
 
+
+//! Tells the optimizer that the condition holds, without evaluating it at runtime.
+//  The condition must be free of side effects. On compilers without a
+//  non-evaluating assume intrinsic the hint is dropped entirely, because
+//  evaluating the condition for __builtin_unreachable() could cost more than
+//  the check it replaces.
+#if defined(__clang__)
+#define KINDR_ASSUME(condition) __builtin_assume(condition)
+#elif defined(_MSC_VER)
+#define KINDR_ASSUME(condition) __assume(condition)
+#elif defined(__GNUC__) && (__GNUC__ >= 13)
+#define KINDR_ASSUME(condition) __attribute__((assume(condition)))
+#else
+#define KINDR_ASSUME(condition) static_cast<void>(0)
+#endif
+
+
+/* KINDR_USE_ASSUME_ASSERTS turns the always-on KINDR_ASSERT_* checks into
+ * optimizer hints: instead of a branch plus exception-path code in every
+ * inlined function, the validated invariant is handed to the compiler with
+ * KINDR_ASSUME. Only enable this for release builds whose inputs have been
+ * exercised with the checks active — a violated assumption is undefined
+ * behavior, not an exception.
+ *
+ * KINDR_ASSERT_SAMPLING_RATE=N (with the mode enabled) keeps a safety net:
+ * each call site still validates every Nth call through a thread-local
+ * counter and throws as usual, so production retains a bounded-cost chance
+ * of catching a violated invariant before the assumption misleads the
+ * optimizer on a later call.
+ */
+#if defined(KINDR_USE_ASSUME_ASSERTS)
+
+#if defined(KINDR_ASSERT_SAMPLING_RATE) && (KINDR_ASSERT_SAMPLING_RATE > 0)
+#define KINDR_ASSERT_SAMPLED_CHECK(exceptionType, condition, message)    \
+  {                                  \
+    static thread_local unsigned kindr_assert_sample_counter = 0u;       \
+    if (++kindr_assert_sample_counter >= (KINDR_ASSERT_SAMPLING_RATE)) { \
+      kindr_assert_sample_counter = 0u;                                  \
+      if (!(condition)) {                                                \
+        std::stringstream kindr_assert_stringstream;                     \
+        kindr_assert_stringstream << "sampled assert(" << #condition << ") failed: " << message; \
+        kindr::internal::kindr_throw_exception<exceptionType>("[" #exceptionType "] ", __FUNCTION__,__FILE__,__LINE__, kindr_assert_stringstream.str()); \
+      }                                                                  \
+    }                                                                    \
+  }
+#else
+#define KINDR_ASSERT_SAMPLED_CHECK(exceptionType, condition, message)
+#endif
+
+#define KINDR_ASSERT_TRUE(exceptionType, condition, message)             \
+  {                                                                      \
+    KINDR_ASSERT_SAMPLED_CHECK(exceptionType, condition, message);       \
+    KINDR_ASSUME(condition);                                             \
+  }
+
+#define KINDR_ASSERT_FALSE(exceptionType, condition, message)            \
+  {                                                                      \
+    KINDR_ASSERT_SAMPLED_CHECK(exceptionType, !(condition), message);    \
+    KINDR_ASSUME(!(condition));                                          \
+  }
+
+#define KINDR_ASSERT_GE_LT(exceptionType, value, lowerBound, upperBound, message) \
+  {                                                                      \
+    KINDR_ASSERT_SAMPLED_CHECK(exceptionType, (value) >= (lowerBound) && (value) < (upperBound), message); \
+    KINDR_ASSUME((value) >= (lowerBound) && (value) < (upperBound));     \
+  }
+
+#define KINDR_ASSERT_LT(exceptionType, value, upperBound, message)       \
+  {                                                                      \
+    KINDR_ASSERT_SAMPLED_CHECK(exceptionType, (value) < (upperBound), message); \
+    KINDR_ASSUME((value) < (upperBound));                                \
+  }
+
+#define KINDR_ASSERT_GE(exceptionType, value, lowerBound, message)       \
+  {                                                                      \
+    KINDR_ASSERT_SAMPLED_CHECK(exceptionType, (value) >= (lowerBound), message); \
+    KINDR_ASSUME((value) >= (lowerBound));                               \
+  }
+
+#define KINDR_ASSERT_LE(exceptionType, value, upperBound, message)       \
+  {                                                                      \
+    KINDR_ASSERT_SAMPLED_CHECK(exceptionType, (value) <= (upperBound), message); \
+    KINDR_ASSUME((value) <= (upperBound));                               \
+  }
+
+#define KINDR_ASSERT_GT(exceptionType, value, lowerBound, message)       \
+  {                                                                      \
+    KINDR_ASSERT_SAMPLED_CHECK(exceptionType, (value) > (lowerBound), message); \
+    KINDR_ASSUME((value) > (lowerBound));                                \
+  }
+
+#define KINDR_ASSERT_EQ(exceptionType, value, testValue, message)        \
+  {                                                                      \
+    KINDR_ASSERT_SAMPLED_CHECK(exceptionType, (value) == (testValue), message); \
+    KINDR_ASSUME((value) == (testValue));                                \
+  }
+
+#define KINDR_ASSERT_NE(exceptionType, value, testValue, message)        \
+  {                                                                      \
+    KINDR_ASSERT_SAMPLED_CHECK(exceptionType, (value) != (testValue), message); \
+    KINDR_ASSUME((value) != (testValue));                                \
+  }
+
+#define KINDR_ASSERT_NEAR(exceptionType, value, testValue, abs_error, message) \
+  {                                                                      \
+    KINDR_ASSERT_SAMPLED_CHECK(exceptionType, fabs((testValue) - (value)) <= fabs(abs_error), message); \
+  }
+
+#else // !KINDR_USE_ASSUME_ASSERTS
+
 #define KINDR_ASSERT_TRUE(exceptionType, condition, message)       \
   if(!(condition))                            \
     {                                 \
@@ -188,6 +298,8 @@ namespace kindr {
       kindr::internal::kindr_throw_exception<exceptionType>("[" #exceptionType "] ", __FUNCTION__,__FILE__,__LINE__,kindr_assert_stringstream.str()); \
     }
 
+#endif // KINDR_USE_ASSUME_ASSERTS
+
 
 
 #ifndef NDEBUG
@@ -301,6 +413,23 @@ namespace kindr {
 
 #define KINDR_OUT(X)
 #define KINDR_THROW_DBG(exceptionType, message)
+
+#if defined(KINDR_USE_ASSUME_ASSERTS)
+
+// the invariants validated in debug builds become optimizer hints in release
+#define KINDR_ASSERT_TRUE_DBG(exceptionType, condition, message) KINDR_ASSUME(condition)
+#define KINDR_ASSERT_FALSE_DBG(exceptionType, condition, message) KINDR_ASSUME(!(condition))
+#define KINDR_ASSERT_GE_LT_DBG(exceptionType, value, lowerBound, upperBound, message) KINDR_ASSUME((value) >= (lowerBound) && (value) < (upperBound))
+#define KINDR_ASSERT_LT_DBG(exceptionType, value, upperBound, message) KINDR_ASSUME((value) < (upperBound))
+#define KINDR_ASSERT_GT_DBG(exceptionType, value, lowerBound, message) KINDR_ASSUME((value) > (lowerBound))
+#define KINDR_ASSERT_LE_DBG(exceptionType, value, upperBound, message) KINDR_ASSUME((value) <= (upperBound))
+#define KINDR_ASSERT_GE_DBG(exceptionType, value, lowerBound, message) KINDR_ASSUME((value) >= (lowerBound))
+#define KINDR_ASSERT_NE_DBG(exceptionType, value, testValue, message) KINDR_ASSUME((value) != (testValue))
+#define KINDR_ASSERT_EQ_DBG(exceptionType, value, testValue, message) KINDR_ASSUME((value) == (testValue))
+#define KINDR_ASSERT_NEAR_DBG(exceptionType, value, testValue, abs_error, message)
+
+#else
+
 #define KINDR_ASSERT_TRUE_DBG(exceptionType, condition, message)
 #define KINDR_ASSERT_FALSE_DBG(exceptionType, condition, message)
 #define KINDR_ASSERT_GE_LT_DBG(exceptionType, value, lowerBound, upperBound, message)
@@ -311,6 +440,8 @@ namespace kindr {
 #define KINDR_ASSERT_NE_DBG(exceptionType, value, testValue, message)
 #define KINDR_ASSERT_EQ_DBG(exceptionType, value, testValue, message)
 #define KINDR_ASSERT_NEAR_DBG(exceptionType, value, testValue, abs_error, message)
+
+#endif // KINDR_USE_ASSUME_ASSERTS
 #endif
 
 #endif /* KINDR_ASSERT_MACROS_HPP_ */
@@ -30,6 +30,7 @@
 
 #include <cmath>
 #include <cassert>
+#include <cstdint>
 #include <iostream>
 #include <limits>
 #include <random>
@@ -37,6 +38,19 @@
 
 namespace kindr {
 
+/*! \brief Tag type selecting constructors that skip input validation.
+ *
+ * Pass kindr::trusted when the input is valid by construction (e.g. a unit
+ * quaternion deserialized from our own logs or produced by a composition of
+ * unit quaternions), so hot paths do not pay for the debug-mode checks.
+ */
+struct trusted_t {
+  explicit constexpr trusted_t() = default;
+};
+
+//! Tag instance passed to no-validate constructors
+constexpr trusted_t trusted = trusted_t();
+
 /*! \brief Floating-point modulo
  *
  * The result (the remainder) has same sign as the divisor.
@@ -105,14 +119,116 @@ inline T wrapTwoPI(T angle)
     return floatingPointModulo(angle, T(2.0*M_PI));
 }
 
+/*! \brief Branchless canonicalization of an Euler angle triple.
+ *
+ * Maps the angles, given in rotation-sequence order, onto the unique ranges used
+ * by EulerAnglesZyx::getUnique() and EulerAnglesXyz::getUnique(): the first and
+ * last angles end up in [-pi,pi) and the middle angle in [-pi/2,pi/2), with the
+ * same 1e-3 gimbal-lock band in which the last angle is folded into the first
+ * angle and zeroed. All case selection is done with arithmetic masks instead of
+ * data-dependent branches, so the function pipelines well when called for many
+ * triples in a row.
+ *
+ * \param firstAngle    angle of the first elementary rotation (modified in place)
+ * \param middleAngle   angle of the second elementary rotation (modified in place)
+ * \param lastAngle     angle of the third elementary rotation (modified in place)
+ */
+template<typename T>
+inline void wrapUniqueEulerAngles(T& firstAngle, T& middleAngle, T& lastAngle)
+{
+    const T first = floatingPointModulo(firstAngle + T(M_PI), T(2.0*M_PI)) - T(M_PI);
+    const T middle = floatingPointModulo(middleAngle + T(M_PI), T(2.0*M_PI)) - T(M_PI);
+    const T last = floatingPointModulo(lastAngle + T(M_PI), T(2.0*M_PI)) - T(M_PI);
+
+    const T tol = T(1e-3);
+
+    // masks: 1 beyond the pole (middle angle outside [-pi/2-tol, pi/2+tol]),
+    //        1 within the gimbal-lock band around +-pi/2, 0 otherwise
+    const T flip = static_cast<T>(std::fabs(middle) > T(M_PI_2) + tol);
+    const T lock = static_cast<T>(std::fabs(std::fabs(middle) - T(M_PI_2)) <= tol);
+    const T keep = T(1) - flip;
+
+    // candidate values for the far side of the pole
+    const T firstFlipped = floatingPointModulo(first, T(2.0*M_PI)) - T(M_PI);
+    const T middleFlipped = std::copysign(T(M_PI), middle) - middle;
+    const T lastFlipped = floatingPointModulo(last, T(2.0*M_PI)) - T(M_PI);
+
+    // within the lock band the last angle is folded into the first angle;
+    // the fold direction follows the sign of the middle angle
+    const T fold = lock*std::copysign(T(1), middle);
+
+    firstAngle = keep*first + flip*firstFlipped + fold*last;
+    middleAngle = keep*middle + flip*middleFlipped;
+    lastAngle = (T(1) - lock)*(keep*last + flip*lastFlipped);
+}
+
+
+namespace internal {
+
+/*! \brief xoshiro256++ pseudo-random generator.
+ *
+ *  Satisfies the UniformRandomBitGenerator concept, so it can be plugged into
+ *  the standard distributions. Seeding happens once per engine from
+ *  std::random_device through a splitmix64 scrambler, which is what makes the
+ *  thread-local instance below cheap to draw from compared to constructing a
+ *  freshly seeded std::mt19937 per call.
+ *  (only for advanced users)
+ */
+class Xoshiro256PlusPlus {
+ public:
+  typedef uint64_t result_type;
+
+  Xoshiro256PlusPlus() {
+    std::random_device randomDevice;
+    uint64_t seed = (static_cast<uint64_t>(randomDevice()) << 32) ^ static_cast<uint64_t>(randomDevice());
+    for (int i = 0; i < 4; i++) {
+      // splitmix64 expands the seed into the four state words
+      seed += 0x9e3779b97f4a7c15ull;
+      uint64_t word = seed;
+      word = (word ^ (word >> 30))*0xbf58476d1ce4e5b9ull;
+      word = (word ^ (word >> 27))*0x94d049bb133111ebull;
+      state_[i] = word ^ (word >> 31);
+    }
+  }
+
+  static constexpr result_type min() { return 0u; }
+  static constexpr result_type max() { return ~static_cast<result_type>(0u); }
+
+  inline result_type operator ()() {
+    const uint64_t result = rotl(state_[0] + state_[3], 23) + state_[0];
+    const uint64_t temp = state_[1] << 17;
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= temp;
+    state_[3] = rotl(state_[3], 45);
+    return result;
+  }
+
+ private:
+  static inline uint64_t rotl(uint64_t value, int shift) {
+    return (value << shift) | (value >> (64 - shift));
+  }
+
+  uint64_t state_[4];
+};
+
+/*! \brief Returns the thread-local random engine used by the setRandom() methods.
+ *  (only for advanced users)
+ */
+inline Xoshiro256PlusPlus& getRandomEngine() {
+  static thread_local Xoshiro256PlusPlus engine;
+  return engine;
+}
+
+} // namespace internal
 
 template <typename PrimType_,  int Rows_>
 static inline void setUniformRandom(Eigen::Matrix<PrimType_, Rows_, 1>& vector, PrimType_ min, PrimType_ max) {
-  std::random_device  rand_dev;
-  std::mt19937 generator(rand_dev());
   std::uniform_real_distribution<PrimType_>  distr(min, max);
   for (int i=0; i<vector.size(); i++) {
-    vector(i) = distr(generator);
+    vector(i) = distr(internal::getRandomEngine());
   }
 }
 
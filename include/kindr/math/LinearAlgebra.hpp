@@ -27,6 +27,9 @@
 */
 #pragma once
 
+#include <vector>
+
+#include <Eigen/LU>
 #include <Eigen/SVD>
 
 namespace kindr {
@@ -56,6 +59,64 @@ inline static Eigen::Matrix<PrimType_, 3, 1> getVectorFromSkewMatrix(const Eigen
 
 
 
+/*!
+ * \brief Gets the skew-symmetric matrices of a batch of (column) vectors
+ *
+ * Batch variant of getSkewMatrixFromVector() for callers that build one skew matrix per body
+ * or contact point inside a loop. The output vector is resized to one 3x3 matrix per column
+ * of the input.
+ *
+ * \param   vectors 3xN-matrix, one vector per column
+ * \param   skewMatrices  packed array of 3x3-matrices, one per input column
+ */
+template<typename PrimType_>
+inline static void getSkewMatrixFromVectorBatch(const Eigen::Matrix<PrimType_, 3, Eigen::Dynamic>& vectors,
+                                                std::vector<Eigen::Matrix<PrimType_, 3, 3>, Eigen::aligned_allocator<Eigen::Matrix<PrimType_, 3, 3>>>& skewMatrices) {
+  skewMatrices.resize(vectors.cols());
+  for (int i = 0; i < vectors.cols(); i++) {
+    skewMatrices[i] << PrimType_(0), -vectors(2,i),  vectors(1,i),
+                       vectors(2,i),  PrimType_(0), -vectors(0,i),
+                      -vectors(1,i),  vectors(0,i),  PrimType_(0);
+  }
+}
+
+/*!
+ * \brief Gets a batch of 3x1 vectors from a batch of skew-symmetric matrices
+ * \param   skewMatrices  packed array of 3x3-matrices
+ * \return  3xN-matrix, one vector per column
+ */
+template<typename PrimType_>
+inline static Eigen::Matrix<PrimType_, 3, Eigen::Dynamic> getVectorFromSkewMatrixBatch(const std::vector<Eigen::Matrix<PrimType_, 3, 3>, Eigen::aligned_allocator<Eigen::Matrix<PrimType_, 3, 3>>>& skewMatrices) {
+  Eigen::Matrix<PrimType_, 3, Eigen::Dynamic> vectors(3, skewMatrices.size());
+  for (std::size_t i = 0; i < skewMatrices.size(); i++) {
+    vectors(0,i) = skewMatrices[i](2,1);
+    vectors(1,i) = skewMatrices[i](0,2);
+    vectors(2,i) = skewMatrices[i](1,0);
+  }
+  return vectors;
+}
+
+/*!
+ * \brief Computes the column-wise cross product of two batches of vectors
+ *
+ * Fused kernel for output.col(i) = lhs.col(i) x rhs.col(i): applying v x directly avoids
+ * materializing the intermediate skew matrices just to multiply them. The computation is
+ * expressed row-wise so it vectorizes across the batch.
+ *
+ * \param   lhs 3xN-matrix, one vector per column
+ * \param   rhs 3xN-matrix, one vector per column
+ * \param   output 3xN-matrix the cross products are written to (must not alias the inputs)
+ */
+template<typename PrimType_>
+inline static void crossBatch(const Eigen::Matrix<PrimType_, 3, Eigen::Dynamic>& lhs,
+                              const Eigen::Matrix<PrimType_, 3, Eigen::Dynamic>& rhs,
+                              Eigen::Matrix<PrimType_, 3, Eigen::Dynamic>& output) {
+  output.resize(3, lhs.cols());
+  output.row(0) = lhs.row(1).cwiseProduct(rhs.row(2)) - lhs.row(2).cwiseProduct(rhs.row(1));
+  output.row(1) = lhs.row(2).cwiseProduct(rhs.row(0)) - lhs.row(0).cwiseProduct(rhs.row(2));
+  output.row(2) = lhs.row(0).cwiseProduct(rhs.row(1)) - lhs.row(1).cwiseProduct(rhs.row(0));
+}
+
 /*!
  * \brief Computes the Moore–Penrose pseudoinverse
  * info: http://eigen.tuxfamily.org/bz/show_bug.cgi?id=257
@@ -76,4 +137,69 @@ bool static pseudoInverse(const _Matrix_Type_ &a, _Matrix_Type_ &result, double
   return true;
 }
 
+/*!
+ * \brief Computes the Moore–Penrose pseudoinverse of a fixed-size square matrix
+ *
+ * Overload for fixed-size square matrices (e.g. the 3x3/6x6 blocks of contact Jacobians).
+ * The full-rank case is handled by a pivoted LU inverse on the stack, which avoids both the
+ * heap-allocated SVD workspaces and most of its flops; only rank-deficient inputs fall back
+ * to a fixed-size SVD.
+ *
+ * \param a: Matrix to invert
+ * \param result: Result is written here
+ * \param epsilon: Numerical precision (for example 1e-6)
+ * \return true if successful
+ */
+template<typename PrimType_, int Dim_>
+bool static pseudoInverse(const Eigen::Matrix<PrimType_, Dim_, Dim_> &a, Eigen::Matrix<PrimType_, Dim_, Dim_> &result, double epsilon = std::numeric_limits<PrimType_>::epsilon())
+{
+  typedef Eigen::Matrix<PrimType_, Dim_, Dim_> Matrix;
+
+  Eigen::FullPivLU<Matrix> lu(a);
+  lu.setThreshold(epsilon * Dim_);
+  if (lu.isInvertible()) {
+    result = lu.inverse();
+    return true;
+  }
+
+  // Rank-deficient: thin unitaries are unavailable for fixed-size inputs, so use the full ones.
+  Eigen::JacobiSVD<Matrix> svd(a, Eigen::ComputeFullU | Eigen::ComputeFullV);
+  PrimType_ tolerance = epsilon * Dim_ * svd.singularValues().array().abs().maxCoeff();
+  const Eigen::Matrix<PrimType_, Dim_, 1> invertedSingularValues =
+      (svd.singularValues().array().abs() > tolerance).select(svd.singularValues().array().inverse(), 0);
+  result = svd.matrixV() * invertedSingularValues.asDiagonal() * svd.matrixU().adjoint();
+  return true;
+}
+
+/*!
+ * \brief Preallocated workspace for repeated pseudoInverse calls on same-shaped inputs
+ *
+ * Holds the SVD decomposition object so that its workspaces are allocated once and reused
+ * across calls instead of reallocated per invocation.
+ */
+template<typename _Matrix_Type_>
+struct PseudoInverseWorkspace {
+  Eigen::JacobiSVD<_Matrix_Type_> svd;
+};
+
+/*!
+ * \brief Computes the Moore–Penrose pseudoinverse with a preallocated workspace
+ * \param a: Matrix to invert
+ * \param result: Result is written here
+ * \param workspace: Workspace reused across calls on same-shaped inputs
+ * \param epsilon: Numerical precision (for example 1e-6)
+ * \return true if successful
+ */
+template<typename _Matrix_Type_>
+bool static pseudoInverse(const _Matrix_Type_ &a, _Matrix_Type_ &result, PseudoInverseWorkspace<_Matrix_Type_> &workspace, double epsilon = std::numeric_limits<typename _Matrix_Type_::Scalar>::epsilon())
+{
+  workspace.svd.compute(a, Eigen::ComputeThinU | Eigen::ComputeThinV);
+
+  typename _Matrix_Type_::Scalar tolerance = epsilon * std::max(a.cols(), a.rows()) * workspace.svd.singularValues().array().abs().maxCoeff();
+
+  result = workspace.svd.matrixV() * _Matrix_Type_( (workspace.svd.singularValues().array().abs() > tolerance).select(workspace.svd.singularValues().array().inverse(), 0) ).asDiagonal() * workspace.svd.matrixU().adjoint();
+
+  return true;
+}
+
 } // end namespace kindr
@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/packed/Packed.hpp"
+
+namespace kindr {
+namespace packed {
+
+/*! \file DeltaPoseCodec.hpp
+ *  \brief Streaming delta compression for pose trajectory logs.
+ *
+ *  High-rate pose logs are dominated by tiny frame-to-frame deltas; writing
+ *  full packed::Pose records wastes most of the bandwidth on near-identical
+ *  scalars. The codec encodes each pose against its predecessor: the rotation
+ *  as the boxMinus tangent vector and the translation as a difference, both
+ *  quantized to a configurable precision and stored as zigzag varints, so a
+ *  steady-state record is a handful of bytes instead of 56. Periodic keyframes
+ *  carry the full packed pose for seekability and bound the effect of a
+ *  corrupted record. The encoder tracks the dequantized pose as its
+ *  predecessor, so quantization errors do not accumulate along the stream.
+ */
+
+//! Record tag of a full packed pose.
+static const uint8_t deltaCodecKeyframeTag = 0x4Bu; // 'K'
+//! Record tag of a quantized delta record.
+static const uint8_t deltaCodecDeltaTag = 0x44u; // 'D'
+
+//! Stream header of a delta-compressed pose log: layout header plus the quantization steps.
+struct DeltaHeader {
+  Header base;
+  double positionPrecision;
+  double rotationPrecision;
+};
+
+static_assert(std::is_standard_layout<DeltaHeader>::value && sizeof(DeltaHeader) == 24u,
+              "DeltaHeader must be standard-layout and 24 bytes");
+
+//! Byte offset and pose index of a keyframe, for seeking into the stream.
+struct KeyframeEntry {
+  uint64_t byteOffset;
+  uint64_t poseIndex;
+};
+
+namespace internal {
+
+/*! \brief Appends an unsigned value as a LEB128 varint. (only for advanced users) */
+inline void appendVarint(std::vector<uint8_t>& buffer, uint64_t value) {
+  while (value >= 0x80u) {
+    buffer.push_back(static_cast<uint8_t>(value) | 0x80u);
+    value >>= 7u;
+  }
+  buffer.push_back(static_cast<uint8_t>(value));
+}
+
+/*! \brief Reads a LEB128 varint and advances the cursor. (only for advanced users) */
+inline uint64_t readVarint(const uint8_t* data, std::size_t size, std::size_t& cursor) {
+  uint64_t value = 0u;
+  unsigned int shift = 0u;
+  // a 64-bit value needs at most ten varint bytes; more means the stream is corrupt
+  while (shift < 64u) {
+    KINDR_ASSERT_TRUE(std::runtime_error, cursor < size, "Delta pose stream is truncated.");
+    const uint8_t byte = data[cursor++];
+    value |= static_cast<uint64_t>(byte & 0x7Fu) << shift;
+    if ((byte & 0x80u) == 0u) {
+      return value;
+    }
+    shift += 7u;
+  }
+  KINDR_THROW(std::runtime_error, "Corrupt varint in delta pose stream.");
+  return 0u;
+}
+
+/*! \brief Maps a signed value to an unsigned one with small magnitudes staying small. */
+inline uint64_t zigzagEncode(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1u) ^ static_cast<uint64_t>(value >> 63);
+}
+
+/*! \brief Inverse of zigzagEncode(). */
+inline int64_t zigzagDecode(uint64_t value) {
+  return static_cast<int64_t>(value >> 1u) ^ -static_cast<int64_t>(value & 1u);
+}
+
+} // namespace internal
+
+/*! \class DeltaPoseEncoder
+ * \brief Streaming encoder writing delta-compressed pose records into a byte buffer.
+ *
+ *  addPose() appends one record per call: a keyframe every keyframeInterval
+ *  poses (and for the first pose), a quantized delta otherwise. The buffer can
+ *  be written to disk as-is; the keyframe table allows a reader to start
+ *  decoding mid-stream.
+ *
+ *  \tparam PrimType_ the primitive type of the poses (double or float)
+ */
+template<typename PrimType_>
+class DeltaPoseEncoder {
+ public:
+  typedef HomogeneousTransformationPosition3RotationQuaternion<PrimType_> PoseType;
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+
+  /*! \brief Constructor writing the stream header.
+   *  \param positionPrecision   quantization step of the translation deltas
+   *  \param rotationPrecision   quantization step of the rotation tangent, in radians
+   *  \param keyframeInterval    number of poses between two keyframes
+   */
+  explicit DeltaPoseEncoder(PrimType_ positionPrecision = PrimType_(1e-6),
+                            PrimType_ rotationPrecision = PrimType_(1e-7),
+                            std::size_t keyframeInterval = 128u)
+    : positionPrecision_(positionPrecision),
+      rotationPrecision_(rotationPrecision),
+      keyframeInterval_(keyframeInterval),
+      count_(0u) {
+    KINDR_ASSERT_TRUE(std::runtime_error, positionPrecision > PrimType_(0), "Position precision must be positive.");
+    KINDR_ASSERT_TRUE(std::runtime_error, rotationPrecision > PrimType_(0), "Rotation precision must be positive.");
+    KINDR_ASSERT_TRUE(std::runtime_error, keyframeInterval > 0u, "Keyframe interval must be positive.");
+    DeltaHeader header;
+    header.base = makeHeader<PrimType_>();
+    header.positionPrecision = static_cast<double>(positionPrecision);
+    header.rotationPrecision = static_cast<double>(rotationPrecision);
+    buffer_.resize(sizeof(DeltaHeader));
+    std::memcpy(buffer_.data(), &header, sizeof(header));
+  }
+
+  /*! \brief Appends one pose to the stream.
+   *  \param pose   pose to encode
+   */
+  void addPose(const PoseType& pose) {
+    if (count_ % keyframeInterval_ == 0u) {
+      appendKeyframe(pose);
+    } else {
+      appendDelta(pose);
+    }
+    count_++;
+  }
+
+  //! The encoded stream, headed by the DeltaHeader.
+  const std::vector<uint8_t>& getBuffer() const {
+    return buffer_;
+  }
+
+  //! Byte offsets and pose indices of the keyframes, for seeking.
+  const std::vector<KeyframeEntry>& getKeyframeEntries() const {
+    return keyframes_;
+  }
+
+  //! Number of poses encoded so far.
+  std::size_t getNumPoses() const {
+    return count_;
+  }
+
+ private:
+  void appendKeyframe(const PoseType& pose) {
+    KeyframeEntry entry;
+    entry.byteOffset = buffer_.size();
+    entry.poseIndex = count_;
+    keyframes_.push_back(entry);
+    buffer_.push_back(deltaCodecKeyframeTag);
+    const Pose<PrimType_> packedPose = toPacked(pose);
+    const std::size_t offset = buffer_.size();
+    buffer_.resize(offset + sizeof(packedPose));
+    std::memcpy(buffer_.data() + offset, &packedPose, sizeof(packedPose));
+    previous_ = pose;
+  }
+
+  void appendDelta(const PoseType& pose) {
+    const Vector3 positionDelta = pose.getPosition().toImplementation() - previous_.getPosition().toImplementation();
+    const Vector3 rotationDelta = pose.getRotation().boxMinus(previous_.getRotation());
+    buffer_.push_back(deltaCodecDeltaTag);
+    Vector3 dequantizedPosition, dequantizedRotation;
+    for (int k = 0; k < 3; k++) {
+      const int64_t quantized = static_cast<int64_t>(std::floor(positionDelta(k)/positionPrecision_ + PrimType_(0.5)));
+      internal::appendVarint(buffer_, internal::zigzagEncode(quantized));
+      dequantizedPosition(k) = static_cast<PrimType_>(quantized)*positionPrecision_;
+    }
+    for (int k = 0; k < 3; k++) {
+      const int64_t quantized = static_cast<int64_t>(std::floor(rotationDelta(k)/rotationPrecision_ + PrimType_(0.5)));
+      internal::appendVarint(buffer_, internal::zigzagEncode(quantized));
+      dequantizedRotation(k) = static_cast<PrimType_>(quantized)*rotationPrecision_;
+    }
+    // track the dequantized pose as the predecessor, exactly like the decoder,
+    // so the quantization error stays bounded instead of accumulating
+    previous_ = PoseType(typename PoseType::Position(previous_.getPosition().toImplementation() + dequantizedPosition),
+                         previous_.getRotation().boxPlus(dequantizedRotation));
+  }
+
+  PrimType_ positionPrecision_;
+  PrimType_ rotationPrecision_;
+  std::size_t keyframeInterval_;
+  std::size_t count_;
+  PoseType previous_;
+  std::vector<uint8_t> buffer_;
+  std::vector<KeyframeEntry> keyframes_;
+};
+
+/*! \class DeltaPoseDecoder
+ * \brief Sequential reader for delta-compressed pose streams.
+ *
+ *  Decodes the records of a DeltaPoseEncoder buffer in order; seek() jumps to
+ *  a keyframe byte offset from the encoder's keyframe table and resumes
+ *  decoding there.
+ *
+ *  \tparam PrimType_ the primitive type of the poses (double or float)
+ */
+template<typename PrimType_>
+class DeltaPoseDecoder {
+ public:
+  typedef HomogeneousTransformationPosition3RotationQuaternion<PrimType_> PoseType;
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+
+  /*! \brief Constructor validating the stream header.
+   *  \param data   start of the encoded stream
+   *  \param size   size of the encoded stream in bytes
+   */
+  DeltaPoseDecoder(const uint8_t* data, std::size_t size)
+    : data_(data),
+      size_(size),
+      cursor_(sizeof(DeltaHeader)) {
+    KINDR_ASSERT_TRUE(std::runtime_error, size >= sizeof(DeltaHeader), "Delta pose stream is truncated.");
+    DeltaHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    KINDR_ASSERT_TRUE(std::runtime_error, header.base.magic == packedMagic, "Not a packed delta pose stream.");
+    KINDR_ASSERT_TRUE(std::runtime_error, header.base.version == packedLayoutVersion, "Unsupported layout version.");
+    KINDR_ASSERT_TRUE(std::runtime_error, header.base.scalarSize == sizeof(PrimType_), "Scalar type mismatch.");
+    positionPrecision_ = static_cast<PrimType_>(header.positionPrecision);
+    rotationPrecision_ = static_cast<PrimType_>(header.rotationPrecision);
+  }
+
+  /*! \brief Constructor from an encoder buffer. */
+  explicit DeltaPoseDecoder(const std::vector<uint8_t>& buffer)
+    : DeltaPoseDecoder(buffer.data(), buffer.size()) {
+  }
+
+  //! Returns true while records remain.
+  bool hasNext() const {
+    return cursor_ < size_;
+  }
+
+  /*! \brief Decodes the next record.
+   *  \returns the decoded pose
+   */
+  PoseType decodeNext() {
+    KINDR_ASSERT_TRUE(std::runtime_error, hasNext(), "Delta pose stream is exhausted.");
+    const uint8_t tag = data_[cursor_++];
+    if (tag == deltaCodecKeyframeTag) {
+      KINDR_ASSERT_TRUE(std::runtime_error, cursor_ + sizeof(Pose<PrimType_>) <= size_, "Delta pose stream is truncated.");
+      Pose<PrimType_> packedPose;
+      std::memcpy(&packedPose, data_ + cursor_, sizeof(packedPose));
+      cursor_ += sizeof(packedPose);
+      previous_ = fromPacked(packedPose);
+      return previous_;
+    }
+    KINDR_ASSERT_TRUE(std::runtime_error, tag == deltaCodecDeltaTag, "Corrupt record tag in delta pose stream.");
+    Vector3 positionDelta, rotationDelta;
+    for (int k = 0; k < 3; k++) {
+      positionDelta(k) = static_cast<PrimType_>(internal::zigzagDecode(internal::readVarint(data_, size_, cursor_)))*positionPrecision_;
+    }
+    for (int k = 0; k < 3; k++) {
+      rotationDelta(k) = static_cast<PrimType_>(internal::zigzagDecode(internal::readVarint(data_, size_, cursor_)))*rotationPrecision_;
+    }
+    previous_ = PoseType(typename PoseType::Position(previous_.getPosition().toImplementation() + positionDelta),
+                         previous_.getRotation().boxPlus(rotationDelta));
+    return previous_;
+  }
+
+  /*! \brief Jumps to a keyframe, from where decoding can resume.
+   *  \param byteOffset   byte offset of a keyframe record (from KeyframeEntry)
+   */
+  void seek(std::size_t byteOffset) {
+    KINDR_ASSERT_TRUE(std::runtime_error, byteOffset < size_, "Seek offset is beyond the stream.");
+    KINDR_ASSERT_TRUE(std::runtime_error, data_[byteOffset] == deltaCodecKeyframeTag, "Seek offset is not a keyframe.");
+    cursor_ = byteOffset;
+  }
+
+ private:
+  const uint8_t* data_;
+  std::size_t size_;
+  std::size_t cursor_;
+  PrimType_ positionPrecision_;
+  PrimType_ rotationPrecision_;
+  PoseType previous_;
+};
+
+//! \brief Delta pose encoder with primitive type double
+typedef DeltaPoseEncoder<double> DeltaPoseEncoderD;
+//! \brief Delta pose encoder with primitive type float
+typedef DeltaPoseEncoder<float> DeltaPoseEncoderF;
+//! \brief Delta pose decoder with primitive type double
+typedef DeltaPoseDecoder<double> DeltaPoseDecoderD;
+//! \brief Delta pose decoder with primitive type float
+typedef DeltaPoseDecoder<float> DeltaPoseDecoderF;
+
+} // namespace packed
+} // namespace kindr
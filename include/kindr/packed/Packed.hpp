@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include "kindr/poses/Pose.hpp"
+#include "kindr/phys_quant/Wrench.hpp"
+
+namespace kindr {
+/*! \brief Memcpy-able binary layouts for logging and replay.
+ *
+ *  Every type in this namespace is standard-layout and trivially copyable, with a field
+ *  order that is part of the format: a log record can be written with one memcpy and read
+ *  back by memory-mapping the file. packedLayoutVersion must be bumped (and stored in the
+ *  log header) whenever a layout changes.
+ */
+namespace packed {
+
+//! Version of the packed binary layouts defined in this header.
+static const uint16_t packedLayoutVersion = 1u;
+
+//! Packed rotation quaternion, coefficients ordered (w, x, y, z).
+template<typename PrimType_>
+struct RotationQuaternion {
+  PrimType_ w;
+  PrimType_ x;
+  PrimType_ y;
+  PrimType_ z;
+};
+
+//! Packed position, coefficients ordered (x, y, z).
+template<typename PrimType_>
+struct Position {
+  PrimType_ x;
+  PrimType_ y;
+  PrimType_ z;
+};
+
+//! Packed pose: position followed by rotation quaternion.
+template<typename PrimType_>
+struct Pose {
+  Position<PrimType_> position;
+  RotationQuaternion<PrimType_> rotation;
+};
+
+//! Packed wrench: force followed by torque.
+template<typename PrimType_>
+struct Wrench {
+  PrimType_ force[3];
+  PrimType_ torque[3];
+};
+
+//! File/stream header identifying the layout of the records that follow.
+struct Header {
+  //! 'k''p''k''d'
+  uint32_t magic;
+  uint16_t version;
+  //! sizeof the scalar of the records (4 or 8)
+  uint16_t scalarSize;
+};
+
+static const uint32_t packedMagic = 0x646b706bu; // "kpkd", little-endian
+
+/*! \brief Creates a header for records with the given scalar type. */
+template<typename PrimType_>
+inline Header makeHeader() {
+  Header header;
+  header.magic = packedMagic;
+  header.version = packedLayoutVersion;
+  header.scalarSize = static_cast<uint16_t>(sizeof(PrimType_));
+  return header;
+}
+
+// The memcpy/mmap contract: every packed type must keep standard layout, trivial
+// copyability and exactly its coefficient count in size (no padding).
+#define KINDR_PACKED_LAYOUT_CHECK(Type, scalars) \
+  static_assert(std::is_standard_layout<Type>::value, #Type " must be standard-layout"); \
+  static_assert(std::is_trivially_copyable<Type>::value, #Type " must be trivially copyable"); \
+  static_assert(sizeof(Type) == (scalars)*sizeof(double), #Type " must not contain padding")
+
+KINDR_PACKED_LAYOUT_CHECK(RotationQuaternion<double>, 4);
+KINDR_PACKED_LAYOUT_CHECK(Position<double>, 3);
+KINDR_PACKED_LAYOUT_CHECK(Pose<double>, 7);
+KINDR_PACKED_LAYOUT_CHECK(Wrench<double>, 6);
+
+#undef KINDR_PACKED_LAYOUT_CHECK
+
+static_assert(std::is_standard_layout<Header>::value && sizeof(Header) == 8u,
+              "Header must be standard-layout and 8 bytes");
+
+} // namespace packed
+
+
+/*! \brief Converts a rotation quaternion to its packed layout. */
+template<typename PrimType_>
+inline packed::RotationQuaternion<PrimType_> toPacked(const RotationQuaternion<PrimType_>& rotation) {
+  packed::RotationQuaternion<PrimType_> result;
+  result.w = rotation.w();
+  result.x = rotation.x();
+  result.y = rotation.y();
+  result.z = rotation.z();
+  return result;
+}
+
+/*! \brief Converts a packed rotation quaternion back to the kindr type. */
+template<typename PrimType_>
+inline RotationQuaternion<PrimType_> fromPacked(const packed::RotationQuaternion<PrimType_>& packedRotation) {
+  return RotationQuaternion<PrimType_>(packedRotation.w, packedRotation.x, packedRotation.y, packedRotation.z);
+}
+
+/*! \brief Converts a position to its packed layout. */
+template<typename PrimType_>
+inline packed::Position<PrimType_> toPacked(const kindr::Position<PrimType_, 3>& position) {
+  packed::Position<PrimType_> result;
+  result.x = position(0);
+  result.y = position(1);
+  result.z = position(2);
+  return result;
+}
+
+/*! \brief Converts a packed position back to the kindr type. */
+template<typename PrimType_>
+inline kindr::Position<PrimType_, 3> fromPacked(const packed::Position<PrimType_>& packedPosition) {
+  return kindr::Position<PrimType_, 3>(packedPosition.x, packedPosition.y, packedPosition.z);
+}
+
+/*! \brief Converts a pose to its packed layout. */
+template<typename PrimType_>
+inline packed::Pose<PrimType_> toPacked(const HomogeneousTransformationPosition3RotationQuaternion<PrimType_>& pose) {
+  packed::Pose<PrimType_> result;
+  result.position = toPacked(pose.getPosition());
+  result.rotation = toPacked(pose.getRotation());
+  return result;
+}
+
+/*! \brief Converts a packed pose back to the kindr type. */
+template<typename PrimType_>
+inline HomogeneousTransformationPosition3RotationQuaternion<PrimType_> fromPacked(const packed::Pose<PrimType_>& packedPose) {
+  return HomogeneousTransformationPosition3RotationQuaternion<PrimType_>(fromPacked(packedPose.position),
+                                                                         fromPacked(packedPose.rotation));
+}
+
+/*! \brief Converts a wrench to its packed layout. */
+template<typename PrimType_>
+inline packed::Wrench<PrimType_> toPacked(const Wrench6<PrimType_>& wrench) {
+  packed::Wrench<PrimType_> result;
+  for (int k = 0; k < 3; k++) {
+    result.force[k] = wrench.getForce()(k);
+    result.torque[k] = wrench.getTorque()(k);
+  }
+  return result;
+}
+
+/*! \brief Converts a packed wrench back to the kindr type. */
+template<typename PrimType_>
+inline Wrench6<PrimType_> fromPacked(const packed::Wrench<PrimType_>& packedWrench) {
+  typedef typename Wrench6<PrimType_>::Vector3 Vector3;
+  return Wrench6<PrimType_>(Vector3(packedWrench.force[0], packedWrench.force[1], packedWrench.force[2]),
+                            Vector3(packedWrench.torque[0], packedWrench.torque[1], packedWrench.torque[2]));
+}
+
+} // namespace kindr
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/packed/Packed.hpp"
+#include "kindr/rotations/RotationQuaternionMap.hpp"
+#include "kindr/vectors/VectorMap.hpp"
+
+namespace kindr {
+namespace packed {
+
+//! One trajectory record: timestamp followed by the packed pose.
+template<typename PrimType_>
+struct TimedPose {
+  double time;
+  Pose<PrimType_> pose;
+};
+
+static_assert(std::is_standard_layout<TimedPose<double>>::value &&
+              sizeof(TimedPose<double>) == 8u*sizeof(double),
+              "TimedPose<double> must be standard-layout and free of padding");
+
+/*! \class TrajectoryFileWriter
+ * \brief Streams timestamped poses into a packed trajectory log
+ *
+ *  Writes the packed::Header, a record count and then one TimedPose per sample; each
+ *  record is a single fwrite of the POD layout. The count field is backpatched on close.
+ *
+ *  \tparam PrimType_ the primitive type of the logged data (double or float)
+ */
+template<typename PrimType_>
+class TrajectoryFileWriter {
+ public:
+  typedef HomogeneousTransformationPosition3RotationQuaternion<PrimType_> PoseType;
+
+  explicit TrajectoryFileWriter(const std::string& fileName)
+    : file_(std::fopen(fileName.c_str(), "wb")),
+      count_(0u) {
+    KINDR_ASSERT_TRUE(std::runtime_error, file_ != nullptr, "Could not open trajectory file for writing.");
+    const Header header = makeHeader<PrimType_>();
+    std::fwrite(&header, sizeof(header), 1u, file_);
+    std::fwrite(&count_, sizeof(count_), 1u, file_);
+  }
+
+  ~TrajectoryFileWriter() {
+    close();
+  }
+
+  /*! \brief Appends a pose record; timestamps must increase monotonically for seekTime(). */
+  void addPose(double time, const PoseType& pose) {
+    TimedPose<PrimType_> record;
+    record.time = time;
+    record.pose = toPacked(pose);
+    std::fwrite(&record, sizeof(record), 1u, file_);
+    count_++;
+  }
+
+  /*! \brief Backpatches the record count and closes the file. */
+  void close() {
+    if (file_ != nullptr) {
+      std::fseek(file_, sizeof(Header), SEEK_SET);
+      std::fwrite(&count_, sizeof(count_), 1u, file_);
+      std::fclose(file_);
+      file_ = nullptr;
+    }
+  }
+
+ private:
+  std::FILE* file_;
+  uint64_t count_;
+};
+
+/*! \class TrajectoryFile
+ * \brief Memory-mapped random-access reader for packed trajectory logs
+ *
+ *  Maps the whole log copy-on-write instead of parsing it, so opening a multi-gigabyte
+ *  file is near-instant and only the pages actually touched are faulted in. Records are
+ *  exposed either as raw packed structs, as lazily materialized kindr poses, or as
+ *  zero-copy Map views over the mapped scalars. seekTime() binary-searches the (sorted)
+ *  record timestamps in O(log n).
+ *
+ *  \tparam PrimType_ the primitive type of the logged data (double or float)
+ */
+template<typename PrimType_>
+class TrajectoryFile {
+ public:
+  typedef HomogeneousTransformationPosition3RotationQuaternion<PrimType_> PoseType;
+  typedef kindr::Position<PrimType_, 3> PositionType;
+  typedef kindr::RotationQuaternion<PrimType_> RotationType;
+
+  explicit TrajectoryFile(const std::string& fileName)
+    : mapping_(nullptr),
+      mappingSize_(0u),
+      records_(nullptr),
+      count_(0u) {
+    const int fileDescriptor = ::open(fileName.c_str(), O_RDONLY);
+    KINDR_ASSERT_TRUE(std::runtime_error, fileDescriptor >= 0, "Could not open trajectory file for reading.");
+    struct stat fileStatus;
+    ::fstat(fileDescriptor, &fileStatus);
+    mappingSize_ = static_cast<std::size_t>(fileStatus.st_size);
+    KINDR_ASSERT_TRUE(std::runtime_error, mappingSize_ >= sizeof(Header) + sizeof(uint64_t),
+                      "Trajectory file is truncated.");
+    // copy-on-write mapping: views may be created over non-const scalars without
+    // any risk of altering the file
+    mapping_ = ::mmap(nullptr, mappingSize_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileDescriptor, 0);
+    ::close(fileDescriptor);
+    KINDR_ASSERT_TRUE(std::runtime_error, mapping_ != MAP_FAILED, "Could not map trajectory file.");
+
+    // the destructor does not run if the constructor throws, so unmap manually
+    // when validation fails
+    try {
+      const Header* header = static_cast<const Header*>(mapping_);
+      KINDR_ASSERT_TRUE(std::runtime_error, header->magic == packedMagic, "Not a packed trajectory file.");
+      KINDR_ASSERT_TRUE(std::runtime_error, header->version == packedLayoutVersion, "Unsupported layout version.");
+      KINDR_ASSERT_TRUE(std::runtime_error, header->scalarSize == sizeof(PrimType_), "Scalar type mismatch.");
+
+      count_ = *reinterpret_cast<const uint64_t*>(static_cast<const char*>(mapping_) + sizeof(Header));
+      records_ = reinterpret_cast<TimedPose<PrimType_>*>(static_cast<char*>(mapping_) + sizeof(Header) + sizeof(uint64_t));
+      // divide instead of multiplying so a corrupt count cannot wrap the check
+      const uint64_t maxCount = (mappingSize_ - sizeof(Header) - sizeof(uint64_t))/sizeof(TimedPose<PrimType_>);
+      KINDR_ASSERT_TRUE(std::runtime_error, count_ <= maxCount, "Trajectory file is truncated.");
+    } catch (...) {
+      ::munmap(mapping_, mappingSize_);
+      mapping_ = nullptr;
+      throw;
+    }
+  }
+
+  ~TrajectoryFile() {
+    if (mapping_ != nullptr && mapping_ != MAP_FAILED) {
+      ::munmap(mapping_, mappingSize_);
+    }
+  }
+
+  TrajectoryFile(const TrajectoryFile&) = delete;
+  TrajectoryFile& operator=(const TrajectoryFile&) = delete;
+
+  /*! \brief Returns the number of records. */
+  std::size_t getNumberOfPoses() const {
+    return static_cast<std::size_t>(count_);
+  }
+
+  /*! \brief Returns the timestamp of a record. */
+  double getTime(std::size_t index) const {
+    return records_[index].time;
+  }
+
+  /*! \brief Returns the raw packed record (zero-copy). */
+  const TimedPose<PrimType_>& getRecord(std::size_t index) const {
+    return records_[index];
+  }
+
+  /*! \brief Materializes a record as a kindr pose. */
+  PoseType getPose(std::size_t index) const {
+    return fromPacked(records_[index].pose);
+  }
+
+  /*! \brief Returns a zero-copy view of the position of a record. */
+  Map<PositionType> getPositionView(std::size_t index) const {
+    return Map<PositionType>(&records_[index].pose.position.x);
+  }
+
+  /*! \brief Materializes the rotation of a record.
+   *
+   *  The packed layout stores the quaternion w-first, while Eigen maps expect x-first, so
+   *  the rotation is copied (4 scalars) instead of viewed.
+   */
+  RotationType getRotation(std::size_t index) const {
+    return fromPacked(records_[index].pose.rotation);
+  }
+
+  /*! \brief Finds the record with the largest timestamp <= time in O(log n).
+   *  \param time  query time
+   *  \returns record index, or 0 if the query predates the log
+   */
+  std::size_t seekTime(double time) const {
+    KINDR_ASSERT_TRUE(std::out_of_range, count_ > 0u, "Trajectory file is empty.");
+    if (time <= records_[0].time) {
+      return 0u;
+    }
+    std::size_t lower = 0u;
+    std::size_t upper = static_cast<std::size_t>(count_) - 1u;
+    while (upper - lower > 1u) {
+      const std::size_t middle = lower + (upper - lower)/2u;
+      if (records_[middle].time <= time) {
+        lower = middle;
+      } else {
+        upper = middle;
+      }
+    }
+    return records_[upper].time <= time ? upper : lower;
+  }
+
+ private:
+  void* mapping_;
+  std::size_t mappingSize_;
+  TimedPose<PrimType_>* records_;
+  uint64_t count_;
+};
+
+} // namespace packed
+} // namespace kindr
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include "kindr/phys_quant/PhysicalType.hpp"
+#include "kindr/vectors/Vector.hpp"
+
+namespace kindr {
+
+/*! \file DimensionalArithmetic.hpp
+ *  \brief Operator sugar for dimensional arithmetic across physical quantity types.
+ *
+ *  Element-wise multiplication and division between Vector instances of
+ *  different PhysicalType, with the result type derived at compile time from
+ *  the MultiplicationReturnTypeTrait/DivisionReturnTypeTrait tables in
+ *  Vector.hpp: Velocity*Time yields Position, Force/Mass yields Acceleration,
+ *  and a pair without a specialized physical meaning yields Typeless. The
+ *  operators forward to elementwiseMultiplication()/elementwiseDivision() and
+ *  expand to the plain Eigen cwise product/quotient, so typed integrator code
+ *  stays allocation-free with zero runtime overhead.
+ */
+
+/*! \brief Element-wise product of two physical quantities with the dimensionally correct result type.
+ *  \param lhs  left factor
+ *  \param rhs  right factor
+ *  \returns e.g. a Position for Velocity*Time
+ *  \ingroup vectors
+ */
+template<enum PhysicalType LhsType_, enum PhysicalType RhsType_, typename PrimType_, int Dimension_>
+typename internal::MultiplicationReturnTypeTrait<Vector<LhsType_, PrimType_, Dimension_>, Vector<RhsType_, PrimType_, Dimension_>>::ReturnType
+operator*(const Vector<LhsType_, PrimType_, Dimension_>& lhs, const Vector<RhsType_, PrimType_, Dimension_>& rhs) {
+  return lhs.elementwiseMultiplication(rhs);
+}
+
+/*! \brief Element-wise quotient of two physical quantities with the dimensionally correct result type.
+ *  \param lhs  dividend
+ *  \param rhs  divisor
+ *  \returns e.g. a Velocity for Position/Time
+ *  \ingroup vectors
+ */
+template<enum PhysicalType LhsType_, enum PhysicalType RhsType_, typename PrimType_, int Dimension_>
+typename internal::DivisionReturnTypeTrait<Vector<LhsType_, PrimType_, Dimension_>, Vector<RhsType_, PrimType_, Dimension_>>::ReturnType
+operator/(const Vector<LhsType_, PrimType_, Dimension_>& lhs, const Vector<RhsType_, PrimType_, Dimension_>& rhs) {
+  return lhs.elementwiseDivision(rhs);
+}
+
+} // namespace kindr
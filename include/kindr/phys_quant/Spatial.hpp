@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) 2017, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "kindr/math/LinearAlgebra.hpp"
+#include "kindr/rotations/Rotation.hpp"
+
+namespace kindr {
+
+/*! \class SpatialTransform
+ * \brief Plucker coordinate transform for spatial motion and force vectors
+ *
+ *  Represents the 6x6 transform X_BA that maps spatial vectors expressed in frame A to
+ *  frame B, parameterized by the rotation E (coordinates A to B) and the position r of the
+ *  origin of B expressed in A (Featherstone's convention). Rotation and translation are
+ *  stored contiguously so a transform occupies one packed 12-scalar block instead of a
+ *  dense 6x6 matrix, and the motion/force kernels apply E and the r-cross term fused, in
+ *  place of a 6x6 GEMV.
+ *
+ *  Spatial motion vectors stack (angular; linear), as does Twist::getVector(); spatial
+ *  force vectors stack (torque; force).
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ */
+template<typename PrimType_>
+class SpatialTransform {
+ public:
+  typedef PrimType_ Scalar;
+  typedef Eigen::Matrix<PrimType_, 3, 3> Matrix3;
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+  typedef Eigen::Matrix<PrimType_, 6, 1> Vector6;
+  typedef Eigen::Matrix<PrimType_, 6, 6> Matrix6;
+
+  /*! \brief Default constructor creates the identity transform. */
+  SpatialTransform()
+    : rotation_(Matrix3::Identity()),
+      position_(Vector3::Zero()) {
+  }
+
+  /*! \brief Constructor from rotation and translation
+   *  \param rotation  rotation matrix E mapping coordinates from A to B
+   *  \param position  position r of the origin of B expressed in A
+   */
+  SpatialTransform(const Matrix3& rotation, const Vector3& position)
+    : rotation_(rotation),
+      position_(position) {
+  }
+
+  /*! \brief Constructor from a rotation of any parameterization. */
+  template<typename Rotation_>
+  SpatialTransform(const RotationBase<Rotation_>& rotation, const Vector3& position)
+    : rotation_(RotationMatrix<PrimType_>(rotation.derived()).matrix()),
+      position_(position) {
+  }
+
+  inline const Matrix3& getRotation() const {
+    return rotation_;
+  }
+
+  inline const Vector3& getPosition() const {
+    return position_;
+  }
+
+  /*! \brief Transforms a spatial motion vector (angular; linear).
+   *
+   *  Fused kernel for X * m: angular' = E w, linear' = E (v - r x w).
+   */
+  inline Vector6 transformMotion(const Vector6& motion) const {
+    const Vector3 angular = motion.template head<3>();
+    const Vector3 linear = motion.template tail<3>();
+    Vector6 transformed;
+    transformed.template head<3>() = rotation_*angular;
+    transformed.template tail<3>() = rotation_*(linear - position_.cross(angular));
+    return transformed;
+  }
+
+  /*! \brief Transforms a spatial force vector (torque; force).
+   *
+   *  Fused kernel for X^-T * f: torque' = E (n - r x f), force' = E f.
+   */
+  inline Vector6 transformForce(const Vector6& force) const {
+    const Vector3 torquePart = force.template head<3>();
+    const Vector3 forcePart = force.template tail<3>();
+    Vector6 transformed;
+    transformed.template head<3>() = rotation_*(torquePart - position_.cross(forcePart));
+    transformed.template tail<3>() = rotation_*forcePart;
+    return transformed;
+  }
+
+  /*! \brief Returns the inverse transform X_AB. */
+  SpatialTransform inverted() const {
+    return SpatialTransform(rotation_.transpose(), -rotation_*position_);
+  }
+
+  /*! \brief Composes two transforms: X_CA = X_CB * X_BA. */
+  SpatialTransform operator*(const SpatialTransform& other) const {
+    return SpatialTransform(rotation_*other.rotation_,
+                            other.position_ + other.rotation_.transpose()*position_);
+  }
+
+  /*! \brief Returns the dense 6x6 motion transform (for debugging and tests). */
+  Matrix6 getMatrix() const {
+    Matrix6 matrix = Matrix6::Zero();
+    matrix.template block<3,3>(0,0) = rotation_;
+    matrix.template block<3,3>(3,3) = rotation_;
+    matrix.template block<3,3>(3,0) = -rotation_*getSkewMatrixFromVector(position_);
+    return matrix;
+  }
+
+  /*! \brief Sets the transform to identity
+   *  \returns reference
+   */
+  SpatialTransform& setIdentity() {
+    rotation_.setIdentity();
+    position_.setZero();
+    return *this;
+  }
+
+  /*! \brief Used for printing the object with std::cout. */
+  friend std::ostream& operator << (std::ostream& out, const SpatialTransform& transform) {
+    out << transform.getRotation() << " " << transform.getPosition().transpose();
+    return out;
+  }
+
+ protected:
+  Matrix3 rotation_;
+  Vector3 position_;
+};
+
+typedef SpatialTransform<double> SpatialTransformD;
+typedef SpatialTransform<float> SpatialTransformF;
+
+
+/*! \class SpatialInertia
+ * \brief Spatial (6D) rigid-body inertia in compressed symmetric storage
+ *
+ *  Stores mass, first moment of mass h = m*c and the rotational inertia about the body
+ *  frame origin as the ten coefficients that determine the symmetric 6x6 spatial inertia
+ *  [ I      S(h) ]
+ *  [ S(h)^T m*1  ],
+ *  instead of the dense matrix. apply() multiplies a spatial motion vector by the inertia
+ *  without expanding to 6x6.
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ */
+template<typename PrimType_>
+class SpatialInertia {
+ public:
+  typedef PrimType_ Scalar;
+  typedef Eigen::Matrix<PrimType_, 3, 3> Matrix3;
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+  typedef Eigen::Matrix<PrimType_, 6, 1> Vector6;
+  typedef Eigen::Matrix<PrimType_, 6, 6> Matrix6;
+
+  /*! \brief Default constructor creates a zero inertia. */
+  SpatialInertia()
+    : mass_(PrimType_(0)),
+      firstMoment_(Vector3::Zero()) {
+    inertia_[0] = inertia_[1] = inertia_[2] = PrimType_(0);
+    inertia_[3] = inertia_[4] = inertia_[5] = PrimType_(0);
+  }
+
+  /*! \brief Constructor from mass, center of mass and rotational inertia
+   *  \param mass          mass of the body
+   *  \param centerOfMass  position of the center of mass in the body frame
+   *  \param inertia       rotational inertia about the body frame origin (symmetric 3x3)
+   */
+  SpatialInertia(PrimType_ mass, const Vector3& centerOfMass, const Matrix3& inertia)
+    : mass_(mass),
+      firstMoment_(mass*centerOfMass) {
+    setInertiaMatrix(inertia);
+  }
+
+  inline PrimType_ getMass() const {
+    return mass_;
+  }
+
+  inline const Vector3& getFirstMoment() const {
+    return firstMoment_;
+  }
+
+  inline Vector3 getCenterOfMass() const {
+    return firstMoment_/mass_;
+  }
+
+  /*! \brief Sets the rotational inertia from a symmetric 3x3 matrix (upper triangle is read). */
+  void setInertiaMatrix(const Matrix3& inertia) {
+    inertia_[0] = inertia(0,0);
+    inertia_[1] = inertia(1,1);
+    inertia_[2] = inertia(2,2);
+    inertia_[3] = inertia(0,1);
+    inertia_[4] = inertia(0,2);
+    inertia_[5] = inertia(1,2);
+  }
+
+  /*! \brief Returns the rotational inertia expanded to a symmetric 3x3 matrix. */
+  Matrix3 getInertiaMatrix() const {
+    Matrix3 inertia;
+    inertia << inertia_[0], inertia_[3], inertia_[4],
+               inertia_[3], inertia_[1], inertia_[5],
+               inertia_[4], inertia_[5], inertia_[2];
+    return inertia;
+  }
+
+  /*! \brief Multiplies the inertia with a spatial motion vector (angular; linear).
+   *
+   *  Fused kernel for I * m without expanding the 6x6 matrix:
+   *  top = I w + h x v, bottom = m v - h x w.
+   */
+  Vector6 apply(const Vector6& motion) const {
+    const Vector3 angular = motion.template head<3>();
+    const Vector3 linear = motion.template tail<3>();
+    Vector6 momentum;
+    momentum.template head<3>() = getInertiaMatrix()*angular + firstMoment_.cross(linear);
+    momentum.template tail<3>() = mass_*linear - firstMoment_.cross(angular);
+    return momentum;
+  }
+
+  /*! \brief Adds the inertia of another body expressed in the same frame. */
+  SpatialInertia& operator+=(const SpatialInertia& other) {
+    mass_ += other.mass_;
+    firstMoment_ += other.firstMoment_;
+    for (int i = 0; i < 6; i++) {
+      inertia_[i] += other.inertia_[i];
+    }
+    return *this;
+  }
+
+  /*! \brief Sum of the inertias of two bodies expressed in the same frame. */
+  SpatialInertia operator+(const SpatialInertia& other) const {
+    SpatialInertia sum(*this);
+    sum += other;
+    return sum;
+  }
+
+  /*! \brief Returns the dense symmetric 6x6 spatial inertia (for debugging and tests). */
+  Matrix6 getMatrix() const {
+    Matrix6 matrix;
+    matrix.template block<3,3>(0,0) = getInertiaMatrix();
+    matrix.template block<3,3>(0,3) = getSkewMatrixFromVector(firstMoment_);
+    matrix.template block<3,3>(3,0) = getSkewMatrixFromVector(firstMoment_).transpose();
+    matrix.template block<3,3>(3,3) = mass_*Matrix3::Identity();
+    return matrix;
+  }
+
+  /*! \brief Sets the inertia to zero
+   *  \returns reference
+   */
+  SpatialInertia& setZero() {
+    mass_ = PrimType_(0);
+    firstMoment_.setZero();
+    for (int i = 0; i < 6; i++) {
+      inertia_[i] = PrimType_(0);
+    }
+    return *this;
+  }
+
+ protected:
+  PrimType_ mass_;
+  Vector3 firstMoment_;
+  //! diagonal (xx, yy, zz) followed by the off-diagonal (xy, xz, yz) coefficients
+  PrimType_ inertia_[6];
+};
+
+typedef SpatialInertia<double> SpatialInertiaD;
+typedef SpatialInertia<float> SpatialInertiaF;
+
+} // namespace kindr
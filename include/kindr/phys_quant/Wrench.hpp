@@ -36,6 +36,7 @@
 
 #include <kindr/phys_quant/WrenchBase.hpp>
 #include <kindr/phys_quant/PhysicalQuantities.hpp>
+#include <kindr/rotations/Rotation.hpp>
 
 namespace kindr {
 
@@ -239,4 +240,26 @@ typedef Wrench6<double> WrenchD;
 typedef Wrench6<float> WrenchF;
 
 
+namespace internal {
+
+/*! \brief Adjoint map for Wrench6 and any pose type
+ *
+ *  One fused kernel: the rotation is converted to a matrix once and shared by the force and
+ *  torque blocks, and the lever-arm cross product is folded in without intermediate Force or
+ *  Torque objects.
+ */
+template<typename PrimType_, typename Pose_>
+class WrenchTransformTraits<Wrench6<PrimType_>, Pose_> {
+ public:
+  inline static Wrench6<PrimType_> transform(const Wrench6<PrimType_>& wrench, const Pose_& pose) {
+    const Eigen::Matrix<PrimType_, 3, 3> rotationMatrix = RotationMatrix<PrimType_>(pose.getRotation()).matrix();
+    const Eigen::Matrix<PrimType_, 3, 1> rotatedForce = rotationMatrix*wrench.getForce().toImplementation();
+    const Eigen::Matrix<PrimType_, 3, 1> rotatedTorque = rotationMatrix*wrench.getTorque().toImplementation()
+        + pose.getPosition().toImplementation().cross(rotatedForce);
+    return Wrench6<PrimType_>(rotatedForce, rotatedTorque);
+  }
+};
+
+} // namespace internal
+
 } // namespace kindr
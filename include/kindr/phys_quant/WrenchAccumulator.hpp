@@ -0,0 +1,109 @@
+/*
+ * WrenchAccumulator.hpp
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include <kindr/common/SoAVector.hpp>
+#include <kindr/phys_quant/Wrench.hpp>
+
+namespace kindr {
+
+/*! \class WrenchAccumulator
+ * \brief Structure-of-arrays accumulator for contact wrenches.
+ *
+ *  Summing contact forces as a chain of Wrench6 additions constructs a new
+ *  Wrench6 with Force/Torque temporaries per contact. This accumulator stores
+ *  the six wrench components in separate aligned arrays instead: addContact()
+ *  folds the p x f torque contribution of a contact force in at insertion, and
+ *  sum() reduces each component array in one vectorizable pass with no
+ *  temporaries.
+ *
+ * \tparam PrimType_  Primitive type of the components.
+ */
+template<typename PrimType_>
+class WrenchAccumulator {
+ public:
+  typedef PrimType_ Scalar;
+  typedef Wrench6<PrimType_> Wrench;
+  typedef typename Wrench6<PrimType_>::Force Force;
+  typedef typename Wrench6<PrimType_>::Torque Torque;
+  typedef Position<PrimType_, 3> Position3;
+
+  WrenchAccumulator() = default;
+
+  std::size_t size() const { return forceX_.size(); }
+  bool empty() const { return forceX_.empty(); }
+
+  void reserve(std::size_t count) {
+    forceX_.reserve(count); forceY_.reserve(count); forceZ_.reserve(count);
+    torqueX_.reserve(count); torqueY_.reserve(count); torqueZ_.reserve(count);
+  }
+
+  void clear() {
+    forceX_.clear(); forceY_.clear(); forceZ_.clear();
+    torqueX_.clear(); torqueY_.clear(); torqueZ_.clear();
+  }
+
+  /*! \brief Adds a contact force acting at a point.
+   *
+   *  The torque contribution p x f about the accumulator origin is computed
+   *  here, so sum() stays a plain component-wise reduction.
+   *  \param position   point of attack of the force
+   *  \param force      contact force
+   */
+  void addContact(const Position3& position, const Force& force) {
+    forceX_.push_back(force.x());
+    forceY_.push_back(force.y());
+    forceZ_.push_back(force.z());
+    torqueX_.push_back(position.y()*force.z() - position.z()*force.y());
+    torqueY_.push_back(position.z()*force.x() - position.x()*force.z());
+    torqueZ_.push_back(position.x()*force.y() - position.y()*force.x());
+  }
+
+  /*! \brief Adds a wrench that is already expressed about the accumulator origin.
+   *  \param wrench   wrench to accumulate
+   */
+  void addWrench(const Wrench& wrench) {
+    forceX_.push_back(wrench.getForce().x());
+    forceY_.push_back(wrench.getForce().y());
+    forceZ_.push_back(wrench.getForce().z());
+    torqueX_.push_back(wrench.getTorque().x());
+    torqueY_.push_back(wrench.getTorque().y());
+    torqueZ_.push_back(wrench.getTorque().z());
+  }
+
+  /*! \brief Reduces the accumulated contacts to the net wrench.
+   *
+   *  Each component array is summed in one pass over aligned contiguous
+   *  memory, which the compiler vectorizes horizontally.
+   *  \returns the net wrench about the accumulator origin
+   */
+  Wrench sum() const {
+    return Wrench(typename Wrench::Vector3(reduce(forceX_), reduce(forceY_), reduce(forceZ_)),
+                  typename Wrench::Vector3(reduce(torqueX_), reduce(torqueY_), reduce(torqueZ_)));
+  }
+
+ private:
+  static PrimType_ reduce(const internal::AlignedScalarVector<PrimType_>& components) {
+    if (components.empty()) {
+      return PrimType_(0);
+    }
+    typedef Eigen::Matrix<PrimType_, Eigen::Dynamic, 1> VectorX;
+    return Eigen::Map<const VectorX, Eigen::Aligned64>(components.data(), components.size()).sum();
+  }
+
+  internal::AlignedScalarVector<PrimType_> forceX_;
+  internal::AlignedScalarVector<PrimType_> forceY_;
+  internal::AlignedScalarVector<PrimType_> forceZ_;
+  internal::AlignedScalarVector<PrimType_> torqueX_;
+  internal::AlignedScalarVector<PrimType_> torqueY_;
+  internal::AlignedScalarVector<PrimType_> torqueZ_;
+};
+
+typedef WrenchAccumulator<double> WrenchAccumulatorD;
+typedef WrenchAccumulator<float> WrenchAccumulatorF;
+
+} // namespace kindr
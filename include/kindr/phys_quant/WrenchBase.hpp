@@ -36,6 +36,23 @@
 
 namespace kindr {
 
+template<typename Derived_>
+class WrenchBase;
+
+namespace internal {
+
+/*! \brief Transformation traits for the adjoint map of a wrench
+ *  \class WrenchTransformTraits
+ *  (only for advanced users)
+ */
+template<typename Wrench_, typename Pose_>
+class WrenchTransformTraits {
+ public:
+//  inline static Wrench_ transform(const Wrench_& wrench, const Pose_& pose);
+};
+
+} // namespace internal
+
 template<typename Derived_>
 class WrenchBase {
  public:
@@ -81,6 +98,18 @@ class WrenchBase {
    *  \returns reference
    */
   Derived_& setZero();
+
+  /*! \brief Transforms the wrench into the frame the pose maps to (adjoint map).
+   *
+   *  The force becomes R*f and the torque R*tau + p x (R*f), where R and p are
+   *  the rotation and position of the pose.
+   *  \param pose   pose of the wrench frame expressed in the target frame
+   *  \returns transformed wrench
+   */
+  template<typename Pose_>
+  Derived_ transform(const Pose_& pose) const {
+    return internal::WrenchTransformTraits<Derived_, Pose_>::transform(this->derived(), pose);
+  }
 };
 
 } // namespace
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <vector>
+
+#include <Eigen/StdVector>
+
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/poses/HomogeneousTransformation.hpp"
+#include "kindr/poses/Twist.hpp"
+#include "kindr/phys_quant/Wrench.hpp"
+
+namespace kindr {
+
+/*! \file ChainVelocityPropagation.hpp
+ *  \brief Velocity and force sweeps along serial kinematic chains.
+ *
+ *  Twist represents one body's velocity; propagating velocities down a chain
+ *  (v_child = X * v_parent + S * qdot) was left to callers, who converted each
+ *  twist to raw Eigen and back per link. These kernels run the recursion on
+ *  contiguous arrays of twists and joint rates. Each link rotation is
+ *  converted to a matrix once and its transpose is reused for the angular and
+ *  the linear part, so the sweeps are the plain RNEA inner loops without
+ *  per-link abstraction cost.
+ *
+ *  Conventions: linkTransforms[i] is the pose of link frame i in its parent
+ *  frame (link 0's parent is the base), jointAxes[i] is the revolute axis in
+ *  link frame i, and all twists/wrenches are expressed in the frame of their
+ *  own link at its origin.
+ */
+
+/*! \brief Propagates a base twist down a serial chain (outward velocity sweep).
+ *
+ *  For every link i:
+ *    omega_i = R_i^T * omega_parent + S_i * qdot_i
+ *    v_i     = R_i^T * (v_parent + omega_parent x p_i)
+ *
+ *  \param linkTransforms  pose of each link frame relative to its predecessor
+ *  \param jointAxes       revolute joint axis of each link, in the link frame
+ *  \param jointRates      joint rate qdot of each link
+ *  \param baseTwist       twist of the base, in the base frame
+ *  \param linkTwists      output twist of each link, in the link frame (resized)
+ *  \ingroup poses
+ */
+template<typename PrimType_>
+void propagateChainVelocities(const std::vector<HomogeneousTransformationPosition3RotationQuaternion<PrimType_>, Eigen::aligned_allocator<HomogeneousTransformationPosition3RotationQuaternion<PrimType_>>>& linkTransforms,
+                              const std::vector<Eigen::Matrix<PrimType_, 3, 1>>& jointAxes,
+                              const std::vector<PrimType_>& jointRates,
+                              const TwistLinearVelocityLocalAngularVelocity<PrimType_>& baseTwist,
+                              std::vector<TwistLinearVelocityLocalAngularVelocity<PrimType_>, Eigen::aligned_allocator<TwistLinearVelocityLocalAngularVelocity<PrimType_>>>& linkTwists) {
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+  typedef Eigen::Matrix<PrimType_, 3, 3> Matrix3;
+  typedef TwistLinearVelocityLocalAngularVelocity<PrimType_> Twist;
+  KINDR_ASSERT_TRUE(std::runtime_error, linkTransforms.size() == jointAxes.size(), "Number of joint axes does not match the number of links.");
+  KINDR_ASSERT_TRUE(std::runtime_error, linkTransforms.size() == jointRates.size(), "Number of joint rates does not match the number of links.");
+
+  linkTwists.resize(linkTransforms.size());
+  Vector3 parentLinear = baseTwist.getTranslationalVelocity().toImplementation();
+  Vector3 parentAngular = baseTwist.getRotationalVelocity().toImplementation();
+  for (std::size_t i = 0; i < linkTransforms.size(); i++) {
+    // one matrix conversion per link, reused for the angular and the linear part
+    const Matrix3 transposedRotation = RotationMatrix<PrimType_>(linkTransforms[i].getRotation()).toImplementation().transpose();
+    const Vector3& offset = linkTransforms[i].getPosition().toImplementation();
+    const Vector3 angular = transposedRotation*parentAngular + jointAxes[i]*jointRates[i];
+    const Vector3 linear = transposedRotation*(parentLinear + parentAngular.cross(offset));
+    linkTwists[i] = Twist(linear, angular);
+    parentLinear = linear;
+    parentAngular = angular;
+  }
+}
+
+/*! \brief Accumulates link wrenches up a serial chain (inward force sweep).
+ *
+ *  The reverse sweep of the velocity propagation: starting from the tip, the
+ *  net wrench of every link is its own wrench plus the child's net wrench
+ *  mapped into the link frame,
+ *    f_i = f_i^own + R_{i+1} * f_{i+1}
+ *    n_i = n_i^own + R_{i+1} * n_{i+1} + p_{i+1} x (R_{i+1} * f_{i+1})
+ *
+ *  \param linkTransforms  pose of each link frame relative to its predecessor
+ *  \param linkWrenches    wrench acting on each link, in the link frame
+ *  \param netWrenches     output net wrench supported at each link, in the link frame (resized)
+ *  \ingroup poses
+ */
+template<typename PrimType_>
+void propagateChainWrenches(const std::vector<HomogeneousTransformationPosition3RotationQuaternion<PrimType_>, Eigen::aligned_allocator<HomogeneousTransformationPosition3RotationQuaternion<PrimType_>>>& linkTransforms,
+                            const std::vector<Wrench6<PrimType_>, Eigen::aligned_allocator<Wrench6<PrimType_>>>& linkWrenches,
+                            std::vector<Wrench6<PrimType_>, Eigen::aligned_allocator<Wrench6<PrimType_>>>& netWrenches) {
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+  typedef Eigen::Matrix<PrimType_, 3, 3> Matrix3;
+  typedef Wrench6<PrimType_> Wrench;
+  KINDR_ASSERT_TRUE(std::runtime_error, linkTransforms.size() == linkWrenches.size(), "Number of wrenches does not match the number of links.");
+
+  netWrenches.resize(linkTransforms.size());
+  for (std::size_t k = linkTransforms.size(); k > 0; k--) {
+    const std::size_t i = k - 1;
+    Vector3 force = linkWrenches[i].getForce().toImplementation();
+    Vector3 torque = linkWrenches[i].getTorque().toImplementation();
+    if (i + 1 < linkTransforms.size()) {
+      const Matrix3 childRotation = RotationMatrix<PrimType_>(linkTransforms[i + 1].getRotation()).toImplementation();
+      const Vector3& childOffset = linkTransforms[i + 1].getPosition().toImplementation();
+      const Vector3 childForce = childRotation*netWrenches[i + 1].getForce().toImplementation();
+      force += childForce;
+      torque += childRotation*netWrenches[i + 1].getTorque().toImplementation() + childOffset.cross(childForce);
+    }
+    netWrenches[i] = Wrench(force, torque);
+  }
+}
+
+} // namespace kindr
@@ -0,0 +1,340 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <vector>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros_eigen.hpp"
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/poses/Pose.hpp"
+
+
+namespace kindr {
+
+template<typename PrimType_>
+class DualQuaternion;
+
+namespace internal {
+
+template<typename PrimType_>
+class get_position<DualQuaternion<PrimType_>> {
+ public:
+  //! Position
+  typedef kindr::Position<PrimType_, 3> Position;
+};
+
+} // namespace internal
+
+
+/*! \class DualQuaternion
+ * \brief Pose stored as a unit dual quaternion.
+ *
+ *  The rotation lives in the real part and the translation is encoded in the
+ *  dual part as dual = 1/2 * t * real, so a pose occupies eight contiguous
+ *  scalars. Composition is a dual quaternion product and blending N poses
+ *  reduces to an 8-wide weighted sum of coefficients followed by a single
+ *  normalization (see blendDualQuaternions()), without renormalizing the
+ *  rotation and lerping the translation per weight.
+ * \tparam PrimType_ the primitive type of the data (double or float)
+ * \ingroup poses
+ */
+template<typename PrimType_>
+class DualQuaternion : public PoseBase<DualQuaternion<PrimType_>> {
+ public:
+  typedef PrimType_ Scalar;
+  typedef kindr::Position<PrimType_, 3> Position;
+  typedef RotationQuaternion<PrimType_> Rotation;
+  //! Unaligned Eigen quaternion used for the real and dual parts
+  typedef Eigen::Quaternion<PrimType_, Eigen::DontAlign> Quaternion;
+
+  /*! \brief Default constructor.
+   *  Creates the identity pose (unit real part, zero dual part).
+   */
+  DualQuaternion()
+    : real_(Quaternion::Identity()), dual_(PrimType_(0), PrimType_(0), PrimType_(0), PrimType_(0)) {
+  }
+
+  /*! \brief Constructor using position and rotation.
+   *  \param position   translational part
+   *  \param rotation   rotational part
+   */
+  inline explicit DualQuaternion(const Position& position, const Rotation& rotation)
+    : real_(rotation.toImplementation()) {
+    setDualFromPosition(position);
+  }
+
+  /*! \brief Constructor using the real and dual parts directly.
+   *  \param real   rotational part (must have unit norm)
+   *  \param dual   translational part (must be orthogonal to the real part)
+   */
+  inline explicit DualQuaternion(const Quaternion& real, const Quaternion& dual)
+    : real_(real), dual_(dual) {
+    KINDR_ASSERT_SCALAR_NEAR_DBG(std::runtime_error, real_.norm(), static_cast<PrimType_>(1), static_cast<PrimType_>(1e-4), "Input real part has not unit length.");
+  }
+
+  /*! \brief Constructor using another pose.
+   *  \param other   other pose
+   */
+  template<typename OtherDerived_>
+  inline explicit DualQuaternion(const PoseBase<OtherDerived_>& other)
+    : real_(Rotation(other.derived().getRotation()).toImplementation()) {
+    setDualFromPosition(Position(other.derived().getPosition()));
+  }
+
+  /*! \brief Gets the translational part.
+   *  \returns the position
+   */
+  inline Position getPosition() const {
+    // t = 2 * dual * real^-1, the scalar part vanishes for orthogonal parts
+    const Quaternion translation = multiply(dual_, real_.conjugate());
+    return Position(PrimType_(2)*translation.x(), PrimType_(2)*translation.y(), PrimType_(2)*translation.z());
+  }
+
+  /*! \brief Sets the translational part.
+   *  \param position   the position
+   */
+  inline void setPosition(const Position& position) {
+    setDualFromPosition(position);
+  }
+
+  /*! \brief Gets the rotational part.
+   *  \returns the rotation
+   */
+  inline Rotation getRotation() const {
+    return Rotation(real_);
+  }
+
+  /*! \brief Sets the rotational part, keeping the translation.
+   *  \param rotation   the rotation
+   */
+  inline void setRotation(const Rotation& rotation) {
+    const Position position = getPosition();
+    real_ = rotation.toImplementation();
+    setDualFromPosition(position);
+  }
+
+  /*! \brief Gets the real (rotational) quaternion part.
+   *  \returns the real part
+   */
+  inline const Quaternion& getReal() const {
+    return real_;
+  }
+
+  /*! \brief Gets the dual (translational) quaternion part.
+   *  \returns the dual part
+   */
+  inline const Quaternion& getDual() const {
+    return dual_;
+  }
+
+  /*! \brief Concatenation operator.
+   *  This is explicitly specified, because RotationBase provides also an operator*.
+   *  \returns the concatenation of two transformations
+   */
+  using PoseBase<DualQuaternion<PrimType_>>::operator*;
+
+  /*! \brief Returns the inverse pose.
+   *  For a unit dual quaternion the inverse is the quaternion conjugate of both parts.
+   *  \returns the inverse pose
+   */
+  DualQuaternion inverted() const {
+    return DualQuaternion(real_.conjugate(), dual_.conjugate());
+  }
+
+  /*! \brief Inverts the pose.
+   *  \returns reference
+   */
+  DualQuaternion& invert() {
+    *this = inverted();
+    return *this;
+  }
+
+  /*! \brief Norm of the real part.
+   *  \returns the norm
+   */
+  PrimType_ norm() const {
+    return real_.norm();
+  }
+
+  /*! \brief Renormalizes the dual quaternion.
+   *  Divides both parts by the norm of the real part and projects the dual
+   *  part back onto the orthogonal complement of the real part, so the result
+   *  encodes a rigid transformation again (e.g. after blending).
+   *  \returns reference
+   */
+  DualQuaternion& normalize() {
+    const PrimType_ invNorm = PrimType_(1)/real_.norm();
+    real_.coeffs() *= invNorm;
+    dual_.coeffs() *= invNorm;
+    dual_.coeffs() -= real_.coeffs().dot(dual_.coeffs())*real_.coeffs();
+    return *this;
+  }
+
+  /*! \brief Sets the pose to identity
+   *  \returns reference
+   */
+  DualQuaternion& setIdentity() {
+    real_ = Quaternion::Identity();
+    dual_ = Quaternion(PrimType_(0), PrimType_(0), PrimType_(0), PrimType_(0));
+    return *this;
+  }
+
+  /*! \brief Used for printing the object with std::cout.
+   *  \returns std::stream object
+   */
+  friend std::ostream& operator << (std::ostream& out, const DualQuaternion& pose) {
+    out << "real: " << pose.real_.coeffs().transpose() << " dual: " << pose.dual_.coeffs().transpose();
+    return out;
+  }
+
+  //! Quaternion product that does not renormalize (only for advanced users)
+  inline static Quaternion multiply(const Quaternion& lhs, const Quaternion& rhs) {
+    return Quaternion(lhs.w()*rhs.w() - lhs.x()*rhs.x() - lhs.y()*rhs.y() - lhs.z()*rhs.z(),
+                      lhs.w()*rhs.x() + lhs.x()*rhs.w() + lhs.y()*rhs.z() - lhs.z()*rhs.y(),
+                      lhs.w()*rhs.y() - lhs.x()*rhs.z() + lhs.y()*rhs.w() + lhs.z()*rhs.x(),
+                      lhs.w()*rhs.z() + lhs.x()*rhs.y() - lhs.y()*rhs.x() + lhs.z()*rhs.w());
+  }
+
+ private:
+  //! Encodes a position in the dual part: dual = 1/2 * t * real
+  inline void setDualFromPosition(const Position& position) {
+    const Quaternion translation(PrimType_(0), position.x(), position.y(), position.z());
+    dual_ = multiply(translation, real_);
+    dual_.coeffs() *= PrimType_(0.5);
+  }
+
+  //! Rotational part
+  Quaternion real_;
+  //! Translational part, dual = 1/2 * t * real
+  Quaternion dual_;
+};
+
+typedef DualQuaternion<double> DualQuaternionD;
+typedef DualQuaternion<float> DualQuaternionF;
+
+
+/*! \brief Dual quaternion linear blending of N poses.
+ *
+ *  Accumulates the weighted coefficients of all poses (flipping the sign of
+ *  contributions whose real part opposes the hemisphere of the first pose) and
+ *  normalizes the sum once. The result is the well-known DLB approximation of
+ *  the weighted pose average; for two poses it follows the same screw path as
+ *  the exact interpolation, only with a slightly non-uniform parameterization.
+ *
+ *  \param poses     poses to blend (at least one)
+ *  \param weights   blend weights, one per pose
+ *  \returns the blended pose
+ *  \ingroup poses
+ */
+template<typename PrimType_>
+DualQuaternion<PrimType_> blendDualQuaternions(const std::vector<DualQuaternion<PrimType_>>& poses,
+                                               const std::vector<PrimType_>& weights) {
+  KINDR_ASSERT_TRUE(std::runtime_error, !poses.empty(), "At least one pose is required.");
+  KINDR_ASSERT_TRUE(std::runtime_error, poses.size() == weights.size(), "One weight per pose is required.");
+  typedef Eigen::Matrix<PrimType_, 4, 1> Vector4;
+  Vector4 real = Vector4::Zero();
+  Vector4 dual = Vector4::Zero();
+  const Vector4 reference = poses.front().getReal().coeffs();
+  for (std::size_t k = 0; k < poses.size(); k++) {
+    const PrimType_ sign = (reference.dot(poses[k].getReal().coeffs()) < PrimType_(0)) ? PrimType_(-1) : PrimType_(1);
+    real += (sign*weights[k])*poses[k].getReal().coeffs();
+    dual += (sign*weights[k])*poses[k].getDual().coeffs();
+  }
+  // normalize once: unit real part and dual part orthogonal to it
+  const PrimType_ invNorm = PrimType_(1)/real.norm();
+  real *= invNorm;
+  dual *= invNorm;
+  dual -= real.dot(dual)*real;
+  typedef typename DualQuaternion<PrimType_>::Quaternion Quaternion;
+  return DualQuaternion<PrimType_>(Quaternion(real), Quaternion(dual));
+}
+
+
+namespace internal {
+
+template<typename PrimType_>
+class TransformationTraits<DualQuaternion<PrimType_>> {
+ private:
+  typedef DualQuaternion<PrimType_> Pose;
+  typedef typename get_position<Pose>::Position Translation;
+ public:
+  inline static Translation transform(const Pose& pose, const Translation& position) {
+    return pose.getRotation().rotate(position) + pose.getPosition();
+  }
+  inline static Translation inverseTransform(const Pose& pose, const Translation& position) {
+    return pose.getRotation().inverseRotate(position - pose.getPosition());
+  }
+};
+
+/*! \brief Composition of two dual quaternion poses is a dual quaternion product.
+ */
+template<typename PrimType_>
+class MultiplicationTraits<PoseBase<DualQuaternion<PrimType_>>, PoseBase<DualQuaternion<PrimType_>>> {
+ private:
+  typedef DualQuaternion<PrimType_> Pose;
+  typedef typename Pose::Quaternion Quaternion;
+ public:
+  inline static Pose mult(const Pose& lhs, const Pose& rhs) {
+    const Quaternion real = Pose::multiply(lhs.getReal(), rhs.getReal());
+    Quaternion dual = Pose::multiply(lhs.getReal(), rhs.getDual());
+    dual.coeffs() += Pose::multiply(lhs.getDual(), rhs.getReal()).coeffs();
+    return Pose(real, dual);
+  }
+};
+
+/*! \brief Relative pose between two dual quaternion poses.
+ */
+template<typename PrimType_>
+class InverseCompositionTraits<DualQuaternion<PrimType_>, DualQuaternion<PrimType_>> {
+ public:
+  inline static DualQuaternion<PrimType_> inverseCompose(const DualQuaternion<PrimType_>& lhs, const DualQuaternion<PrimType_>& rhs) {
+    return MultiplicationTraits<PoseBase<DualQuaternion<PrimType_>>, PoseBase<DualQuaternion<PrimType_>>>::mult(lhs.inverted(), rhs);
+  }
+};
+
+/*! \brief SE(3) exponential and logarithmic map, delegated to the homogeneous
+ *         transformation implementation.
+ */
+template<typename PrimType_>
+class MapTraits<DualQuaternion<PrimType_>> {
+ private:
+  typedef HomogeneousTransformation<PrimType_, typename DualQuaternion<PrimType_>::Position, typename DualQuaternion<PrimType_>::Rotation> EquivalentPose;
+ public:
+  inline static DualQuaternion<PrimType_> set_exponential_map(const Eigen::Matrix<PrimType_, 6, 1>& vector) {
+    return DualQuaternion<PrimType_>(MapTraits<EquivalentPose>::set_exponential_map(vector));
+  }
+  inline static Eigen::Matrix<PrimType_, 6, 1> get_logarithmic_map(const DualQuaternion<PrimType_>& pose) {
+    return MapTraits<EquivalentPose>::get_logarithmic_map(EquivalentPose(pose));
+  }
+};
+
+} // namespace internal
+} // namespace kindr
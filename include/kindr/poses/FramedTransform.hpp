@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include "kindr/poses/Pose.hpp"
+
+namespace kindr {
+
+/*! \file FramedTransform.hpp
+ *  \brief Compile-time frame tags on positions, rotations, and poses.
+ *
+ *  Physical typing catches unit errors; frame tags catch composing transforms
+ *  between the wrong frames. Frames are empty user-defined structs (e.g.
+ *  struct MapFrame {};) carried as template parameters: T_map_body*T_body_cam
+ *  compiles and yields a map-from-camera transform, while T_map_body*T_cam_imu
+ *  has no matching operator and fails to compile. The wrappers hold exactly the
+ *  underlying kindr object and every call inlines to it, so a build with the
+ *  tags erased is bit-identical — the checks cost nothing at runtime.
+ */
+
+/*! \class FramedPosition
+ * \brief A position expressed in a tagged frame.
+ *
+ *  \tparam Frame_     tag type of the frame the coordinates are expressed in
+ *  \tparam Position_  underlying kindr position type
+ */
+template<typename Frame_, typename Position_ = Position3D>
+class FramedPosition {
+ public:
+  typedef Frame_ Frame;
+  typedef Position_ Position;
+
+  FramedPosition() = default;
+
+  explicit FramedPosition(const Position_& position) : position_(position) {}
+
+  const Position_& get() const { return position_; }
+  Position_& get() { return position_; }
+
+  FramedPosition operator+(const FramedPosition& other) const {
+    return FramedPosition(Position_(position_ + other.position_));
+  }
+
+  FramedPosition operator-(const FramedPosition& other) const {
+    return FramedPosition(Position_(position_ - other.position_));
+  }
+
+ private:
+  Position_ position_;
+};
+
+/*! \class FramedRotation
+ * \brief A rotation mapping vectors from a source frame to a target frame.
+ *
+ *  \tparam TargetFrame_  tag type of the frame rotated into
+ *  \tparam SourceFrame_  tag type of the frame rotated from
+ *  \tparam Rotation_     underlying kindr rotation type
+ */
+template<typename TargetFrame_, typename SourceFrame_, typename Rotation_ = RotationQuaternionD>
+class FramedRotation {
+ public:
+  typedef TargetFrame_ TargetFrame;
+  typedef SourceFrame_ SourceFrame;
+  typedef Rotation_ Rotation;
+
+  FramedRotation() = default;
+
+  explicit FramedRotation(const Rotation_& rotation) : rotation_(rotation) {}
+
+  const Rotation_& get() const { return rotation_; }
+  Rotation_& get() { return rotation_; }
+
+  /*! \brief Concatenation: frames must chain, R_a_b*R_b_c yields R_a_c. */
+  template<typename OtherSourceFrame_>
+  FramedRotation<TargetFrame_, OtherSourceFrame_, Rotation_>
+  operator*(const FramedRotation<SourceFrame_, OtherSourceFrame_, Rotation_>& other) const {
+    return FramedRotation<TargetFrame_, OtherSourceFrame_, Rotation_>(Rotation_(rotation_*other.get()));
+  }
+
+  /*! \brief Inversion swaps the frame tags. */
+  FramedRotation<SourceFrame_, TargetFrame_, Rotation_> inverted() const {
+    return FramedRotation<SourceFrame_, TargetFrame_, Rotation_>(rotation_.inverted());
+  }
+
+  /*! \brief Rotates a source-frame position into the target frame. */
+  template<typename Position_>
+  FramedPosition<TargetFrame_, Position_> rotate(const FramedPosition<SourceFrame_, Position_>& position) const {
+    return FramedPosition<TargetFrame_, Position_>(rotation_.rotate(position.get()));
+  }
+
+ private:
+  Rotation_ rotation_;
+};
+
+/*! \class FramedTransform
+ * \brief A pose mapping positions from a source frame to a target frame.
+ *
+ *  \tparam TargetFrame_  tag type of the frame transformed into
+ *  \tparam SourceFrame_  tag type of the frame transformed from
+ *  \tparam Pose_         underlying kindr pose type
+ */
+template<typename TargetFrame_, typename SourceFrame_, typename Pose_ = HomogeneousTransformationPosition3RotationQuaternionD>
+class FramedTransform {
+ public:
+  typedef TargetFrame_ TargetFrame;
+  typedef SourceFrame_ SourceFrame;
+  typedef Pose_ Pose;
+  typedef typename Pose_::Position Position;
+
+  FramedTransform() = default;
+
+  explicit FramedTransform(const Pose_& pose) : pose_(pose) {}
+
+  FramedTransform(const typename Pose_::Position& position, const typename Pose_::Rotation& rotation)
+    : pose_(position, rotation) {}
+
+  const Pose_& get() const { return pose_; }
+  Pose_& get() { return pose_; }
+
+  /*! \brief Concatenation: frames must chain, T_a_b*T_b_c yields T_a_c. */
+  template<typename OtherSourceFrame_>
+  FramedTransform<TargetFrame_, OtherSourceFrame_, Pose_>
+  operator*(const FramedTransform<SourceFrame_, OtherSourceFrame_, Pose_>& other) const {
+    return FramedTransform<TargetFrame_, OtherSourceFrame_, Pose_>(pose_*other.get());
+  }
+
+  /*! \brief Inversion swaps the frame tags. */
+  FramedTransform<SourceFrame_, TargetFrame_, Pose_> inverted() const {
+    const typename Pose_::Rotation rotation(pose_.getRotation().inverted());
+    const typename Pose_::Position position(-pose_.getRotation().inverseRotate(pose_.getPosition()));
+    return FramedTransform<SourceFrame_, TargetFrame_, Pose_>(Pose_(position, rotation));
+  }
+
+  /*! \brief Transforms a source-frame position into the target frame. */
+  FramedPosition<TargetFrame_, Position> transform(const FramedPosition<SourceFrame_, Position>& position) const {
+    return FramedPosition<TargetFrame_, Position>(pose_.transform(position.get()));
+  }
+
+  /*! \brief Transforms a target-frame position back into the source frame. */
+  FramedPosition<SourceFrame_, Position> inverseTransform(const FramedPosition<TargetFrame_, Position>& position) const {
+    return FramedPosition<SourceFrame_, Position>(pose_.inverseTransform(position.get()));
+  }
+
+  FramedTransform& setIdentity() {
+    pose_.setIdentity();
+    return *this;
+  }
+
+ private:
+  Pose_ pose_;
+};
+
+} // namespace kindr
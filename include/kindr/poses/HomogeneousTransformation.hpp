@@ -181,6 +181,89 @@ class MultiplicationTraits<PoseBase<HomogeneousTransformation<PrimType_, Positio
   }
 };
 
+/*! \brief SE(3) exponential and logarithmic map for homogeneous transformations.
+ *
+ *  The 6-vector carries the translational part on top and the rotational part
+ *  below. The translation couples to the rotation through the closed-form
+ *  V-matrix; a series branch keeps small angles accurate without dividing by
+ *  a vanishing angle.
+ */
+template<typename PrimType_, typename Position_, typename Rotation_>
+class MapTraits<HomogeneousTransformation<PrimType_, Position_, Rotation_>> {
+ private:
+  typedef HomogeneousTransformation<PrimType_, Position_, Rotation_> Pose;
+  typedef Eigen::Matrix<PrimType_, 6, 1> Vector6;
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+  typedef Eigen::Matrix<PrimType_, 3, 3> Matrix3;
+
+  /*! \brief V-matrix of the SE(3) exponential: V = I + a*[phi]x + b*[phi]x^2
+   *         with a = (1-cos(t))/t^2 and b = (t-sin(t))/t^3.
+   */
+  inline static Matrix3 getV(const Vector3& rotationVector) {
+    using std::sqrt;
+    using std::sin;
+    using std::cos;
+    const PrimType_ angleSquared = rotationVector.squaredNorm();
+    const Matrix3 skew = getSkewMatrixFromVector(rotationVector);
+    PrimType_ a, b;
+    if (angleSquared < sqrt(std::numeric_limits<PrimType_>::epsilon())) {
+      a = PrimType_(0.5) - angleSquared/PrimType_(24.0);
+      b = PrimType_(1.0)/PrimType_(6.0) - angleSquared/PrimType_(120.0);
+    } else {
+      const PrimType_ angle = sqrt(angleSquared);
+      a = (PrimType_(1.0) - cos(angle))/angleSquared;
+      b = (angle - sin(angle))/(angleSquared*angle);
+    }
+    return Matrix3(Matrix3::Identity() + a*skew + b*skew*skew);
+  }
+
+  /*! \brief Inverse V-matrix in closed form: V^-1 = I - 1/2*[phi]x + c*[phi]x^2. */
+  inline static Matrix3 getVInverse(const Vector3& rotationVector) {
+    using std::sqrt;
+    using std::sin;
+    using std::cos;
+    const PrimType_ angleSquared = rotationVector.squaredNorm();
+    const Matrix3 skew = getSkewMatrixFromVector(rotationVector);
+    PrimType_ c;
+    if (angleSquared < sqrt(std::numeric_limits<PrimType_>::epsilon())) {
+      c = PrimType_(1.0)/PrimType_(12.0) + angleSquared/PrimType_(720.0);
+    } else {
+      const PrimType_ angle = sqrt(angleSquared);
+      c = (PrimType_(1.0) - angle*sin(angle)/(PrimType_(2.0)*(PrimType_(1.0) - cos(angle))))/angleSquared;
+    }
+    return Matrix3(Matrix3::Identity() - PrimType_(0.5)*skew + c*skew*skew);
+  }
+
+ public:
+  inline static Pose set_exponential_map(const Vector6& vector) {
+    const Vector3 translationalPart = vector.template head<3>();
+    const Vector3 rotationalPart = vector.template tail<3>();
+    const Rotation_ rotation = Rotation_(RotationVector<PrimType_>(rotationalPart));
+    return Pose(Position_(getV(rotationalPart)*translationalPart), rotation);
+  }
+
+  inline static Vector6 get_logarithmic_map(const Pose& pose) {
+    const Vector3 rotationalPart = pose.getRotation().logarithmicMap();
+    Vector6 vector;
+    vector.template head<3>() = getVInverse(rotationalPart)*pose.getPosition().toImplementation();
+    vector.template tail<3>() = rotationalPart;
+    return vector;
+  }
+};
+
+/*! \brief Relative pose between two homogeneous transformations.
+ */
+template<typename PrimType_, typename Position_, typename Rotation_>
+class InverseCompositionTraits<HomogeneousTransformation<PrimType_, Position_, Rotation_>, HomogeneousTransformation<PrimType_, Position_, Rotation_>> {
+ public:
+  //! Computes R_a^T*R_b and R_a^T*(t_b - t_a) directly without materializing the inverse of the left-hand side
+  inline static HomogeneousTransformation<PrimType_, Position_, Rotation_> inverseCompose(const HomogeneousTransformation<PrimType_, Position_, Rotation_>& lhs, const HomogeneousTransformation<PrimType_, Position_, Rotation_>& rhs) {
+    const typename HomogeneousTransformation<PrimType_, Position_, Rotation_>::Position position = lhs.getRotation().inverseRotate(rhs.getPosition() - lhs.getPosition());
+    const typename HomogeneousTransformation<PrimType_, Position_, Rotation_>::Rotation rotation(lhs.getRotation().inverted()*rhs.getRotation());
+    return HomogeneousTransformation<PrimType_, Position_, Rotation_>(position, rotation);
+  }
+};
+
 
 
 } // namespace internal
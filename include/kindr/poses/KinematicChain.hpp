@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <vector>
+
+#include <Eigen/StdVector>
+
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/poses/HomogeneousTransformation.hpp"
+
+namespace kindr {
+
+/*! \class KinematicChain
+ * \brief Serial chain of link transforms with incremental composite-transform caching
+ *
+ *  Stores the relative link transforms contiguously together with the cached prefix
+ *  products T_0*...*T_i. Updating a single joint only invalidates the suffix of the prefix
+ *  products from that joint on, so when few joints move between evaluations the forward
+ *  kinematics costs O(changed links) pose compositions instead of O(n).
+ *
+ *  The prefix products are recomputed lazily on lookup, so any number of joint updates
+ *  between evaluations is folded into one recompute of the affected suffix.
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *  \ingroup poses
+ */
+template<typename PrimType_>
+class KinematicChain {
+ public:
+  typedef PrimType_ Scalar;
+  typedef HomogeneousTransformationPosition3RotationQuaternion<PrimType_> Pose;
+
+  KinematicChain()
+    : firstInvalidPrefix_(0) {
+  }
+
+  /*! \brief Returns the number of links in the chain. */
+  std::size_t getNumberOfLinks() const {
+    return linkTransforms_.size();
+  }
+
+  /*! \brief Appends a link transform at the end of the chain.
+   *  \param transform  pose of the new link frame relative to its predecessor
+   */
+  void appendLink(const Pose& transform) {
+    linkTransforms_.push_back(transform);
+    prefixProducts_.resize(linkTransforms_.size());
+  }
+
+  /*! \brief Gets the relative transform of a link.
+   *  \param index  index of the link
+   */
+  const Pose& getLinkTransform(std::size_t index) const {
+    KINDR_ASSERT_TRUE(std::out_of_range, index < linkTransforms_.size(), "Link index is out of range.");
+    return linkTransforms_[index];
+  }
+
+  /*! \brief Sets the relative transform of a link and invalidates the affected suffix.
+   *  \param index      index of the link
+   *  \param transform  new pose of the link frame relative to its predecessor
+   */
+  void setLinkTransform(std::size_t index, const Pose& transform) {
+    KINDR_ASSERT_TRUE(std::out_of_range, index < linkTransforms_.size(), "Link index is out of range.");
+    linkTransforms_[index] = transform;
+    if (index < firstInvalidPrefix_) {
+      firstInvalidPrefix_ = index;
+    }
+  }
+
+  /*! \brief Gets the composite transform from the base to a link frame.
+   *
+   *  Returns the cached prefix product T_0*...*T_index, recomputing only the invalidated
+   *  suffix if joints changed since the last lookup.
+   *  \param index  index of the link
+   */
+  const Pose& getTransformToLink(std::size_t index) const {
+    KINDR_ASSERT_TRUE(std::out_of_range, index < linkTransforms_.size(), "Link index is out of range.");
+    updatePrefixProducts(index);
+    return prefixProducts_[index];
+  }
+
+  /*! \brief Gets the composite transform from the base to the last link frame. */
+  const Pose& getEndEffectorTransform() const {
+    KINDR_ASSERT_TRUE(std::out_of_range, !linkTransforms_.empty(), "Chain is empty.");
+    return getTransformToLink(linkTransforms_.size() - 1);
+  }
+
+  /*! \brief Removes all links. */
+  void clear() {
+    linkTransforms_.clear();
+    prefixProducts_.clear();
+    firstInvalidPrefix_ = 0;
+  }
+
+ private:
+  /*! \brief Recomputes the prefix products from the first invalid entry up to index. */
+  void updatePrefixProducts(std::size_t index) const {
+    if (firstInvalidPrefix_ > index) {
+      return;
+    }
+    std::size_t i = firstInvalidPrefix_;
+    if (i == 0) {
+      prefixProducts_[0] = linkTransforms_[0];
+      i = 1;
+    }
+    for (; i <= index; i++) {
+      prefixProducts_[i] = Pose(prefixProducts_[i - 1]*linkTransforms_[i]);
+    }
+    firstInvalidPrefix_ = index + 1;
+  }
+
+  std::vector<Pose, Eigen::aligned_allocator<Pose>> linkTransforms_;
+  //! cached composite transforms T_0*...*T_i (entries >= firstInvalidPrefix_ are stale)
+  mutable std::vector<Pose, Eigen::aligned_allocator<Pose>> prefixProducts_;
+  //! index of the first stale prefix product
+  mutable std::size_t firstInvalidPrefix_;
+};
+
+typedef KinematicChain<double> KinematicChainD;
+typedef KinematicChain<float> KinematicChainF;
+
+} // namespace kindr
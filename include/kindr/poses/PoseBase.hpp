@@ -62,6 +62,17 @@ class get_position {
 //  typedef typename positions::Position3D Position;
 };
 
+/*! \class InverseCompositionTraits
+ * \brief Trait to compute the relative pose between two poses in one pass.
+ *
+ *  (only for advanced users)
+ */
+template<typename Left_, typename Right_>
+class InverseCompositionTraits {
+ public:
+//  inline static Left_ inverseCompose(const Left_& lhs, const Right_& rhs);
+};
+
 } // namespace internal
 
 
@@ -139,12 +150,47 @@ class PoseBase {
     return internal::MultiplicationTraits<PoseBase<Derived_>,PoseBase<OtherDerived_>>::mult(this->derived(), other.derived()); // todo: 1. ok? 2. may be optimized
   }
 
+  /*! \brief Computes the relative pose this⁻¹ * other in one pass.
+   *
+   *  Unlike inverting first and composing afterwards, no intermediate pose
+   *  with a back-rotated translation is materialized.
+   *  \returns the relative pose
+   */
+  template<typename OtherDerived_>
+  Derived_ inverseCompose(const PoseBase<OtherDerived_>& other) const {
+    return internal::InverseCompositionTraits<Derived_, OtherDerived_>::inverseCompose(this->derived(), other.derived());
+  }
+
+  /*! \brief Sets the pose using the SE(3) exponential map, mirroring RotationBase::exponentialMap().
+   * \param vector  Eigen::Matrix<Scalar, 6, 1> with the translational part on top and the rotational part below
+   * \return  the pose
+   */
+  static Derived_ exponentialMap(const Eigen::Matrix<typename internal::get_position<Derived_>::Position::Scalar, 6, 1>& vector) {
+    return internal::MapTraits<Derived_>::set_exponential_map(vector);
+  }
+
+  /*! \brief Gets the SE(3) logarithmic map from the pose, mirroring RotationBase::logarithmicMap().
+   * \returns vector  Eigen::Matrix<Scalar, 6, 1> with the translational part on top and the rotational part below
+   */
+  Eigen::Matrix<typename internal::get_position<Derived_>::Position::Scalar, 6, 1> logarithmicMap() const {
+    return internal::MapTraits<Derived_>::get_logarithmic_map(this->derived());
+  }
+
   /*! \brief Sets the pose to identity
    *  \returns reference
    */
   Derived_& setIdentity();
 };
 
+/*! \brief Computes the relative pose lhs⁻¹ * rhs in one pass.
+ *  \returns the relative pose
+ *  \ingroup poses
+ */
+template<typename LeftDerived_, typename RightDerived_>
+LeftDerived_ betweenPoses(const PoseBase<LeftDerived_>& lhs, const PoseBase<RightDerived_>& rhs) {
+  return lhs.inverseCompose(rhs);
+}
+
 
 } // namespace kindr
 
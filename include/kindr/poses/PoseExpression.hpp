@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include "kindr/poses/PoseBase.hpp"
+
+namespace kindr {
+
+/*! \defgroup poseexpressions Lazy pose expressions
+ *  \ingroup poses
+ *
+ *  Lazy expressions defer the composition of homogeneous transformations. A
+ *  chain such as lazy(A)*B*C stores only references to its factors; applying
+ *  transform() folds the chain right-to-left as one rotate-translate pass per
+ *  link, without materializing intermediate Position and Rotation temporaries.
+ *  Assigning the expression to a pose evaluates the composition once.
+ */
+
+template<typename LhsExpression_, typename RhsExpression_>
+class PoseProductExpression;
+
+/*! \brief Leaf expression referencing a single pose.
+ *  \tparam Pose_ the referenced pose type
+ *  \ingroup poseexpressions
+ */
+template<typename Pose_>
+class PoseRefExpression {
+ public:
+  //! The concrete pose type the expression evaluates to
+  typedef Pose_ Pose;
+  //! The position type of the pose
+  typedef typename Pose_::Position Position;
+
+  /*! \brief Constructor referencing a pose.
+   *  \param pose   referenced pose, must outlive the expression
+   */
+  explicit PoseRefExpression(const Pose_& pose)
+    : pose_(pose) {
+  }
+
+  /*! \brief Transforms a position.
+   *  \returns the transformed position
+   */
+  Position transform(const Position& position) const {
+    return pose_.transform(position);
+  }
+
+  /*! \brief Evaluates the expression.
+   *  \returns the referenced pose
+   */
+  Pose eval() const {
+    return pose_;
+  }
+
+  /*! \brief Implicit evaluation into a concrete pose.
+   */
+  operator Pose() const {
+    return eval();
+  }
+
+  /*! \brief Extends the chain by another pose.
+   *  \returns the deferred product expression
+   */
+  template<typename OtherDerived_>
+  PoseProductExpression<PoseRefExpression, PoseRefExpression<OtherDerived_>> operator *(const PoseBase<OtherDerived_>& other) const {
+    return PoseProductExpression<PoseRefExpression, PoseRefExpression<OtherDerived_>>(*this, PoseRefExpression<OtherDerived_>(other.derived()));
+  }
+
+ private:
+  //! Referenced pose
+  const Pose_& pose_;
+};
+
+/*! \brief Deferred product of two pose expressions.
+ *  \tparam LhsExpression_ the left-hand side expression type
+ *  \tparam RhsExpression_ the right-hand side expression type
+ *  \ingroup poseexpressions
+ */
+template<typename LhsExpression_, typename RhsExpression_>
+class PoseProductExpression {
+ public:
+  //! The concrete pose type the expression evaluates to
+  typedef typename LhsExpression_::Pose Pose;
+  //! The position type of the pose
+  typedef typename Pose::Position Position;
+
+  /*! \brief Constructor from two sub-expressions.
+   */
+  PoseProductExpression(const LhsExpression_& lhs, const RhsExpression_& rhs)
+    : lhs_(lhs), rhs_(rhs) {
+  }
+
+  /*! \brief Transforms a position through the whole chain.
+   *
+   *  The chain is folded right-to-left, so each link contributes exactly one
+   *  rotate-translate pass and no intermediate pose is materialized.
+   *  \returns the transformed position
+   */
+  Position transform(const Position& position) const {
+    return lhs_.transform(rhs_.transform(position));
+  }
+
+  /*! \brief Evaluates the composition of the whole chain.
+   *  \returns the composed pose
+   */
+  Pose eval() const {
+    return Pose(lhs_.eval()*rhs_.eval());
+  }
+
+  /*! \brief Implicit evaluation into a concrete pose.
+   */
+  operator Pose() const {
+    return eval();
+  }
+
+  /*! \brief Extends the chain by another pose.
+   *  \returns the deferred product expression
+   */
+  template<typename OtherDerived_>
+  PoseProductExpression<PoseProductExpression, PoseRefExpression<OtherDerived_>> operator *(const PoseBase<OtherDerived_>& other) const {
+    return PoseProductExpression<PoseProductExpression, PoseRefExpression<OtherDerived_>>(*this, PoseRefExpression<OtherDerived_>(other.derived()));
+  }
+
+ private:
+  //! Sub-expressions
+  const LhsExpression_ lhs_;
+  const RhsExpression_ rhs_;
+};
+
+/*! \brief Starts a lazy pose expression chain.
+ *
+ *  Usage: (lazy(A)*B*C).transform(p) transforms p through the chain without
+ *  composing the poses; Pose D = lazy(A)*B*C; composes them once.
+ *
+ *  \param pose   first pose of the chain, must outlive the expression
+ *  \returns leaf expression referencing the pose
+ *  \ingroup poseexpressions
+ */
+template<typename Derived_>
+PoseRefExpression<Derived_> lazy(const PoseBase<Derived_>& pose) {
+  return PoseRefExpression<Derived_>(pose.derived());
+}
+
+} // namespace kindr
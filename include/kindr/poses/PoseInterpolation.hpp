@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include "kindr/poses/HomogeneousTransformation.hpp"
+#include "kindr/rotations/RotationInterpolation.hpp"
+
+namespace kindr {
+
+/*! \brief Interpolates linearly between two poses.
+ *
+ *  The position is interpolated linearly and the rotation along its geodesic (slerp).
+ *  \param start  pose at alpha = 0
+ *  \param end    pose at alpha = 1
+ *  \param alpha  interpolation parameter in [0, 1]
+ *  \returns interpolated pose
+ *  \ingroup poses
+ */
+template<typename Pose_>
+Pose_ interpolateLinear(const Pose_& start, const Pose_& end, typename Pose_::Scalar alpha) {
+  typedef typename Pose_::Position Position;
+  const Position position(start.getPosition().toImplementation()
+                          + alpha*(end.getPosition().toImplementation() - start.getPosition().toImplementation()));
+  return Pose_(position, start.getRotation().slerp(end.getRotation(), alpha));
+}
+
+/*! \class PoseInterpolator
+ * \brief Precomputed linear interpolation between a fixed pair of poses
+ *
+ *  Caches the position difference and the relative rotation logarithm at construction, so
+ *  each evaluation costs one axpy per block and one exponential map — the repeated
+ *  boxMinus of interpolateLinear() is hoisted out of the per-alpha loop.
+ *
+ *  \tparam Pose_ the pose type of the endpoints
+ *  \ingroup poses
+ */
+template<typename Pose_>
+class PoseInterpolator {
+ public:
+  typedef typename Pose_::Scalar Scalar;
+  typedef typename Pose_::Position Position;
+  typedef typename Pose_::Rotation Rotation;
+
+  /*! \brief Constructor caching the relative transformation of the endpoints
+   *  \param start  pose at alpha = 0
+   *  \param end    pose at alpha = 1
+   */
+  PoseInterpolator(const Pose_& start, const Pose_& end)
+    : startPosition_(start.getPosition()),
+      positionDelta_(end.getPosition().toImplementation() - start.getPosition().toImplementation()),
+      rotationInterpolator_(start.getRotation(), end.getRotation()) {
+  }
+
+  /*! \brief Evaluates the interpolation.
+   *  \param alpha  interpolation parameter in [0, 1]
+   *  \returns interpolated pose
+   */
+  Pose_ evaluate(Scalar alpha) const {
+    return Pose_(Position(startPosition_.toImplementation() + alpha*positionDelta_),
+                 rotationInterpolator_.evaluate(alpha));
+  }
+
+ private:
+  Position startPosition_;
+  Eigen::Matrix<Scalar, 3, 1> positionDelta_;
+  RotationInterpolator<Rotation> rotationInterpolator_;
+};
+
+} // namespace kindr
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+
+#include "kindr/common/ArenaAllocator.hpp"
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/poses/HomogeneousTransformation.hpp"
+
+namespace kindr {
+
+/*! \file StagingBufferExport.hpp
+ *  \brief Bulk export of pose arrays into caller-provided graphics staging buffers.
+ *
+ *  getTransformationMatrix() builds one 4x4 at a time, converting the rotation
+ *  and returning by value; uploading a large bone array that way costs one
+ *  conversion plus one repack per pose. The exporter here fuses both: it reads
+ *  the quaternion coefficients once per pose, computes the nine rotation matrix
+ *  entries inline and stores the matrix directly in the requested layout and
+ *  scalar type. Every matrix is written front to back with no reads from the
+ *  destination, so the export streams cleanly into write-combined mapped
+ *  memory.
+ */
+
+/*! \brief Memory layout of the exported matrices. */
+enum class MatrixExportLayout {
+  //! 16 scalars per pose, columns consecutive (OpenGL/Vulkan convention)
+  ColumnMajor4x4,
+  //! 16 scalars per pose, rows consecutive
+  RowMajor4x4,
+  //! 12 scalars per pose, rows consecutive, implicit (0 0 0 1) bottom row
+  RowMajor3x4
+};
+
+/*! \brief Number of scalars one matrix occupies in a layout. */
+inline std::size_t getMatrixExportSize(MatrixExportLayout layout) {
+  return (layout == MatrixExportLayout::RowMajor3x4) ? 12u : 16u;
+}
+
+/*! \brief Writes an array of poses as transformation matrices into a staging buffer.
+ *
+ *  \param poses     poses to export
+ *  \param numPoses  number of poses
+ *  \param buffer    output buffer with room for numPoses*stride scalars
+ *  \param layout    matrix layout to write
+ *  \param stride    scalars from one matrix to the next; 0 packs them densely
+ *  \ingroup poses
+ */
+template<typename OutPrimType_, typename PrimType_>
+void exportTransformationMatrices(const HomogeneousTransformationPosition3RotationQuaternion<PrimType_>* poses,
+                                  std::size_t numPoses,
+                                  OutPrimType_* buffer,
+                                  MatrixExportLayout layout = MatrixExportLayout::ColumnMajor4x4,
+                                  std::size_t stride = 0u) {
+  const std::size_t matrixSize = getMatrixExportSize(layout);
+  if (stride == 0u) {
+    stride = matrixSize;
+  }
+  KINDR_ASSERT_TRUE(std::runtime_error, stride >= matrixSize, "Stride is smaller than one matrix.");
+
+  for (std::size_t i = 0; i < numPoses; i++) {
+    const PrimType_ w = poses[i].getRotation().w();
+    const PrimType_ x = poses[i].getRotation().x();
+    const PrimType_ y = poses[i].getRotation().y();
+    const PrimType_ z = poses[i].getRotation().z();
+    const OutPrimType_ r00 = static_cast<OutPrimType_>(PrimType_(1) - PrimType_(2)*(y*y + z*z));
+    const OutPrimType_ r01 = static_cast<OutPrimType_>(PrimType_(2)*(x*y - w*z));
+    const OutPrimType_ r02 = static_cast<OutPrimType_>(PrimType_(2)*(x*z + w*y));
+    const OutPrimType_ r10 = static_cast<OutPrimType_>(PrimType_(2)*(x*y + w*z));
+    const OutPrimType_ r11 = static_cast<OutPrimType_>(PrimType_(1) - PrimType_(2)*(x*x + z*z));
+    const OutPrimType_ r12 = static_cast<OutPrimType_>(PrimType_(2)*(y*z - w*x));
+    const OutPrimType_ r20 = static_cast<OutPrimType_>(PrimType_(2)*(x*z - w*y));
+    const OutPrimType_ r21 = static_cast<OutPrimType_>(PrimType_(2)*(y*z + w*x));
+    const OutPrimType_ r22 = static_cast<OutPrimType_>(PrimType_(1) - PrimType_(2)*(x*x + y*y));
+    const OutPrimType_ px = static_cast<OutPrimType_>(poses[i].getPosition().x());
+    const OutPrimType_ py = static_cast<OutPrimType_>(poses[i].getPosition().y());
+    const OutPrimType_ pz = static_cast<OutPrimType_>(poses[i].getPosition().z());
+
+    OutPrimType_* out = buffer + i*stride;
+    switch (layout) {
+      case MatrixExportLayout::ColumnMajor4x4:
+        out[0] = r00; out[1] = r10; out[2] = r20; out[3] = OutPrimType_(0);
+        out[4] = r01; out[5] = r11; out[6] = r21; out[7] = OutPrimType_(0);
+        out[8] = r02; out[9] = r12; out[10] = r22; out[11] = OutPrimType_(0);
+        out[12] = px; out[13] = py; out[14] = pz; out[15] = OutPrimType_(1);
+        break;
+      case MatrixExportLayout::RowMajor4x4:
+        out[0] = r00; out[1] = r01; out[2] = r02; out[3] = px;
+        out[4] = r10; out[5] = r11; out[6] = r12; out[7] = py;
+        out[8] = r20; out[9] = r21; out[10] = r22; out[11] = pz;
+        out[12] = OutPrimType_(0); out[13] = OutPrimType_(0); out[14] = OutPrimType_(0); out[15] = OutPrimType_(1);
+        break;
+      case MatrixExportLayout::RowMajor3x4:
+        out[0] = r00; out[1] = r01; out[2] = r02; out[3] = px;
+        out[4] = r10; out[5] = r11; out[6] = r12; out[7] = py;
+        out[8] = r20; out[9] = r21; out[10] = r22; out[11] = pz;
+        break;
+    }
+  }
+}
+
+/*! \brief Convenience overload exporting an aligned_vector of poses.
+ *  \param poses    poses to export
+ *  \param buffer   output buffer with room for poses.size()*stride scalars
+ *  \param layout   matrix layout to write
+ *  \param stride   scalars from one matrix to the next; 0 packs them densely
+ *  \ingroup poses
+ */
+template<typename OutPrimType_, typename PrimType_>
+void exportTransformationMatrices(const aligned_vector<HomogeneousTransformationPosition3RotationQuaternion<PrimType_>>& poses,
+                                  OutPrimType_* buffer,
+                                  MatrixExportLayout layout = MatrixExportLayout::ColumnMajor4x4,
+                                  std::size_t stride = 0u) {
+  exportTransformationMatrices(poses.data(), poses.size(), buffer, layout, stride);
+}
+
+} // namespace kindr
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include "kindr/poses/Pose.hpp"
+#include "kindr/rotations/Rotation.hpp"
+
+namespace kindr {
+
+/*! \file StaticTransform.hpp
+ *  \brief Literal rotation and transformation types for compile-time calibration folding.
+ *
+ *  The regular kindr types store Eigen objects and therefore cannot be constexpr in
+ *  C++11. The types in this file hold plain scalars, are constexpr-constructible and
+ *  compose/invert in constexpr context, so chains of fixed calibration transforms
+ *  (e.g. camera-IMU extrinsics) can be folded into literal constants by the compiler
+ *  and converted to the kindr types only where a runtime object is needed.
+ */
+
+//! Literal 3-vector used by the static calibration types.
+template<typename PrimType_>
+struct StaticVector {
+  PrimType_ x;
+  PrimType_ y;
+  PrimType_ z;
+
+  constexpr StaticVector() : x(0), y(0), z(0) {}
+  constexpr StaticVector(PrimType_ xIn, PrimType_ yIn, PrimType_ zIn) : x(xIn), y(yIn), z(zIn) {}
+
+  constexpr StaticVector operator+(const StaticVector& other) const {
+    return StaticVector(x + other.x, y + other.y, z + other.z);
+  }
+  constexpr StaticVector operator*(PrimType_ factor) const {
+    return StaticVector(x*factor, y*factor, z*factor);
+  }
+  constexpr StaticVector cross(const StaticVector& other) const {
+    return StaticVector(y*other.z - z*other.y, z*other.x - x*other.z, x*other.y - y*other.x);
+  }
+  constexpr PrimType_ dot(const StaticVector& other) const {
+    return x*other.x + y*other.y + z*other.z;
+  }
+
+  //! Converts to the kindr position (not constexpr; constructs an Eigen object).
+  Position<PrimType_, 3> toPosition() const {
+    return Position<PrimType_, 3>(x, y, z);
+  }
+};
+
+/*! \class StaticRotation
+ * \brief Literal unit quaternion with constexpr composition and inversion.
+ *
+ *  The coefficients are expected to form a unit quaternion; inverted() is the
+ *  conjugate. No normalization is performed, matching the use case of coefficients
+ *  taken from a calibration file and fixed at compile time.
+ */
+template<typename PrimType_>
+struct StaticRotation {
+  PrimType_ w;
+  PrimType_ x;
+  PrimType_ y;
+  PrimType_ z;
+
+  //! Identity rotation.
+  constexpr StaticRotation() : w(1), x(0), y(0), z(0) {}
+  constexpr StaticRotation(PrimType_ wIn, PrimType_ xIn, PrimType_ yIn, PrimType_ zIn)
+    : w(wIn), x(xIn), y(yIn), z(zIn) {
+  }
+
+  //! Hamilton product.
+  constexpr StaticRotation operator*(const StaticRotation& other) const {
+    return StaticRotation(w*other.w - x*other.x - y*other.y - z*other.z,
+                          w*other.x + x*other.w + y*other.z - z*other.y,
+                          w*other.y - x*other.z + y*other.w + z*other.x,
+                          w*other.z + x*other.y - y*other.x + z*other.w);
+  }
+
+  //! Inverse of a unit quaternion (conjugate).
+  constexpr StaticRotation inverted() const {
+    return StaticRotation(w, -x, -y, -z);
+  }
+
+  constexpr StaticVector<PrimType_> imaginary() const {
+    return StaticVector<PrimType_>(x, y, z);
+  }
+
+  //! Rotates a vector: v' = v + w*t + u x t with t = 2 u x v.
+  constexpr StaticVector<PrimType_> rotate(const StaticVector<PrimType_>& vector) const {
+    return rotateWithHalfCross(vector, imaginary().cross(vector)*PrimType_(2));
+  }
+
+  //! Converts to the kindr rotation quaternion (not constexpr; constructs an Eigen object).
+  RotationQuaternion<PrimType_> toRotationQuaternion() const {
+    return RotationQuaternion<PrimType_>(w, x, y, z);
+  }
+
+ private:
+  constexpr StaticVector<PrimType_> rotateWithHalfCross(const StaticVector<PrimType_>& vector,
+                                                        const StaticVector<PrimType_>& crossTerm) const {
+    return vector + crossTerm*w + imaginary().cross(crossTerm);
+  }
+};
+
+/*! \class StaticTransform
+ * \brief Literal rigid-body transform with constexpr composition and inversion.
+ *
+ *  Follows the same convention as HomogeneousTransformation: transform(v) rotates v
+ *  and adds the position, and composition applies the right-hand transform first.
+ */
+template<typename PrimType_>
+struct StaticTransform {
+  StaticVector<PrimType_> position;
+  StaticRotation<PrimType_> rotation;
+
+  //! Identity transform.
+  constexpr StaticTransform() : position(), rotation() {}
+  constexpr StaticTransform(const StaticVector<PrimType_>& positionIn, const StaticRotation<PrimType_>& rotationIn)
+    : position(positionIn), rotation(rotationIn) {
+  }
+
+  //! Composition: (*this) * other applies other first.
+  constexpr StaticTransform operator*(const StaticTransform& other) const {
+    return StaticTransform(position + rotation.rotate(other.position), rotation*other.rotation);
+  }
+
+  //! Inverse transform.
+  constexpr StaticTransform inverted() const {
+    return StaticTransform(rotation.inverted().rotate(position)*PrimType_(-1), rotation.inverted());
+  }
+
+  //! Transforms a point.
+  constexpr StaticVector<PrimType_> transform(const StaticVector<PrimType_>& vector) const {
+    return position + rotation.rotate(vector);
+  }
+
+  //! Converts to the kindr pose (not constexpr; constructs Eigen objects).
+  HomogeneousTransformationPosition3RotationQuaternion<PrimType_> toPose() const {
+    return HomogeneousTransformationPosition3RotationQuaternion<PrimType_>(position.toPosition(),
+                                                                           rotation.toRotationQuaternion());
+  }
+};
+
+//! \brief Literal 3-vector with primitive type double
+typedef StaticVector<double> StaticVectorD;
+//! \brief Literal 3-vector with primitive type float
+typedef StaticVector<float> StaticVectorF;
+//! \brief Literal rotation with primitive type double
+typedef StaticRotation<double> StaticRotationD;
+//! \brief Literal rotation with primitive type float
+typedef StaticRotation<float> StaticRotationF;
+//! \brief Literal transform with primitive type double
+typedef StaticTransform<double> StaticTransformD;
+//! \brief Literal transform with primitive type float
+typedef StaticTransform<float> StaticTransformF;
+
+} // namespace kindr
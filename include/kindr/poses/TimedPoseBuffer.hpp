@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <Eigen/Geometry>
+
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/poses/HomogeneousTransformation.hpp"
+
+namespace kindr {
+
+/*! \class TimedPoseBuffer
+ * \brief Fixed-capacity ring of timestamped poses with lock-free interpolated lookup
+ *
+ *  Single-writer/multi-reader time-indexed pose storage for sensor-fusion lookups. Entries
+ *  are stored in contiguous cache-line-aligned slots, each guarded by a per-slot sequence
+ *  counter (seqlock): the writer never blocks, and readers detect a concurrent overwrite of
+ *  the slot they are copying and retry instead of taking a mutex.
+ *
+ *  addPose() must be called from a single thread with monotonically increasing timestamps;
+ *  getPoseAtTime() may be called from any number of reader threads concurrently and returns
+ *  the pose interpolated (linear in position, slerp in orientation) between the two samples
+ *  bracketing the query time, clamped to the oldest/newest sample outside the stored range.
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *  \ingroup poses
+ */
+template<typename PrimType_>
+class TimedPoseBuffer {
+ public:
+  typedef PrimType_ Scalar;
+  typedef HomogeneousTransformationPosition3RotationQuaternion<PrimType_> Pose;
+
+  /*! \brief Constructor
+   *  \param capacity  number of slots in the ring (oldest entries are overwritten)
+   */
+  explicit TimedPoseBuffer(std::size_t capacity)
+    : slots_(capacity),
+      count_(0u) {
+    KINDR_ASSERT_TRUE(std::invalid_argument, capacity >= 2u, "Capacity must be at least two for interpolation.");
+  }
+
+  /*! \brief Returns the number of slots in the ring. */
+  std::size_t getCapacity() const {
+    return slots_.size();
+  }
+
+  /*! \brief Returns the number of stored entries (saturates at the capacity). */
+  std::size_t getSize() const {
+    const uint64_t count = count_.load(std::memory_order_acquire);
+    return count < slots_.size() ? static_cast<std::size_t>(count) : slots_.size();
+  }
+
+  /*! \brief Appends a pose (single writer only).
+   *  \param time  timestamp of the sample, must increase monotonically
+   *  \param pose  pose sample
+   */
+  void addPose(double time, const Pose& pose) {
+    const uint64_t count = count_.load(std::memory_order_relaxed);
+    Slot& slot = slots_[count % slots_.size()];
+    // odd sequence marks the slot as being written
+    const uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1u, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.entry.time = time;
+    for (int k = 0; k < 3; k++) {
+      slot.entry.position[k] = pose.getPosition()(k);
+    }
+    slot.entry.quaternion[0] = pose.getRotation().w();
+    slot.entry.quaternion[1] = pose.getRotation().x();
+    slot.entry.quaternion[2] = pose.getRotation().y();
+    slot.entry.quaternion[3] = pose.getRotation().z();
+    slot.sequence.store(sequence + 2u, std::memory_order_release);
+    count_.store(count + 1u, std::memory_order_release);
+  }
+
+  /*! \brief Looks up the pose at a query time (any reader thread).
+   *
+   *  Binary-searches the stored timestamps and interpolates between the bracketing samples;
+   *  query times outside the stored range are clamped to the oldest/newest sample.
+   *  \param time  query time
+   *  \param pose  interpolated pose is written here
+   *  \returns true if the buffer contained at least one sample
+   */
+  bool getPoseAtTime(double time, Pose& pose) const {
+    while (true) {
+      const uint64_t count = count_.load(std::memory_order_acquire);
+      if (count == 0u) {
+        return false;
+      }
+      // logical indices of the entries that are still in the ring
+      const uint64_t newest = count - 1u;
+      const uint64_t oldest = count > slots_.size() ? count - slots_.size() : 0u;
+
+      Entry newestEntry;
+      if (!readEntry(newest, newestEntry)) {
+        continue;
+      }
+      if (time >= newestEntry.time || newest == oldest) {
+        writePoseFromEntry(newestEntry, pose);
+        return true;
+      }
+      Entry oldestEntry;
+      if (!readEntry(oldest, oldestEntry)) {
+        continue;
+      }
+      if (time <= oldestEntry.time) {
+        writePoseFromEntry(oldestEntry, pose);
+        return true;
+      }
+
+      // invariant: t(lower) <= time < t(upper)
+      uint64_t lower = oldest;
+      uint64_t upper = newest;
+      Entry lowerEntry = oldestEntry;
+      Entry upperEntry = newestEntry;
+      bool restart = false;
+      while (upper - lower > 1u) {
+        const uint64_t middle = lower + (upper - lower)/2u;
+        Entry middleEntry;
+        if (!readEntry(middle, middleEntry)) {
+          restart = true;
+          break;
+        }
+        if (middleEntry.time <= time) {
+          lower = middle;
+          lowerEntry = middleEntry;
+        } else {
+          upper = middle;
+          upperEntry = middleEntry;
+        }
+      }
+      if (restart) {
+        continue;
+      }
+      interpolateEntries(lowerEntry, upperEntry, time, pose);
+      return true;
+    }
+  }
+
+ private:
+  //! trivially copyable payload so a reader can copy it and validate afterwards
+  struct Entry {
+    double time;
+    PrimType_ position[3];
+    //! coefficients ordered (w, x, y, z)
+    PrimType_ quaternion[4];
+  };
+
+  //! cache-line-aligned slot to keep writer and readers from false sharing across entries
+  struct alignas(64) Slot {
+    Slot() : sequence(0u) {}
+    std::atomic<uint64_t> sequence;
+    Entry entry;
+  };
+
+  /*! \brief Copies the entry at a logical index, returning false if a writer interfered. */
+  bool readEntry(uint64_t logicalIndex, Entry& entry) const {
+    const Slot& slot = slots_[logicalIndex % slots_.size()];
+    const uint64_t sequenceBefore = slot.sequence.load(std::memory_order_acquire);
+    if (sequenceBefore & 1u) {
+      return false;
+    }
+    entry = slot.entry;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t sequenceAfter = slot.sequence.load(std::memory_order_relaxed);
+    if (sequenceBefore != sequenceAfter) {
+      return false;
+    }
+    // the slot may meanwhile hold a newer sample than the logical index asked for
+    return count_.load(std::memory_order_acquire) - logicalIndex <= slots_.size();
+  }
+
+  static void writePoseFromEntry(const Entry& entry, Pose& pose) {
+    pose.getPosition() = typename Pose::Position(entry.position[0], entry.position[1], entry.position[2]);
+    pose.getRotation() = typename Pose::Rotation(entry.quaternion[0], entry.quaternion[1], entry.quaternion[2], entry.quaternion[3]);
+  }
+
+  static void interpolateEntries(const Entry& lower, const Entry& upper, double time, Pose& pose) {
+    const PrimType_ alpha = static_cast<PrimType_>((time - lower.time)/(upper.time - lower.time));
+    typename Pose::Position position;
+    for (int k = 0; k < 3; k++) {
+      position(k) = lower.position[k] + alpha*(upper.position[k] - lower.position[k]);
+    }
+    const Eigen::Quaternion<PrimType_> lowerQuat(lower.quaternion[0], lower.quaternion[1], lower.quaternion[2], lower.quaternion[3]);
+    const Eigen::Quaternion<PrimType_> upperQuat(upper.quaternion[0], upper.quaternion[1], upper.quaternion[2], upper.quaternion[3]);
+    pose.getPosition() = position;
+    pose.getRotation() = typename Pose::Rotation(lowerQuat.slerp(alpha, upperQuat));
+  }
+
+  std::vector<Slot> slots_;
+  //! total number of writes; entry i lives in slot i % capacity
+  std::atomic<uint64_t> count_;
+};
+
+typedef TimedPoseBuffer<double> TimedPoseBufferD;
+typedef TimedPoseBuffer<float> TimedPoseBufferF;
+
+} // namespace kindr
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "kindr/poses/Pose.hpp"
+#include "kindr/rotations/Rotation.hpp"
+
+namespace kindr {
+
+/*! \class TransformEngine
+ * \brief Tiled, multithreaded application of one rotation or pose to large point batches.
+ *
+ *  RotationBase::rotate(Matrix3X) hands the whole matrix to a single-threaded Eigen
+ *  product. For millions of points that leaves all but one core idle and streams the
+ *  batch through the cache in one monolithic pass. The engine converts the rotation
+ *  to a matrix once, tiles the batch into blocks sized to stay resident in L2 while
+ *  input and output are streamed together, and fans contiguous block ranges across
+ *  worker threads. Each block is a plain 3x3-times-3xN product, so Eigen's
+ *  vectorization still applies within a tile.
+ *
+ *  Small batches (up to one block) skip the thread fan-out entirely.
+ *
+ *  \tparam PrimType_ the primitive type of the point data (double or float)
+ */
+template<typename PrimType_>
+class TransformEngine {
+ public:
+  typedef PrimType_ Scalar;
+  typedef Eigen::Matrix<PrimType_, 3, Eigen::Dynamic> Matrix3X;
+  typedef Eigen::Matrix<PrimType_, 3, 3> Matrix3;
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+
+  /*! \brief Constructor
+   *  \param numThreads  worker threads to fan blocks across; 0 uses the hardware concurrency
+   *  \param blockSize   points per tile; the default keeps an input and an output tile
+   *                     of doubles together under a 256 KB L2 slice
+   */
+  explicit TransformEngine(std::size_t numThreads = 0, std::size_t blockSize = 4096)
+    : numThreads_(numThreads != 0 ? numThreads : resolveHardwareThreads()),
+      blockSize_(blockSize != 0 ? blockSize : 4096) {
+  }
+
+  std::size_t getNumThreads() const {
+    return numThreads_;
+  }
+
+  std::size_t getBlockSize() const {
+    return blockSize_;
+  }
+
+  /*! \brief Rotates a batch of points into a separate output matrix.
+   *  \param rotation  rotation in any parameterization
+   *  \param points    3xN input points
+   *  \param rotatedPoints  3xN output; resized to match the input
+   */
+  template<typename Rotation_>
+  void rotate(const RotationBase<Rotation_>& rotation, const Matrix3X& points, Matrix3X& rotatedPoints) const {
+    const Matrix3 rotationMatrix = RotationMatrix<PrimType_>(rotation.derived()).matrix();
+    rotatedPoints.resize(3, points.cols());
+    Matrix3X* out = &rotatedPoints;
+    const Matrix3X* in = &points;
+    runTiled(points.cols(), [rotationMatrix, in, out](std::ptrdiff_t begin, std::ptrdiff_t count) {
+      out->middleCols(begin, count).noalias() = rotationMatrix*in->middleCols(begin, count);
+    });
+  }
+
+  /*! \brief Rotates a batch of points in place, one tile at a time. */
+  template<typename Rotation_>
+  void rotateInPlace(const RotationBase<Rotation_>& rotation, Matrix3X& points) const {
+    const Matrix3 rotationMatrix = RotationMatrix<PrimType_>(rotation.derived()).matrix();
+    Matrix3X* data = &points;
+    runTiled(points.cols(), [rotationMatrix, data](std::ptrdiff_t begin, std::ptrdiff_t count) {
+      // per-tile temporary: keeps the in-place variant allocation-bounded by the tile size
+      const Matrix3X rotated = rotationMatrix*data->middleCols(begin, count);
+      data->middleCols(begin, count) = rotated;
+    });
+  }
+
+  /*! \brief Transforms a batch of points through a pose into a separate output matrix.
+   *  \param pose    pose (e.g. a HomogeneousTransformation)
+   *  \param points  3xN input points
+   *  \param transformedPoints  3xN output; resized to match the input
+   */
+  template<typename Pose_>
+  void transform(const PoseBase<Pose_>& pose, const Matrix3X& points, Matrix3X& transformedPoints) const {
+    const Matrix3 rotationMatrix = RotationMatrix<PrimType_>(pose.derived().getRotation()).matrix();
+    const Vector3 translation = pose.derived().getPosition().toImplementation().template cast<PrimType_>();
+    transformedPoints.resize(3, points.cols());
+    Matrix3X* out = &transformedPoints;
+    const Matrix3X* in = &points;
+    runTiled(points.cols(), [rotationMatrix, translation, in, out](std::ptrdiff_t begin, std::ptrdiff_t count) {
+      out->middleCols(begin, count).noalias() = rotationMatrix*in->middleCols(begin, count);
+      out->middleCols(begin, count).colwise() += translation;
+    });
+  }
+
+  /*! \brief Transforms a batch of points through a pose in place. */
+  template<typename Pose_>
+  void transformInPlace(const PoseBase<Pose_>& pose, Matrix3X& points) const {
+    const Matrix3 rotationMatrix = RotationMatrix<PrimType_>(pose.derived().getRotation()).matrix();
+    const Vector3 translation = pose.derived().getPosition().toImplementation().template cast<PrimType_>();
+    Matrix3X* data = &points;
+    runTiled(points.cols(), [rotationMatrix, translation, data](std::ptrdiff_t begin, std::ptrdiff_t count) {
+      const Matrix3X transformed = (rotationMatrix*data->middleCols(begin, count)).colwise() + translation;
+      data->middleCols(begin, count) = transformed;
+    });
+  }
+
+ private:
+  static std::size_t resolveHardwareThreads() {
+    const unsigned int hardware = std::thread::hardware_concurrency();
+    return hardware != 0 ? hardware : 1;
+  }
+
+  /*! \brief Splits [0, numCols) into blockSize_ tiles and fans contiguous tile ranges
+   *         across the workers; each worker walks its range front to back so the
+   *         hardware prefetcher sees a monotone stride.
+   */
+  void runTiled(std::ptrdiff_t numCols, const std::function<void(std::ptrdiff_t, std::ptrdiff_t)>& processBlock) const {
+    const std::ptrdiff_t blockSize = static_cast<std::ptrdiff_t>(blockSize_);
+    if (numCols <= blockSize || numThreads_ == 1) {
+      for (std::ptrdiff_t begin = 0; begin < numCols; begin += blockSize) {
+        processBlock(begin, std::min(blockSize, numCols - begin));
+      }
+      return;
+    }
+
+    const std::ptrdiff_t numBlocks = (numCols + blockSize - 1)/blockSize;
+    const std::size_t numWorkers = std::min(numThreads_, static_cast<std::size_t>(numBlocks));
+    const std::ptrdiff_t blocksPerWorker = (numBlocks + static_cast<std::ptrdiff_t>(numWorkers) - 1)/static_cast<std::ptrdiff_t>(numWorkers);
+
+    std::vector<std::thread> workers;
+    workers.reserve(numWorkers);
+    for (std::size_t worker = 0; worker < numWorkers; worker++) {
+      const std::ptrdiff_t firstBlock = static_cast<std::ptrdiff_t>(worker)*blocksPerWorker;
+      const std::ptrdiff_t endBlock = std::min(firstBlock + blocksPerWorker, numBlocks);
+      if (firstBlock >= endBlock) {
+        break;
+      }
+      workers.push_back(std::thread([firstBlock, endBlock, blockSize, numCols, &processBlock]() {
+        for (std::ptrdiff_t block = firstBlock; block < endBlock; block++) {
+          const std::ptrdiff_t begin = block*blockSize;
+          processBlock(begin, std::min(blockSize, numCols - begin));
+        }
+      }));
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  }
+
+  std::size_t numThreads_;
+  std::size_t blockSize_;
+};
+
+//! \brief Transform engine with primitive type double
+typedef TransformEngine<double> TransformEngineD;
+//! \brief Transform engine with primitive type float
+typedef TransformEngine<float> TransformEngineF;
+
+} // namespace kindr
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/poses/Pose.hpp"
+
+namespace kindr {
+
+/*! \class TransformTree
+ * \brief Tree of coordinate frames with lock-free snapshot reads.
+ *
+ *  Holds pairwise parent-child transformations (e.g. sensors, links, world) in
+ *  contiguous storage and composes lookups like T_cam_world on demand. Edge
+ *  updates are serialized internally and published through an epoch counter in
+ *  seqlock fashion, so readers never take a lock: they retry the (cheap) copy
+ *  of the edge table if a writer interleaved. Repeated queries should go
+ *  through a Snapshot, which keeps the flattened frame-to-root compositions
+ *  cached; the cache stays valid for the lifetime of the snapshot, and
+ *  isCurrent() tells cheaply whether any edge has changed since it was taken.
+ *
+ *  The frame structure (addFrame) must be set up before concurrent use;
+ *  only the edge poses (setEdge) may change afterwards.
+ *
+ *  \tparam PrimType_ the primitive type of the transformations (double or float)
+ *  \ingroup poses
+ */
+template<typename PrimType_>
+class TransformTree {
+ public:
+  typedef PrimType_ Scalar;
+  typedef HomogeneousTransformation<PrimType_, Position<PrimType_, 3>, RotationQuaternion<PrimType_>> Pose;
+  typedef std::size_t FrameId;
+
+  //! Parent id of the root frame
+  static constexpr FrameId kNoParent = static_cast<FrameId>(-1);
+
+  /*! \brief Flattened edge storage: position and quaternion coefficients of one parent-child transformation. */
+  struct EdgeData {
+    Scalar positionX, positionY, positionZ;
+    Scalar quaternionW, quaternionX, quaternionY, quaternionZ;
+  };
+
+  /*! \class Snapshot
+   * \brief Consistent copy of all edges, taken without locking.
+   *
+   *  Lookups lazily compose and cache the frame-to-root transformations, so
+   *  repeated queries against the same snapshot recompose nothing.
+   */
+  class Snapshot {
+   public:
+    /*! \brief Returns the transformation that maps points from one frame into another.
+     *  \param from   frame the points are expressed in
+     *  \param to     frame to express the points in
+     *  \returns pose T_to_from with p_to = T_to_from.transform(p_from)
+     */
+    Pose getTransform(FrameId from, FrameId to) const {
+      const Pose poseRootFrom = getTransformToRoot(from);
+      const Pose poseRootTo = getTransformToRoot(to);
+      // T_to_from = T_root_to^-1 * T_root_from
+      const typename Pose::Rotation rotationToRoot = poseRootTo.getRotation().inverted();
+      return Pose(typename Pose::Position(rotationToRoot.rotate(poseRootFrom.getPosition() - poseRootTo.getPosition())),
+                  typename Pose::Rotation(rotationToRoot*poseRootFrom.getRotation()));
+    }
+
+    /*! \brief Returns the cached transformation from a frame to the root frame.
+     *  \param frame   frame id
+     *  \returns pose T_root_frame
+     */
+    Pose getTransformToRoot(FrameId frame) const {
+      KINDR_ASSERT_TRUE(std::runtime_error, frame < tree_->parents_.size(), "Unknown frame id.");
+      if (!cacheValid_[frame]) {
+        const FrameId parent = tree_->parents_[frame];
+        const Pose poseParentFrame = toPose(edges_[frame]);
+        if (parent == kNoParent) {
+          cache_[frame] = poseParentFrame;
+        } else {
+          cache_[frame] = getTransformToRoot(parent)*poseParentFrame;
+        }
+        cacheValid_[frame] = true;
+      }
+      return cache_[frame];
+    }
+
+    /*! \brief Returns true if no edge has changed since the snapshot was taken. */
+    bool isCurrent() const {
+      return tree_->epoch_.load(std::memory_order_acquire) == epoch_;
+    }
+
+   private:
+    friend class TransformTree;
+
+    explicit Snapshot(const TransformTree& tree)
+      : tree_(&tree), cache_(tree.parents_.size()), cacheValid_(tree.parents_.size(), false) {
+      // seqlock read: retry until the edge table was copied without an interleaved writer
+      while (true) {
+        epoch_ = tree.epoch_.load(std::memory_order_acquire);
+        if (epoch_ % 2u != 0u) {
+          continue; // writer in progress
+        }
+        edges_ = tree.edges_;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (tree.epoch_.load(std::memory_order_acquire) == epoch_) {
+          break;
+        }
+      }
+    }
+
+    const TransformTree* tree_;
+    std::vector<EdgeData> edges_;
+    std::uint64_t epoch_;
+    mutable std::vector<Pose> cache_;
+    mutable std::vector<char> cacheValid_;
+  };
+
+  TransformTree() : epoch_(0u) {
+  }
+
+  /*! \brief Adds a frame to the tree (not thread-safe, setup only).
+   *  \param name             frame name for lookup by getFrameId()
+   *  \param parent           id of the parent frame, or kNoParent for the root
+   *  \param poseParentChild  transformation of the new frame relative to its parent
+   *  \returns id of the new frame
+   */
+  FrameId addFrame(const std::string& name, FrameId parent = kNoParent, const Pose& poseParentChild = Pose()) {
+    KINDR_ASSERT_TRUE(std::runtime_error, parent == kNoParent || parent < parents_.size(), "Unknown parent frame id.");
+    names_.push_back(name);
+    parents_.push_back(parent);
+    edges_.push_back(toEdgeData(poseParentChild));
+    return parents_.size() - 1u;
+  }
+
+  /*! \brief Returns the id of a frame by name.
+   *  \param name   frame name
+   *  \returns frame id
+   */
+  FrameId getFrameId(const std::string& name) const {
+    for (FrameId id = 0u; id < names_.size(); id++) {
+      if (names_[id] == name) {
+        return id;
+      }
+    }
+    KINDR_THROW(std::runtime_error, "Unknown frame name.");
+    return kNoParent;
+  }
+
+  std::size_t getNumFrames() const {
+    return parents_.size();
+  }
+
+  /*! \brief Updates the transformation between a frame and its parent.
+   *
+   *  Writers are serialized internally; readers observe the update lock-free
+   *  through the epoch counter.
+   *  \param frame            frame whose edge to its parent changes
+   *  \param poseParentChild  new transformation of the frame relative to its parent
+   */
+  void setEdge(FrameId frame, const Pose& poseParentChild) {
+    KINDR_ASSERT_TRUE(std::runtime_error, frame < parents_.size(), "Unknown frame id.");
+    const EdgeData data = toEdgeData(poseParentChild);
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    epoch_.fetch_add(1u, std::memory_order_acquire); // odd: write in progress
+    std::atomic_thread_fence(std::memory_order_release);
+    edges_[frame] = data;
+    std::atomic_thread_fence(std::memory_order_release);
+    epoch_.fetch_add(1u, std::memory_order_release); // even: consistent again
+  }
+
+  /*! \brief Takes a consistent lock-free snapshot of all edges for repeated queries. */
+  Snapshot snapshot() const {
+    return Snapshot(*this);
+  }
+
+  /*! \brief One-shot lookup; takes a fresh snapshot internally.
+   *
+   *  For repeated queries at the same state prefer snapshot(), which caches
+   *  the composed frame-to-root transformations across lookups.
+   *  \param from   frame the points are expressed in
+   *  \param to     frame to express the points in
+   *  \returns pose T_to_from
+   */
+  Pose getTransform(FrameId from, FrameId to) const {
+    return snapshot().getTransform(from, to);
+  }
+
+ private:
+  static EdgeData toEdgeData(const Pose& pose) {
+    EdgeData data;
+    data.positionX = pose.getPosition().x();
+    data.positionY = pose.getPosition().y();
+    data.positionZ = pose.getPosition().z();
+    data.quaternionW = pose.getRotation().w();
+    data.quaternionX = pose.getRotation().x();
+    data.quaternionY = pose.getRotation().y();
+    data.quaternionZ = pose.getRotation().z();
+    return data;
+  }
+
+  static Pose toPose(const EdgeData& data) {
+    return Pose(typename Pose::Position(data.positionX, data.positionY, data.positionZ),
+                typename Pose::Rotation(trusted, data.quaternionW, data.quaternionX, data.quaternionY, data.quaternionZ));
+  }
+
+  std::vector<std::string> names_;
+  std::vector<FrameId> parents_;
+  std::vector<EdgeData> edges_;
+  std::atomic<std::uint64_t> epoch_;
+  std::mutex writeMutex_;
+};
+
+template<typename PrimType_>
+constexpr typename TransformTree<PrimType_>::FrameId TransformTree<PrimType_>::kNoParent;
+
+typedef TransformTree<double> TransformTreeD;
+typedef TransformTree<float> TransformTreeF;
+
+} // namespace kindr
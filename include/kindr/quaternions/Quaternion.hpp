@@ -319,6 +319,18 @@ class UnitQuaternion : public UnitQuaternionBase<UnitQuaternion<PrimType_>> {
     KINDR_ASSERT_SCALAR_NEAR_DBG(std::runtime_error, norm(), static_cast<Scalar>(1.0), static_cast<Scalar>(1e-2), "Input quaternion has not unit length.");
   }
 
+  /*! \brief Constructor using four scalars which skips the unit-length validation,
+   *  also in debug builds. Only pass kindr::trusted if the quaternion is unit by
+   *  construction.
+   *  \param   w   scalar
+   *  \param   x   vector index 1
+   *  \param   y   vector index 2
+   *  \param   z   vector index 3
+   */
+  UnitQuaternion(trusted_t, Scalar w, Scalar x, Scalar y, Scalar z)
+    : unitQuternion_(w,x,y,z) {
+  }
+
   /*! \brief Constructor using real and imaginary part.
    *  In debug mode, an assertion is thrown if the quaternion has not unit length.
    *  \param real   real part (PrimType_)
@@ -131,6 +131,7 @@ class AngleAxis : public RotationBase<AngleAxis<PrimType_>> {
   template<typename OtherDerived_>
   inline explicit AngleAxis(const RotationBase<OtherDerived_>& other)
     : angleAxis_(internal::ConversionTraits<AngleAxis, OtherDerived_>::convert(other.derived()).toImplementation()) {
+    KINDR_COUNT_CONVERSION(AngleAxis, OtherDerived_);
   }
 
   /*! \brief Assignment operator using another rotation.
@@ -139,6 +140,7 @@ class AngleAxis : public RotationBase<AngleAxis<PrimType_>> {
    */
   template<typename OtherDerived_>
   AngleAxis& operator =(const RotationBase<OtherDerived_>& other) {
+    KINDR_COUNT_CONVERSION(AngleAxis, OtherDerived_);
     this->toImplementation() = internal::ConversionTraits<AngleAxis, OtherDerived_>::convert(other.derived()).toImplementation();
     return *this;
   }
@@ -149,6 +151,7 @@ class AngleAxis : public RotationBase<AngleAxis<PrimType_>> {
    */
   template<typename OtherDerived_>
   AngleAxis& operator ()(const RotationBase<OtherDerived_>& other) {
+    KINDR_COUNT_CONVERSION(AngleAxis, OtherDerived_);
     this->toImplementation() = internal::ConversionTraits<AngleAxis, OtherDerived_>::convert(other.derived()).toImplementation();
     return *this;
   }
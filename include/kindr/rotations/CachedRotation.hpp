@@ -0,0 +1,323 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <Eigen/Geometry>
+
+#include "kindr/rotations/Rotation.hpp"
+
+namespace kindr {
+
+/*! \class CachedRotation
+ * \brief Rotation stored as a quaternion with a lazily cached matrix form.
+ *
+ *  The rotation is represented by a rotation quaternion, and the equivalent 3x3 matrix is
+ *  computed at most once per update: the first rotate() after a modification converts the
+ *  quaternion and caches the result, and every further rotate() reuses the cached matrix.
+ *  This pays the conversion cost once per update instead of once per use when the same
+ *  rotation is queried repeatedly (e.g. by render and physics code within one frame).
+ *
+ *  The cache is not synchronized; concurrent readers must fill it first by calling
+ *  getCachedRotationMatrix() before the rotation is shared.
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+class CachedRotation : public RotationBase<CachedRotation<PrimType_>> {
+ public:
+  //! The primitive type.
+  typedef PrimType_ Scalar;
+  //! The rotation that stores the parameters.
+  typedef RotationQuaternion<PrimType_> Rotation;
+  //! The cached matrix type.
+  typedef Eigen::Matrix<PrimType_, 3, 3> Matrix3;
+
+  /*! \brief Default constructor using identity rotation.
+   */
+  CachedRotation()
+    : rotationQuaternion_(),
+      rotationMatrix_(Matrix3::Identity()),
+      matrixDirty_(false) {
+  }
+
+  /*! \brief Constructor using a rotation quaternion.
+   *  \param rotation  rotation quaternion
+   */
+  explicit CachedRotation(const Rotation& rotation)
+    : rotationQuaternion_(rotation),
+      matrixDirty_(true) {
+  }
+
+  /*! \brief Constructor using another rotation.
+   *  \param other  other rotation
+   */
+  template<typename OtherDerived_>
+  inline explicit CachedRotation(const RotationBase<OtherDerived_>& other)
+    : rotationQuaternion_(other.derived()),
+      matrixDirty_(true) {
+  }
+
+  /*! \brief Assignment operator using another rotation.
+   *  \param other  other rotation
+   *  \returns reference
+   */
+  template<typename OtherDerived_>
+  CachedRotation& operator =(const RotationBase<OtherDerived_>& other) {
+    this->setRotationQuaternion(Rotation(other.derived()));
+    return *this;
+  }
+
+  /*! \brief Returns the stored rotation quaternion.
+   *  \returns rotation quaternion
+   */
+  const Rotation& getRotationQuaternion() const {
+    return rotationQuaternion_;
+  }
+
+  /*! \brief Sets the rotation and invalidates the cached matrix.
+   *  \param rotation  rotation quaternion
+   */
+  void setRotationQuaternion(const Rotation& rotation) {
+    rotationQuaternion_ = rotation;
+    matrixDirty_ = true;
+  }
+
+  /*! \brief Returns the equivalent rotation matrix, converting and caching it on first use.
+   *  \returns cached rotation matrix
+   */
+  const Matrix3& getCachedRotationMatrix() const {
+    if (matrixDirty_) {
+      rotationMatrix_ = rotationQuaternion_.toImplementation().toRotationMatrix();
+      matrixDirty_ = false;
+    }
+    return rotationMatrix_;
+  }
+
+  /*! \brief Returns true if the matrix cache is up to date (for tests and diagnostics).
+   */
+  bool isMatrixCached() const {
+    return !matrixDirty_;
+  }
+
+  /*! \brief Returns the inverse of the rotation.
+   *
+   *  A valid matrix cache is carried over by transposition instead of being recomputed.
+   *  \returns the inverse of the rotation
+   */
+  CachedRotation inverted() const {
+    CachedRotation inverse(rotationQuaternion_.inverted());
+    if (!matrixDirty_) {
+      inverse.rotationMatrix_ = rotationMatrix_.transpose();
+      inverse.matrixDirty_ = false;
+    }
+    return inverse;
+  }
+
+  /*! \brief Inverts the rotation.
+   *  \returns reference
+   */
+  CachedRotation& invert() {
+    *this = this->inverted();
+    return *this;
+  }
+
+  /*! \brief Sets the rotation to identity.
+   *  \returns reference
+   */
+  CachedRotation& setIdentity() {
+    rotationQuaternion_.setIdentity();
+    rotationMatrix_.setIdentity();
+    matrixDirty_ = false;
+    return *this;
+  }
+
+  /*! \brief Returns the rotation in a unique form.
+   *
+   *  The quaternions q and -q map to the same matrix, so a valid cache stays valid.
+   *  \returns copy of the rotation which is unique
+   */
+  CachedRotation getUnique() const {
+    CachedRotation unique(*this);
+    unique.rotationQuaternion_ = rotationQuaternion_.getUnique();
+    return unique;
+  }
+
+  /*! \brief Modifies the rotation such that it is in its unique form.
+   *  \returns reference
+   */
+  CachedRotation& setUnique() {
+    rotationQuaternion_.setUnique();
+    return *this;
+  }
+
+  /*! \brief Used for printing the object with std::cout.
+   *  \returns std::stream object
+   */
+  friend std::ostream& operator << (std::ostream& out, const CachedRotation& rotation) {
+    out << rotation.getRotationQuaternion();
+    return out;
+  }
+
+ private:
+  Rotation rotationQuaternion_;
+  //! Lazily computed matrix form of rotationQuaternion_, valid while matrixDirty_ is false.
+  mutable Matrix3 rotationMatrix_;
+  mutable bool matrixDirty_;
+};
+
+//! \brief Cached rotation with primitive type double
+typedef CachedRotation<double> CachedRotationD;
+//! \brief Cached rotation with primitive type float
+typedef CachedRotation<float> CachedRotationF;
+
+
+namespace internal {
+
+template<typename PrimType_>
+class get_scalar<CachedRotation<PrimType_>> {
+ public:
+  typedef PrimType_ Scalar;
+};
+
+template<typename PrimType_>
+class get_matrix3X<CachedRotation<PrimType_>> {
+ public:
+  typedef int IndexType;
+  template <IndexType Cols>
+  using Matrix3X = Eigen::Matrix<PrimType_, 3, Cols>;
+};
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Conversion Traits
+ * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+//! All conversions route through the stored rotation quaternion.
+template<typename DestRotation_, typename SourcePrimType_>
+class ConversionTraits<DestRotation_, CachedRotation<SourcePrimType_>> {
+ public:
+  inline static DestRotation_ convert(const CachedRotation<SourcePrimType_>& cached) {
+    return DestRotation_(cached.getRotationQuaternion());
+  }
+};
+
+//! Disambiguates against the generic RotationVector conversion.
+template<typename DestPrimType_, typename SourcePrimType_>
+class ConversionTraits<RotationVector<DestPrimType_>, CachedRotation<SourcePrimType_>> {
+ public:
+  inline static RotationVector<DestPrimType_> convert(const CachedRotation<SourcePrimType_>& cached) {
+    return RotationVector<DestPrimType_>(cached.getRotationQuaternion());
+  }
+};
+
+template<typename DestPrimType_, typename SourceRotation_>
+class ConversionTraits<CachedRotation<DestPrimType_>, SourceRotation_> {
+ public:
+  inline static CachedRotation<DestPrimType_> convert(const SourceRotation_& rotation) {
+    return CachedRotation<DestPrimType_>(RotationQuaternion<DestPrimType_>(rotation));
+  }
+};
+
+template<typename DestPrimType_, typename SourcePrimType_>
+class ConversionTraits<CachedRotation<DestPrimType_>, CachedRotation<SourcePrimType_>> {
+ public:
+  inline static CachedRotation<DestPrimType_> convert(const CachedRotation<SourcePrimType_>& cached) {
+    return CachedRotation<DestPrimType_>(RotationQuaternion<DestPrimType_>(cached.getRotationQuaternion()));
+  }
+};
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Rotation Traits
+ * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+//! Rotates with the cached matrix instead of converting on every call.
+template<typename PrimType_>
+class RotationTraits<RotationBase<CachedRotation<PrimType_>>> {
+ public:
+  template<typename get_matrix3X<CachedRotation<PrimType_>>::IndexType Cols>
+  inline static typename get_matrix3X<CachedRotation<PrimType_>>::template Matrix3X<Cols> rotate(const CachedRotation<PrimType_>& rotation, const typename get_matrix3X<CachedRotation<PrimType_>>::template Matrix3X<Cols>& m) {
+    return rotation.getCachedRotationMatrix()*m;
+  }
+  template<typename Vector_>
+  inline static Vector_ rotate(const CachedRotation<PrimType_>& rotation, const Vector_& vector) {
+    return static_cast<Vector_>(rotation.getCachedRotationMatrix()*vector.toImplementation());
+  }
+  template<typename get_matrix3X<CachedRotation<PrimType_>>::IndexType Cols>
+  inline static typename get_matrix3X<CachedRotation<PrimType_>>::template Matrix3X<Cols> inverseRotate(const CachedRotation<PrimType_>& rotation, const typename get_matrix3X<CachedRotation<PrimType_>>::template Matrix3X<Cols>& m) {
+    return rotation.getCachedRotationMatrix().transpose()*m;
+  }
+  template<typename Vector_>
+  inline static Vector_ inverseRotate(const CachedRotation<PrimType_>& rotation, const Vector_& vector) {
+    return static_cast<Vector_>(rotation.getCachedRotationMatrix().transpose()*vector.toImplementation());
+  }
+  template<typename get_matrix3X<CachedRotation<PrimType_>>::IndexType Cols>
+  inline static void rotate(const CachedRotation<PrimType_>& rotation, const typename get_matrix3X<CachedRotation<PrimType_>>::template Matrix3X<Cols>& in, typename get_matrix3X<CachedRotation<PrimType_>>::template Matrix3X<Cols>& out) {
+    out.resize(3, in.cols());
+    out.noalias() = rotation.getCachedRotationMatrix()*in;
+  }
+  template<typename get_matrix3X<CachedRotation<PrimType_>>::IndexType Cols>
+  inline static void rotateInPlace(const CachedRotation<PrimType_>& rotation, typename get_matrix3X<CachedRotation<PrimType_>>::template Matrix3X<Cols>& m) {
+    for (typename get_matrix3X<CachedRotation<PrimType_>>::IndexType i = 0; i < m.cols(); ++i) {
+      m.col(i) = rotation.getCachedRotationMatrix()*m.col(i);
+    }
+  }
+  template<typename get_matrix3X<CachedRotation<PrimType_>>::IndexType Cols>
+  inline static void inverseRotate(const CachedRotation<PrimType_>& rotation, const typename get_matrix3X<CachedRotation<PrimType_>>::template Matrix3X<Cols>& in, typename get_matrix3X<CachedRotation<PrimType_>>::template Matrix3X<Cols>& out) {
+    out.resize(3, in.cols());
+    out.noalias() = rotation.getCachedRotationMatrix().transpose()*in;
+  }
+  template<typename get_matrix3X<CachedRotation<PrimType_>>::IndexType Cols>
+  inline static void inverseRotateInPlace(const CachedRotation<PrimType_>& rotation, typename get_matrix3X<CachedRotation<PrimType_>>::template Matrix3X<Cols>& m) {
+    for (typename get_matrix3X<CachedRotation<PrimType_>>::IndexType i = 0; i < m.cols(); ++i) {
+      m.col(i) = rotation.getCachedRotationMatrix().transpose()*m.col(i);
+    }
+  }
+};
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Fixing Traits
+ * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+template<typename PrimType_>
+class FixingTraits<CachedRotation<PrimType_>> {
+ public:
+  inline static void fix(CachedRotation<PrimType_>& rotation) {
+    RotationQuaternion<PrimType_> quaternion = rotation.getRotationQuaternion();
+    quaternion.fix();
+    rotation.setRotationQuaternion(quaternion);
+  }
+  inline static void fixFast(CachedRotation<PrimType_>& rotation) {
+    RotationQuaternion<PrimType_> quaternion = rotation.getRotationQuaternion();
+    quaternion.fixFast();
+    rotation.setRotationQuaternion(quaternion);
+  }
+};
+
+} // namespace internal
+} // namespace kindr
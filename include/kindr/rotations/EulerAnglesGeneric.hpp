@@ -0,0 +1,316 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <cmath>
+#include <limits>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "kindr/common/common.hpp"
+#include "kindr/rotations/Rotation.hpp"
+
+namespace kindr {
+
+//! \brief Rotation axis used as compile-time parameter of EulerAnglesGeneric
+enum class RotationAxis {
+  X = 0,
+  Y = 1,
+  Z = 2
+};
+
+namespace internal {
+
+/*! \brief Compile-time helpers shared by the generic Euler angle sequences.
+ *  (only for advanced users)
+ */
+struct EulerSequenceHelper {
+  //! True if (first, second, third) is an even (cyclic) permutation of (X, Y, Z)
+  static constexpr bool isEvenPermutation(int first, int second, int third) {
+    return (first == 0 && second == 1 && third == 2)
+        || (first == 1 && second == 2 && third == 0)
+        || (first == 2 && second == 0 && third == 1);
+  }
+
+  //! The axis not contained in {first, second}
+  static constexpr int remainingAxis(int first, int second) {
+    return 3 - first - second;
+  }
+};
+
+} // namespace internal
+
+/*! \class EulerAnglesGeneric
+ * \brief Euler angles with an arbitrary compile-time axis sequence.
+ *
+ *  Generalizes EulerAnglesXyz and EulerAnglesZyx to all 12 intrinsic axis
+ *  sequences: the six Tait-Bryan orders (all axes distinct) and the six
+ *  proper Euler orders (first axis repeated, e.g. ZXZ or YXY as reported by
+ *  gimbal hardware). The rotation is the concatenation of elementary
+ *  rotations about the body-fixed axes, first angle applied first, matching
+ *  the convention of the hand-written classes: EulerAnglesGeneric with the
+ *  sequence Z, Y, X equals EulerAnglesZyx. Conversions to and from the
+ *  rotation matrix and quaternion are generated in closed form from the
+ *  compile-time axis indices — no intermediate representation and the same
+ *  trigonometric cost as the hand-written classes.
+ *
+ *  \tparam Axis1_     axis of the first elementary rotation
+ *  \tparam Axis2_     axis of the second elementary rotation (must differ from the first)
+ *  \tparam Axis3_     axis of the third elementary rotation (must differ from the second)
+ *  \tparam PrimType_  the primitive type of the data (double or float)
+ *  \ingroup rotations
+ */
+template<RotationAxis Axis1_, RotationAxis Axis2_, RotationAxis Axis3_, typename PrimType_>
+class EulerAnglesGeneric {
+ private:
+  //! Numeric axis indices of the sequence
+  static constexpr int First = static_cast<int>(Axis1_);
+  static constexpr int Second = static_cast<int>(Axis2_);
+  static constexpr int Third = static_cast<int>(Axis3_);
+
+  static_assert(First != Second && Second != Third,
+                "Consecutive rotation axes of an Euler sequence must differ.");
+
+  //! True for the six proper Euler sequences (first axis repeated)
+  static constexpr bool IsProperEuler = (First == Third);
+
+ public:
+  /*! \brief The primitive type.
+   *  Float/Double
+   */
+  typedef PrimType_ Scalar;
+
+  //! The base type (storage of the three angles)
+  typedef Eigen::Matrix<PrimType_, 3, 1> Base;
+
+  /*! \brief Default constructor initializing all angles with zero.
+   */
+  EulerAnglesGeneric()
+    : angles_(Base::Zero()) {
+  }
+
+  /*! \brief Constructor using three scalars.
+   *  \param angle1   angle of the first elementary rotation
+   *  \param angle2   angle of the second elementary rotation
+   *  \param angle3   angle of the third elementary rotation
+   */
+  EulerAnglesGeneric(Scalar angle1, Scalar angle2, Scalar angle3)
+    : angles_(angle1, angle2, angle3) {
+  }
+
+  /*! \brief Constructor using Eigen::Matrix.
+   *  \param angles   vector with the three angles in rotation order
+   */
+  explicit EulerAnglesGeneric(const Base& angles)
+    : angles_(angles) {
+  }
+
+  /*! \brief Constructor using another rotation (closed-form extraction).
+   *  \param other   rotation in any kindr parameterization
+   */
+  template<typename OtherDerived_>
+  explicit EulerAnglesGeneric(const RotationBase<OtherDerived_>& other) {
+    this->setFromRotationMatrix(RotationMatrix<PrimType_>(other.derived()).matrix());
+  }
+
+  /*! \brief Gets the angle of the first elementary rotation.
+   *  \returns angle
+   */
+  Scalar angle1() const {
+    return angles_(0);
+  }
+
+  /*! \brief Gets the angle of the second elementary rotation.
+   *  \returns angle
+   */
+  Scalar angle2() const {
+    return angles_(1);
+  }
+
+  /*! \brief Gets the angle of the third elementary rotation.
+   *  \returns angle
+   */
+  Scalar angle3() const {
+    return angles_(2);
+  }
+
+  /*! \brief Cast to the storage type.
+   *  \returns vector with the three angles in rotation order
+   */
+  const Base& toImplementation() const {
+    return angles_;
+  }
+
+  /*! \brief Cast to the storage type.
+   *  \returns vector with the three angles in rotation order
+   */
+  Base& toImplementation() {
+    return angles_;
+  }
+
+  /*! \brief Sets the angles to zero.
+   *  \returns reference
+   */
+  EulerAnglesGeneric& setIdentity() {
+    angles_.setZero();
+    return *this;
+  }
+
+  /*! \brief Converts to a rotation quaternion by composing the three elementary quaternions.
+   *  \returns rotation quaternion
+   */
+  RotationQuaternion<PrimType_> getRotationQuaternion() const {
+    return RotationQuaternion<PrimType_>(
+        elementaryQuaternion(First, angles_(0))
+        *elementaryQuaternion(Second, angles_(1))
+        *elementaryQuaternion(Third, angles_(2)));
+  }
+
+  /*! \brief Converts to a rotation matrix by composing the three elementary rotations.
+   *  \returns rotation matrix
+   */
+  RotationMatrix<PrimType_> getRotationMatrix() const {
+    return RotationMatrix<PrimType_>(
+        Eigen::Matrix<PrimType_, 3, 3>(elementaryMatrix(First, angles_(0))
+                                       *elementaryMatrix(Second, angles_(1))
+                                       *elementaryMatrix(Third, angles_(2))));
+  }
+
+  /*! \brief Sets the angles from a rotation in any kindr parameterization.
+   *  \param other   rotation the angles are extracted from
+   *  \returns reference
+   */
+  template<typename OtherDerived_>
+  EulerAnglesGeneric& setFromRotation(const RotationBase<OtherDerived_>& other) {
+    this->setFromRotationMatrix(RotationMatrix<PrimType_>(other.derived()).matrix());
+    return *this;
+  }
+
+  /*! \brief Sets the angles from a rotation matrix (closed-form extraction).
+   *
+   *  Near the degenerate configuration of the sequence (second angle at
+   *  +-pi/2 for Tait-Bryan orders, 0 or pi for proper Euler orders) only the
+   *  sum or difference of the outer angles is observable; the third angle is
+   *  set to zero there.
+   *  \param rotationMatrix   matrix the angles are extracted from
+   *  \returns reference
+   */
+  EulerAnglesGeneric& setFromRotationMatrix(const Eigen::Matrix<PrimType_, 3, 3>& rotationMatrix) {
+    extract(rotationMatrix);
+    return *this;
+  }
+
+  /*! \brief Used for printing the object with std::cout.
+   *  \returns std::stream object
+   */
+  friend std::ostream& operator << (std::ostream& out, const EulerAnglesGeneric& eulerAngles) {
+    out << eulerAngles.toImplementation().transpose();
+    return out;
+  }
+
+ private:
+  //! Elementary rotation quaternion about a coordinate axis
+  static Eigen::Quaternion<PrimType_> elementaryQuaternion(int axis, Scalar angle) {
+    Eigen::Quaternion<PrimType_> quaternion(std::cos(angle/Scalar(2)), Scalar(0), Scalar(0), Scalar(0));
+    quaternion.vec()(axis) = std::sin(angle/Scalar(2));
+    return quaternion;
+  }
+
+  //! Elementary rotation matrix about a coordinate axis
+  static Eigen::Matrix<PrimType_, 3, 3> elementaryMatrix(int axis, Scalar angle) {
+    const Scalar sine = std::sin(angle);
+    const Scalar cosine = std::cos(angle);
+    const int u = (axis + 1) % 3;
+    const int v = (axis + 2) % 3;
+    Eigen::Matrix<PrimType_, 3, 3> matrix = Eigen::Matrix<PrimType_, 3, 3>::Zero();
+    matrix(axis, axis) = Scalar(1);
+    matrix(u, u) = cosine;
+    matrix(v, v) = cosine;
+    matrix(u, v) = -sine;
+    matrix(v, u) = sine;
+    return matrix;
+  }
+
+  //! Angle of an elementary rotation about the given axis from its matrix
+  static Scalar elementaryAngle(const Eigen::Matrix<PrimType_, 3, 3>& matrix, int axis) {
+    const int u = (axis + 1) % 3;
+    const int v = (axis + 2) % 3;
+    return std::atan2(matrix(v, u), matrix(u, u));
+  }
+
+  //! Closed-form angle extraction for the sequence
+  void extract(const Eigen::Matrix<PrimType_, 3, 3>& rotationMatrix) {
+    const Scalar degeneracyTolerance = Scalar(1) - Scalar(10)*std::numeric_limits<Scalar>::epsilon();
+    if (IsProperEuler) {
+      const int unused = internal::EulerSequenceHelper::remainingAxis(First, Second);
+      const Scalar sign = internal::EulerSequenceHelper::isEvenPermutation(First, Second, unused) ? Scalar(1) : Scalar(-1);
+      const Scalar cosine2 = rotationMatrix(First, First);
+      if (std::fabs(cosine2) >= degeneracyTolerance) {
+        // second angle at 0 or pi: peel the second rotation off and read the first
+        angles_(1) = (cosine2 > Scalar(0)) ? Scalar(0) : Scalar(M_PI);
+        angles_(2) = Scalar(0);
+        const Eigen::Matrix<PrimType_, 3, 3> residual = rotationMatrix*elementaryMatrix(Second, angles_(1)).transpose();
+        angles_(0) = elementaryAngle(residual, First);
+      } else {
+        angles_(1) = std::acos(cosine2);
+        angles_(0) = std::atan2(rotationMatrix(Second, First), -sign*rotationMatrix(unused, First));
+        angles_(2) = std::atan2(rotationMatrix(First, Second), sign*rotationMatrix(First, unused));
+      }
+    } else {
+      const Scalar sign = internal::EulerSequenceHelper::isEvenPermutation(First, Second, Third) ? Scalar(1) : Scalar(-1);
+      const Scalar sine2 = sign*rotationMatrix(First, Third);
+      if (std::fabs(sine2) >= degeneracyTolerance) {
+        // second angle at +-pi/2: peel the second rotation off and read the first
+        angles_(1) = (sine2 > Scalar(0)) ? Scalar(M_PI/2.0) : Scalar(-M_PI/2.0);
+        angles_(2) = Scalar(0);
+        const Eigen::Matrix<PrimType_, 3, 3> residual = rotationMatrix*elementaryMatrix(Second, angles_(1)).transpose();
+        angles_(0) = elementaryAngle(residual, First);
+      } else {
+        angles_(1) = std::asin(sine2);
+        angles_(0) = std::atan2(-sign*rotationMatrix(Second, Third), rotationMatrix(Third, Third));
+        angles_(2) = std::atan2(-sign*rotationMatrix(First, Second), rotationMatrix(First, First));
+      }
+    }
+  }
+
+  //! The three angles in rotation order
+  Base angles_;
+};
+
+//! \brief Proper Euler angles with the sequence ZXZ and primitive type double
+typedef EulerAnglesGeneric<RotationAxis::Z, RotationAxis::X, RotationAxis::Z, double> EulerAnglesZxzD;
+//! \brief Proper Euler angles with the sequence ZXZ and primitive type float
+typedef EulerAnglesGeneric<RotationAxis::Z, RotationAxis::X, RotationAxis::Z, float> EulerAnglesZxzF;
+//! \brief Proper Euler angles with the sequence YXY and primitive type double
+typedef EulerAnglesGeneric<RotationAxis::Y, RotationAxis::X, RotationAxis::Y, double> EulerAnglesYxyD;
+//! \brief Proper Euler angles with the sequence YXY and primitive type float
+typedef EulerAnglesGeneric<RotationAxis::Y, RotationAxis::X, RotationAxis::Y, float> EulerAnglesYxyF;
+
+} // namespace kindr
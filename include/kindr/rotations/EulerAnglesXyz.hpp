@@ -105,6 +105,7 @@ class EulerAnglesXyz : public RotationBase<EulerAnglesXyz<PrimType_>> {
   template<typename OtherDerived_>
   inline explicit EulerAnglesXyz(const RotationBase<OtherDerived_>& other)
     : xyz_(internal::ConversionTraits<EulerAnglesXyz, OtherDerived_>::convert(other.derived()).toImplementation()) {
+    KINDR_COUNT_CONVERSION(EulerAnglesXyz, OtherDerived_);
   }
 
   /*! \brief Assignment operator using another rotation.
@@ -113,6 +114,7 @@ class EulerAnglesXyz : public RotationBase<EulerAnglesXyz<PrimType_>> {
    */
   template<typename OtherDerived_>
   EulerAnglesXyz& operator =(const RotationBase<OtherDerived_>& other) {
+    KINDR_COUNT_CONVERSION(EulerAnglesXyz, OtherDerived_);
     this->toImplementation() = internal::ConversionTraits<EulerAnglesXyz, OtherDerived_>::convert(other.derived()).toImplementation();
     return *this;
   }
@@ -123,6 +125,7 @@ class EulerAnglesXyz : public RotationBase<EulerAnglesXyz<PrimType_>> {
    */
   template<typename OtherDerived_>
   EulerAnglesXyz& operator ()(const RotationBase<OtherDerived_>& other) {
+    KINDR_COUNT_CONVERSION(EulerAnglesXyz, OtherDerived_);
     this->toImplementation() = internal::ConversionTraits<EulerAnglesXyz, OtherDerived_>::convert(other.derived()).toImplementation();
     return *this;
   }
@@ -320,6 +323,28 @@ class EulerAnglesXyz : public RotationBase<EulerAnglesXyz<PrimType_>> {
     return *this;
   }
 
+  /*! \brief Returns a unique Euler angles rotation without data-dependent branches.
+   *  Produces the same canonical angles as getUnique(), but selects between the
+   *  wrap cases with arithmetic masks instead of a comparison cascade, which avoids
+   *  branch misses when canonicalizing many rotations in a row.
+   *  \returns copy of the Euler angles rotation which is unique
+   */
+  EulerAnglesXyz getUniqueFast() const {
+    PrimType_ rollAngle = x();
+    PrimType_ pitchAngle = y();
+    PrimType_ yawAngle = z();
+    kindr::wrapUniqueEulerAngles(rollAngle, pitchAngle, yawAngle);
+    return EulerAnglesXyz(rollAngle, pitchAngle, yawAngle);
+  }
+
+  /*! \brief Modifies the Euler angles rotation such that the angles are unique, without data-dependent branches.
+   *  \returns reference
+   */
+  EulerAnglesXyz& setUniqueFast() {
+    *this = getUniqueFast();
+    return *this;
+  }
+
   typename Eigen::Matrix<PrimType_, 3, 3> getMappingFromDiffToLocalAngularVelocity() const {
     using std::sin;
     using std::cos;
@@ -476,6 +501,28 @@ class get_matrix3X<EulerAnglesXyz<PrimType_>>{
 /* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
  * Conversion Traits
  * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/*! \brief Extracts X-Y'-Z'' angles from rotation matrix entries.
+ *
+ *  Near the gimbal lock at y = +-pi/2 the roll and yaw angles are not separable;
+ *  there the yaw angle is set to zero and the roll angle carries the remaining
+ *  rotation about the locked axis.
+ *  (only for advanced users)
+ */
+template<typename PrimType_>
+inline static EulerAnglesXyz<PrimType_> getEulerAnglesXyzFromMatrixEntries(PrimType_ r00, PrimType_ r01, PrimType_ r02,
+                                                                           PrimType_ r10, PrimType_ r11,
+                                                                           PrimType_ r12, PrimType_ r22) {
+  const PrimType_ cosPitch = sqrt(r00*r00 + r01*r01);
+  if (cosPitch > PrimType_(1e2)*std::numeric_limits<PrimType_>::epsilon()) {
+    return EulerAnglesXyz<PrimType_>(atan2(-r12, r22), atan2(r02, cosPitch), atan2(-r01, r00));
+  }
+  if (r02 > PrimType_(0)) { // y = +pi/2: only (x+z) is observable
+    return EulerAnglesXyz<PrimType_>(atan2(r10, r11), PrimType_(M_PI/2.0), PrimType_(0));
+  }
+  return EulerAnglesXyz<PrimType_>(-atan2(r10, r11), PrimType_(-M_PI/2.0), PrimType_(0)); // y = -pi/2: only (z-x) is observable
+}
+
 template<typename DestPrimType_, typename SourcePrimType_>
 class ConversionTraits<EulerAnglesXyz<DestPrimType_>, AngleAxis<SourcePrimType_>> {
  public:
@@ -496,9 +543,19 @@ class ConversionTraits<EulerAnglesXyz<DestPrimType_>, RotationVector<SourcePrimT
 template<typename DestPrimType_, typename SourcePrimType_>
 class ConversionTraits<EulerAnglesXyz<DestPrimType_>, RotationQuaternion<SourcePrimType_>> {
  public:
+  //! Direct extraction from the quaternion coefficients, avoiding the matrix round-trip
   inline static EulerAnglesXyz<DestPrimType_> convert(const RotationQuaternion<SourcePrimType_>& q) {
-     Eigen::Matrix<DestPrimType_, 3, 1>  vec = q.toImplementation().toRotationMatrix().eulerAngles(0, 1, 2).template cast<DestPrimType_>();
-     return EulerAnglesXyz<DestPrimType_>(vec(0), vec(1), vec(2));
+    const DestPrimType_ w = (DestPrimType_)q.w();
+    const DestPrimType_ x = (DestPrimType_)q.x();
+    const DestPrimType_ y = (DestPrimType_)q.y();
+    const DestPrimType_ z = (DestPrimType_)q.z();
+    return getEulerAnglesXyzFromMatrixEntries(DestPrimType_(1) - DestPrimType_(2)*(y*y + z*z),
+                                              DestPrimType_(2)*(x*y - w*z),
+                                              DestPrimType_(2)*(x*z + w*y),
+                                              DestPrimType_(2)*(x*y + w*z),
+                                              DestPrimType_(1) - DestPrimType_(2)*(x*x + z*z),
+                                              DestPrimType_(2)*(y*z - w*x),
+                                              DestPrimType_(1) - DestPrimType_(2)*(x*x + y*y));
   }
 };
 
@@ -506,8 +563,11 @@ class ConversionTraits<EulerAnglesXyz<DestPrimType_>, RotationQuaternion<SourceP
 template<typename DestPrimType_, typename SourcePrimType_>
 class ConversionTraits<EulerAnglesXyz<DestPrimType_>, RotationMatrix<SourcePrimType_>> {
  public:
+  //! Direct extraction from the matrix entries, avoiding the quaternion round-trip
   inline static EulerAnglesXyz<DestPrimType_> convert(const RotationMatrix<SourcePrimType_>& R) {
-    return EulerAnglesXyz<DestPrimType_>(RotationQuaternion<DestPrimType_>(R));
+    return getEulerAnglesXyzFromMatrixEntries((DestPrimType_)R.matrix()(0,0), (DestPrimType_)R.matrix()(0,1), (DestPrimType_)R.matrix()(0,2),
+                                              (DestPrimType_)R.matrix()(1,0), (DestPrimType_)R.matrix()(1,1),
+                                              (DestPrimType_)R.matrix()(1,2), (DestPrimType_)R.matrix()(2,2));
   }
 };
 
@@ -102,6 +102,7 @@ class EulerAnglesZyx : public RotationBase<EulerAnglesZyx<PrimType_>> {
   template<typename OtherDerived_>
   inline explicit EulerAnglesZyx(const RotationBase<OtherDerived_>& other)
     : zyx_(internal::ConversionTraits<EulerAnglesZyx, OtherDerived_>::convert(other.derived()).toImplementation()) {
+    KINDR_COUNT_CONVERSION(EulerAnglesZyx, OtherDerived_);
   }
 
   /*! \brief Assignment operator using another rotation.
@@ -110,6 +111,7 @@ class EulerAnglesZyx : public RotationBase<EulerAnglesZyx<PrimType_>> {
    */
   template<typename OtherDerived_>
   EulerAnglesZyx& operator =(const RotationBase<OtherDerived_>& other) {
+    KINDR_COUNT_CONVERSION(EulerAnglesZyx, OtherDerived_);
     this->toImplementation() = internal::ConversionTraits<EulerAnglesZyx, OtherDerived_>::convert(other.derived()).toImplementation();
     return *this;
   }
@@ -121,6 +123,7 @@ class EulerAnglesZyx : public RotationBase<EulerAnglesZyx<PrimType_>> {
    */
   template<typename OtherDerived_>
   EulerAnglesZyx& operator ()(const RotationBase<OtherDerived_>& other) {
+    KINDR_COUNT_CONVERSION(EulerAnglesZyx, OtherDerived_);
     this->toImplementation() = internal::ConversionTraits<EulerAnglesZyx, OtherDerived_>::convert(other.derived()).toImplementation();
     return *this;
   }
@@ -389,6 +392,28 @@ class EulerAnglesZyx : public RotationBase<EulerAnglesZyx<PrimType_>> {
     return *this;
   }
 
+  /*! \brief Returns a unique Euler angles rotation without data-dependent branches.
+   *  Produces the same canonical angles as getUnique(), but selects between the
+   *  wrap cases with arithmetic masks instead of a comparison cascade, which avoids
+   *  branch misses when canonicalizing many rotations in a row.
+   *  \returns copy of the Euler angles rotation which is unique
+   */
+  EulerAnglesZyx getUniqueFast() const {
+    PrimType_ yawAngle = z();
+    PrimType_ pitchAngle = y();
+    PrimType_ rollAngle = x();
+    kindr::wrapUniqueEulerAngles(yawAngle, pitchAngle, rollAngle);
+    return EulerAnglesZyx(yawAngle, pitchAngle, rollAngle);
+  }
+
+  /*! \brief Modifies the Euler angles rotation such that the angles are unique, without data-dependent branches.
+   *  \returns reference
+   */
+  EulerAnglesZyx& setUniqueFast() {
+    *this = getUniqueFast();
+    return *this;
+  }
+
 
   typename Eigen::Matrix<PrimType_, 3, 3> getMappingFromDiffToLocalAngularVelocity() const {
     using std::sin;
@@ -498,6 +523,28 @@ class get_matrix3X<EulerAnglesZyx<PrimType_>>{
 /* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
  * Conversion Traits
  * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/*! \brief Extracts Z-Y'-X'' angles from rotation matrix entries.
+ *
+ *  Near the gimbal lock at y = +-pi/2 the yaw and roll angles are not separable;
+ *  there the yaw angle is set to zero and the roll angle carries the remaining
+ *  rotation about the locked axis.
+ *  (only for advanced users)
+ */
+template<typename PrimType_>
+inline static EulerAnglesZyx<PrimType_> getEulerAnglesZyxFromMatrixEntries(PrimType_ r00, PrimType_ r10, PrimType_ r20,
+                                                                           PrimType_ r01, PrimType_ r02,
+                                                                           PrimType_ r21, PrimType_ r22) {
+  const PrimType_ cosPitch = sqrt(r00*r00 + r10*r10);
+  if (cosPitch > PrimType_(1e2)*std::numeric_limits<PrimType_>::epsilon()) {
+    return EulerAnglesZyx<PrimType_>(atan2(r10, r00), atan2(-r20, cosPitch), atan2(r21, r22));
+  }
+  if (r20 < PrimType_(0)) { // y = +pi/2: only (x-z) is observable
+    return EulerAnglesZyx<PrimType_>(PrimType_(0), PrimType_(M_PI/2.0), atan2(r01, r02));
+  }
+  return EulerAnglesZyx<PrimType_>(PrimType_(0), PrimType_(-M_PI/2.0), atan2(-r01, -r02)); // y = -pi/2: only (x+z) is observable
+}
+
 template<typename DestPrimType_, typename SourcePrimType_>
 class ConversionTraits<EulerAnglesZyx<DestPrimType_>, AngleAxis<SourcePrimType_>> {
  public:
@@ -509,8 +556,11 @@ class ConversionTraits<EulerAnglesZyx<DestPrimType_>, AngleAxis<SourcePrimType_>
 template<typename DestPrimType_, typename SourcePrimType_>
 class ConversionTraits<EulerAnglesZyx<DestPrimType_>, RotationMatrix<SourcePrimType_>> {
  public:
+  //! Direct extraction from the matrix entries, avoiding the quaternion round-trip
   inline static EulerAnglesZyx<DestPrimType_> convert(const RotationMatrix<SourcePrimType_>& R) {
-    return EulerAnglesZyx<DestPrimType_>(RotationQuaternion<DestPrimType_>(R));
+    return getEulerAnglesZyxFromMatrixEntries((DestPrimType_)R.matrix()(0,0), (DestPrimType_)R.matrix()(1,0), (DestPrimType_)R.matrix()(2,0),
+                                              (DestPrimType_)R.matrix()(0,1), (DestPrimType_)R.matrix()(0,2),
+                                              (DestPrimType_)R.matrix()(2,1), (DestPrimType_)R.matrix()(2,2));
   }
 };
 
@@ -525,9 +575,19 @@ class ConversionTraits<EulerAnglesZyx<DestPrimType_>, RotationVector<SourcePrimT
 template<typename DestPrimType_, typename SourcePrimType_>
 class ConversionTraits<EulerAnglesZyx<DestPrimType_>, RotationQuaternion<SourcePrimType_>> {
  public:
+  //! Direct extraction from the quaternion coefficients, avoiding the matrix round-trip
   inline static EulerAnglesZyx<DestPrimType_> convert(const RotationQuaternion<SourcePrimType_>& q) {
-    const Eigen::Matrix<DestPrimType_, 3, 1> vec = (q.toImplementation().toRotationMatrix().eulerAngles(2, 1, 0)).template cast<DestPrimType_>();
-    return EulerAnglesZyx<DestPrimType_>(vec(0), vec(1), vec(2));
+    const DestPrimType_ w = (DestPrimType_)q.w();
+    const DestPrimType_ x = (DestPrimType_)q.x();
+    const DestPrimType_ y = (DestPrimType_)q.y();
+    const DestPrimType_ z = (DestPrimType_)q.z();
+    return getEulerAnglesZyxFromMatrixEntries(DestPrimType_(1) - DestPrimType_(2)*(y*y + z*z),
+                                              DestPrimType_(2)*(x*y + w*z),
+                                              DestPrimType_(2)*(x*z - w*y),
+                                              DestPrimType_(2)*(x*y - w*z),
+                                              DestPrimType_(2)*(x*z + w*y),
+                                              DestPrimType_(2)*(y*z + w*x),
+                                              DestPrimType_(1) - DestPrimType_(2)*(x*x + y*y));
   }
 };
 
@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/rotations/RotationDiff.hpp"
+
+namespace kindr {
+
+/*! \file EulerRateMapping.hpp
+ *  \brief Cached mapping matrices between Euler-angle rates and angular velocities.
+ *
+ *  getMappingFromLocalAngularVelocityToDiff() and its inverse rebuild a trig-heavy
+ *  3x3 on every conversion. When many angular velocities are converted at the same
+ *  attitude (e.g. one mapping per limb per control tick), an EulerRateMapping object
+ *  computes the sines/cosines once per attitude update and reuses the stored
+ *  matrices for every vector, including the time derivative of the mapping needed
+ *  for acceleration-level control.
+ */
+
+/*! \class EulerRateMappingZyx
+ * \brief Cached rate mappings for the z-y-x (yaw-pitch-roll) convention.
+ *
+ *  setAttitude() performs the four trigonometry calls and builds both mapping
+ *  matrices; all accessors and conversions afterwards are matrix-vector products.
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ */
+template<typename PrimType_>
+class EulerRateMappingZyx {
+ public:
+  typedef PrimType_ Scalar;
+  typedef Eigen::Matrix<PrimType_, 3, 3> Matrix3;
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+
+  EulerRateMappingZyx() {
+    setAttitude(EulerAnglesZyx<PrimType_>());
+  }
+
+  explicit EulerRateMappingZyx(const EulerAnglesZyx<PrimType_>& eulerAngles) {
+    setAttitude(eulerAngles);
+  }
+
+  /*! \brief Updates the cached matrices for a new attitude (4 trig calls, 1 division). */
+  void setAttitude(const EulerAnglesZyx<PrimType_>& eulerAngles) {
+    using std::sin;
+    using std::cos;
+    sinRoll_ = sin(eulerAngles.roll());
+    cosRoll_ = cos(eulerAngles.roll());
+    sinPitch_ = sin(eulerAngles.pitch());
+    cosPitch_ = cos(eulerAngles.pitch());
+    KINDR_ASSERT_TRUE(std::runtime_error, cosPitch_ != PrimType_(0.0), "Gimbal lock: cos(pitch) is zero!");
+    const PrimType_ inverseCosPitch = PrimType_(1.0)/cosPitch_;
+
+    mappingFromDiffToLocal_.setZero();
+    mappingFromDiffToLocal_(0, 0) = -sinPitch_;
+    mappingFromDiffToLocal_(0, 2) = PrimType_(1.0);
+    mappingFromDiffToLocal_(1, 0) = cosPitch_*sinRoll_;
+    mappingFromDiffToLocal_(1, 1) = cosRoll_;
+    mappingFromDiffToLocal_(2, 0) = cosRoll_*cosPitch_;
+    mappingFromDiffToLocal_(2, 1) = -sinRoll_;
+
+    mappingFromLocalToDiff_.setZero();
+    mappingFromLocalToDiff_(0, 1) = inverseCosPitch*sinRoll_;
+    mappingFromLocalToDiff_(0, 2) = inverseCosPitch*cosRoll_;
+    mappingFromLocalToDiff_(1, 1) = cosRoll_;
+    mappingFromLocalToDiff_(1, 2) = -sinRoll_;
+    mappingFromLocalToDiff_(2, 0) = PrimType_(1.0);
+    mappingFromLocalToDiff_(2, 1) = inverseCosPitch*sinRoll_*sinPitch_;
+    mappingFromLocalToDiff_(2, 2) = inverseCosPitch*cosRoll_*sinPitch_;
+  }
+
+  //! Cached equivalent of EulerAnglesZyx::getMappingFromDiffToLocalAngularVelocity().
+  const Matrix3& getMappingFromDiffToLocalAngularVelocity() const {
+    return mappingFromDiffToLocal_;
+  }
+
+  //! Cached equivalent of EulerAnglesZyx::getMappingFromLocalAngularVelocityToDiff().
+  const Matrix3& getMappingFromLocalAngularVelocityToDiff() const {
+    return mappingFromLocalToDiff_;
+  }
+
+  /*! \brief Converts a local angular velocity to Euler rates (matrix-vector product only). */
+  EulerAnglesZyxDiff<PrimType_> convertToDiff(const LocalAngularVelocity<PrimType_>& angularVelocity) const {
+    return EulerAnglesZyxDiff<PrimType_>(Vector3(mappingFromLocalToDiff_*angularVelocity.vector()));
+  }
+
+  /*! \brief Converts Euler rates to a local angular velocity (matrix-vector product only). */
+  LocalAngularVelocity<PrimType_> convertToLocalAngularVelocity(const EulerAnglesZyxDiff<PrimType_>& diff) const {
+    return LocalAngularVelocity<PrimType_>(Vector3(mappingFromDiffToLocal_*diff.toImplementation()));
+  }
+
+  /*! \brief Time derivative of the diff-to-velocity mapping, from the cached trigonometry.
+   *  \param diff  current Euler rates
+   *  \returns dM/dt with M = getMappingFromDiffToLocalAngularVelocity()
+   */
+  Matrix3 getTimeDerivativeOfMappingFromDiffToLocalAngularVelocity(const EulerAnglesZyxDiff<PrimType_>& diff) const {
+    const PrimType_ rollRate = diff.roll();
+    const PrimType_ pitchRate = diff.pitch();
+    Matrix3 derivative = Matrix3::Zero();
+    derivative(0, 0) = -cosPitch_*pitchRate;
+    derivative(1, 0) = -sinPitch_*sinRoll_*pitchRate + cosPitch_*cosRoll_*rollRate;
+    derivative(1, 1) = -sinRoll_*rollRate;
+    derivative(2, 0) = -sinRoll_*cosPitch_*rollRate - cosRoll_*sinPitch_*pitchRate;
+    derivative(2, 1) = -cosRoll_*rollRate;
+    return derivative;
+  }
+
+ private:
+  Matrix3 mappingFromDiffToLocal_;
+  Matrix3 mappingFromLocalToDiff_;
+  PrimType_ sinRoll_;
+  PrimType_ cosRoll_;
+  PrimType_ sinPitch_;
+  PrimType_ cosPitch_;
+};
+
+/*! \class EulerRateMappingXyz
+ * \brief Cached rate mappings for the x-y-z convention.
+ *
+ *  Same contract as EulerRateMappingZyx; the x-y-z mappings depend on the second
+ *  and third angle.
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ */
+template<typename PrimType_>
+class EulerRateMappingXyz {
+ public:
+  typedef PrimType_ Scalar;
+  typedef Eigen::Matrix<PrimType_, 3, 3> Matrix3;
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+
+  EulerRateMappingXyz() {
+    setAttitude(EulerAnglesXyz<PrimType_>());
+  }
+
+  explicit EulerRateMappingXyz(const EulerAnglesXyz<PrimType_>& eulerAngles) {
+    setAttitude(eulerAngles);
+  }
+
+  /*! \brief Updates the cached matrices for a new attitude (4 trig calls, 1 division). */
+  void setAttitude(const EulerAnglesXyz<PrimType_>& eulerAngles) {
+    using std::sin;
+    using std::cos;
+    sinPitch_ = sin(eulerAngles.pitch());
+    cosPitch_ = cos(eulerAngles.pitch());
+    sinYaw_ = sin(eulerAngles.yaw());
+    cosYaw_ = cos(eulerAngles.yaw());
+    KINDR_ASSERT_TRUE(std::runtime_error, cosPitch_ != PrimType_(0.0), "Gimbal lock: cos(pitch) is zero!");
+    const PrimType_ inverseCosPitch = PrimType_(1.0)/cosPitch_;
+
+    mappingFromDiffToLocal_.setZero();
+    mappingFromDiffToLocal_(0, 0) = cosPitch_*cosYaw_;
+    mappingFromDiffToLocal_(0, 1) = sinYaw_;
+    mappingFromDiffToLocal_(1, 0) = -cosPitch_*sinYaw_;
+    mappingFromDiffToLocal_(1, 1) = cosYaw_;
+    mappingFromDiffToLocal_(2, 0) = sinPitch_;
+    mappingFromDiffToLocal_(2, 2) = PrimType_(1.0);
+
+    mappingFromLocalToDiff_.setZero();
+    mappingFromLocalToDiff_(0, 0) = inverseCosPitch*cosYaw_;
+    mappingFromLocalToDiff_(0, 1) = -inverseCosPitch*sinYaw_;
+    mappingFromLocalToDiff_(1, 0) = sinYaw_;
+    mappingFromLocalToDiff_(1, 1) = cosYaw_;
+    mappingFromLocalToDiff_(2, 0) = -inverseCosPitch*cosYaw_*sinPitch_;
+    mappingFromLocalToDiff_(2, 1) = inverseCosPitch*sinYaw_*sinPitch_;
+    mappingFromLocalToDiff_(2, 2) = PrimType_(1.0);
+  }
+
+  //! Cached equivalent of EulerAnglesXyz::getMappingFromDiffToLocalAngularVelocity().
+  const Matrix3& getMappingFromDiffToLocalAngularVelocity() const {
+    return mappingFromDiffToLocal_;
+  }
+
+  //! Cached equivalent of EulerAnglesXyz::getMappingFromLocalAngularVelocityToDiff().
+  const Matrix3& getMappingFromLocalAngularVelocityToDiff() const {
+    return mappingFromLocalToDiff_;
+  }
+
+  /*! \brief Converts a local angular velocity to Euler rates (matrix-vector product only). */
+  EulerAnglesXyzDiff<PrimType_> convertToDiff(const LocalAngularVelocity<PrimType_>& angularVelocity) const {
+    return EulerAnglesXyzDiff<PrimType_>(Vector3(mappingFromLocalToDiff_*angularVelocity.vector()));
+  }
+
+  /*! \brief Converts Euler rates to a local angular velocity (matrix-vector product only). */
+  LocalAngularVelocity<PrimType_> convertToLocalAngularVelocity(const EulerAnglesXyzDiff<PrimType_>& diff) const {
+    return LocalAngularVelocity<PrimType_>(Vector3(mappingFromDiffToLocal_*diff.toImplementation()));
+  }
+
+  /*! \brief Time derivative of the diff-to-velocity mapping, from the cached trigonometry.
+   *  \param diff  current Euler rates
+   *  \returns dM/dt with M = getMappingFromDiffToLocalAngularVelocity()
+   */
+  Matrix3 getTimeDerivativeOfMappingFromDiffToLocalAngularVelocity(const EulerAnglesXyzDiff<PrimType_>& diff) const {
+    const PrimType_ pitchRate = diff.pitch();
+    const PrimType_ yawRate = diff.yaw();
+    Matrix3 derivative = Matrix3::Zero();
+    derivative(0, 0) = -sinPitch_*cosYaw_*pitchRate - cosPitch_*sinYaw_*yawRate;
+    derivative(0, 1) = cosYaw_*yawRate;
+    derivative(1, 0) = sinPitch_*sinYaw_*pitchRate - cosPitch_*cosYaw_*yawRate;
+    derivative(1, 1) = -sinYaw_*yawRate;
+    derivative(2, 0) = cosPitch_*pitchRate;
+    return derivative;
+  }
+
+ private:
+  Matrix3 mappingFromDiffToLocal_;
+  Matrix3 mappingFromLocalToDiff_;
+  PrimType_ sinPitch_;
+  PrimType_ cosPitch_;
+  PrimType_ sinYaw_;
+  PrimType_ cosYaw_;
+};
+
+//! \brief Cached z-y-x rate mapping with primitive type double
+typedef EulerRateMappingZyx<double> EulerRateMappingZyxD;
+//! \brief Cached z-y-x rate mapping with primitive type float
+typedef EulerRateMappingZyx<float> EulerRateMappingZyxF;
+//! \brief Cached x-y-z rate mapping with primitive type double
+typedef EulerRateMappingXyz<double> EulerRateMappingXyzD;
+//! \brief Cached x-y-z rate mapping with primitive type float
+typedef EulerRateMappingXyz<float> EulerRateMappingXyzF;
+
+} // namespace kindr
@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <cmath>
+#include <limits>
+
+#include "kindr/rotations/Rotation.hpp"
+
+namespace kindr {
+
+/*! \file FastConversions.hpp
+ *  \brief Small-angle fast paths for conversions between AngleAxis, RotationVector
+ *         and RotationQuaternion.
+ *
+ *  The regular ConversionTraits call sin/cos/acos/sqrt unconditionally. For
+ *  high-rate integration loops where nearly all rotations are sub-milliradian
+ *  increments, the functions in this file select a truncated series by a single
+ *  magnitude test on the squared norm (one well-predicted branch, no sqrt or
+ *  trigonometry on the fast path). The series are truncated such that the error
+ *  is below the working precision at the branch threshold theta^2 < sqrt(eps):
+ *   - quaternion from rotation vector: error < theta^6/46080  (~2e-29 for double)
+ *   - rotation vector from quaternion: error < s^6/(7 w^7)    (s = imaginary norm)
+ *  The *Unsafe variants additionally skip the canonicalization of the quaternion
+ *  sign (and the debug unit-norm check) and require w >= 0 and unit norm, which
+ *  a preintegration loop maintains by construction.
+ */
+
+namespace internal {
+
+//! Squared-norm threshold below which the small-angle series are exact to working precision.
+template<typename PrimType_>
+inline PrimType_ getSmallAngleSquaredThreshold() {
+  static const PrimType_ threshold = std::sqrt(std::numeric_limits<PrimType_>::epsilon());
+  return threshold;
+}
+
+} // namespace internal
+
+/*! \brief Converts a rotation vector to a rotation quaternion with a small-angle fast path.
+ *
+ *  For theta^2 below the threshold, w = 1 - theta^2/8 + theta^4/384 and
+ *  sin(theta/2)/theta = 1/2 - theta^2/48 + theta^4/3840 avoid sqrt and trigonometry.
+ *  \param rotationVector  rotation vector
+ *  \returns rotation quaternion
+ */
+template<typename PrimType_>
+RotationQuaternion<PrimType_> convertToRotationQuaternionFast(const RotationVector<PrimType_>& rotationVector) {
+  typedef typename RotationQuaternion<PrimType_>::Imaginary Imaginary;
+  const PrimType_ thetaSquared = rotationVector.toImplementation().squaredNorm();
+  PrimType_ real;
+  PrimType_ imaginaryScale;
+  if (thetaSquared < internal::getSmallAngleSquaredThreshold<PrimType_>()) {
+    real = PrimType_(1) - thetaSquared*PrimType_(1.0/8.0) + thetaSquared*thetaSquared*PrimType_(1.0/384.0);
+    imaginaryScale = PrimType_(0.5) - thetaSquared*PrimType_(1.0/48.0) + thetaSquared*thetaSquared*PrimType_(1.0/3840.0);
+  } else {
+    const PrimType_ theta = std::sqrt(thetaSquared);
+    real = std::cos(theta*PrimType_(0.5));
+    imaginaryScale = std::sin(theta*PrimType_(0.5))/theta;
+  }
+  return RotationQuaternion<PrimType_>(trusted, real, Imaginary(rotationVector.toImplementation()*imaginaryScale));
+}
+
+/*! \brief Converts an angle-axis to a rotation quaternion with a small-angle fast path.
+ *  \param angleAxis  angle-axis rotation (axis must have unit length)
+ *  \returns rotation quaternion
+ */
+template<typename PrimType_>
+RotationQuaternion<PrimType_> convertToRotationQuaternionFast(const AngleAxis<PrimType_>& angleAxis) {
+  typedef typename RotationQuaternion<PrimType_>::Imaginary Imaginary;
+  const PrimType_ theta = angleAxis.angle();
+  const PrimType_ thetaSquared = theta*theta;
+  PrimType_ real;
+  PrimType_ sineHalf;
+  if (thetaSquared < internal::getSmallAngleSquaredThreshold<PrimType_>()) {
+    real = PrimType_(1) - thetaSquared*PrimType_(1.0/8.0) + thetaSquared*thetaSquared*PrimType_(1.0/384.0);
+    sineHalf = theta*(PrimType_(0.5) - thetaSquared*PrimType_(1.0/48.0) + thetaSquared*thetaSquared*PrimType_(1.0/3840.0));
+  } else {
+    real = std::cos(theta*PrimType_(0.5));
+    sineHalf = std::sin(theta*PrimType_(0.5));
+  }
+  return RotationQuaternion<PrimType_>(trusted, real, Imaginary(angleAxis.axis()*sineHalf));
+}
+
+/*! \brief Converts a rotation quaternion to a rotation vector with a small-angle fast path.
+ *
+ *  Uses 2*atan2(s, w)/s with s the imaginary norm (well-conditioned everywhere, no
+ *  clamping needed); for small s the series (2/w)(1 - s^2/(3 w^2) + s^4/(5 w^4))
+ *  avoids sqrt and atan2. The quaternion sign is canonicalized so the result is the
+ *  shortest rotation.
+ *  \param quaternion  rotation quaternion
+ *  \returns rotation vector
+ */
+template<typename PrimType_>
+RotationVector<PrimType_> convertToRotationVectorFast(const RotationQuaternion<PrimType_>& quaternion) {
+  const PrimType_ sign = quaternion.w() < PrimType_(0) ? PrimType_(-1) : PrimType_(1);
+  const PrimType_ real = sign*quaternion.w();
+  const Eigen::Matrix<PrimType_, 3, 1> imaginary = sign*quaternion.imaginary();
+  const PrimType_ imaginarySquaredNorm = imaginary.squaredNorm();
+  PrimType_ scale;
+  if (imaginarySquaredNorm < internal::getSmallAngleSquaredThreshold<PrimType_>()) {
+    const PrimType_ tangentSquared = imaginarySquaredNorm/(real*real);
+    scale = PrimType_(2)/real*(PrimType_(1) - tangentSquared*PrimType_(1.0/3.0) + tangentSquared*tangentSquared*PrimType_(1.0/5.0));
+  } else {
+    const PrimType_ imaginaryNorm = std::sqrt(imaginarySquaredNorm);
+    scale = PrimType_(2)*std::atan2(imaginaryNorm, real)/imaginaryNorm;
+  }
+  return RotationVector<PrimType_>(Eigen::Matrix<PrimType_, 3, 1>(imaginary*scale));
+}
+
+/*! \brief Like convertToRotationVectorFast(), but skips the sign canonicalization.
+ *  \param quaternion  rotation quaternion with w >= 0 and unit norm
+ *  \returns rotation vector
+ */
+template<typename PrimType_>
+RotationVector<PrimType_> convertToRotationVectorFastUnsafe(const RotationQuaternion<PrimType_>& quaternion) {
+  const PrimType_ real = quaternion.w();
+  const PrimType_ imaginarySquaredNorm = quaternion.imaginary().squaredNorm();
+  PrimType_ scale;
+  if (imaginarySquaredNorm < internal::getSmallAngleSquaredThreshold<PrimType_>()) {
+    const PrimType_ tangentSquared = imaginarySquaredNorm/(real*real);
+    scale = PrimType_(2)/real*(PrimType_(1) - tangentSquared*PrimType_(1.0/3.0) + tangentSquared*tangentSquared*PrimType_(1.0/5.0));
+  } else {
+    const PrimType_ imaginaryNorm = std::sqrt(imaginarySquaredNorm);
+    scale = PrimType_(2)*std::atan2(imaginaryNorm, real)/imaginaryNorm;
+  }
+  return RotationVector<PrimType_>(Eigen::Matrix<PrimType_, 3, 1>(quaternion.imaginary()*scale));
+}
+
+/*! \brief Converts a rotation quaternion to an angle-axis using atan2 instead of acos.
+ *
+ *  atan2(s, w) is well-conditioned for all angles and needs no domain clamping,
+ *  unlike the acos(w) form. Identity is returned when the imaginary norm is below
+ *  working precision (the axis is then undefined).
+ *  \param quaternion  rotation quaternion
+ *  \returns angle-axis rotation
+ */
+template<typename PrimType_>
+AngleAxis<PrimType_> convertToAngleAxisFast(const RotationQuaternion<PrimType_>& quaternion) {
+  const PrimType_ sign = quaternion.w() < PrimType_(0) ? PrimType_(-1) : PrimType_(1);
+  const PrimType_ real = sign*quaternion.w();
+  const Eigen::Matrix<PrimType_, 3, 1> imaginary = sign*quaternion.imaginary();
+  const PrimType_ imaginarySquaredNorm = imaginary.squaredNorm();
+  const PrimType_ precision = internal::NumTraits<PrimType_>::dummy_precision();
+  if (imaginarySquaredNorm < precision*precision) {
+    return AngleAxis<PrimType_>();
+  }
+  const PrimType_ imaginaryNorm = std::sqrt(imaginarySquaredNorm);
+  return AngleAxis<PrimType_>(PrimType_(2)*std::atan2(imaginaryNorm, real),
+                              Eigen::Matrix<PrimType_, 3, 1>(imaginary/imaginaryNorm));
+}
+
+/*! \brief Like convertToAngleAxisFast(), but skips the sign canonicalization.
+ *  \param quaternion  rotation quaternion with w >= 0 and unit norm
+ *  \returns angle-axis rotation
+ */
+template<typename PrimType_>
+AngleAxis<PrimType_> convertToAngleAxisFastUnsafe(const RotationQuaternion<PrimType_>& quaternion) {
+  const PrimType_ imaginarySquaredNorm = quaternion.imaginary().squaredNorm();
+  const PrimType_ precision = internal::NumTraits<PrimType_>::dummy_precision();
+  if (imaginarySquaredNorm < precision*precision) {
+    return AngleAxis<PrimType_>();
+  }
+  const PrimType_ imaginaryNorm = std::sqrt(imaginarySquaredNorm);
+  return AngleAxis<PrimType_>(PrimType_(2)*std::atan2(imaginaryNorm, quaternion.w()),
+                              Eigen::Matrix<PrimType_, 3, 1>(quaternion.imaginary()/imaginaryNorm));
+}
+
+/*! \brief Converts a rotation vector to an angle-axis with a single square root.
+ *
+ *  The ConversionTraits path computes the norm twice (norm() and normalized());
+ *  here the norm is reused for the axis. Identity is returned below working
+ *  precision.
+ *  \param rotationVector  rotation vector
+ *  \returns angle-axis rotation
+ */
+template<typename PrimType_>
+AngleAxis<PrimType_> convertToAngleAxisFast(const RotationVector<PrimType_>& rotationVector) {
+  const PrimType_ thetaSquared = rotationVector.toImplementation().squaredNorm();
+  const PrimType_ precision = internal::NumTraits<PrimType_>::dummy_precision();
+  if (thetaSquared < precision*precision) {
+    return AngleAxis<PrimType_>();
+  }
+  const PrimType_ theta = std::sqrt(thetaSquared);
+  return AngleAxis<PrimType_>(theta, Eigen::Matrix<PrimType_, 3, 1>(rotationVector.toImplementation()/theta));
+}
+
+} // namespace kindr
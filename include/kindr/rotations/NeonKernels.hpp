@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include "kindr/rotations/Rotation.hpp"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+namespace kindr {
+
+/*! \file NeonKernels.hpp
+ *  \brief Hand-tuned kernels for the hot quaternion operations on ARM devices.
+ *
+ *  The ANDROID_NREAL device build (see the top-level CMakeLists.txt) compiles
+ *  kindr with NEON available, and quaternion composition and quaternion-to-matrix
+ *  conversion dominate its head-tracking loop. The functions in this file route
+ *  those operations through internal::QuaternionKernelTraits, whose
+ *  single-precision specialization uses NEON intrinsics with short dependency
+ *  chains suited to in-order efficiency cores. On targets without NEON (and for
+ *  double precision) the generic scalar expansion is used, so the API is portable.
+ *  The batched point rotation counterpart lives in RotationBatch.hpp
+ *  (internal::RotateBatchTraits), which carries the matching NEON specialization.
+ */
+
+namespace internal {
+
+/*! \brief Kernels for the Hamilton product and the quaternion-to-matrix conversion.
+ *
+ *  The generic implementation expands the products scalar-wise, which lets the
+ *  compiler schedule them freely. (only for advanced users)
+ */
+template<typename PrimType_>
+class QuaternionKernelTraits {
+ public:
+  //! Hamilton product on raw coefficients in Eigen order (x, y, z, w)
+  inline static void multiply(const PrimType_* lhs, const PrimType_* rhs, PrimType_* result) {
+    const PrimType_ lx = lhs[0], ly = lhs[1], lz = lhs[2], lw = lhs[3];
+    const PrimType_ rx = rhs[0], ry = rhs[1], rz = rhs[2], rw = rhs[3];
+    result[0] = lw*rx + lx*rw + ly*rz - lz*ry;
+    result[1] = lw*ry - lx*rz + ly*rw + lz*rx;
+    result[2] = lw*rz + lx*ry - ly*rx + lz*rw;
+    result[3] = lw*rw - lx*rx - ly*ry - lz*rz;
+  }
+
+  //! Rotation matrix from unit quaternion coefficients in Eigen order (x, y, z, w)
+  inline static void convertToMatrix(const PrimType_* quaternion, Eigen::Matrix<PrimType_, 3, 3>& matrix) {
+    const PrimType_ x = quaternion[0], y = quaternion[1], z = quaternion[2], w = quaternion[3];
+    const PrimType_ tx = x + x, ty = y + y, tz = z + z;
+    const PrimType_ xx = tx*x, yy = ty*y, zz = tz*z;
+    const PrimType_ xy = tx*y, xz = tx*z, yz = ty*z;
+    const PrimType_ wx = tx*w, wy = ty*w, wz = tz*w;
+    matrix(0,0) = PrimType_(1) - (yy + zz);
+    matrix(0,1) = xy - wz;
+    matrix(0,2) = xz + wy;
+    matrix(1,0) = xy + wz;
+    matrix(1,1) = PrimType_(1) - (xx + zz);
+    matrix(1,2) = yz - wx;
+    matrix(2,0) = xz - wy;
+    matrix(2,1) = yz + wx;
+    matrix(2,2) = PrimType_(1) - (xx + yy);
+  }
+};
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+/*! \brief NEON single-precision kernels.
+ *
+ *  The Hamilton product is formed as four scaled shuffles of the right-hand
+ *  coefficients, accumulated with vmla; each step depends only on its
+ *  predecessor, keeping the chain short for in-order cores.
+ */
+template<>
+class QuaternionKernelTraits<float> {
+ public:
+  inline static void multiply(const float* lhs, const float* rhs, float* result) {
+    const float32x4_t r = vld1q_f32(rhs);                       // rx ry rz rw
+    const float32x4_t swapPairs = vrev64q_f32(r);               // ry rx rw rz
+    const float32x4_t rotateHalf = vextq_f32(r, r, 2);          // rz rw rx ry
+    const float32x4_t reverse = vextq_f32(swapPairs, swapPairs, 2); // rw rz ry rx
+
+    const float32x4_t signX = {1.0f, -1.0f, 1.0f, -1.0f};
+    const float32x4_t signY = {1.0f, 1.0f, -1.0f, -1.0f};
+    const float32x4_t signZ = {-1.0f, 1.0f, 1.0f, -1.0f};
+
+    // result = lw*r + lx*(+rw,-rz,+ry,-rx) + ly*(+rz,+rw,-rx,-ry) + lz*(-ry,+rx,+rw,-rz)
+    float32x4_t accumulator = vmulq_n_f32(r, lhs[3]);
+    accumulator = vmlaq_n_f32(accumulator, vmulq_f32(reverse, signX), lhs[0]);
+    accumulator = vmlaq_n_f32(accumulator, vmulq_f32(rotateHalf, signY), lhs[1]);
+    accumulator = vmlaq_n_f32(accumulator, vmulq_f32(swapPairs, signZ), lhs[2]);
+    vst1q_f32(result, accumulator);
+  }
+
+  inline static void convertToMatrix(const float* quaternion, Eigen::Matrix<float, 3, 3>& matrix) {
+    const float32x4_t q = vld1q_f32(quaternion);                // x y z w
+    const float32x4_t twice = vaddq_f32(q, q);                  // 2x 2y 2z 2w
+    const float32x4_t scaledX = vmulq_n_f32(twice, quaternion[0]); // 2xx 2xy 2xz 2xw
+    const float32x4_t scaledY = vmulq_n_f32(twice, quaternion[1]); // 2xy 2yy 2yz 2yw
+    const float32x4_t scaledZ = vmulq_n_f32(twice, quaternion[2]); // 2xz 2yz 2zz 2zw
+    const float xx = vgetq_lane_f32(scaledX, 0), xy = vgetq_lane_f32(scaledX, 1);
+    const float xz = vgetq_lane_f32(scaledX, 2), wx = vgetq_lane_f32(scaledX, 3);
+    const float yy = vgetq_lane_f32(scaledY, 1), yz = vgetq_lane_f32(scaledY, 2);
+    const float wy = vgetq_lane_f32(scaledY, 3);
+    const float zz = vgetq_lane_f32(scaledZ, 2), wz = vgetq_lane_f32(scaledZ, 3);
+    matrix(0,0) = 1.0f - (yy + zz);
+    matrix(0,1) = xy - wz;
+    matrix(0,2) = xz + wy;
+    matrix(1,0) = xy + wz;
+    matrix(1,1) = 1.0f - (xx + zz);
+    matrix(1,2) = yz - wx;
+    matrix(2,0) = xz - wy;
+    matrix(2,1) = yz + wx;
+    matrix(2,2) = 1.0f - (xx + yy);
+  }
+};
+#endif
+
+} // namespace internal
+
+
+/*! \brief Composes two rotation quaternions with the tuned Hamilton product kernel.
+ *
+ *  Equivalent to lhs*rhs, but routed through the NEON kernel on ARM builds.
+ *  No renormalization is performed; for long products chains call fix()
+ *  periodically as usual.
+ *  \param lhs   left-hand rotation quaternion
+ *  \param rhs   right-hand rotation quaternion
+ *  \returns the composed rotation quaternion
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+RotationQuaternion<PrimType_> multiplyQuaternionsFast(const RotationQuaternion<PrimType_>& lhs,
+                                                      const RotationQuaternion<PrimType_>& rhs) {
+  Eigen::Quaternion<PrimType_> result;
+  internal::QuaternionKernelTraits<PrimType_>::multiply(lhs.toImplementation().coeffs().data(),
+                                                        rhs.toImplementation().coeffs().data(),
+                                                        result.coeffs().data());
+  return RotationQuaternion<PrimType_>(trusted, result);
+}
+
+/*! \brief Converts a rotation quaternion to a rotation matrix with the tuned kernel.
+ *  \param quaternion   rotation quaternion (unit norm)
+ *  \returns the rotation matrix
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+RotationMatrix<PrimType_> convertToRotationMatrixFast(const RotationQuaternion<PrimType_>& quaternion) {
+  Eigen::Matrix<PrimType_, 3, 3> matrix;
+  internal::QuaternionKernelTraits<PrimType_>::convertToMatrix(quaternion.toImplementation().coeffs().data(), matrix);
+  return RotationMatrix<PrimType_>(matrix);
+}
+
+} // namespace kindr
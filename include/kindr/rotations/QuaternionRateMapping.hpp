@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/rotations/RotationDiff.hpp"
+
+namespace kindr {
+
+/*! \class QuaternionRateMapping
+ * \brief Cached mapping between angular velocities and quaternion rates.
+ *
+ *  The RotationDiffConversionTraits for RotationQuaternionDiff rebuild the 4x3
+ *  angular-velocity-to-quaternion-rate mapping from the current quaternion on
+ *  every conversion. When many angular velocities are converted at one
+ *  linearization point (e.g. in a filter update), a QuaternionRateMapping
+ *  builds the mappings once per attitude with setAttitude(); every conversion
+ *  afterwards is a plain matrix-vector product, and batches of velocities go
+ *  through one matrix-matrix product.
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ */
+template<typename PrimType_>
+class QuaternionRateMapping {
+ public:
+  typedef PrimType_ Scalar;
+  typedef Eigen::Matrix<PrimType_, 3, 4> Matrix34;
+  typedef Eigen::Matrix<PrimType_, 4, 3> Matrix43;
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+  typedef Eigen::Matrix<PrimType_, 4, 1> Vector4;
+
+  QuaternionRateMapping() {
+    setAttitude(RotationQuaternion<PrimType_>());
+  }
+
+  explicit QuaternionRateMapping(const RotationQuaternion<PrimType_>& rotation) {
+    setAttitude(rotation);
+  }
+
+  /*! \brief Updates the cached mappings for a new attitude (no trigonometry, coefficient shuffles only). */
+  void setAttitude(const RotationQuaternion<PrimType_>& rotation) {
+    localMappingFromDiffToVelocity_ = PrimType_(2.0)*rotation.getLocalQuaternionDiffMatrix();
+    globalMappingFromDiffToVelocity_ = PrimType_(2.0)*rotation.getGlobalQuaternionDiffMatrix();
+    localMappingFromVelocityToDiff_ = PrimType_(0.25)*localMappingFromDiffToVelocity_.transpose();
+    globalMappingFromVelocityToDiff_ = PrimType_(0.25)*globalMappingFromDiffToVelocity_.transpose();
+  }
+
+  //! Cached 0.5*HBar^T with HBar = RotationQuaternion::getLocalQuaternionDiffMatrix().
+  const Matrix43& getLocalMappingFromAngularVelocityToDiff() const {
+    return localMappingFromVelocityToDiff_;
+  }
+
+  //! Cached 0.5*H^T with H = RotationQuaternion::getGlobalQuaternionDiffMatrix().
+  const Matrix43& getGlobalMappingFromAngularVelocityToDiff() const {
+    return globalMappingFromVelocityToDiff_;
+  }
+
+  //! Cached 2*HBar, the adjoint mapping quaternion rates back to local angular velocities.
+  const Matrix34& getLocalMappingFromDiffToAngularVelocity() const {
+    return localMappingFromDiffToVelocity_;
+  }
+
+  //! Cached 2*H, the adjoint mapping quaternion rates back to global angular velocities.
+  const Matrix34& getGlobalMappingFromDiffToAngularVelocity() const {
+    return globalMappingFromDiffToVelocity_;
+  }
+
+  /*! \brief Converts a local angular velocity to a quaternion rate (matrix-vector product only). */
+  RotationQuaternionDiff<PrimType_> convertToDiff(const LocalAngularVelocity<PrimType_>& angularVelocity) const {
+    return RotationQuaternionDiff<PrimType_>(Vector4(localMappingFromVelocityToDiff_*angularVelocity.vector()));
+  }
+
+  /*! \brief Converts a global angular velocity to a quaternion rate (matrix-vector product only). */
+  RotationQuaternionDiff<PrimType_> convertToDiff(const GlobalAngularVelocity<PrimType_>& angularVelocity) const {
+    return RotationQuaternionDiff<PrimType_>(Vector4(globalMappingFromVelocityToDiff_*angularVelocity.vector()));
+  }
+
+  /*! \brief Converts a quaternion rate to a local angular velocity (matrix-vector product only). */
+  LocalAngularVelocity<PrimType_> convertToLocalAngularVelocity(const RotationQuaternionDiff<PrimType_>& diff) const {
+    return LocalAngularVelocity<PrimType_>(Vector3(localMappingFromDiffToVelocity_*diff.vector()));
+  }
+
+  /*! \brief Converts a quaternion rate to a global angular velocity (matrix-vector product only). */
+  GlobalAngularVelocity<PrimType_> convertToGlobalAngularVelocity(const RotationQuaternionDiff<PrimType_>& diff) const {
+    return GlobalAngularVelocity<PrimType_>(Vector3(globalMappingFromDiffToVelocity_*diff.vector()));
+  }
+
+  /*! \brief Converts a batch of local angular velocities to quaternion rates in one product.
+   *  \param angularVelocities  matrix whose columns are local angular velocities
+   *  \param diffs              output matrix whose columns are quaternion rates [w; x; y; z]' (resized to match)
+   */
+  template<int Cols_>
+  void convertToDiff(const Eigen::Matrix<PrimType_, 3, Cols_>& angularVelocities, Eigen::Matrix<PrimType_, 4, Cols_>& diffs) const {
+    diffs.resize(4, angularVelocities.cols());
+    diffs.noalias() = localMappingFromVelocityToDiff_*angularVelocities;
+  }
+
+  /*! \brief Converts a batch of global angular velocities to quaternion rates in one product.
+   *  \param angularVelocities  matrix whose columns are global angular velocities
+   *  \param diffs              output matrix whose columns are quaternion rates [w; x; y; z]' (resized to match)
+   */
+  template<int Cols_>
+  void convertToDiffGlobal(const Eigen::Matrix<PrimType_, 3, Cols_>& angularVelocities, Eigen::Matrix<PrimType_, 4, Cols_>& diffs) const {
+    diffs.resize(4, angularVelocities.cols());
+    diffs.noalias() = globalMappingFromVelocityToDiff_*angularVelocities;
+  }
+
+  /*! \brief Converts a batch of quaternion rates to local angular velocities in one product.
+   *  \param diffs              matrix whose columns are quaternion rates [w; x; y; z]'
+   *  \param angularVelocities  output matrix whose columns are local angular velocities (resized to match)
+   */
+  template<int Cols_>
+  void convertToLocalAngularVelocities(const Eigen::Matrix<PrimType_, 4, Cols_>& diffs, Eigen::Matrix<PrimType_, 3, Cols_>& angularVelocities) const {
+    angularVelocities.resize(3, diffs.cols());
+    angularVelocities.noalias() = localMappingFromDiffToVelocity_*diffs;
+  }
+
+  /*! \brief Converts a batch of quaternion rates to global angular velocities in one product.
+   *  \param diffs              matrix whose columns are quaternion rates [w; x; y; z]'
+   *  \param angularVelocities  output matrix whose columns are global angular velocities (resized to match)
+   */
+  template<int Cols_>
+  void convertToGlobalAngularVelocities(const Eigen::Matrix<PrimType_, 4, Cols_>& diffs, Eigen::Matrix<PrimType_, 3, Cols_>& angularVelocities) const {
+    angularVelocities.resize(3, diffs.cols());
+    angularVelocities.noalias() = globalMappingFromDiffToVelocity_*diffs;
+  }
+
+ private:
+  Matrix34 localMappingFromDiffToVelocity_;
+  Matrix34 globalMappingFromDiffToVelocity_;
+  Matrix43 localMappingFromVelocityToDiff_;
+  Matrix43 globalMappingFromVelocityToDiff_;
+};
+
+//! \brief Cached quaternion rate mapping with primitive type double
+typedef QuaternionRateMapping<double> QuaternionRateMappingD;
+//! \brief Cached quaternion rate mapping with primitive type float
+typedef QuaternionRateMapping<float> QuaternionRateMappingF;
+
+} // namespace kindr
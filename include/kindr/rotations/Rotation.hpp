@@ -75,7 +75,8 @@ class MultiplicationTraits<RotationBase<Left_>, RotationBase<Right_> > {
  public:
   //! Default multiplication of rotations converts the representations of the rotations to rotation quaternions and multiplies them
   inline static Left_ mult(const RotationBase<Left_>& lhs, const RotationBase<Right_>& rhs) {
-      return Left_(RotationQuaternion<typename Left_::Scalar>(
+      // the product of two unit quaternions is unit by construction, so its validation is skipped
+      return Left_(RotationQuaternion<typename Left_::Scalar>(trusted,
                   (RotationQuaternion<typename Left_::Scalar>(lhs.derived())).toImplementation() *
                   (RotationQuaternion<typename Right_::Scalar>(rhs.derived())).toImplementation()
                   ));
@@ -90,7 +91,8 @@ class MultiplicationTraits<RotationBase<LeftAndRight_>, RotationBase<LeftAndRigh
  public:
   //! Default multiplication of rotations converts the representations of the rotations to rotation quaternions and multiplies them
   inline static LeftAndRight_ mult(const RotationBase<LeftAndRight_>& lhs, const RotationBase<LeftAndRight_>& rhs) {
-      return LeftAndRight_(RotationQuaternion<typename LeftAndRight_::Scalar>(
+      // the product of two unit quaternions is unit by construction, so its validation is skipped
+      return LeftAndRight_(RotationQuaternion<typename LeftAndRight_::Scalar>(trusted,
                           (RotationQuaternion<typename LeftAndRight_::Scalar>(lhs.derived())).toImplementation() *
                           (RotationQuaternion<typename LeftAndRight_::Scalar>(rhs.derived())).toImplementation()
                           ));
@@ -116,6 +118,44 @@ class RotationTraits<RotationBase<Rotation_>> {
   inline static Vector_ rotate(const RotationBase<Rotation_>& rotation, const Vector_& vector){
     return static_cast<Vector_>(rotation.derived().rotate(vector.toImplementation()));
   }
+  //! Default inverse rotation converts the rotation to a rotation matrix once and multiplies with its transpose, without materializing an inverse rotation
+  template<typename get_matrix3X<Rotation_>::IndexType Cols>
+  inline static typename get_matrix3X<Rotation_>::template Matrix3X<Cols> inverseRotate(const RotationBase<Rotation_>& rotation, const typename internal::get_matrix3X<Rotation_>::template Matrix3X<Cols>& m){
+      return RotationMatrix<typename Rotation_::Scalar>(rotation.derived()).toImplementation().transpose()*m;
+  }
+  //! Default inverse rotation converts the rotation to a rotation matrix once and multiplies with its transpose, without materializing an inverse rotation
+  template<typename Vector_>
+  inline static Vector_ inverseRotate(const RotationBase<Rotation_>& rotation, const Vector_& vector){
+    return static_cast<Vector_>(rotation.derived().inverseRotate(vector.toImplementation()));
+  }
+  //! Rotates into a caller-provided buffer, so steady-state loops allocate nothing
+  template<typename get_matrix3X<Rotation_>::IndexType Cols>
+  inline static void rotate(const RotationBase<Rotation_>& rotation, const typename get_matrix3X<Rotation_>::template Matrix3X<Cols>& in, typename get_matrix3X<Rotation_>::template Matrix3X<Cols>& out){
+    out.resize(3, in.cols());
+    out.noalias() = RotationMatrix<typename Rotation_::Scalar>(rotation.derived()).toImplementation()*in;
+  }
+  //! Rotates column-wise in place; each column goes through a fixed-size stack temporary
+  template<typename get_matrix3X<Rotation_>::IndexType Cols>
+  inline static void rotateInPlace(const RotationBase<Rotation_>& rotation, typename get_matrix3X<Rotation_>::template Matrix3X<Cols>& m){
+    const Eigen::Matrix<typename Rotation_::Scalar, 3, 3> rotationMatrix = RotationMatrix<typename Rotation_::Scalar>(rotation.derived()).toImplementation();
+    for (typename get_matrix3X<Rotation_>::IndexType i = 0; i < m.cols(); ++i) {
+      m.col(i) = rotationMatrix*m.col(i);
+    }
+  }
+  //! Rotates in reverse into a caller-provided buffer, so steady-state loops allocate nothing
+  template<typename get_matrix3X<Rotation_>::IndexType Cols>
+  inline static void inverseRotate(const RotationBase<Rotation_>& rotation, const typename get_matrix3X<Rotation_>::template Matrix3X<Cols>& in, typename get_matrix3X<Rotation_>::template Matrix3X<Cols>& out){
+    out.resize(3, in.cols());
+    out.noalias() = RotationMatrix<typename Rotation_::Scalar>(rotation.derived()).toImplementation().transpose()*in;
+  }
+  //! Rotates column-wise in reverse in place; each column goes through a fixed-size stack temporary
+  template<typename get_matrix3X<Rotation_>::IndexType Cols>
+  inline static void inverseRotateInPlace(const RotationBase<Rotation_>& rotation, typename get_matrix3X<Rotation_>::template Matrix3X<Cols>& m){
+    const Eigen::Matrix<typename Rotation_::Scalar, 3, 3> transposedMatrix = RotationMatrix<typename Rotation_::Scalar>(rotation.derived()).toImplementation().transpose();
+    for (typename get_matrix3X<Rotation_>::IndexType i = 0; i < m.cols(); ++i) {
+      m.col(i) = transposedMatrix*m.col(i);
+    }
+  }
 
 };
 
@@ -222,7 +262,67 @@ class RandomTraits<RotationBase<Rotation_>> {
   }
 };
 
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Covariance Rotation Traits
+ * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+/*! \brief Fused R*C*R^T kernel exploiting the symmetry of the result.
+ *  Only the upper triangle of the second product is computed and mirrored,
+ *  saving roughly half the flops of the second GEMM.
+ */
+template<typename PrimType_>
+inline Eigen::Matrix<PrimType_, 3, 3> rotateCovarianceFused(const Eigen::Matrix<PrimType_, 3, 3>& rotationMatrix, const Eigen::Matrix<PrimType_, 3, 3>& covariance) {
+  const Eigen::Matrix<PrimType_, 3, 3> halfRotated = rotationMatrix*covariance;
+  Eigen::Matrix<PrimType_, 3, 3> rotated;
+  for (int row = 0; row < 3; row++) {
+    for (int col = row; col < 3; col++) {
+      rotated(row, col) = halfRotated.row(row).dot(rotationMatrix.row(col));
+      rotated(col, row) = rotated(row, col);
+    }
+  }
+  return rotated;
+}
+
+template<typename Rotation_>
+class RotateCovarianceTraits<RotationBase<Rotation_>> {
+ public:
+  inline static Eigen::Matrix<typename Rotation_::Scalar, 3, 3> rotate_covariance(const Rotation_& rotation, const Eigen::Matrix<typename Rotation_::Scalar, 3, 3>& covariance) {
+    typedef typename Rotation_::Scalar Scalar;
+    return rotateCovarianceFused<Scalar>(RotationMatrix<Scalar>(rotation).matrix(), covariance);
+  }
+};
+
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Fold-composition helpers
+ * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+template<typename PrimType_>
+inline Eigen::Quaternion<PrimType_> composeAllFold(const Eigen::Quaternion<PrimType_>& product) {
+  return product;
+}
+
+template<typename PrimType_, typename First_, typename... Rest_>
+inline Eigen::Quaternion<PrimType_> composeAllFold(const Eigen::Quaternion<PrimType_>& product, const RotationBase<First_>& first, const RotationBase<Rest_>&... rest) {
+  return composeAllFold<PrimType_>(Eigen::Quaternion<PrimType_>(product*RotationQuaternion<PrimType_>(first.derived()).toImplementation()), rest...);
+}
+
 } // namespace internal
+
+/*! \brief Concatenates an arbitrary number of rotations with a single final normalization.
+ *
+ *  Chaining RotationBase::operator* keeps every intermediate result normalized. This
+ *  fold multiplies the raw quaternions and normalizes the product exactly once, which
+ *  saves one square root per link in long kinematic chains. The arguments are ordered
+ *  like operator*: composeAll(r3, r2, r1) equals r3*r2*r1.
+ *
+ *  \returns the composed rotation as a rotation quaternion with the scalar type of the first argument
+ */
+template<typename First_, typename... Rest_>
+RotationQuaternion<typename internal::get_scalar<First_>::Scalar> composeAll(const RotationBase<First_>& first, const RotationBase<Rest_>&... rest) {
+  typedef typename internal::get_scalar<First_>::Scalar Scalar;
+  const Eigen::Quaternion<Scalar> product =
+      internal::composeAllFold<Scalar>(RotationQuaternion<Scalar>(first.derived()).toImplementation(), rest...);
+  return RotationQuaternion<Scalar>(trusted, product.normalized());
+}
+
 } // namespace kindr
 
 
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <Eigen/Eigenvalues>
+
+#include "kindr/rotations/Rotation.hpp"
+
+namespace kindr {
+
+/*! \class RotationAverage
+ * \brief Weighted rotation averaging with Markley's quaternion accumulation.
+ *
+ *  The weighted chordal-L2 mean of a set of rotations is the eigenvector to the
+ *  largest eigenvalue of M = sum_i w_i q_i q_i^T. The accumulator keeps this
+ *  fixed 4x4 symmetric matrix in place: add() is O(1) with no heap traffic, and
+ *  the sign of an individual sample does not matter since q and -q contribute
+ *  the same outer product. get() solves the small eigenproblem on demand.
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+class RotationAverage {
+ public:
+  typedef PrimType_ Scalar;
+  typedef Eigen::Matrix<PrimType_, 4, 4> Matrix4;
+  typedef Eigen::Matrix<PrimType_, 4, 1> Vector4;
+
+  RotationAverage() {
+    reset();
+  }
+
+  /*! \brief Clears the accumulator. */
+  void reset() {
+    accumulator_.setZero();
+    weightSum_ = PrimType_(0.0);
+    numSamples_ = 0;
+  }
+
+  /*! \brief Adds a rotation sample in place (no temporaries beyond the stack).
+   *  \param rotation  sample in any parameterization
+   *  \param weight    non-negative sample weight (default 1)
+   */
+  template<typename Rotation_>
+  void add(const RotationBase<Rotation_>& rotation, PrimType_ weight = PrimType_(1.0)) {
+    const RotationQuaternion<PrimType_> quaternion(rotation.derived());
+    Vector4 coefficients;
+    coefficients << quaternion.w(), quaternion.x(), quaternion.y(), quaternion.z();
+    accumulator_.noalias() += weight*coefficients*coefficients.transpose();
+    weightSum_ += weight;
+    numSamples_++;
+  }
+
+  /*! \brief Number of samples added since the last reset. */
+  std::size_t getNumSamples() const {
+    return numSamples_;
+  }
+
+  /*! \brief Sum of the sample weights since the last reset. */
+  PrimType_ getWeightSum() const {
+    return weightSum_;
+  }
+
+  /*! \brief Read access to the accumulated 4x4 matrix. */
+  const Matrix4& getAccumulatorMatrix() const {
+    return accumulator_;
+  }
+
+  /*! \brief Solves for the weighted mean rotation.
+   *
+   *  Asserts that at least one sample with positive weight was added.
+   *  \returns the mean as a rotation quaternion with non-negative real part
+   */
+  RotationQuaternion<PrimType_> get() const {
+    KINDR_ASSERT_TRUE(std::runtime_error, weightSum_ > PrimType_(0.0), "RotationAverage has no samples!");
+    const Eigen::SelfAdjointEigenSolver<Matrix4> solver(accumulator_);
+    // eigenvalues are sorted ascending: the mean is the last eigenvector
+    Vector4 mean = solver.eigenvectors().col(3);
+    if (mean(0) < PrimType_(0.0)) {
+      mean = -mean;
+    }
+    return RotationQuaternion<PrimType_>(mean(0), mean(1), mean(2), mean(3));
+  }
+
+ private:
+  Matrix4 accumulator_;
+  PrimType_ weightSum_;
+  std::size_t numSamples_;
+};
+
+//! \brief Rotation average with primitive type double
+typedef RotationAverage<double> RotationAverageD;
+//! \brief Rotation average with primitive type float
+typedef RotationAverage<float> RotationAverageF;
+
+} // namespace kindr
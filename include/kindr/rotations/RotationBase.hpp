@@ -29,6 +29,7 @@
 #pragma once
 
 #include "kindr/common/common.hpp"
+#include "kindr/common/Instrumentation.hpp"
 #include "kindr/quaternions/QuaternionBase.hpp"
 #include "kindr/vectors/VectorBase.hpp"
 
@@ -38,6 +39,8 @@ namespace kindr {
 /*! \ingroup rotations
  */
 
+template<typename Derived_>
+class RotationBase;
 
 //! Internal stuff (only for developers)
 namespace internal {
@@ -82,6 +85,22 @@ class ComparisonTraits {
 
 
 
+/*! \brief Fast comparison traits comparing rotations in their native parameterization
+ *  \class FastComparisonTraits
+ *
+ *  The default falls back to the disparity angle. Specializations compare the
+ *  stored parameters directly (with sign-ambiguity handling where required)
+ *  and therefore construct no canonical temporaries.
+ *  (only for advanced users)
+ */
+template<typename Left_, typename Right_>
+class FastComparisonTraits {
+ public:
+  inline static bool isNear(const Left_& left, const Right_& right, typename Left_::Scalar tol) {
+    return ComparisonTraits<RotationBase<Left_>, RotationBase<Right_>>::get_disparity_angle(left, right) <= tol;
+  }
+};
+
 /*! \brief Rotation traits for rotating vectors and matrices
  *  \class RotationTraits
  *  (only for advanced users)
@@ -90,6 +109,17 @@ template<typename Rotation_>
 class RotationTraits {
  public:
 // inline static typename internal::get_matrix3X<Derived_>::type rotate(const Rotation_& r, const typename internal::get_vector3<Derived_>::type& );
+// inline static typename internal::get_matrix3X<Derived_>::type inverseRotate(const Rotation_& r, const typename internal::get_vector3<Derived_>::type& );
+};
+
+/*! \brief Traits for rotating covariance matrices (R*C*R^T)
+ *  \class RotateCovarianceTraits
+ *  (only for advanced users)
+ */
+template<typename Rotation_>
+class RotateCovarianceTraits {
+ public:
+//  inline static typename internal::get_matrix3X<Derived_>::template Matrix3X<3> rotate_covariance(const Rotation_& rotation, const typename internal::get_matrix3X<Derived_>::template Matrix3X<3>& covariance);
 };
 
 /*! \brief Traits for map operations
@@ -133,6 +163,13 @@ class FixingTraits {
   inline static void fix(Rotation_& rot) {
     // do nothing is the standard case
   }
+  /*! \brief First-order renormalization for high-rate integration loops.
+   *  The default defers to the exact fix; parameterizations with a cheap
+   *  first-order correction specialize this.
+   */
+  inline static void fixFast(Rotation_& rot) {
+    fix(rot);
+  }
 };
 
 
@@ -250,6 +287,7 @@ class RotationBase {
    */
   template<typename OtherDerived_>
   Derived_ operator *(const RotationBase<OtherDerived_>& other) const {
+    KINDR_COUNT_ROTATION_OPERATION("multiply", Derived_);
     return internal::MultiplicationTraits<RotationBase<Derived_>,RotationBase<OtherDerived_>>::mult(this->derived(), other.derived()); // todo: 1. ok? 2. may be optimized
   }
 
@@ -283,11 +321,26 @@ class RotationBase {
     return (angle <= tol);
   }
 
+  /*! \brief Compares two rotations with a tolerance on their native parameters.
+   *
+   *  In contrast to isNear(), which measures the disparity angle and therefore
+   *  converts both operands, this compares the stored parameters directly
+   *  (handling sign ambiguities such as q and -q for quaternions) and builds no
+   *  canonical temporaries. The tolerance applies to the parameter difference,
+   *  not to an angle.
+   *  \returns true if the parameter difference is within the tolerance
+   */
+  template<typename OtherDerived_>
+  bool isNearFast(const RotationBase<OtherDerived_>& other, typename internal::get_scalar<Derived_>::Scalar tol) const {
+    return internal::FastComparisonTraits<Derived_, OtherDerived_>::isNear(this->derived(), other.derived(), tol);
+  }
+
   /*! \brief Rotates a vector or a matrix column-wise.
    *  \returns the rotated vector or matrix
    */
   template <typename internal::get_matrix3X<Derived_>::IndexType Cols>
   typename internal::get_matrix3X<Derived_>::template Matrix3X<Cols> rotate(const typename internal::get_matrix3X<Derived_>::template Matrix3X<Cols>& matrix) const {
+    KINDR_COUNT_ROTATION_OPERATION("rotate", Derived_);
     return internal::RotationTraits<RotationBase<Derived_>>::rotate(this->derived(), matrix);
   }
 
@@ -297,7 +350,63 @@ class RotationBase {
    */
   template <typename internal::get_matrix3X<Derived_>::IndexType Cols>
   typename internal::get_matrix3X<Derived_>::template Matrix3X<Cols> inverseRotate(const typename internal::get_matrix3X<Derived_>::template Matrix3X<Cols>& matrix) const {
-    return internal::RotationTraits<RotationBase<Derived_>>::rotate(this->derived().inverted(), matrix); // todo: may be optimized
+    KINDR_COUNT_ROTATION_OPERATION("inverseRotate", Derived_);
+    return internal::RotationTraits<RotationBase<Derived_>>::inverseRotate(this->derived(), matrix);
+  }
+
+  /*! \brief Rotates a matrix column-wise into a caller-provided buffer.
+   *
+   *  In contrast to rotate(), which returns the result by value and therefore
+   *  allocates a fresh matrix for dynamic widths, this overload reuses the
+   *  caller's storage, so steady-state transform loops perform zero allocations.
+   *  \param matrix   input matrix (must not alias the output)
+   *  \param result   output buffer, resized to the input width if necessary
+   */
+  template <typename internal::get_matrix3X<Derived_>::IndexType Cols>
+  void rotate(const typename internal::get_matrix3X<Derived_>::template Matrix3X<Cols>& matrix, typename internal::get_matrix3X<Derived_>::template Matrix3X<Cols>& result) const {
+    KINDR_COUNT_ROTATION_OPERATION("rotate", Derived_);
+    internal::RotationTraits<RotationBase<Derived_>>::rotate(this->derived(), matrix, result);
+  }
+
+  /*! \brief Rotates a matrix column-wise in place.
+   *  \param matrix   matrix whose columns are replaced by their rotated values
+   */
+  template <typename internal::get_matrix3X<Derived_>::IndexType Cols>
+  void rotateInPlace(typename internal::get_matrix3X<Derived_>::template Matrix3X<Cols>& matrix) const {
+    KINDR_COUNT_ROTATION_OPERATION("rotate", Derived_);
+    internal::RotationTraits<RotationBase<Derived_>>::rotateInPlace(this->derived(), matrix);
+  }
+
+  /*! \brief Rotates a matrix column-wise in reverse into a caller-provided buffer.
+   *  \param matrix   input matrix (must not alias the output)
+   *  \param result   output buffer, resized to the input width if necessary
+   */
+  template <typename internal::get_matrix3X<Derived_>::IndexType Cols>
+  void inverseRotate(const typename internal::get_matrix3X<Derived_>::template Matrix3X<Cols>& matrix, typename internal::get_matrix3X<Derived_>::template Matrix3X<Cols>& result) const {
+    KINDR_COUNT_ROTATION_OPERATION("inverseRotate", Derived_);
+    internal::RotationTraits<RotationBase<Derived_>>::inverseRotate(this->derived(), matrix, result);
+  }
+
+  /*! \brief Rotates a matrix column-wise in reverse in place.
+   *  \param matrix   matrix whose columns are replaced by their reverse rotated values
+   */
+  template <typename internal::get_matrix3X<Derived_>::IndexType Cols>
+  void inverseRotateInPlace(typename internal::get_matrix3X<Derived_>::template Matrix3X<Cols>& matrix) const {
+    KINDR_COUNT_ROTATION_OPERATION("inverseRotate", Derived_);
+    internal::RotationTraits<RotationBase<Derived_>>::inverseRotateInPlace(this->derived(), matrix);
+  }
+
+  /*! \brief Rotates a 3x3 covariance matrix.
+   *
+   *  Computes R*C*R^T in one fused kernel: the rotation is converted to a
+   *  matrix once and the symmetry of the result is exploited to compute only
+   *  the upper triangle, instead of two full GEMMs with a temporary.
+   *  \param covariance   symmetric 3x3 covariance matrix
+   *  \returns the rotated covariance matrix
+   */
+  typename internal::get_matrix3X<Derived_>::template Matrix3X<3> rotateCovariance(const typename internal::get_matrix3X<Derived_>::template Matrix3X<3>& covariance) const {
+    KINDR_COUNT_ROTATION_OPERATION("rotateCovariance", Derived_);
+    return internal::RotateCovarianceTraits<RotationBase<Derived_>>::rotate_covariance(this->derived(), covariance);
   }
 
   /*! \brief Rotates a vector.
@@ -305,6 +414,7 @@ class RotationBase {
    */
   template <typename Vector_>
   Vector_ rotate(const Vector_& vector) const {
+    KINDR_COUNT_ROTATION_OPERATION("rotate", Derived_);
     return internal::RotationTraits<RotationBase<Derived_>>::rotate(this->derived(), vector);
   }
 
@@ -313,7 +423,8 @@ class RotationBase {
    */
   template <typename Vector_>
   Vector_ inverseRotate(const Vector_& vector) const {
-    return internal::RotationTraits<RotationBase<Derived_>>::rotate(this->derived().inverted(), vector);
+    KINDR_COUNT_ROTATION_OPERATION("inverseRotate", Derived_);
+    return internal::RotationTraits<RotationBase<Derived_>>::inverseRotate(this->derived(), vector);
   }
 
   /*! \brief Sets the rotation using an exponential map @todo avoid altering the rotation
@@ -345,6 +456,19 @@ class RotationBase {
     return internal::BoxOperationTraits<RotationBase<Derived_>, RotationBase<Derived_>>::box_plus(this->derived(), vector);
   }
 
+  /*! \brief Spherical linear interpolation towards another rotation.
+   *
+   *  Follows the geodesic from this rotation (alpha = 0) to the other rotation (alpha = 1)
+   *  by scaling the box minus difference: this->boxPlus(alpha*other.boxMinus(*this)).
+   * \param other   rotation interpolated towards
+   * \param alpha   interpolation parameter in [0, 1]
+   * \returns interpolated rotation
+   */
+  template<typename OtherDerived_>
+  Derived_ slerp(const RotationBase<OtherDerived_>& other, typename internal::get_scalar<Derived_>::Scalar alpha) const {
+    return this->boxPlus(alpha*other.derived().boxMinus(this->derived()));
+  }
+
 
   /*! \brief Sets the rotation C_IB from two vectors such that I_v = C_IB*B_v i.e.
    * I_v = this->rotate(B_v).
@@ -360,6 +484,16 @@ class RotationBase {
   void fix() {
     internal::FixingTraits<Derived_>::fix(this->derived());
   }
+
+  /*! \brief Fixes the rotation with a cheap first-order correction.
+   *
+   *  Intended for high-rate integration loops where the parameters drift by
+   *  parts-per-million per step. Falls back to the exact fix when the drift is
+   *  too large for the first-order correction to be accurate.
+   */
+  void fixFast() {
+    internal::FixingTraits<Derived_>::fixFast(this->derived());
+  }
 };
 
 
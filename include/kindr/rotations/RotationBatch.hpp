@@ -0,0 +1,1028 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <vector>
+
+#include <Eigen/Core>
+#include <Eigen/StdVector>
+
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/common/TaskPool.hpp"
+#include "kindr/math/VectorizedTrigonometry.hpp"
+#include "kindr/rotations/Rotation.hpp"
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+namespace kindr {
+
+/*! \class VectorBatch3
+ *  \brief Structure-of-arrays storage for a batch of 3d vectors.
+ *
+ *  The three coordinates are stored in separate contiguous arrays, which allows
+ *  the batch rotation kernels to process several vectors per instruction instead
+ *  of one quaternion-vector sandwich product per point.
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+class VectorBatch3 {
+ public:
+  /*! \brief The primitive type.
+   *  Float/Double
+   */
+  typedef PrimType_ Scalar;
+
+  //! Aligned contiguous storage of one coordinate array
+  typedef std::vector<PrimType_, Eigen::aligned_allocator<PrimType_>> CoordinateArray;
+
+  /*! \brief Default constructor creates an empty batch.
+   */
+  VectorBatch3() = default;
+
+  /*! \brief Constructor which allocates storage for a given number of vectors.
+   *  \param size   number of vectors in the batch
+   */
+  explicit VectorBatch3(std::size_t size)
+    : x_(size), y_(size), z_(size) {
+  }
+
+  /*! \brief Constructor from a 3xN matrix (array-of-structures layout).
+   *  \param matrix   matrix whose columns are copied into the batch
+   */
+  explicit VectorBatch3(const Eigen::Matrix<PrimType_, 3, Eigen::Dynamic>& matrix)
+    : x_(matrix.cols()), y_(matrix.cols()), z_(matrix.cols()) {
+    const std::size_t size = matrix.cols();
+    Eigen::Map<Eigen::Matrix<PrimType_, Eigen::Dynamic, 1>>(x_.data(), size) = matrix.row(0).transpose();
+    Eigen::Map<Eigen::Matrix<PrimType_, Eigen::Dynamic, 1>>(y_.data(), size) = matrix.row(1).transpose();
+    Eigen::Map<Eigen::Matrix<PrimType_, Eigen::Dynamic, 1>>(z_.data(), size) = matrix.row(2).transpose();
+  }
+
+  /*! \brief Number of vectors stored in the batch.
+   *  \returns batch size
+   */
+  std::size_t size() const {
+    return x_.size();
+  }
+
+  /*! \brief Resizes the batch.
+   *  \param size   new number of vectors
+   */
+  void resize(std::size_t size) {
+    x_.resize(size);
+    y_.resize(size);
+    z_.resize(size);
+  }
+
+  /*! \brief Appends a vector to the batch.
+   *  \param vector   vector to append
+   */
+  void append(const Eigen::Matrix<PrimType_, 3, 1>& vector) {
+    x_.push_back(vector(0));
+    y_.push_back(vector(1));
+    z_.push_back(vector(2));
+  }
+
+  /*! \brief Reads a single vector from the batch.
+   *  \param index   index of the vector
+   *  \returns vector at the given index
+   */
+  Eigen::Matrix<PrimType_, 3, 1> getVector(std::size_t index) const {
+    return Eigen::Matrix<PrimType_, 3, 1>(x_[index], y_[index], z_[index]);
+  }
+
+  /*! \brief Copies the batch into a 3xN matrix (array-of-structures layout).
+   *  \returns matrix whose columns are the vectors of the batch
+   */
+  Eigen::Matrix<PrimType_, 3, Eigen::Dynamic> toImplementation() const {
+    Eigen::Matrix<PrimType_, 3, Eigen::Dynamic> matrix(3, size());
+    matrix.row(0) = Eigen::Map<const Eigen::Matrix<PrimType_, Eigen::Dynamic, 1>>(x_.data(), size()).transpose();
+    matrix.row(1) = Eigen::Map<const Eigen::Matrix<PrimType_, Eigen::Dynamic, 1>>(y_.data(), size()).transpose();
+    matrix.row(2) = Eigen::Map<const Eigen::Matrix<PrimType_, Eigen::Dynamic, 1>>(z_.data(), size()).transpose();
+    return matrix;
+  }
+
+  //! Mutable pointer to the first coordinate array
+  PrimType_* x() { return x_.data(); }
+  //! Mutable pointer to the second coordinate array
+  PrimType_* y() { return y_.data(); }
+  //! Mutable pointer to the third coordinate array
+  PrimType_* z() { return z_.data(); }
+  //! Constant pointer to the first coordinate array
+  const PrimType_* x() const { return x_.data(); }
+  //! Constant pointer to the second coordinate array
+  const PrimType_* y() const { return y_.data(); }
+  //! Constant pointer to the third coordinate array
+  const PrimType_* z() const { return z_.data(); }
+
+ private:
+  //! Coordinate arrays
+  CoordinateArray x_;
+  CoordinateArray y_;
+  CoordinateArray z_;
+};
+
+//! \brief VectorBatch3 with primitive type double
+typedef VectorBatch3<double> VectorBatch3D;
+//! \brief VectorBatch3 with primitive type float
+typedef VectorBatch3<float> VectorBatch3F;
+
+
+namespace internal {
+
+/*! \brief Applies a 3x3 matrix to structure-of-arrays coordinate streams.
+ *
+ *  The generic implementation maps the coordinate arrays as Eigen vectors, such
+ *  that Eigen emits vectorized fused multiply-adds for the nine-term product.
+ *  The input is copied block-wise into local temporaries before the outputs are
+ *  stored, so the output streams may alias the input streams (as in the SIMD
+ *  specializations, which read a full block before storing it).
+ *  (only for advanced users)
+ */
+template<typename PrimType_>
+class RotateBatchTraits {
+ public:
+  inline static void rotate(const Eigen::Matrix<PrimType_, 3, 3>& rotationMatrix,
+                            const PrimType_* x, const PrimType_* y, const PrimType_* z,
+                            PrimType_* xOut, PrimType_* yOut, PrimType_* zOut,
+                            std::size_t size) {
+    typedef Eigen::Map<const Eigen::Array<PrimType_, Eigen::Dynamic, 1>> ConstMap;
+    typedef Eigen::Map<Eigen::Array<PrimType_, Eigen::Dynamic, 1>> Map;
+    const std::size_t blockSize = 64u;
+    Eigen::Array<PrimType_, 64, 1> xi, yi, zi;
+    for (std::size_t i = 0u; i < size; i += blockSize) {
+      const std::size_t n = (size - i < blockSize) ? size - i : blockSize;
+      xi.head(n) = ConstMap(x + i, n);
+      yi.head(n) = ConstMap(y + i, n);
+      zi.head(n) = ConstMap(z + i, n);
+      Map(xOut + i, n) = rotationMatrix(0,0)*xi.head(n) + rotationMatrix(0,1)*yi.head(n) + rotationMatrix(0,2)*zi.head(n);
+      Map(yOut + i, n) = rotationMatrix(1,0)*xi.head(n) + rotationMatrix(1,1)*yi.head(n) + rotationMatrix(1,2)*zi.head(n);
+      Map(zOut + i, n) = rotationMatrix(2,0)*xi.head(n) + rotationMatrix(2,1)*yi.head(n) + rotationMatrix(2,2)*zi.head(n);
+    }
+  }
+};
+
+#if defined(__AVX2__) && defined(__FMA__)
+/*! \brief AVX2 kernel processing eight single-precision vectors per iteration.
+ */
+template<>
+class RotateBatchTraits<float> {
+ public:
+  inline static void rotate(const Eigen::Matrix<float, 3, 3>& rotationMatrix,
+                            const float* x, const float* y, const float* z,
+                            float* xOut, float* yOut, float* zOut,
+                            std::size_t size) {
+    const __m256 r00 = _mm256_set1_ps(rotationMatrix(0,0));
+    const __m256 r01 = _mm256_set1_ps(rotationMatrix(0,1));
+    const __m256 r02 = _mm256_set1_ps(rotationMatrix(0,2));
+    const __m256 r10 = _mm256_set1_ps(rotationMatrix(1,0));
+    const __m256 r11 = _mm256_set1_ps(rotationMatrix(1,1));
+    const __m256 r12 = _mm256_set1_ps(rotationMatrix(1,2));
+    const __m256 r20 = _mm256_set1_ps(rotationMatrix(2,0));
+    const __m256 r21 = _mm256_set1_ps(rotationMatrix(2,1));
+    const __m256 r22 = _mm256_set1_ps(rotationMatrix(2,2));
+    std::size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+      const __m256 xi = _mm256_loadu_ps(x + i);
+      const __m256 yi = _mm256_loadu_ps(y + i);
+      const __m256 zi = _mm256_loadu_ps(z + i);
+      _mm256_storeu_ps(xOut + i, _mm256_fmadd_ps(r00, xi, _mm256_fmadd_ps(r01, yi, _mm256_mul_ps(r02, zi))));
+      _mm256_storeu_ps(yOut + i, _mm256_fmadd_ps(r10, xi, _mm256_fmadd_ps(r11, yi, _mm256_mul_ps(r12, zi))));
+      _mm256_storeu_ps(zOut + i, _mm256_fmadd_ps(r20, xi, _mm256_fmadd_ps(r21, yi, _mm256_mul_ps(r22, zi))));
+    }
+    for (; i < size; ++i) {
+      const float xi = x[i], yi = y[i], zi = z[i];
+      xOut[i] = rotationMatrix(0,0)*xi + rotationMatrix(0,1)*yi + rotationMatrix(0,2)*zi;
+      yOut[i] = rotationMatrix(1,0)*xi + rotationMatrix(1,1)*yi + rotationMatrix(1,2)*zi;
+      zOut[i] = rotationMatrix(2,0)*xi + rotationMatrix(2,1)*yi + rotationMatrix(2,2)*zi;
+    }
+  }
+};
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+/*! \brief NEON kernel processing four single-precision vectors per iteration.
+ */
+template<>
+class RotateBatchTraits<float> {
+ public:
+  inline static void rotate(const Eigen::Matrix<float, 3, 3>& rotationMatrix,
+                            const float* x, const float* y, const float* z,
+                            float* xOut, float* yOut, float* zOut,
+                            std::size_t size) {
+    std::size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+      const float32x4_t xi = vld1q_f32(x + i);
+      const float32x4_t yi = vld1q_f32(y + i);
+      const float32x4_t zi = vld1q_f32(z + i);
+      float32x4_t xo = vmulq_n_f32(xi, rotationMatrix(0,0));
+      xo = vmlaq_n_f32(xo, yi, rotationMatrix(0,1));
+      xo = vmlaq_n_f32(xo, zi, rotationMatrix(0,2));
+      float32x4_t yo = vmulq_n_f32(xi, rotationMatrix(1,0));
+      yo = vmlaq_n_f32(yo, yi, rotationMatrix(1,1));
+      yo = vmlaq_n_f32(yo, zi, rotationMatrix(1,2));
+      float32x4_t zo = vmulq_n_f32(xi, rotationMatrix(2,0));
+      zo = vmlaq_n_f32(zo, yi, rotationMatrix(2,1));
+      zo = vmlaq_n_f32(zo, zi, rotationMatrix(2,2));
+      vst1q_f32(xOut + i, xo);
+      vst1q_f32(yOut + i, yo);
+      vst1q_f32(zOut + i, zo);
+    }
+    for (; i < size; ++i) {
+      const float xi = x[i], yi = y[i], zi = z[i];
+      xOut[i] = rotationMatrix(0,0)*xi + rotationMatrix(0,1)*yi + rotationMatrix(0,2)*zi;
+      yOut[i] = rotationMatrix(1,0)*xi + rotationMatrix(1,1)*yi + rotationMatrix(1,2)*zi;
+      zOut[i] = rotationMatrix(2,0)*xi + rotationMatrix(2,1)*yi + rotationMatrix(2,2)*zi;
+    }
+  }
+};
+#endif
+
+} // namespace internal
+
+
+/*! \brief Rotates a batch of vectors.
+ *
+ *  The rotation is converted to a rotation matrix once and applied to the
+ *  structure-of-arrays batch with vectorized kernels. The result may alias the
+ *  input batch.
+ *
+ *  \param rotation   rotation to apply
+ *  \param input      batch of vectors to rotate
+ *  \param output     batch the rotated vectors are written to (resized if needed)
+ *  \ingroup rotations
+ */
+template<typename Rotation_, typename PrimType_>
+void rotateBatch(const RotationBase<Rotation_>& rotation, const VectorBatch3<PrimType_>& input, VectorBatch3<PrimType_>& output) {
+  if (output.size() != input.size()) {
+    output.resize(input.size());
+  }
+  const Eigen::Matrix<PrimType_, 3, 3> rotationMatrix =
+      RotationMatrix<PrimType_>(rotation.derived()).matrix();
+  internal::RotateBatchTraits<PrimType_>::rotate(rotationMatrix,
+                                                 input.x(), input.y(), input.z(),
+                                                 output.x(), output.y(), output.z(),
+                                                 input.size());
+}
+
+/*! \brief Rotates a batch of vectors in reverse.
+ *  \param rotation   rotation whose inverse is applied
+ *  \param input      batch of vectors to rotate
+ *  \param output     batch the rotated vectors are written to (resized if needed)
+ *  \ingroup rotations
+ */
+template<typename Rotation_, typename PrimType_>
+void inverseRotateBatch(const RotationBase<Rotation_>& rotation, const VectorBatch3<PrimType_>& input, VectorBatch3<PrimType_>& output) {
+  rotateBatch(rotation.derived().inverted(), input, output);
+}
+
+/*! \class QuaternionBatch
+ *  \brief Structure-of-arrays storage for a batch of rotation quaternions.
+ *
+ *  The four quaternion coefficients are stored in separate contiguous arrays,
+ *  such that the batch composition kernels operate on several quaternions per
+ *  instruction instead of one Hamilton product per pair.
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+class QuaternionBatch {
+ public:
+  /*! \brief The primitive type.
+   *  Float/Double
+   */
+  typedef PrimType_ Scalar;
+
+  //! Aligned contiguous storage of one coefficient array
+  typedef std::vector<PrimType_, Eigen::aligned_allocator<PrimType_>> CoefficientArray;
+
+  /*! \brief Default constructor creates an empty batch.
+   */
+  QuaternionBatch() = default;
+
+  /*! \brief Constructor which allocates storage for a given number of identity quaternions.
+   *  \param size   number of quaternions in the batch
+   */
+  explicit QuaternionBatch(std::size_t size)
+    : w_(size, PrimType_(1)), x_(size, PrimType_(0)), y_(size, PrimType_(0)), z_(size, PrimType_(0)) {
+  }
+
+  /*! \brief Number of quaternions stored in the batch.
+   *  \returns batch size
+   */
+  std::size_t size() const {
+    return w_.size();
+  }
+
+  /*! \brief Resizes the batch, filling new entries with the identity rotation.
+   *  \param size   new number of quaternions
+   */
+  void resize(std::size_t size) {
+    w_.resize(size, PrimType_(1));
+    x_.resize(size, PrimType_(0));
+    y_.resize(size, PrimType_(0));
+    z_.resize(size, PrimType_(0));
+  }
+
+  /*! \brief Appends a rotation quaternion to the batch.
+   *  \param rotationQuaternion   rotation quaternion to append
+   */
+  void append(const RotationQuaternion<PrimType_>& rotationQuaternion) {
+    w_.push_back(rotationQuaternion.w());
+    x_.push_back(rotationQuaternion.x());
+    y_.push_back(rotationQuaternion.y());
+    z_.push_back(rotationQuaternion.z());
+  }
+
+  /*! \brief Reads a single rotation quaternion from the batch.
+   *  \param index   index of the quaternion
+   *  \returns rotation quaternion at the given index
+   */
+  RotationQuaternion<PrimType_> getRotationQuaternion(std::size_t index) const {
+    return RotationQuaternion<PrimType_>(w_[index], x_[index], y_[index], z_[index]);
+  }
+
+  //! Mutable pointer to the real coefficient array
+  PrimType_* w() { return w_.data(); }
+  //! Mutable pointer to the first imaginary coefficient array
+  PrimType_* x() { return x_.data(); }
+  //! Mutable pointer to the second imaginary coefficient array
+  PrimType_* y() { return y_.data(); }
+  //! Mutable pointer to the third imaginary coefficient array
+  PrimType_* z() { return z_.data(); }
+  //! Constant pointer to the real coefficient array
+  const PrimType_* w() const { return w_.data(); }
+  //! Constant pointer to the first imaginary coefficient array
+  const PrimType_* x() const { return x_.data(); }
+  //! Constant pointer to the second imaginary coefficient array
+  const PrimType_* y() const { return y_.data(); }
+  //! Constant pointer to the third imaginary coefficient array
+  const PrimType_* z() const { return z_.data(); }
+
+ private:
+  //! Coefficient arrays
+  CoefficientArray w_;
+  CoefficientArray x_;
+  CoefficientArray y_;
+  CoefficientArray z_;
+};
+
+//! \brief QuaternionBatch with primitive type double
+typedef QuaternionBatch<double> QuaternionBatchD;
+//! \brief QuaternionBatch with primitive type float
+typedef QuaternionBatch<float> QuaternionBatchF;
+
+
+namespace internal {
+
+/*! \brief Hamilton products on structure-of-arrays coefficient streams.
+ *
+ *  The loads of one iteration are completed before its stores, so the output
+ *  streams may alias either input, which the in-place accumulation relies on.
+ *  (only for advanced users)
+ */
+template<typename PrimType_>
+class ComposeBatchTraits {
+ public:
+  inline static void compose(const PrimType_* wLhs, const PrimType_* xLhs, const PrimType_* yLhs, const PrimType_* zLhs,
+                             const PrimType_* wRhs, const PrimType_* xRhs, const PrimType_* yRhs, const PrimType_* zRhs,
+                             PrimType_* wOut, PrimType_* xOut, PrimType_* yOut, PrimType_* zOut,
+                             std::size_t size) {
+    for (std::size_t i = 0; i < size; ++i) {
+      const PrimType_ w1 = wLhs[i], x1 = xLhs[i], y1 = yLhs[i], z1 = zLhs[i];
+      const PrimType_ w2 = wRhs[i], x2 = xRhs[i], y2 = yRhs[i], z2 = zRhs[i];
+      wOut[i] = w1*w2 - x1*x2 - y1*y2 - z1*z2;
+      xOut[i] = w1*x2 + x1*w2 + y1*z2 - z1*y2;
+      yOut[i] = w1*y2 - x1*z2 + y1*w2 + z1*x2;
+      zOut[i] = w1*z2 + x1*y2 - y1*x2 + z1*w2;
+    }
+  }
+};
+
+} // namespace internal
+
+
+namespace internal {
+
+//! Minimum elements per chunk when a batch sweep is split across the installed executor;
+//! below this, the per-chunk dispatch costs more than the vectorized loop saves.
+static const std::size_t batchParallelGrain = 4096u;
+
+} // namespace internal
+
+/*! \brief Composes two batches of rotation quaternions element-wise.
+ *
+ *  Writes out[i] = lhs[i]*rhs[i] for all indices with a vectorized
+ *  structure-of-arrays Hamilton product. Both batches must have the same size.
+ *
+ *  \param lhs      batch of left-hand side quaternions
+ *  \param rhs      batch of right-hand side quaternions
+ *  \param output   batch the products are written to (resized if needed)
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+void composeBatch(const QuaternionBatch<PrimType_>& lhs, const QuaternionBatch<PrimType_>& rhs, QuaternionBatch<PrimType_>& output) {
+  KINDR_ASSERT_TRUE(std::runtime_error, lhs.size() == rhs.size(), "Batches have different sizes.");
+  if (output.size() != lhs.size()) {
+    output.resize(lhs.size());
+  }
+  parallelFor(0u, lhs.size(), internal::batchParallelGrain, [&](std::size_t chunkBegin, std::size_t chunkEnd) {
+    internal::ComposeBatchTraits<PrimType_>::compose(lhs.w() + chunkBegin, lhs.x() + chunkBegin, lhs.y() + chunkBegin, lhs.z() + chunkBegin,
+                                                     rhs.w() + chunkBegin, rhs.x() + chunkBegin, rhs.y() + chunkBegin, rhs.z() + chunkBegin,
+                                                     output.w() + chunkBegin, output.x() + chunkBegin, output.y() + chunkBegin, output.z() + chunkBegin,
+                                                     chunkEnd - chunkBegin);
+  });
+}
+
+/*! \brief Applies the SO(3) exponential map to a batch of tangent vectors.
+ *
+ *  Writes output[i] = exp(tangent[i]) as a unit quaternion. The small-angle
+ *  case is handled with a branchless Taylor select per element, so the sweep
+ *  stays vectorizable across the batch.
+ *
+ *  \param tangents   batch of rotation vectors
+ *  \param output     batch the unit quaternions are written to (resized if needed)
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+void expMapBatch(const VectorBatch3<PrimType_>& tangents, QuaternionBatch<PrimType_>& output) {
+  if (output.size() != tangents.size()) {
+    output.resize(tangents.size());
+  }
+  const PrimType_ eps = std::numeric_limits<PrimType_>::epsilon();
+  parallelFor(0u, tangents.size(), internal::batchParallelGrain, [&](std::size_t chunkBegin, std::size_t chunkEnd) {
+    for (std::size_t i = chunkBegin; i < chunkEnd; ++i) {
+      const PrimType_ vx = tangents.x()[i], vy = tangents.y()[i], vz = tangents.z()[i];
+      const PrimType_ angleSquared = vx*vx + vy*vy + vz*vz;
+      const PrimType_ angle = sqrt(angleSquared);
+      const PrimType_ halfAngle = PrimType_(0.5)*angle;
+      // k = sin(angle/2)/angle, with its Taylor expansion below the cutoff
+      const PrimType_ k = (angle > eps) ? sin(halfAngle)/angle : PrimType_(0.5) - angleSquared/PrimType_(48);
+      output.w()[i] = cos(halfAngle);
+      output.x()[i] = k*vx;
+      output.y()[i] = k*vy;
+      output.z()[i] = k*vz;
+    }
+  });
+}
+
+/*! \brief Applies the SO(3) logarithmic map to a batch of unit quaternions.
+ *
+ *  Writes output[i] = log(input[i]) as the unique rotation vector with angle
+ *  in [0,pi], matching logarithmicMap() on a single rotation.
+ *
+ *  \param input    batch of unit quaternions
+ *  \param output   batch the rotation vectors are written to (resized if needed)
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+void logMapBatch(const QuaternionBatch<PrimType_>& input, VectorBatch3<PrimType_>& output) {
+  if (output.size() != input.size()) {
+    output.resize(input.size());
+  }
+  const PrimType_ eps = std::numeric_limits<PrimType_>::epsilon();
+  parallelFor(0u, input.size(), internal::batchParallelGrain, [&](std::size_t chunkBegin, std::size_t chunkEnd) {
+    for (std::size_t i = chunkBegin; i < chunkEnd; ++i) {
+      // Map q and -q to the same tangent vector by flipping to non-negative real part.
+      const PrimType_ sign = (input.w()[i] < PrimType_(0)) ? PrimType_(-1) : PrimType_(1);
+      const PrimType_ w = sign*input.w()[i];
+      const PrimType_ x = sign*input.x()[i], y = sign*input.y()[i], z = sign*input.z()[i];
+      const PrimType_ imagNorm = sqrt(x*x + y*y + z*z);
+      const PrimType_ angle = PrimType_(2)*atan2(imagNorm, w);
+      const PrimType_ k = (imagNorm > eps) ? angle/imagNorm : PrimType_(2)/w;
+      output.x()[i] = k*x;
+      output.y()[i] = k*y;
+      output.z()[i] = k*z;
+    }
+  });
+}
+
+/*! \brief Applies the box plus operation to a batch of unit quaternions in place.
+ *
+ *  Writes rotations[i] = exp(tangent[i])*rotations[i], matching boxPlus() on a
+ *  single rotation.
+ *
+ *  \param rotations   batch that is retracted in place
+ *  \param tangents    batch of state increments
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+void boxPlusBatch(QuaternionBatch<PrimType_>& rotations, const VectorBatch3<PrimType_>& tangents) {
+  KINDR_ASSERT_TRUE(std::runtime_error, rotations.size() == tangents.size(), "Batches have different sizes.");
+  QuaternionBatch<PrimType_> increments;
+  expMapBatch(tangents, increments);
+  internal::ComposeBatchTraits<PrimType_>::compose(increments.w(), increments.x(), increments.y(), increments.z(),
+                                                   rotations.w(), rotations.x(), rotations.y(), rotations.z(),
+                                                   rotations.w(), rotations.x(), rotations.y(), rotations.z(),
+                                                   rotations.size());
+}
+
+/*! \brief Applies the box minus operation to two batches of unit quaternions.
+ *
+ *  Writes output[i] = log(lhs[i]*rhs[i]^-1), matching boxMinus() on a single
+ *  rotation.
+ *
+ *  \param lhs      batch of left-hand side quaternions
+ *  \param rhs      batch of right-hand side quaternions
+ *  \param output   batch the tangent vectors are written to (resized if needed)
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+void boxMinusBatch(const QuaternionBatch<PrimType_>& lhs, const QuaternionBatch<PrimType_>& rhs, VectorBatch3<PrimType_>& output) {
+  KINDR_ASSERT_TRUE(std::runtime_error, lhs.size() == rhs.size(), "Batches have different sizes.");
+  QuaternionBatch<PrimType_> difference(lhs.size());
+  // lhs*rhs^-1: conjugating rhs flips the sign of its imaginary coefficients.
+  QuaternionBatch<PrimType_> rhsConjugate(rhs.size());
+  typedef Eigen::Map<Eigen::Array<PrimType_, Eigen::Dynamic, 1>> Map;
+  typedef Eigen::Map<const Eigen::Array<PrimType_, Eigen::Dynamic, 1>> ConstMap;
+  Map(rhsConjugate.w(), rhs.size()) = ConstMap(rhs.w(), rhs.size());
+  Map(rhsConjugate.x(), rhs.size()) = -ConstMap(rhs.x(), rhs.size());
+  Map(rhsConjugate.y(), rhs.size()) = -ConstMap(rhs.y(), rhs.size());
+  Map(rhsConjugate.z(), rhs.size()) = -ConstMap(rhs.z(), rhs.size());
+  composeBatch(lhs, rhsConjugate, difference);
+  logMapBatch(difference, output);
+}
+
+/*! \brief Fills a batch with uniformly distributed random unit quaternions.
+ *
+ *  Uses Shoemake's subgroup algorithm driven by the thread-local random
+ *  engine, so the whole batch is sampled in one pass without reseeding a
+ *  generator per quaternion.
+ *
+ *  \param batch   batch that is overwritten with random rotations
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+void setRandomBatch(QuaternionBatch<PrimType_>& batch) {
+  std::uniform_real_distribution<PrimType_> distr(PrimType_(0), PrimType_(1));
+  internal::Xoshiro256PlusPlus& engine = internal::getRandomEngine();
+  for (std::size_t i = 0; i < batch.size(); ++i) {
+    const PrimType_ u1 = distr(engine);
+    const PrimType_ u2 = PrimType_(2.0*M_PI)*distr(engine);
+    const PrimType_ u3 = PrimType_(2.0*M_PI)*distr(engine);
+    const PrimType_ a = sqrt(PrimType_(1) - u1);
+    const PrimType_ b = sqrt(u1);
+    batch.x()[i] = a*sin(u2);
+    batch.y()[i] = a*cos(u2);
+    batch.z()[i] = b*sin(u3);
+    batch.w()[i] = b*cos(u3);
+  }
+}
+
+/*! \brief Accumulates incremental rotations into a batch of rotation quaternions in place.
+ *
+ *  Writes accumulator[i] = accumulator[i]*increment[i] for all indices, which
+ *  chains incremental rotations without materializing a second batch.
+ *
+ *  \param accumulator   batch that is updated in place
+ *  \param increment     batch of incremental rotations
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+void accumulateBatch(QuaternionBatch<PrimType_>& accumulator, const QuaternionBatch<PrimType_>& increment) {
+  KINDR_ASSERT_TRUE(std::runtime_error, accumulator.size() == increment.size(), "Batches have different sizes.");
+  internal::ComposeBatchTraits<PrimType_>::compose(accumulator.w(), accumulator.x(), accumulator.y(), accumulator.z(),
+                                                   increment.w(), increment.x(), increment.y(), increment.z(),
+                                                   accumulator.w(), accumulator.x(), accumulator.y(), accumulator.z(),
+                                                   accumulator.size());
+}
+
+
+namespace internal {
+
+/*! \brief Quaternion-to-rotation-matrix conversion on structure-of-arrays coefficient streams.
+ *
+ *  One iteration reads the four coefficient lanes of a quaternion and writes
+ *  the nine matrix entries; the coefficient loads are contiguous per lane, so
+ *  the compiler unrolls and vectorizes the sweep across quaternions instead of
+ *  going through ConversionTraits one rotation at a time.
+ *  (only for advanced users)
+ */
+template<typename PrimType_>
+class QuaternionToMatrixBatchTraits {
+ public:
+  inline static void convert(const PrimType_* w, const PrimType_* x, const PrimType_* y, const PrimType_* z,
+                             PrimType_* packedMatrices, std::size_t size) {
+    for (std::size_t i = 0; i < size; ++i) {
+      const PrimType_ wi = w[i], xi = x[i], yi = y[i], zi = z[i];
+      const PrimType_ xx = xi*xi, yy = yi*yi, zz = zi*zi;
+      const PrimType_ xy = xi*yi, xz = xi*zi, yz = yi*zi;
+      const PrimType_ wx = wi*xi, wy = wi*yi, wz = wi*zi;
+      PrimType_* matrix = packedMatrices + 9u*i;
+      // column-major 3x3: column 0
+      matrix[0] = PrimType_(1) - PrimType_(2)*(yy + zz);
+      matrix[1] = PrimType_(2)*(xy + wz);
+      matrix[2] = PrimType_(2)*(xz - wy);
+      // column 1
+      matrix[3] = PrimType_(2)*(xy - wz);
+      matrix[4] = PrimType_(1) - PrimType_(2)*(xx + zz);
+      matrix[5] = PrimType_(2)*(yz + wx);
+      // column 2
+      matrix[6] = PrimType_(2)*(xz + wy);
+      matrix[7] = PrimType_(2)*(yz - wx);
+      matrix[8] = PrimType_(1) - PrimType_(2)*(xx + yy);
+    }
+  }
+};
+
+} // namespace internal
+
+
+/*! \brief Converts a batch of rotation quaternions to a packed rotation matrix array.
+ *
+ *  Each column of the output holds one 3x3 matrix in column-major order, so the
+ *  whole result is a single contiguous buffer of 9*N scalars ready for upload
+ *  staging. Reading matrix i back is a plain
+ *  Eigen::Map<const Eigen::Matrix3d>(output.col(i).data()).
+ *
+ *  \param input    batch of unit quaternions
+ *  \param output   9xN packed matrix array (resized if needed)
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+void convertToRotationMatrixBatch(const QuaternionBatch<PrimType_>& input, Eigen::Matrix<PrimType_, 9, Eigen::Dynamic>& output) {
+  if (output.cols() != static_cast<Eigen::Index>(input.size())) {
+    output.resize(9, input.size());
+  }
+  internal::QuaternionToMatrixBatchTraits<PrimType_>::convert(input.w(), input.x(), input.y(), input.z(),
+                                                              output.data(), input.size());
+}
+
+
+namespace internal {
+
+/*! \brief Vector-pair alignment on structure-of-arrays coordinate streams.
+ *
+ *  Builds the quaternion (1+dot, cross) per pair and renormalizes once, which
+ *  needs no acos/sin. The antiparallel degenerate case is resolved with
+ *  per-element selects of an orthogonal axis instead of a data-dependent
+ *  branch, so the sweep stays predictable across the batch.
+ *  (only for advanced users)
+ */
+template<typename PrimType_>
+class SetFromVectorsBatchTraits {
+ public:
+  template<bool Normalize_>
+  inline static void align(const PrimType_* xFrom, const PrimType_* yFrom, const PrimType_* zFrom,
+                           const PrimType_* xTo, const PrimType_* yTo, const PrimType_* zTo,
+                           PrimType_* wOut, PrimType_* xOut, PrimType_* yOut, PrimType_* zOut,
+                           std::size_t size) {
+    const PrimType_ eps = std::numeric_limits<PrimType_>::epsilon();
+    for (std::size_t i = 0; i < size; ++i) {
+      PrimType_ ux = xFrom[i], uy = yFrom[i], uz = zFrom[i];
+      PrimType_ vx = xTo[i], vy = yTo[i], vz = zTo[i];
+      if (Normalize_) {
+        const PrimType_ uInvNorm = PrimType_(1)/sqrt(ux*ux + uy*uy + uz*uz);
+        const PrimType_ vInvNorm = PrimType_(1)/sqrt(vx*vx + vy*vy + vz*vz);
+        ux *= uInvNorm; uy *= uInvNorm; uz *= uInvNorm;
+        vx *= vInvNorm; vy *= vInvNorm; vz *= vInvNorm;
+      }
+      const PrimType_ w = PrimType_(1) + ux*vx + uy*vy + uz*vz;
+      const PrimType_ cx = uy*vz - uz*vy;
+      const PrimType_ cy = uz*vx - ux*vz;
+      const PrimType_ cz = ux*vy - uy*vx;
+      // antiparallel pair: w vanishes and the cross product gives no axis; select
+      // a vector orthogonal to u as a half-turn axis instead. The threshold
+      // leaves headroom above eps because normalization and dot-product rounding
+      // (FMA contraction in particular) can leave w at a few eps for exactly
+      // antiparallel inputs.
+      const bool degenerate = (w <= PrimType_(1e2)*eps);
+      const bool useXY = (ux*ux > uz*uz);
+      const PrimType_ ax = useXY ? -uy : PrimType_(0);
+      const PrimType_ ay = useXY ? ux : -uz;
+      const PrimType_ az = useXY ? PrimType_(0) : uy;
+      const PrimType_ qw = degenerate ? PrimType_(0) : w;
+      const PrimType_ qx = degenerate ? ax : cx;
+      const PrimType_ qy = degenerate ? ay : cy;
+      const PrimType_ qz = degenerate ? az : cz;
+      const PrimType_ invNorm = PrimType_(1)/sqrt(qw*qw + qx*qx + qy*qy + qz*qz);
+      wOut[i] = qw*invNorm;
+      xOut[i] = qx*invNorm;
+      yOut[i] = qy*invNorm;
+      zOut[i] = qz*invNorm;
+    }
+  }
+};
+
+} // namespace internal
+
+
+/*! \brief Aligns a batch of vector pairs: output[i] rotates from[i] onto to[i].
+ *
+ *  Batched counterpart of setFromVectors() on a single rotation. The inputs are
+ *  normalized inside the kernel; antiparallel pairs yield a half turn about an
+ *  axis orthogonal to the source vector.
+ *
+ *  \param from     batch of source vectors
+ *  \param to       batch of target vectors
+ *  \param output   batch the aligning quaternions are written to (resized if needed)
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+void setFromVectorsBatch(const VectorBatch3<PrimType_>& from, const VectorBatch3<PrimType_>& to, QuaternionBatch<PrimType_>& output) {
+  KINDR_ASSERT_TRUE(std::runtime_error, from.size() == to.size(), "Batches have different sizes.");
+  if (output.size() != from.size()) {
+    output.resize(from.size());
+  }
+  internal::SetFromVectorsBatchTraits<PrimType_>::template align<true>(from.x(), from.y(), from.z(),
+                                                                       to.x(), to.y(), to.z(),
+                                                                       output.w(), output.x(), output.y(), output.z(),
+                                                                       from.size());
+}
+
+/*! \brief Aligns a batch of pre-normalized vector pairs, skipping the input normalization.
+ *
+ *  Same contract as setFromVectorsBatch(), but both batches must already hold
+ *  unit vectors (e.g. surface normals), saving two square roots per pair.
+ *
+ *  \param from     batch of unit source vectors
+ *  \param to       batch of unit target vectors
+ *  \param output   batch the aligning quaternions are written to (resized if needed)
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+void setFromUnitVectorsBatch(const VectorBatch3<PrimType_>& from, const VectorBatch3<PrimType_>& to, QuaternionBatch<PrimType_>& output) {
+  KINDR_ASSERT_TRUE(std::runtime_error, from.size() == to.size(), "Batches have different sizes.");
+  if (output.size() != from.size()) {
+    output.resize(from.size());
+  }
+  internal::SetFromVectorsBatchTraits<PrimType_>::template align<false>(from.x(), from.y(), from.z(),
+                                                                        to.x(), to.y(), to.z(),
+                                                                        output.w(), output.x(), output.y(), output.z(),
+                                                                        from.size());
+}
+
+/*! \brief Rotates a batch of 3x3 covariance matrices sharing one rotation.
+ *
+ *  The rotation is converted to a matrix once and each covariance is rotated
+ *  with the fused symmetric R*C*R^T kernel, instead of two GEMMs with a
+ *  temporary per covariance.
+ *
+ *  \param rotation      rotation applied to every covariance
+ *  \param covariances   symmetric 3x3 covariance matrices
+ *  \param output        rotated covariance matrices (resized if needed)
+ *  \ingroup rotations
+ */
+template<typename Rotation_, typename PrimType_>
+void rotateCovarianceBatch(const RotationBase<Rotation_>& rotation,
+                           const std::vector<Eigen::Matrix<PrimType_, 3, 3>, Eigen::aligned_allocator<Eigen::Matrix<PrimType_, 3, 3>>>& covariances,
+                           std::vector<Eigen::Matrix<PrimType_, 3, 3>, Eigen::aligned_allocator<Eigen::Matrix<PrimType_, 3, 3>>>& output) {
+  if (output.size() != covariances.size()) {
+    output.resize(covariances.size());
+  }
+  const Eigen::Matrix<PrimType_, 3, 3> rotationMatrix = RotationMatrix<PrimType_>(rotation.derived()).matrix();
+  for (std::size_t k = 0; k < covariances.size(); k++) {
+    output[k] = internal::rotateCovarianceFused<PrimType_>(rotationMatrix, covariances[k]);
+  }
+}
+
+/*! \brief Canonicalizes a batch of Euler angle triples in place.
+ *
+ *  Applies the branchless wrapUniqueEulerAngles() kernel to every triple, so
+ *  the loop body is free of data-dependent branches. The batch components hold
+ *  the angles in rotation-sequence order: x() the first angles, y() the middle
+ *  angles and z() the last angles, so the same batch layout serves both
+ *  EulerAnglesZyx and EulerAnglesXyz triples. Each triple ends up in the same
+ *  canonical ranges as getUniqueFast() of those classes.
+ *
+ *  \param angles   batch of Euler angle triples, canonicalized in place
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+void setUniqueEulerAnglesBatch(VectorBatch3<PrimType_>& angles) {
+  PrimType_* firstAngles = angles.x();
+  PrimType_* middleAngles = angles.y();
+  PrimType_* lastAngles = angles.z();
+  const std::size_t size = angles.size();
+  for (std::size_t k = 0; k < size; k++) {
+    wrapUniqueEulerAngles(firstAngles[k], middleAngles[k], lastAngles[k]);
+  }
+}
+
+
+namespace internal {
+
+/*! \brief Quaternion-to-ZYX-Euler extraction on structure-of-arrays coefficient streams.
+ *
+ *  Per element this is the same extraction as the RotationQuaternion to
+ *  EulerAnglesZyx ConversionTraits, but the transcendentals go through the
+ *  branchless kernels and the gimbal-lock case is folded in with selects
+ *  instead of branches, so the sweep vectorizes across quaternions.
+ *  (only for advanced users)
+ */
+template<typename PrimType_>
+class QuaternionToEulerAnglesZyxBatchTraits {
+ public:
+  inline static void convert(const PrimType_* w, const PrimType_* x, const PrimType_* y, const PrimType_* z,
+                             PrimType_* yaw, PrimType_* pitch, PrimType_* roll,
+                             std::size_t size) {
+    const PrimType_ lockThreshold = PrimType_(1e2)*std::numeric_limits<PrimType_>::epsilon();
+    for (std::size_t i = 0; i < size; ++i) {
+      const PrimType_ wi = w[i], xi = x[i], yi = y[i], zi = z[i];
+      const PrimType_ r00 = PrimType_(1) - PrimType_(2)*(yi*yi + zi*zi);
+      const PrimType_ r10 = PrimType_(2)*(xi*yi + wi*zi);
+      const PrimType_ r20 = PrimType_(2)*(xi*zi - wi*yi);
+      const PrimType_ r01 = PrimType_(2)*(xi*yi - wi*zi);
+      const PrimType_ r02 = PrimType_(2)*(xi*zi + wi*yi);
+      const PrimType_ r21 = PrimType_(2)*(yi*zi + wi*xi);
+      const PrimType_ r22 = PrimType_(1) - PrimType_(2)*(xi*xi + yi*yi);
+      const PrimType_ cosPitch = sqrt(r00*r00 + r10*r10);
+      // atan2(-r20, cosPitch) yields +-pi/2 at the lock, so only yaw and roll
+      // need the degenerate-case selects
+      const bool locked = !(cosPitch > lockThreshold);
+      const bool positivePitch = (r20 < PrimType_(0));
+      const PrimType_ rollY = locked ? (positivePitch ? r01 : -r01) : r21;
+      const PrimType_ rollX = locked ? (positivePitch ? r02 : -r02) : r22;
+      yaw[i] = locked ? PrimType_(0) : atan2Branchless(r10, r00);
+      pitch[i] = atan2Branchless(-r20, cosPitch);
+      roll[i] = atan2Branchless(rollY, rollX);
+    }
+  }
+};
+
+} // namespace internal
+
+
+/*! \brief Converts a batch of rotation quaternions to ZYX Euler angle triples.
+ *
+ *  Bulk counterpart of constructing EulerAnglesZyx(RotationQuaternion) per
+ *  element, intended for telemetry encoding of many joint orientations per
+ *  frame. The angle components land in the batch layout of
+ *  setUniqueEulerAnglesBatch(): x() holds the yaw, y() the pitch and z() the
+ *  roll angles. Near the gimbal lock the yaw is zero and the roll carries the
+ *  remaining rotation, like the scalar conversion.
+ *
+ *  \param input    batch of unit quaternions
+ *  \param angles   batch the angle triples are written to (resized if needed)
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+void convertToEulerAnglesZyxBatch(const QuaternionBatch<PrimType_>& input, VectorBatch3<PrimType_>& angles) {
+  if (angles.size() != input.size()) {
+    angles.resize(input.size());
+  }
+  internal::QuaternionToEulerAnglesZyxBatchTraits<PrimType_>::convert(input.w(), input.x(), input.y(), input.z(),
+                                                                      angles.x(), angles.y(), angles.z(),
+                                                                      input.size());
+}
+
+
+namespace internal {
+
+/*! \brief Per-element quaternion-vector rotation on structure-of-arrays streams.
+ *
+ *  Rotates each vector by its own quaternion with the two-cross-product
+ *  sandwich (t = 2 q_v x v, v' = v + w t + q_v x t), which needs no matrix
+ *  conversion per element. Inverse_ conjugates the quaternion on the fly.
+ *  (only for advanced users)
+ */
+template<typename PrimType_>
+class RotateByQuaternionBatchTraits {
+ public:
+  template<bool Inverse_>
+  inline static void rotate(const PrimType_* w, const PrimType_* x, const PrimType_* y, const PrimType_* z,
+                            const PrimType_* xIn, const PrimType_* yIn, const PrimType_* zIn,
+                            PrimType_* xOut, PrimType_* yOut, PrimType_* zOut,
+                            std::size_t size) {
+    const PrimType_ sign = Inverse_ ? PrimType_(-1) : PrimType_(1);
+    for (std::size_t i = 0; i < size; ++i) {
+      const PrimType_ qw = w[i];
+      const PrimType_ qx = sign*x[i], qy = sign*y[i], qz = sign*z[i];
+      const PrimType_ vx = xIn[i], vy = yIn[i], vz = zIn[i];
+      const PrimType_ tx = PrimType_(2)*(qy*vz - qz*vy);
+      const PrimType_ ty = PrimType_(2)*(qz*vx - qx*vz);
+      const PrimType_ tz = PrimType_(2)*(qx*vy - qy*vx);
+      xOut[i] = vx + qw*tx + qy*tz - qz*ty;
+      yOut[i] = vy + qw*ty + qz*tx - qx*tz;
+      zOut[i] = vz + qw*tz + qx*ty - qy*tx;
+    }
+  }
+};
+
+} // namespace internal
+
+
+/*! \brief Re-expresses a batch of local angular velocities in the global frame.
+ *
+ *  Batched counterpart of the GlobalAngularVelocity(rotation, localAngularVelocity)
+ *  conversion: the shared rotation is converted to a matrix once and the batch
+ *  is streamed through the vectorized rotation kernel.
+ *
+ *  \param rotation                  shared rotation of the bodies with respect to the global frame
+ *  \param localAngularVelocities    batch of angular velocities in body (local) coordinates
+ *  \param globalAngularVelocities   batch the global angular velocities are written to (resized if needed)
+ *  \ingroup rotations
+ */
+template<typename Rotation_, typename PrimType_>
+void convertToGlobalAngularVelocityBatch(const RotationBase<Rotation_>& rotation,
+                                         const VectorBatch3<PrimType_>& localAngularVelocities,
+                                         VectorBatch3<PrimType_>& globalAngularVelocities) {
+  rotateBatch(rotation, localAngularVelocities, globalAngularVelocities);
+}
+
+/*! \brief Re-expresses a batch of global angular velocities in the local frame.
+ *
+ *  Batched counterpart of the LocalAngularVelocity(rotation, globalAngularVelocity)
+ *  conversion. The transposed rotation matrix is built once; no inverse rotation
+ *  object is constructed.
+ *
+ *  \param rotation                  shared rotation of the bodies with respect to the global frame
+ *  \param globalAngularVelocities   batch of angular velocities in global coordinates
+ *  \param localAngularVelocities    batch the local angular velocities are written to (resized if needed)
+ *  \ingroup rotations
+ */
+template<typename Rotation_, typename PrimType_>
+void convertToLocalAngularVelocityBatch(const RotationBase<Rotation_>& rotation,
+                                        const VectorBatch3<PrimType_>& globalAngularVelocities,
+                                        VectorBatch3<PrimType_>& localAngularVelocities) {
+  if (localAngularVelocities.size() != globalAngularVelocities.size()) {
+    localAngularVelocities.resize(globalAngularVelocities.size());
+  }
+  const Eigen::Matrix<PrimType_, 3, 3> transposedRotationMatrix =
+      RotationMatrix<PrimType_>(rotation.derived()).matrix().transpose();
+  internal::RotateBatchTraits<PrimType_>::rotate(transposedRotationMatrix,
+                                                 globalAngularVelocities.x(), globalAngularVelocities.y(), globalAngularVelocities.z(),
+                                                 localAngularVelocities.x(), localAngularVelocities.y(), localAngularVelocities.z(),
+                                                 globalAngularVelocities.size());
+}
+
+/*! \brief Re-expresses a batch of local angular velocities with one rotation per body.
+ *
+ *  Each velocity is rotated by its own quaternion with the sandwich kernel, so
+ *  no per-body matrix conversion takes place. Both batches must have the same size.
+ *
+ *  \param rotations                 batch of body-to-global rotations, one per velocity
+ *  \param localAngularVelocities    batch of angular velocities in body (local) coordinates
+ *  \param globalAngularVelocities   batch the global angular velocities are written to (resized if needed)
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+void convertToGlobalAngularVelocityBatch(const QuaternionBatch<PrimType_>& rotations,
+                                         const VectorBatch3<PrimType_>& localAngularVelocities,
+                                         VectorBatch3<PrimType_>& globalAngularVelocities) {
+  KINDR_ASSERT_TRUE(std::runtime_error, rotations.size() == localAngularVelocities.size(), "Batches have different sizes.");
+  if (globalAngularVelocities.size() != localAngularVelocities.size()) {
+    globalAngularVelocities.resize(localAngularVelocities.size());
+  }
+  internal::RotateByQuaternionBatchTraits<PrimType_>::template rotate<false>(rotations.w(), rotations.x(), rotations.y(), rotations.z(),
+                                                                             localAngularVelocities.x(), localAngularVelocities.y(), localAngularVelocities.z(),
+                                                                             globalAngularVelocities.x(), globalAngularVelocities.y(), globalAngularVelocities.z(),
+                                                                             rotations.size());
+}
+
+/*! \brief Re-expresses a batch of global angular velocities with one rotation per body.
+ *
+ *  Each velocity is rotated by the conjugate of its own quaternion; the
+ *  conjugation happens inside the kernel. Both batches must have the same size.
+ *
+ *  \param rotations                 batch of body-to-global rotations, one per velocity
+ *  \param globalAngularVelocities   batch of angular velocities in global coordinates
+ *  \param localAngularVelocities    batch the local angular velocities are written to (resized if needed)
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+void convertToLocalAngularVelocityBatch(const QuaternionBatch<PrimType_>& rotations,
+                                        const VectorBatch3<PrimType_>& globalAngularVelocities,
+                                        VectorBatch3<PrimType_>& localAngularVelocities) {
+  KINDR_ASSERT_TRUE(std::runtime_error, rotations.size() == globalAngularVelocities.size(), "Batches have different sizes.");
+  if (localAngularVelocities.size() != globalAngularVelocities.size()) {
+    localAngularVelocities.resize(globalAngularVelocities.size());
+  }
+  internal::RotateByQuaternionBatchTraits<PrimType_>::template rotate<true>(rotations.w(), rotations.x(), rotations.y(), rotations.z(),
+                                                                            globalAngularVelocities.x(), globalAngularVelocities.y(), globalAngularVelocities.z(),
+                                                                            localAngularVelocities.x(), localAngularVelocities.y(), localAngularVelocities.z(),
+                                                                            rotations.size());
+}
+
+} // namespace kindr
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include "kindr/rotations/RotationBase.hpp"
+
+namespace kindr {
+
+/*! \class RotationInterpolator
+ * \brief Precomputed slerp between a fixed pair of rotations
+ *
+ *  Caches the relative logarithm between the two endpoints at construction, so each
+ *  evaluation costs one tangent-vector scaling and one exponential map instead of a full
+ *  boxMinus per alpha. Intended for resamplers that evaluate the same endpoint pair at
+ *  many interpolation parameters.
+ *
+ *  \tparam Rotation_ the rotation type of the endpoints
+ *  \ingroup rotations
+ */
+template<typename Rotation_>
+class RotationInterpolator {
+ public:
+  typedef typename internal::get_scalar<Rotation_>::Scalar Scalar;
+  typedef typename internal::get_matrix3X<Rotation_>::template Matrix3X<1> Vector;
+
+  /*! \brief Constructor caching the relative logarithm of the endpoints
+   *  \param start  rotation at alpha = 0
+   *  \param end    rotation at alpha = 1
+   */
+  RotationInterpolator(const Rotation_& start, const Rotation_& end)
+    : start_(start),
+      relativeLog_(end.boxMinus(start)) {
+  }
+
+  /*! \brief Evaluates the interpolation.
+   *  \param alpha  interpolation parameter in [0, 1]
+   *  \returns interpolated rotation
+   */
+  Rotation_ evaluate(Scalar alpha) const {
+    return start_.boxPlus(alpha*relativeLog_);
+  }
+
+  inline const Rotation_& getStart() const {
+    return start_;
+  }
+
+  inline const Vector& getRelativeLog() const {
+    return relativeLog_;
+  }
+
+ private:
+  Rotation_ start_;
+  Vector relativeLog_;
+};
+
+} // namespace kindr
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <cmath>
+
+#include <Eigen/Core>
+
+#include "kindr/math/LinearAlgebra.hpp"
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/rotations/RotationDiff.hpp"
+
+namespace kindr {
+
+/*!
+ * \brief Gets the 3x4 Jacobian of rotQuat.rotate(vector) with respect to the quaternion coefficients.
+ *
+ * The columns are ordered (w, x, y, z). The quaternion is treated as a free 4-vector,
+ * i.e. the Jacobian is that of the homogeneous expression
+ * (w^2 - u'u) v + 2 (u'v) u + 2 w (u x v), which coincides with rotate() on the unit sphere.
+ * This is the form needed by calibration and estimation pipelines that handle the unit-norm
+ * constraint separately.
+ *
+ * \param   rotation  rotation quaternion
+ * \param   vector    3x1-matrix
+ * \return  matrix  (3x4-matrix)
+ */
+template<typename PrimType_>
+inline static Eigen::Matrix<PrimType_, 3, 4> getJacobianOfRotateWrtQuaternion(const RotationQuaternion<PrimType_>& rotation,
+                                                                              const Eigen::Matrix<PrimType_, 3, 1>& vector) {
+  const PrimType_ w = rotation.w();
+  const Eigen::Matrix<PrimType_, 3, 1> imaginary = rotation.imaginary();
+  Eigen::Matrix<PrimType_, 3, 4> jacobian;
+  jacobian.template block<3,1>(0,0) = PrimType_(2)*(w*vector + imaginary.cross(vector));
+  jacobian.template block<3,3>(0,1) = PrimType_(2)*(imaginary.dot(vector)*Eigen::Matrix<PrimType_, 3, 3>::Identity()
+                                                    + imaginary*vector.transpose()
+                                                    - vector*imaginary.transpose()
+                                                    - w*getSkewMatrixFromVector(vector));
+  return jacobian;
+}
+
+/*!
+ * \brief Gets the 3x3 Jacobian of rotationVector.rotate(vector) with respect to the rotation vector.
+ *
+ * Uses the chain rule through the exponential map: d(R(phi) v)/d(phi) = -[R(phi) v]_x J(phi),
+ * where J is the Jacobian of the exponential map.
+ *
+ * \param   rotation  rotation vector
+ * \param   vector    3x1-matrix
+ * \return  matrix  (3x3-matrix)
+ */
+template<typename PrimType_>
+inline static Eigen::Matrix<PrimType_, 3, 3> getJacobianOfRotateWrtRotationVector(const RotationVector<PrimType_>& rotation,
+                                                                                  const Eigen::Matrix<PrimType_, 3, 1>& vector) {
+  const Eigen::Matrix<PrimType_, 3, 1> rotatedVector = rotation.rotate(vector);
+  return -getSkewMatrixFromVector(rotatedVector)*getJacobianOfExponentialMap(rotation.toImplementation());
+}
+
+/*!
+ * \brief Gets the 3x4 Jacobian of angleAxis.rotate(vector) with respect to angle and axis.
+ *
+ * The first column is the derivative with respect to the angle, the remaining 3x3 block the
+ * derivative with respect to the axis treated as a free 3-vector (the unit-norm constraint on
+ * the axis is not projected out).
+ *
+ * \param   rotation  angle-axis rotation
+ * \param   vector    3x1-matrix
+ * \return  matrix  (3x4-matrix)
+ */
+template<typename PrimType_>
+inline static Eigen::Matrix<PrimType_, 3, 4> getJacobianOfRotateWrtAngleAxis(const AngleAxis<PrimType_>& rotation,
+                                                                             const Eigen::Matrix<PrimType_, 3, 1>& vector) {
+  const PrimType_ sinAngle = sin(rotation.angle());
+  const PrimType_ cosAngle = cos(rotation.angle());
+  const Eigen::Matrix<PrimType_, 3, 1> axis = rotation.axis();
+  const PrimType_ axisDotVector = axis.dot(vector);
+  Eigen::Matrix<PrimType_, 3, 4> jacobian;
+  // Rodrigues: R v = cos(a) v + sin(a) (n x v) + (1 - cos(a)) (n'v) n
+  jacobian.template block<3,1>(0,0) = -sinAngle*vector + cosAngle*axis.cross(vector) + sinAngle*axisDotVector*axis;
+  jacobian.template block<3,3>(0,1) = -sinAngle*getSkewMatrixFromVector(vector)
+                                      + (PrimType_(1) - cosAngle)*(axis*vector.transpose()
+                                                                   + axisDotVector*Eigen::Matrix<PrimType_, 3, 3>::Identity());
+  return jacobian;
+}
+
+/*!
+ * \brief Gets the 4x3 Jacobian of the conversion from a rotation vector to a rotation quaternion.
+ *
+ * The rows are ordered (w, x, y, z). The small-angle case falls back to the Taylor expansion
+ * of the half-angle sinc terms.
+ *
+ * \param   rotationVector  rotation vector
+ * \return  matrix  (4x3-matrix)
+ */
+template<typename PrimType_>
+inline static Eigen::Matrix<PrimType_, 4, 3> getJacobianOfQuaternionWrtRotationVector(const RotationVector<PrimType_>& rotationVector) {
+  const Eigen::Matrix<PrimType_, 3, 1>& phi = rotationVector.toImplementation();
+  const PrimType_ angle = phi.norm();
+  PrimType_ k; // sin(a/2)/a
+  PrimType_ dk; // (d k/d a)/a
+  if (angle < PrimType_(1.0e-4)) {
+    k = PrimType_(0.5) - angle*angle/PrimType_(48);
+    dk = PrimType_(-1.0)/PrimType_(24);
+  } else {
+    k = sin(PrimType_(0.5)*angle)/angle;
+    dk = (PrimType_(0.5)*cos(PrimType_(0.5)*angle)*angle - sin(PrimType_(0.5)*angle))/(angle*angle*angle);
+  }
+  Eigen::Matrix<PrimType_, 4, 3> jacobian;
+  jacobian.template block<1,3>(0,0) = PrimType_(-0.5)*k*phi.transpose();
+  jacobian.template block<3,3>(1,0) = k*Eigen::Matrix<PrimType_, 3, 3>::Identity() + dk*phi*phi.transpose();
+  return jacobian;
+}
+
+/*!
+ * \brief Gets the 3x4 Jacobian of the conversion from a rotation quaternion to a rotation vector.
+ *
+ * The columns are ordered (w, x, y, z); the quaternion is assumed to have unit norm.
+ *
+ * \param   rotation  rotation quaternion
+ * \return  matrix  (3x4-matrix)
+ */
+template<typename PrimType_>
+inline static Eigen::Matrix<PrimType_, 3, 4> getJacobianOfRotationVectorWrtQuaternion(const RotationQuaternion<PrimType_>& rotation) {
+  const PrimType_ w = rotation.w();
+  const Eigen::Matrix<PrimType_, 3, 1> imaginary = rotation.imaginary();
+  const PrimType_ imaginaryNorm = imaginary.norm();
+  Eigen::Matrix<PrimType_, 3, 4> jacobian;
+  if (imaginaryNorm < PrimType_(1.0e-6)) {
+    jacobian.template block<3,1>(0,0) = PrimType_(-2)*imaginary;
+    jacobian.template block<3,3>(0,1) = PrimType_(2)/w*Eigen::Matrix<PrimType_, 3, 3>::Identity();
+    return jacobian;
+  }
+  const Eigen::Matrix<PrimType_, 3, 1> axis = imaginary/imaginaryNorm;
+  const PrimType_ angle = PrimType_(2)*atan2(imaginaryNorm, w);
+  jacobian.template block<3,1>(0,0) = PrimType_(-2)*imaginaryNorm*axis;
+  jacobian.template block<3,3>(0,1) = PrimType_(2)*w*axis*axis.transpose()
+                                      + angle/imaginaryNorm*(Eigen::Matrix<PrimType_, 3, 3>::Identity() - axis*axis.transpose());
+  return jacobian;
+}
+
+} // namespace kindr
@@ -29,6 +29,7 @@
 #pragma once
 
 #include <cmath>
+#include <limits>
 
 #include <Eigen/Geometry>
 
@@ -115,6 +116,7 @@ class RotationMatrix : public RotationBase<RotationMatrix<PrimType_>>, private E
   inline explicit RotationMatrix(const RotationBase<OtherDerived_>& other)
   // : Base(internal::ConversionTraits<RotationMatrix, OtherDerived_>::convert(other.derived()).toImplementation())
   {
+    KINDR_COUNT_CONVERSION(RotationMatrix, OtherDerived_);
     this->toImplementation() = internal::ConversionTraits<RotationMatrix, OtherDerived_>::convert(other.derived()).toImplementation();
   }
 
@@ -124,6 +126,7 @@ class RotationMatrix : public RotationBase<RotationMatrix<PrimType_>>, private E
    */
   template<typename OtherDerived_>
   RotationMatrix& operator =(const RotationBase<OtherDerived_>& other) {
+    KINDR_COUNT_CONVERSION(RotationMatrix, OtherDerived_);
     this->toImplementation() = internal::ConversionTraits<RotationMatrix, OtherDerived_>::convert(other.derived()).toImplementation();
     return *this;
   }
@@ -134,6 +137,7 @@ class RotationMatrix : public RotationBase<RotationMatrix<PrimType_>>, private E
    */
   template<typename OtherDerived_>
   RotationMatrix& operator ()(const RotationBase<OtherDerived_>& other) {
+    KINDR_COUNT_CONVERSION(RotationMatrix, OtherDerived_);
     this->toImplementation() = internal::ConversionTraits<RotationMatrix, OtherDerived_>::convert(other.derived()).toImplementation();
     return *this;
   }
@@ -179,6 +183,76 @@ class RotationMatrix : public RotationBase<RotationMatrix<PrimType_>>, private E
   return toImplementation().determinant();
   }
 
+  /*! \brief Returns only the yaw angle of the Z-Y'-X'' decomposition.
+   *
+   *  Computes the first angle of EulerAnglesZyx directly from the matrix
+   *  entries with a single atan2, skipping the full conversion. The value
+   *  matches EulerAnglesZyx, including the convention that the yaw is zero in
+   *  the gimbal lock at pitch = +-pi/2.
+   *  \returns rotation angle around the Z axis
+   */
+  Scalar getYaw() const {
+    const Scalar r00 = toImplementation()(0,0);
+    const Scalar r10 = toImplementation()(1,0);
+    if (std::sqrt(r00*r00 + r10*r10) <= Scalar(1e2)*std::numeric_limits<Scalar>::epsilon()) {
+      return Scalar(0);
+    }
+    return std::atan2(r10, r00);
+  }
+
+  /*! \brief Returns only the pitch angle of the Z-Y'-X'' decomposition.
+   *
+   *  Computes the second angle of EulerAnglesZyx directly from the matrix
+   *  entries with a single atan2.
+   *  \returns rotation angle around the Y' axis, in [-pi/2, pi/2]
+   */
+  Scalar getPitch() const {
+    const Scalar r00 = toImplementation()(0,0);
+    const Scalar r10 = toImplementation()(1,0);
+    return std::atan2(-toImplementation()(2,0), std::sqrt(r00*r00 + r10*r10));
+  }
+
+  /*! \brief Returns only the roll angle of the Z-Y'-X'' decomposition.
+   *
+   *  Computes the third angle of EulerAnglesZyx directly from the matrix
+   *  entries with a single atan2. In the gimbal lock the roll carries the
+   *  whole rotation about the locked axis, matching EulerAnglesZyx.
+   *  \returns rotation angle around the X'' axis
+   */
+  Scalar getRoll() const {
+    const Scalar r00 = toImplementation()(0,0);
+    const Scalar r10 = toImplementation()(1,0);
+    if (std::sqrt(r00*r00 + r10*r10) <= Scalar(1e2)*std::numeric_limits<Scalar>::epsilon()) {
+      return (toImplementation()(2,0) < Scalar(0)) ? std::atan2(toImplementation()(0,1), toImplementation()(0,2))
+                                                   : std::atan2(-toImplementation()(0,1), -toImplementation()(0,2));
+    }
+    return std::atan2(toImplementation()(2,1), toImplementation()(2,2));
+  }
+
+  /*! \brief Re-orthonormalizes the rotation matrix without an SVD.
+   *
+   *  fix() only rescales by the cube root of the determinant, which removes
+   *  scale drift but not loss of orthogonality. This method applies the scale
+   *  fix as a cheap first stage and then iterates the Newton-Schulz step of
+   *  the polar decomposition, R = 0.5*R*(3*I - R^T*R), which converges
+   *  quadratically to the nearest orthogonal matrix using a few 3x3
+   *  multiplies. Intended after long integration runs where the matrix has
+   *  drifted too far for fix() alone.
+   *  \returns reference
+   */
+  RotationMatrix& fixOrthonormal() {
+    this->fix();
+    Implementation& matrix = this->toImplementation();
+    for (int iteration = 0; iteration < 5; iteration++) {
+      const Implementation gram = matrix.transpose()*matrix;
+      if ((gram - Implementation::Identity()).template lpNorm<Eigen::Infinity>() <= Scalar(10)*std::numeric_limits<Scalar>::epsilon()) {
+        break;
+      }
+      matrix = Scalar(0.5)*matrix*(Scalar(3)*Implementation::Identity() - gram);
+    }
+    return *this;
+  }
+
   /*! \brief Cast to the implementation type.
    *  \returns the implementation for direct manipulation (recommended only for advanced users)
    */
@@ -335,19 +409,37 @@ class ConversionTraits<RotationMatrix<DestPrimType_>, RotationMatrix<SourcePrimT
 template<typename DestPrimType_, typename SourcePrimType_>
 class ConversionTraits<RotationMatrix<DestPrimType_>, EulerAnglesXyz<SourcePrimType_>> {
  public:
+  //! Direct closed form of C = C_x(x)*C_y(y)*C_z(z), evaluating the three sine/cosine pairs only once
   inline static RotationMatrix<DestPrimType_> convert(const EulerAnglesXyz<SourcePrimType_>& xyz) {
-      RotationMatrix<DestPrimType_> matrix;
-      matrix.toImplementation() = RotationQuaternion<DestPrimType_>(xyz).toImplementation().toRotationMatrix();
-      return matrix;
+    const DestPrimType_ sx = sin((DestPrimType_)xyz.x());
+    const DestPrimType_ cx = cos((DestPrimType_)xyz.x());
+    const DestPrimType_ sy = sin((DestPrimType_)xyz.y());
+    const DestPrimType_ cy = cos((DestPrimType_)xyz.y());
+    const DestPrimType_ sz = sin((DestPrimType_)xyz.z());
+    const DestPrimType_ cz = cos((DestPrimType_)xyz.z());
+    RotationMatrix<DestPrimType_> matrix;
+    matrix.setMatrix(cy*cz,                -cy*sz,                 sy,
+                     cx*sz + sx*sy*cz,      cx*cz - sx*sy*sz,     -sx*cy,
+                     sx*sz - cx*sy*cz,      sx*cz + cx*sy*sz,      cx*cy);
+    return matrix;
   }
 };
 
 template<typename DestPrimType_, typename SourcePrimType_>
 class ConversionTraits<RotationMatrix<DestPrimType_>, EulerAnglesZyx<SourcePrimType_>> {
  public:
+  //! Direct closed form of C = C_z(z)*C_y(y)*C_x(x), evaluating the three sine/cosine pairs only once
   inline static RotationMatrix<DestPrimType_> convert(const EulerAnglesZyx<SourcePrimType_>& zyx) {
+    const DestPrimType_ sz = sin((DestPrimType_)zyx.z());
+    const DestPrimType_ cz = cos((DestPrimType_)zyx.z());
+    const DestPrimType_ sy = sin((DestPrimType_)zyx.y());
+    const DestPrimType_ cy = cos((DestPrimType_)zyx.y());
+    const DestPrimType_ sx = sin((DestPrimType_)zyx.x());
+    const DestPrimType_ cx = cos((DestPrimType_)zyx.x());
     RotationMatrix<DestPrimType_> matrix;
-    matrix.toImplementation() = RotationQuaternion<DestPrimType_>(zyx).toImplementation().toRotationMatrix();
+    matrix.setMatrix(cz*cy,     cz*sy*sx - sz*cx,      cz*sy*cx + sz*sx,
+                     sz*cy,     sz*sy*sx + cz*cx,      sz*sy*cx - cz*sx,
+                     -sy,       cy*sx,                 cy*cx);
     return matrix;
   }
 };
@@ -372,6 +464,54 @@ class MultiplicationTraits<RotationBase<RotationMatrix<PrimType_>>, RotationBase
  * Rotation Traits
  * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
 
+/*! \brief Rotates with the stored matrix directly.
+ *
+ *  The inverse rotation multiplies with the transposed matrix, so no inverse
+ *  rotation object and no conversion round trip is constructed per call.
+ */
+template<typename PrimType_>
+class RotationTraits<RotationBase<RotationMatrix<PrimType_>>> {
+ public:
+  template<typename get_matrix3X<RotationMatrix<PrimType_>>::IndexType Cols>
+  inline static typename get_matrix3X<RotationMatrix<PrimType_>>::template Matrix3X<Cols> rotate(const RotationMatrix<PrimType_>& rotation, const typename get_matrix3X<RotationMatrix<PrimType_>>::template Matrix3X<Cols>& m) {
+    return rotation.toImplementation()*m;
+  }
+  template<typename Vector_>
+  inline static Vector_ rotate(const RotationMatrix<PrimType_>& rotation, const Vector_& vector) {
+    return static_cast<Vector_>(rotation.toImplementation()*vector.toImplementation());
+  }
+  template<typename get_matrix3X<RotationMatrix<PrimType_>>::IndexType Cols>
+  inline static typename get_matrix3X<RotationMatrix<PrimType_>>::template Matrix3X<Cols> inverseRotate(const RotationMatrix<PrimType_>& rotation, const typename get_matrix3X<RotationMatrix<PrimType_>>::template Matrix3X<Cols>& m) {
+    return rotation.toImplementation().transpose()*m;
+  }
+  template<typename Vector_>
+  inline static Vector_ inverseRotate(const RotationMatrix<PrimType_>& rotation, const Vector_& vector) {
+    return static_cast<Vector_>(rotation.toImplementation().transpose()*vector.toImplementation());
+  }
+  template<typename get_matrix3X<RotationMatrix<PrimType_>>::IndexType Cols>
+  inline static void rotate(const RotationMatrix<PrimType_>& rotation, const typename get_matrix3X<RotationMatrix<PrimType_>>::template Matrix3X<Cols>& in, typename get_matrix3X<RotationMatrix<PrimType_>>::template Matrix3X<Cols>& out) {
+    out.resize(3, in.cols());
+    out.noalias() = rotation.toImplementation()*in;
+  }
+  template<typename get_matrix3X<RotationMatrix<PrimType_>>::IndexType Cols>
+  inline static void rotateInPlace(const RotationMatrix<PrimType_>& rotation, typename get_matrix3X<RotationMatrix<PrimType_>>::template Matrix3X<Cols>& m) {
+    for (typename get_matrix3X<RotationMatrix<PrimType_>>::IndexType i = 0; i < m.cols(); ++i) {
+      m.col(i) = rotation.toImplementation()*m.col(i);
+    }
+  }
+  template<typename get_matrix3X<RotationMatrix<PrimType_>>::IndexType Cols>
+  inline static void inverseRotate(const RotationMatrix<PrimType_>& rotation, const typename get_matrix3X<RotationMatrix<PrimType_>>::template Matrix3X<Cols>& in, typename get_matrix3X<RotationMatrix<PrimType_>>::template Matrix3X<Cols>& out) {
+    out.resize(3, in.cols());
+    out.noalias() = rotation.toImplementation().transpose()*in;
+  }
+  template<typename get_matrix3X<RotationMatrix<PrimType_>>::IndexType Cols>
+  inline static void inverseRotateInPlace(const RotationMatrix<PrimType_>& rotation, typename get_matrix3X<RotationMatrix<PrimType_>>::template Matrix3X<Cols>& m) {
+    for (typename get_matrix3X<RotationMatrix<PrimType_>>::IndexType i = 0; i < m.cols(); ++i) {
+      m.col(i) = rotation.toImplementation().transpose()*m.col(i);
+    }
+  }
+};
+
 /* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
  * Comparison Traits
  * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
@@ -382,6 +522,22 @@ class MultiplicationTraits<RotationBase<RotationMatrix<PrimType_>>, RotationBase
  * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
 
 
+/* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Comparison Traits
+ * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
+
+/*! \brief Compares two rotation matrices entry-wise.
+ *
+ *  The matrix parameterization is unique, so no sign handling is needed.
+ */
+template<typename PrimType_>
+class FastComparisonTraits<RotationMatrix<PrimType_>, RotationMatrix<PrimType_>> {
+ public:
+  inline static bool isNear(const RotationMatrix<PrimType_>& a, const RotationMatrix<PrimType_>& b, PrimType_ tol) {
+    return ((a.toImplementation() - b.toImplementation()).template lpNorm<Eigen::Infinity>() <= tol);
+  }
+};
+
 /* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
  * Fixing Traits
  * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros_eigen.hpp"
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/rotations/RotationDiff.hpp"
+#include "kindr/rotations/RotationBatch.hpp"
+
+namespace kindr {
+
+/*! \class RotationPreintegrator
+ *  \brief Incremental preintegration of a gyroscope stream.
+ *
+ *  Consumes (time step, local angular velocity) samples and maintains the
+ *  accumulated relative rotation between two keyframes together with its
+ *  first-order Jacobian with respect to the gyroscope bias, as used by
+ *  preintegration-based VIO backends. The per-sample exponential maps are
+ *  fused into one running quaternion product whose normalization is deferred
+ *  to getDeltaRotation(), so an 8 kHz stream costs one small-angle exponential
+ *  and one quaternion product per sample. When the bias estimate changes by a
+ *  small delta, getDeltaRotation(delta) corrects the preintegrated rotation
+ *  to first order without re-integrating the stream.
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+class RotationPreintegrator {
+ public:
+  /*! \brief The primitive type.
+   *  Float/Double
+   */
+  typedef PrimType_ Scalar;
+
+  //! The type of a 3d vector
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector3;
+
+  //! The type of a 3x3 matrix
+  typedef Eigen::Matrix<PrimType_, 3, 3> Matrix3;
+
+  /*! \brief Default constructor with zero gyroscope bias.
+   */
+  RotationPreintegrator()
+    : gyroBias_(Vector3::Zero()) {
+    reset();
+  }
+
+  /*! \brief Constructor using a gyroscope bias estimate.
+   *  \param gyroBias   bias subtracted from every angular velocity sample
+   */
+  explicit RotationPreintegrator(const Vector3& gyroBias)
+    : gyroBias_(gyroBias) {
+    reset();
+  }
+
+  /*! \brief Resets the preintegrated rotation, the bias Jacobian, and the sample counters.
+   *  The gyroscope bias estimate is kept.
+   */
+  void reset() {
+    deltaRotation_.setIdentity();
+    jacobianWrtGyroBias_.setZero();
+    deltaTime_ = PrimType_(0);
+    numSamples_ = 0;
+  }
+
+  /*! \brief Sets the gyroscope bias estimate used for subsequent samples.
+   *  \param gyroBias   bias subtracted from every angular velocity sample
+   */
+  void setGyroBias(const Vector3& gyroBias) {
+    gyroBias_ = gyroBias;
+  }
+
+  /*! \brief Gets the gyroscope bias estimate.
+   *  \returns bias
+   */
+  const Vector3& getGyroBias() const {
+    return gyroBias_;
+  }
+
+  /*! \brief Integrates a single angular velocity sample.
+   *  \param timeStep          duration the sample is valid for
+   *  \param angularVelocity   angular velocity expressed in the local (body) frame
+   */
+  void integrate(Scalar timeStep, const LocalAngularVelocity<PrimType_>& angularVelocity) {
+    this->integrate(timeStep, angularVelocity.toImplementation());
+  }
+
+  /*! \brief Integrates a single angular velocity sample given as a plain vector.
+   *  \param timeStep          duration the sample is valid for
+   *  \param angularVelocity   angular velocity expressed in the local (body) frame
+   */
+  void integrate(Scalar timeStep, const Vector3& angularVelocity) {
+    const Vector3 rotationIncrement = (angularVelocity - gyroBias_)*timeStep;
+    const Eigen::Quaternion<PrimType_> increment = exponential(rotationIncrement);
+
+    // propagate the bias Jacobian before fusing the increment:
+    // J_{k+1} = dR_{k+1,k}^T J_k - Jr(phi_k) dt  (Forster et al.)
+    jacobianWrtGyroBias_ = increment.toRotationMatrix().transpose()*jacobianWrtGyroBias_
+                           - rightJacobian(rotationIncrement)*timeStep;
+
+    // raw quaternion product; the increments are unit up to rounding, so the
+    // norm drifts only slowly and one normalization at read-out suffices
+    deltaRotation_ = deltaRotation_*increment;
+    deltaTime_ += timeStep;
+    numSamples_++;
+  }
+
+  /*! \brief Integrates a batch of angular velocity samples.
+   *  \param timeSteps           durations of the samples
+   *  \param angularVelocities   angular velocities expressed in the local (body) frame
+   */
+  void integrate(const std::vector<Scalar>& timeSteps, const VectorBatch3<PrimType_>& angularVelocities) {
+    KINDR_ASSERT_TRUE(std::runtime_error, timeSteps.size() == angularVelocities.size(),
+                      "The number of time steps and angular velocities must be equal!");
+    for (std::size_t k = 0; k < timeSteps.size(); k++) {
+      this->integrate(timeSteps[k], angularVelocities.getVector(k));
+    }
+  }
+
+  /*! \brief Gets the preintegrated rotation (normalized once on read-out).
+   *  \returns relative rotation accumulated since the last reset
+   */
+  RotationQuaternion<PrimType_> getDeltaRotation() const {
+    return RotationQuaternion<PrimType_>(trusted, deltaRotation_.normalized());
+  }
+
+  /*! \brief Gets the preintegrated rotation corrected for a change of the gyroscope bias.
+   *  \param gyroBiasDelta   small change of the bias with respect to the estimate used during integration
+   *  \returns first-order corrected relative rotation
+   */
+  RotationQuaternion<PrimType_> getDeltaRotation(const Vector3& gyroBiasDelta) const {
+    const Eigen::Quaternion<PrimType_> correction = exponential(Vector3(jacobianWrtGyroBias_*gyroBiasDelta));
+    return RotationQuaternion<PrimType_>(trusted, (deltaRotation_*correction).normalized());
+  }
+
+  /*! \brief Gets the Jacobian of the preintegrated rotation with respect to the gyroscope bias.
+   *  \returns 3x3 Jacobian
+   */
+  const Matrix3& getJacobianWrtGyroBias() const {
+    return jacobianWrtGyroBias_;
+  }
+
+  /*! \brief Gets the accumulated integration time.
+   *  \returns sum of the time steps since the last reset
+   */
+  Scalar getDeltaTime() const {
+    return deltaTime_;
+  }
+
+  /*! \brief Gets the number of integrated samples.
+   *  \returns sample count since the last reset
+   */
+  std::size_t getNumSamples() const {
+    return numSamples_;
+  }
+
+ private:
+  /*! \brief Exponential map of a rotation vector as a quaternion, with a small-angle branch.
+   */
+  static Eigen::Quaternion<PrimType_> exponential(const Vector3& rotationVector) {
+    const PrimType_ angleSquared = rotationVector.squaredNorm();
+    PrimType_ realPart;
+    PrimType_ imaginaryScale;
+    if (angleSquared < std::sqrt(std::numeric_limits<PrimType_>::epsilon())) {
+      // cos(t/2) = 1 - t^2/8, sin(t/2)/t = 1/2 - t^2/48
+      realPart = PrimType_(1) - angleSquared/PrimType_(8);
+      imaginaryScale = PrimType_(0.5) - angleSquared/PrimType_(48);
+    } else {
+      const PrimType_ angle = std::sqrt(angleSquared);
+      realPart = std::cos(angle/PrimType_(2));
+      imaginaryScale = std::sin(angle/PrimType_(2))/angle;
+    }
+    return Eigen::Quaternion<PrimType_>(realPart,
+                                        imaginaryScale*rotationVector(0),
+                                        imaginaryScale*rotationVector(1),
+                                        imaginaryScale*rotationVector(2));
+  }
+
+  /*! \brief Right Jacobian of the exponential map, with a small-angle branch.
+   */
+  static Matrix3 rightJacobian(const Vector3& rotationVector) {
+    const PrimType_ angleSquared = rotationVector.squaredNorm();
+    const Matrix3 skew = getSkewMatrixFromVector(rotationVector);
+    PrimType_ firstCoefficient;
+    PrimType_ secondCoefficient;
+    if (angleSquared < std::sqrt(std::numeric_limits<PrimType_>::epsilon())) {
+      // (1-cos(t))/t^2 = 1/2 - t^2/24, (t-sin(t))/t^3 = 1/6 - t^2/120
+      firstCoefficient = PrimType_(0.5) - angleSquared/PrimType_(24);
+      secondCoefficient = PrimType_(1)/PrimType_(6) - angleSquared/PrimType_(120);
+    } else {
+      const PrimType_ angle = std::sqrt(angleSquared);
+      firstCoefficient = (PrimType_(1) - std::cos(angle))/angleSquared;
+      secondCoefficient = (angle - std::sin(angle))/(angleSquared*angle);
+    }
+    return Matrix3::Identity() - firstCoefficient*skew + secondCoefficient*skew*skew;
+  }
+
+  //! Accumulated rotation as a raw quaternion with deferred normalization
+  Eigen::Quaternion<PrimType_> deltaRotation_;
+
+  //! Jacobian of the preintegrated rotation with respect to the gyroscope bias
+  Matrix3 jacobianWrtGyroBias_;
+
+  //! Gyroscope bias estimate subtracted from every sample
+  Vector3 gyroBias_;
+
+  //! Accumulated integration time
+  Scalar deltaTime_;
+
+  //! Number of integrated samples
+  std::size_t numSamples_;
+};
+
+//! \brief Preintegrator of a gyroscope stream with primitive type double
+typedef RotationPreintegrator<double> RotationPreintegratorD;
+//! \brief Preintegrator of a gyroscope stream with primitive type float
+typedef RotationPreintegrator<float> RotationPreintegratorF;
+
+} // namespace kindr
@@ -29,6 +29,7 @@
 #pragma once
 
 #include <cmath>
+#include <limits>
 
 #include <Eigen/Geometry>
 
@@ -133,12 +134,54 @@ class RotationQuaternion : public RotationBase<RotationQuaternion<PrimType_>> {
     KINDR_ASSERT_SCALAR_NEAR_DBG(std::runtime_error, rotationQuaternion_.norm(), static_cast<Scalar>(1), static_cast<Scalar>(1e-2), "Input quaternion has not unit length.");
   }
 
+  /*! \brief Constructor using four scalars which skips the unit-length validation.
+   *  Only pass kindr::trusted if the quaternion is unit by construction, e.g. the
+   *  product of two unit quaternions or the result of an exponential map.
+   *  \param w     first entry of the quaternion = cos(phi/2)
+   *  \param x     second entry of the quaternion = n1*sin(phi/2)
+   *  \param y     third entry of the quaternion = n2*sin(phi/2)
+   *  \param z     fourth entry of the quaternion = n3*sin(phi/2)
+   */
+  RotationQuaternion(trusted_t, Scalar w, Scalar x, Scalar y, Scalar z)
+    : rotationQuaternion_(trusted,w,x,y,z) {
+  }
+
+  /*! \brief Constructor using real and imaginary part which skips the unit-length validation.
+   *  \param real   real part (PrimType_)
+   *  \param imag   imaginary part (Eigen::Matrix<PrimType_,3,1>), unit together with the real part by construction
+   */
+  RotationQuaternion(trusted_t, Scalar real, const Imaginary& imag)
+    : rotationQuaternion_(trusted,real,imag(0),imag(1),imag(2)) {
+  }
+
+  /*! \brief Constructor using Eigen::Matrix<PrimType_,4,1> which skips the unit-length validation.
+   *  \param vec   Eigen::Matrix<PrimType_,4,1>, unit by construction
+   */
+  RotationQuaternion(trusted_t, const Vector4& vec)
+    : rotationQuaternion_(trusted,vec(0),vec(1),vec(2),vec(3)) {
+  }
+
+  /*! \brief Constructor using Eigen::Quaternion<PrimType_> which skips the unit-length validation.
+   *  \param other   Eigen::Quaternion<PrimType_>, unit by construction
+   */
+  RotationQuaternion(trusted_t, const Implementation& other)
+    : rotationQuaternion_(trusted, other.w(), other.x(), other.y(), other.z()) {
+  }
+
+  /*! \brief Constructor using UnitQuaternion which skips the unit-length validation.
+   *  \param other   UnitQuaternion, unit by construction
+   */
+  RotationQuaternion(trusted_t, const Base& other)
+    : rotationQuaternion_(trusted, other.w(), other.x(), other.y(), other.z()) {
+  }
+
   /*! \brief Constructor using another rotation.
    *  \param other   other rotation
    */
   template<typename OtherDerived_>
   inline explicit RotationQuaternion(const RotationBase<OtherDerived_>& other)
     : rotationQuaternion_(internal::ConversionTraits<RotationQuaternion, OtherDerived_>::convert(other.derived()).toImplementation()) {
+    KINDR_COUNT_CONVERSION(RotationQuaternion, OtherDerived_);
   }
 
   inline Scalar w() const {
@@ -239,6 +282,7 @@ class RotationQuaternion : public RotationBase<RotationQuaternion<PrimType_>> {
    */
   template<typename OtherDerived_>
   RotationQuaternion& operator =(const RotationBase<OtherDerived_>& other) {
+    KINDR_COUNT_CONVERSION(RotationQuaternion, OtherDerived_);
     this->toImplementation() = internal::ConversionTraits<RotationQuaternion, OtherDerived_>::convert(other.derived()).toImplementation();
     return *this;
   }
@@ -281,6 +325,7 @@ class RotationQuaternion : public RotationBase<RotationQuaternion<PrimType_>> {
    */
   template<typename OtherDerived_>
   RotationQuaternion& operator ()(const RotationBase<OtherDerived_>& other) {
+    KINDR_COUNT_CONVERSION(RotationQuaternion, OtherDerived_);
     this->toImplementation() = internal::ConversionTraits<RotationQuaternion, OtherDerived_>::convert(other.derived()).toImplementation();
     return *this;
   }
@@ -289,7 +334,7 @@ class RotationQuaternion : public RotationBase<RotationQuaternion<PrimType_>> {
    *  \returns the inverse of the rotation
    */
   RotationQuaternion inverted() const {
-    return RotationQuaternion(this->toUnitQuaternion().inverted());
+    return RotationQuaternion(trusted, this->toUnitQuaternion().inverted());
   }
 
   /*! \brief Inverts the rotation.
@@ -304,7 +349,7 @@ class RotationQuaternion : public RotationBase<RotationQuaternion<PrimType_>> {
    *  \returns conjugated of the quaternion
    */
   RotationQuaternion conjugated() const {
-    return RotationQuaternion(this->toUnitQuaternion().conjugated());
+    return RotationQuaternion(trusted, this->toUnitQuaternion().conjugated());
   }
 
   /*! \brief Conjugates of the quaternion.
@@ -425,6 +470,57 @@ class RotationQuaternion : public RotationBase<RotationQuaternion<PrimType_>> {
     return rotationQuaternion_.norm();
   }
 
+  /*! \brief Returns only the yaw angle of the Z-Y'-X'' decomposition.
+   *
+   *  Computes the first angle of EulerAnglesZyx directly from the quaternion
+   *  coefficients with a single atan2, skipping the full conversion. The value
+   *  matches EulerAnglesZyx, including the convention that the yaw is zero in
+   *  the gimbal lock at pitch = +-pi/2.
+   *  \returns rotation angle around the Z axis
+   */
+  Scalar getYaw() const {
+    const Scalar r00 = Scalar(1) - Scalar(2)*(this->y()*this->y() + this->z()*this->z());
+    const Scalar r10 = Scalar(2)*(this->x()*this->y() + this->w()*this->z());
+    if (std::sqrt(r00*r00 + r10*r10) <= Scalar(1e2)*std::numeric_limits<Scalar>::epsilon()) {
+      return Scalar(0);
+    }
+    return std::atan2(r10, r00);
+  }
+
+  /*! \brief Returns only the pitch angle of the Z-Y'-X'' decomposition.
+   *
+   *  Computes the second angle of EulerAnglesZyx directly from the quaternion
+   *  coefficients with a single atan2.
+   *  \returns rotation angle around the Y' axis, in [-pi/2, pi/2]
+   */
+  Scalar getPitch() const {
+    const Scalar r00 = Scalar(1) - Scalar(2)*(this->y()*this->y() + this->z()*this->z());
+    const Scalar r10 = Scalar(2)*(this->x()*this->y() + this->w()*this->z());
+    const Scalar r20 = Scalar(2)*(this->x()*this->z() - this->w()*this->y());
+    return std::atan2(-r20, std::sqrt(r00*r00 + r10*r10));
+  }
+
+  /*! \brief Returns only the roll angle of the Z-Y'-X'' decomposition.
+   *
+   *  Computes the third angle of EulerAnglesZyx directly from the quaternion
+   *  coefficients with a single atan2. In the gimbal lock the roll carries the
+   *  whole rotation about the locked axis, matching EulerAnglesZyx.
+   *  \returns rotation angle around the X'' axis
+   */
+  Scalar getRoll() const {
+    const Scalar r00 = Scalar(1) - Scalar(2)*(this->y()*this->y() + this->z()*this->z());
+    const Scalar r10 = Scalar(2)*(this->x()*this->y() + this->w()*this->z());
+    if (std::sqrt(r00*r00 + r10*r10) <= Scalar(1e2)*std::numeric_limits<Scalar>::epsilon()) {
+      const Scalar r20 = Scalar(2)*(this->x()*this->z() - this->w()*this->y());
+      const Scalar r01 = Scalar(2)*(this->x()*this->y() - this->w()*this->z());
+      const Scalar r02 = Scalar(2)*(this->x()*this->z() + this->w()*this->y());
+      return (r20 < Scalar(0)) ? std::atan2(r01, r02) : std::atan2(-r01, -r02);
+    }
+    const Scalar r21 = Scalar(2)*(this->y()*this->z() + this->w()*this->x());
+    const Scalar r22 = Scalar(1) - Scalar(2)*(this->x()*this->x() + this->y()*this->y());
+    return std::atan2(r21, r22);
+  }
+
   /*! \brief Concenation operator.
    *  This is explicitly specified, because QuaternionBase provides also an operator*.
    *  \returns the concenation of two rotations
@@ -530,7 +626,7 @@ class ConversionTraits<RotationQuaternion<DestPrimType_>, RotationVector<SourceP
     }
     Imaginary axis = rotationVector.toImplementation().template cast<Scalar>()*na;
     Scalar ct = cos(theta*0.5);
-    return RotationQuaternion<DestPrimType_>(ct, axis[0],axis[1],axis[2]);
+    return RotationQuaternion<DestPrimType_>(trusted, ct, axis[0],axis[1],axis[2]);
 //    return Eigen::Vector4d(axis[0],axis[1],axis[2],ct);
 
   }
@@ -555,22 +651,36 @@ class ConversionTraits<RotationQuaternion<DestPrimType_>, RotationMatrix<SourceP
 template<typename DestPrimType_, typename SourcePrimType_>
 class ConversionTraits<RotationQuaternion<DestPrimType_>, EulerAnglesXyz<SourcePrimType_>> {
  public:
+  //! Direct closed form of q = q_x(x)*q_y(y)*q_z(z) from the three half-angle sine/cosine pairs
   inline static RotationQuaternion<DestPrimType_> convert(const EulerAnglesXyz<SourcePrimType_>& xyz) {
-    return RotationQuaternion<DestPrimType_>(Eigen::Quaternion<DestPrimType_>(
-      Eigen::AngleAxis<DestPrimType_>((DestPrimType_)xyz.x(), Eigen::Matrix<DestPrimType_, 3, 1>::UnitX()) *
-      Eigen::AngleAxis<DestPrimType_>((DestPrimType_)xyz.y(), Eigen::Matrix<DestPrimType_, 3, 1>::UnitY()) *
-      Eigen::AngleAxis<DestPrimType_>((DestPrimType_)xyz.z(), Eigen::Matrix<DestPrimType_, 3, 1>::UnitZ())));
+    const DestPrimType_ sx = sin((DestPrimType_)xyz.x()/DestPrimType_(2));
+    const DestPrimType_ cx = cos((DestPrimType_)xyz.x()/DestPrimType_(2));
+    const DestPrimType_ sy = sin((DestPrimType_)xyz.y()/DestPrimType_(2));
+    const DestPrimType_ cy = cos((DestPrimType_)xyz.y()/DestPrimType_(2));
+    const DestPrimType_ sz = sin((DestPrimType_)xyz.z()/DestPrimType_(2));
+    const DestPrimType_ cz = cos((DestPrimType_)xyz.z()/DestPrimType_(2));
+    return RotationQuaternion<DestPrimType_>(cx*cy*cz - sx*sy*sz,
+                                             sx*cy*cz + cx*sy*sz,
+                                             cx*sy*cz - sx*cy*sz,
+                                             cx*cy*sz + sx*sy*cz);
   }
 };
 
 template<typename DestPrimType_, typename SourcePrimType_>
 class ConversionTraits<RotationQuaternion<DestPrimType_>, EulerAnglesZyx<SourcePrimType_>> {
  public:
+  //! Direct closed form of q = q_z(z)*q_y(y)*q_x(x) from the three half-angle sine/cosine pairs
   inline static RotationQuaternion<DestPrimType_> convert(const EulerAnglesZyx<SourcePrimType_>& zyx) {
-    return RotationQuaternion<DestPrimType_>(Eigen::Quaternion<DestPrimType_>(
-      Eigen::AngleAxis<DestPrimType_>((DestPrimType_)zyx.z(), Eigen::Matrix<DestPrimType_, 3, 1>::UnitZ()) *
-      Eigen::AngleAxis<DestPrimType_>((DestPrimType_)zyx.y(), Eigen::Matrix<DestPrimType_, 3, 1>::UnitY()) *
-      Eigen::AngleAxis<DestPrimType_>((DestPrimType_)zyx.x(), Eigen::Matrix<DestPrimType_, 3, 1>::UnitX())));
+    const DestPrimType_ sz = sin((DestPrimType_)zyx.z()/DestPrimType_(2));
+    const DestPrimType_ cz = cos((DestPrimType_)zyx.z()/DestPrimType_(2));
+    const DestPrimType_ sy = sin((DestPrimType_)zyx.y()/DestPrimType_(2));
+    const DestPrimType_ cy = cos((DestPrimType_)zyx.y()/DestPrimType_(2));
+    const DestPrimType_ sx = sin((DestPrimType_)zyx.x()/DestPrimType_(2));
+    const DestPrimType_ cx = cos((DestPrimType_)zyx.x()/DestPrimType_(2));
+    return RotationQuaternion<DestPrimType_>(cx*cy*cz + sx*sy*sz,
+                                             sx*cy*cz - cx*sy*sz,
+                                             cx*sy*cz + sx*cy*sz,
+                                             cx*cy*sz - sx*sy*cz);
   }
 };
 
@@ -582,6 +692,65 @@ class ConversionTraits<RotationQuaternion<DestPrimType_>, EulerAnglesZyx<SourceP
  * Rotation Traits
  * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
 
+/*! \brief Rotates with the quaternion directly.
+ *
+ *  A single vector is rotated with the conjugate sandwich q*v*q^-1 (resp. its
+ *  conjugate for the inverse rotation), so no rotation matrix and in particular
+ *  no inverse rotation object is constructed per call. Multiple columns are
+ *  still rotated through one matrix conversion, which is amortized over the
+ *  columns.
+ */
+template<typename PrimType_>
+class RotationTraits<RotationBase<RotationQuaternion<PrimType_>>> {
+ public:
+  template<typename get_matrix3X<RotationQuaternion<PrimType_>>::IndexType Cols>
+  inline static typename get_matrix3X<RotationQuaternion<PrimType_>>::template Matrix3X<Cols> rotate(const RotationQuaternion<PrimType_>& rotation, const typename get_matrix3X<RotationQuaternion<PrimType_>>::template Matrix3X<Cols>& m) {
+    return RotationMatrix<PrimType_>(rotation).toImplementation()*m;
+  }
+  inline static Eigen::Matrix<PrimType_, 3, 1> rotate(const RotationQuaternion<PrimType_>& rotation, const Eigen::Matrix<PrimType_, 3, 1>& vector) {
+    return rotation.toImplementation()*vector;
+  }
+  template<typename Vector_>
+  inline static Vector_ rotate(const RotationQuaternion<PrimType_>& rotation, const Vector_& vector) {
+    return static_cast<Vector_>(rotation.toImplementation()*vector.toImplementation());
+  }
+  template<typename get_matrix3X<RotationQuaternion<PrimType_>>::IndexType Cols>
+  inline static typename get_matrix3X<RotationQuaternion<PrimType_>>::template Matrix3X<Cols> inverseRotate(const RotationQuaternion<PrimType_>& rotation, const typename get_matrix3X<RotationQuaternion<PrimType_>>::template Matrix3X<Cols>& m) {
+    return RotationMatrix<PrimType_>(rotation).toImplementation().transpose()*m;
+  }
+  inline static Eigen::Matrix<PrimType_, 3, 1> inverseRotate(const RotationQuaternion<PrimType_>& rotation, const Eigen::Matrix<PrimType_, 3, 1>& vector) {
+    return rotation.toImplementation().conjugate()*vector;
+  }
+  template<typename Vector_>
+  inline static Vector_ inverseRotate(const RotationQuaternion<PrimType_>& rotation, const Vector_& vector) {
+    return static_cast<Vector_>(rotation.toImplementation().conjugate()*vector.toImplementation());
+  }
+  template<typename get_matrix3X<RotationQuaternion<PrimType_>>::IndexType Cols>
+  inline static void rotate(const RotationQuaternion<PrimType_>& rotation, const typename get_matrix3X<RotationQuaternion<PrimType_>>::template Matrix3X<Cols>& in, typename get_matrix3X<RotationQuaternion<PrimType_>>::template Matrix3X<Cols>& out) {
+    out.resize(3, in.cols());
+    out.noalias() = rotation.toImplementation().toRotationMatrix()*in;
+  }
+  template<typename get_matrix3X<RotationQuaternion<PrimType_>>::IndexType Cols>
+  inline static void rotateInPlace(const RotationQuaternion<PrimType_>& rotation, typename get_matrix3X<RotationQuaternion<PrimType_>>::template Matrix3X<Cols>& m) {
+    const Eigen::Matrix<PrimType_, 3, 3> rotationMatrix = rotation.toImplementation().toRotationMatrix();
+    for (typename get_matrix3X<RotationQuaternion<PrimType_>>::IndexType i = 0; i < m.cols(); ++i) {
+      m.col(i) = rotationMatrix*m.col(i);
+    }
+  }
+  template<typename get_matrix3X<RotationQuaternion<PrimType_>>::IndexType Cols>
+  inline static void inverseRotate(const RotationQuaternion<PrimType_>& rotation, const typename get_matrix3X<RotationQuaternion<PrimType_>>::template Matrix3X<Cols>& in, typename get_matrix3X<RotationQuaternion<PrimType_>>::template Matrix3X<Cols>& out) {
+    out.resize(3, in.cols());
+    out.noalias() = rotation.toImplementation().toRotationMatrix().transpose()*in;
+  }
+  template<typename get_matrix3X<RotationQuaternion<PrimType_>>::IndexType Cols>
+  inline static void inverseRotateInPlace(const RotationQuaternion<PrimType_>& rotation, typename get_matrix3X<RotationQuaternion<PrimType_>>::template Matrix3X<Cols>& m) {
+    const Eigen::Matrix<PrimType_, 3, 3> transposedMatrix = rotation.toImplementation().toRotationMatrix().transpose();
+    for (typename get_matrix3X<RotationQuaternion<PrimType_>>::IndexType i = 0; i < m.cols(); ++i) {
+      m.col(i) = transposedMatrix*m.col(i);
+    }
+  }
+};
+
 /* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
  * Comparison Traits
  * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
@@ -596,6 +765,25 @@ class ComparisonTraits<RotationQuaternion<PrimType_>, RotationQuaternion<PrimTyp
    }
 };
 
+/*! \brief Compares two rotation quaternions coefficient-wise.
+ *
+ *  q and -q represent the same rotation, so the smaller of the two coefficient
+ *  distances is compared against the tolerance.
+ */
+template<typename PrimType_>
+class FastComparisonTraits<RotationQuaternion<PrimType_>, RotationQuaternion<PrimType_>> {
+ public:
+  inline static bool isNear(const RotationQuaternion<PrimType_>& a, const RotationQuaternion<PrimType_>& b, PrimType_ tol) {
+    using std::abs;
+    using std::max;
+    const PrimType_ diffSameSign = max(max(abs(a.w() - b.w()), abs(a.x() - b.x())),
+                                       max(abs(a.y() - b.y()), abs(a.z() - b.z())));
+    const PrimType_ diffFlippedSign = max(max(abs(a.w() + b.w()), abs(a.x() + b.x())),
+                                          max(abs(a.y() + b.y()), abs(a.z() + b.z())));
+    return (diffSameSign <= tol) || (diffFlippedSign <= tol);
+  }
+};
+
 /* -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
  * Fixing Traits
  * ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------- */
@@ -605,6 +793,21 @@ class FixingTraits<RotationQuaternion<PrimType_>> {
   inline static void fix(RotationQuaternion<PrimType_>& q) {
     q.toImplementation().normalize();
   }
+
+  /*! \brief First-order renormalization q *= (3 - |q|^2)/2 without sqrt and divide.
+   *
+   *  The correction is accurate to second order in the norm error, which is
+   *  sufficient for the parts-per-million drift of incremental integration.
+   *  Larger drift falls back to the exact normalization.
+   */
+  inline static void fixFast(RotationQuaternion<PrimType_>& q) {
+    const PrimType_ squaredNorm = q.toImplementation().squaredNorm();
+    if (std::abs(squaredNorm - PrimType_(1)) < PrimType_(2.5e-3)) {
+      q.toImplementation().coeffs() *= (PrimType_(1.5) - PrimType_(0.5)*squaredNorm);
+    } else {
+      fix(q);
+    }
+  }
 };
 
 } // namespace internal
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <Eigen/Geometry>
+
+#include "kindr/rotations/Rotation.hpp"
+
+namespace kindr {
+
+template<typename Type_>
+class Map;
+
+/*! \brief View on a RotationQuaternion over caller-owned memory.
+ *
+ *  Wraps an external coefficient buffer in Eigen's storage order [x, y, z, w]
+ *  without copying it. Conversion to a RotationQuaternion and assignment from
+ *  any rotation copy through it, which makes ingestion from DDS/ROS messages
+ *  or mmapped sensor blocks zero-copy.
+ *
+ * \tparam PrimType_ the primitive type of the data (double or float)
+ * \ingroup rotations
+ */
+template<typename PrimType_>
+class Map<RotationQuaternion<PrimType_>> {
+ public:
+  //! The mapped kindr type
+  typedef RotationQuaternion<PrimType_> RotationQuaternionType;
+  //! The Eigen map over the external buffer
+  typedef Eigen::Map<Eigen::Quaternion<PrimType_>> ImplementationMap;
+  //! The primitive type of the coefficients
+  typedef PrimType_ Scalar;
+
+  /*! \brief Constructor mapping an external buffer.
+   *  \param data   external buffer of four coefficients [x, y, z, w], must outlive the map
+   */
+  explicit Map(PrimType_* data)
+    : map_(data) {
+  }
+
+  /*! \brief Cast to the Eigen map.
+   *  \returns the map for direct manipulation (recommended only for advanced users)
+   */
+  ImplementationMap& toImplementation() {
+    return map_;
+  }
+
+  /*! \brief Cast to the Eigen map.
+   *  \returns the map for direct manipulation (recommended only for advanced users)
+   */
+  const ImplementationMap& toImplementation() const {
+    return map_;
+  }
+
+  //! Returns the real part of the mapped quaternion
+  PrimType_ w() const { return map_.w(); }
+  //! Returns the first imaginary part of the mapped quaternion
+  PrimType_ x() const { return map_.x(); }
+  //! Returns the second imaginary part of the mapped quaternion
+  PrimType_ y() const { return map_.y(); }
+  //! Returns the third imaginary part of the mapped quaternion
+  PrimType_ z() const { return map_.z(); }
+
+  /*! \brief Copies the mapped coefficients into an owning rotation quaternion.
+   *  In debug mode, an assertion is thrown if the mapped quaternion has not unit length.
+   *  \returns owning rotation quaternion with the mapped coefficients
+   */
+  operator RotationQuaternionType() const {
+    return RotationQuaternionType(map_.w(), map_.x(), map_.y(), map_.z());
+  }
+
+  /*! \brief Writes a rotation through the map into the external buffer.
+   *  \returns reference
+   */
+  template<typename OtherDerived_>
+  Map& operator =(const RotationBase<OtherDerived_>& other) {
+    const RotationQuaternionType rotationQuaternion(other.derived());
+    map_.w() = rotationQuaternion.w();
+    map_.x() = rotationQuaternion.x();
+    map_.y() = rotationQuaternion.y();
+    map_.z() = rotationQuaternion.z();
+    return *this;
+  }
+
+  /*! \brief Rotates a vector without copying the mapped quaternion.
+   *  \returns the rotated vector
+   */
+  Eigen::Matrix<PrimType_, 3, 1> rotate(const Eigen::Matrix<PrimType_, 3, 1>& vector) const {
+    return map_._transformVector(vector);
+  }
+
+  /*! \brief Rotates a vector in reverse without copying the mapped quaternion.
+   *  \returns the reverse rotated vector
+   */
+  Eigen::Matrix<PrimType_, 3, 1> inverseRotate(const Eigen::Matrix<PrimType_, 3, 1>& vector) const {
+    return map_.conjugate()._transformVector(vector);
+  }
+
+ private:
+  //! Eigen map over the external buffer
+  ImplementationMap map_;
+};
+
+} // namespace kindr
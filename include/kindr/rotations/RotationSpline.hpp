@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <vector>
+
+#include <Eigen/StdVector>
+
+#include "kindr/common/assert_macros.hpp"
+#include "kindr/rotations/Rotation.hpp"
+
+namespace kindr {
+
+/*! \class RotationSpline
+ * \brief SQUAD orientation trajectory over sparse keyframes
+ *
+ *  Interpolates an orientation trajectory through timestamped keyframes with spherical
+ *  cubic interpolation (SQUAD), expressed through the box operations so the control-point
+ *  and segment logarithms are precomputed once per keyframe change. The knots and cached
+ *  segment coefficients live in contiguous storage, and evaluate() keeps a segment hint so
+ *  that the monotonically increasing query times of a resampling loop skip the knot-vector
+ *  search entirely.
+ *
+ *  evaluate() is not thread-safe because of the segment hint; use one spline per thread.
+ *
+ *  \tparam PrimType_ the primitive type of the data (double or float)
+ *  \ingroup rotations
+ */
+template<typename PrimType_>
+class RotationSpline {
+ public:
+  typedef PrimType_ Scalar;
+  typedef RotationQuaternion<PrimType_> Rotation;
+  typedef Eigen::Matrix<PrimType_, 3, 1> Vector;
+
+  RotationSpline()
+    : coefficientsDirty_(false),
+      segmentHint_(0u) {
+  }
+
+  /*! \brief Returns the number of keyframes. */
+  std::size_t getNumberOfKnots() const {
+    return knotTimes_.size();
+  }
+
+  /*! \brief Appends a keyframe.
+   *  \param time      timestamp of the keyframe, must be strictly greater than the previous one
+   *  \param rotation  orientation at the keyframe
+   */
+  void addKnot(Scalar time, const Rotation& rotation) {
+    KINDR_ASSERT_TRUE(std::invalid_argument, knotTimes_.empty() || time > knotTimes_.back(),
+                      "Knot times must be strictly increasing.");
+    knotTimes_.push_back(time);
+    knots_.push_back(rotation);
+    coefficientsDirty_ = true;
+  }
+
+  /*! \brief Removes all keyframes. */
+  void clear() {
+    knotTimes_.clear();
+    knots_.clear();
+    controlPoints_.clear();
+    segmentLogs_.clear();
+    controlLogs_.clear();
+    coefficientsDirty_ = false;
+    segmentHint_ = 0u;
+  }
+
+  /*! \brief Evaluates the trajectory at a query time.
+   *
+   *  Query times outside the keyframe range are clamped to the first/last keyframe.
+   *  \param time  query time
+   *  \returns interpolated orientation
+   */
+  Rotation evaluate(Scalar time) const {
+    KINDR_ASSERT_TRUE(std::out_of_range, !knots_.empty(), "Spline has no knots.");
+    if (coefficientsDirty_) {
+      updateCoefficients();
+    }
+    if (time <= knotTimes_.front() || knots_.size() == 1u) {
+      return knots_.front();
+    }
+    if (time >= knotTimes_.back()) {
+      return knots_.back();
+    }
+
+    const std::size_t segment = findSegment(time);
+    const Scalar u = (time - knotTimes_[segment])/(knotTimes_[segment + 1u] - knotTimes_[segment]);
+
+    // squad(q_i, q_i+1, s_i, s_i+1, u) with the inner slerps using the cached logarithms
+    const Rotation outer = knots_[segment].boxPlus(Vector(u*segmentLogs_[segment]));
+    const Rotation inner = controlPoints_[segment].boxPlus(Vector(u*controlLogs_[segment]));
+    const Scalar blend = Scalar(2)*u*(Scalar(1) - u);
+    return outer.boxPlus(Vector(blend*inner.boxMinus(outer)));
+  }
+
+ private:
+  /*! \brief Precomputes the SQUAD control points and the segment/control logarithms. */
+  void updateCoefficients() const {
+    const std::size_t numberOfKnots = knots_.size();
+    controlPoints_.resize(numberOfKnots);
+    // s_i = q_i boxPlus -((q_i+1 boxMinus q_i) + (q_i-1 boxMinus q_i))/4, endpoints pass through
+    controlPoints_.front() = knots_.front();
+    controlPoints_.back() = knots_.back();
+    for (std::size_t i = 1u; i + 1u < numberOfKnots; i++) {
+      const Vector correction = (knots_[i + 1u].boxMinus(knots_[i]) + knots_[i - 1u].boxMinus(knots_[i]))/Scalar(-4);
+      controlPoints_[i] = knots_[i].boxPlus(correction);
+    }
+    if (numberOfKnots >= 2u) {
+      segmentLogs_.resize(numberOfKnots - 1u);
+      controlLogs_.resize(numberOfKnots - 1u);
+      for (std::size_t i = 0u; i + 1u < numberOfKnots; i++) {
+        segmentLogs_[i] = knots_[i + 1u].boxMinus(knots_[i]);
+        controlLogs_[i] = controlPoints_[i + 1u].boxMinus(controlPoints_[i]);
+      }
+    }
+    segmentHint_ = 0u;
+    coefficientsDirty_ = false;
+  }
+
+  /*! \brief Finds the segment containing the query time, starting from the last hit. */
+  std::size_t findSegment(Scalar time) const {
+    std::size_t segment = segmentHint_ < knotTimes_.size() - 1u ? segmentHint_ : 0u;
+    if (knotTimes_[segment] <= time) {
+      // the resampling case: walk forward from the previous segment
+      while (time >= knotTimes_[segment + 1u]) {
+        segment++;
+      }
+    } else {
+      // non-monotonic query: fall back to binary search
+      std::size_t lower = 0u;
+      std::size_t upper = knotTimes_.size() - 1u;
+      while (upper - lower > 1u) {
+        const std::size_t middle = lower + (upper - lower)/2u;
+        if (knotTimes_[middle] <= time) {
+          lower = middle;
+        } else {
+          upper = middle;
+        }
+      }
+      segment = lower;
+    }
+    segmentHint_ = segment;
+    return segment;
+  }
+
+  std::vector<Scalar> knotTimes_;
+  std::vector<Rotation, Eigen::aligned_allocator<Rotation>> knots_;
+  //! SQUAD inner control points (recomputed when keyframes change)
+  mutable std::vector<Rotation, Eigen::aligned_allocator<Rotation>> controlPoints_;
+  //! cached logarithms q_i+1 boxMinus q_i per segment
+  mutable std::vector<Vector, Eigen::aligned_allocator<Vector>> segmentLogs_;
+  //! cached logarithms s_i+1 boxMinus s_i per segment
+  mutable std::vector<Vector, Eigen::aligned_allocator<Vector>> controlLogs_;
+  mutable bool coefficientsDirty_;
+  //! segment of the previous evaluation, exploited by monotonically increasing queries
+  mutable std::size_t segmentHint_;
+};
+
+typedef RotationSpline<double> RotationSplineD;
+typedef RotationSpline<float> RotationSplineF;
+
+} // namespace kindr
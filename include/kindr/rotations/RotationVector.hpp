@@ -110,6 +110,7 @@ class RotationVector : public RotationBase<RotationVector<PrimType_>> {
   template<typename OtherDerived_>
   inline explicit RotationVector(const RotationBase<OtherDerived_>& other)
     : vector_(internal::ConversionTraits<RotationVector, OtherDerived_>::convert(other.derived()).toImplementation()) {
+    KINDR_COUNT_CONVERSION(RotationVector, OtherDerived_);
   }
 
   /*! \brief Assignment operator using another rotation.
@@ -118,6 +119,7 @@ class RotationVector : public RotationBase<RotationVector<PrimType_>> {
    */
   template<typename OtherDerived_>
   RotationVector& operator =(const RotationBase<OtherDerived_>& other) {
+    KINDR_COUNT_CONVERSION(RotationVector, OtherDerived_);
     this->toImplementation() = internal::ConversionTraits<RotationVector, OtherDerived_>::convert(other.derived()).toImplementation();
     return *this;
   }
@@ -128,6 +130,7 @@ class RotationVector : public RotationBase<RotationVector<PrimType_>> {
    */
   template<typename OtherDerived_>
   RotationVector& operator ()(const RotationBase<OtherDerived_>& other) {
+    KINDR_COUNT_CONVERSION(RotationVector, OtherDerived_);
     this->toImplementation() = internal::ConversionTraits<RotationVector, OtherDerived_>::convert(other.derived()).toImplementation();
     return *this;
   }
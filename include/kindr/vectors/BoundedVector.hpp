@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <Eigen/Core>
+
+#include "kindr/common/common.hpp"
+#include "kindr/common/assert_macros_eigen.hpp"
+#include "kindr/vectors/Vector.hpp"
+
+namespace kindr {
+
+/*! \class BoundedVector
+ * \brief Vector with run-time size and fixed-capacity stack storage.
+ *
+ * This class implements a vector whose size is chosen at run time but bounded
+ * by a compile-time capacity. The coefficients live inline in the object
+ * (Eigen MaxRows-style storage), so construction and resizing never touch the
+ * heap — unlike Vector with Dimension_ = Eigen::Dynamic, which allocates on
+ * every construction. The dynamic-size API is preserved: size() and resize()
+ * behave as on a dynamic vector, and conversions to and from Vector are
+ * provided. Resizing beyond the capacity is a programming error.
+ * \tparam PhysicalType_   Physical type of the vector.
+ * \tparam PrimType_       Primitive type of the coordinates.
+ * \tparam MaxDimension_   Maximum dimension of the vector (capacity).
+ * \ingroup vectors
+ */
+template<enum PhysicalType PhysicalType_, typename PrimType_, int MaxDimension_>
+class BoundedVector : public VectorBase<BoundedVector<PhysicalType_, PrimType_, MaxDimension_> >, private Eigen::Matrix<PrimType_, Eigen::Dynamic, 1, Eigen::AutoAlign, MaxDimension_, 1> {
+ private:
+  static_assert(MaxDimension_ > 0, "The maximum dimension must be positive.");
+
+  /*! \brief The base type.
+   */
+  typedef VectorBase<BoundedVector<PhysicalType_, PrimType_, MaxDimension_> > Base;
+
+ public:
+  /*! \brief The implementation type.
+   *
+   *  The implementation type is always an Eigen object.
+   */
+  typedef Eigen::Matrix<PrimType_, Eigen::Dynamic, 1, Eigen::AutoAlign, MaxDimension_, 1> Implementation;
+
+  /*! \brief The primitive type of the coordinates.
+   */
+  typedef PrimType_ Scalar;
+
+  /*! \brief The maximum dimension of the vector.
+   */
+  static constexpr int MaxDimension = MaxDimension_;
+
+  /*! \brief Default constructor which initializes an empty vector.
+   */
+  BoundedVector()
+    : Implementation() {
+  }
+
+  /*! \brief Constructor which initializes all components of a vector of the given size with zero.
+   *  \param size   size of the vector (must not exceed the capacity)
+   */
+  explicit BoundedVector(int size)
+    : Implementation(Implementation::Zero(size)) {
+    KINDR_ASSERT_TRUE(std::runtime_error, size <= MaxDimension_, "The size exceeds the maximum dimension!");
+  }
+
+  /*! \brief Constructor using a vector with static or dynamic dimension.
+   *  \param other   Vector<PhysicalType_, PrimType_, Dimension_>
+   */
+  template<int Dimension_>
+  explicit BoundedVector(const Vector<PhysicalType_, PrimType_, Dimension_>& other)
+    : Implementation(other.toImplementation()) {
+    KINDR_ASSERT_TRUE(std::runtime_error, other.toImplementation().size() <= MaxDimension_, "The size exceeds the maximum dimension!");
+  }
+
+  /*! \brief Constructor using Eigen::Matrix.
+   *  \param other   Eigen::Matrix<PrimType_, Eigen::Dynamic, 1>
+   */
+  explicit BoundedVector(const Eigen::Matrix<PrimType_, Eigen::Dynamic, 1>& other)
+    : Implementation(other) {
+    KINDR_ASSERT_TRUE(std::runtime_error, other.size() <= MaxDimension_, "The size exceeds the maximum dimension!");
+  }
+
+  /*! \brief Constructor using the implementation type.
+   *  \param other   Eigen::Matrix<PrimType_, Eigen::Dynamic, 1, Eigen::AutoAlign, MaxDimension_, 1>
+   */
+  explicit BoundedVector(const Implementation& other)
+    : Implementation(other) {
+  }
+
+  /*! \brief Gets the current size of the vector.
+   *  \returns size
+   */
+  int size() const {
+    return static_cast<int>(this->toImplementation().size());
+  }
+
+  /*! \brief Resizes the vector within the capacity, leaving the coefficients uninitialized.
+   *  \param size   new size of the vector (must not exceed the capacity)
+   *  \returns reference
+   */
+  BoundedVector<PhysicalType_, PrimType_, MaxDimension_>& resize(int size) {
+    KINDR_ASSERT_TRUE(std::runtime_error, size <= MaxDimension_, "The size exceeds the maximum dimension!");
+    this->toImplementation().resize(size);
+    return *this;
+  }
+
+  /*! \brief Sets all components of the vector to zero.
+   *  \returns reference
+   */
+  BoundedVector<PhysicalType_, PrimType_, MaxDimension_>& setZero() {
+    this->toImplementation().setZero();
+    return *this;
+  }
+
+  /*! \brief Resizes the vector and sets all components to zero.
+   *  \param size   new size of the vector (must not exceed the capacity)
+   *  \returns reference
+   */
+  BoundedVector<PhysicalType_, PrimType_, MaxDimension_>& setZero(int size) {
+    KINDR_ASSERT_TRUE(std::runtime_error, size <= MaxDimension_, "The size exceeds the maximum dimension!");
+    this->toImplementation().setZero(size);
+    return *this;
+  }
+
+  /*! \brief Copies the vector into a vector with dynamic dimension (heap-allocated).
+   *  \returns Vector<PhysicalType_, PrimType_, Eigen::Dynamic>
+   */
+  Vector<PhysicalType_, PrimType_, Eigen::Dynamic> toDynamic() const {
+    return Vector<PhysicalType_, PrimType_, Eigen::Dynamic>(Eigen::Matrix<PrimType_, Eigen::Dynamic, 1>(this->toImplementation()));
+  }
+
+  /*! \brief Cast to the implementation type.
+   *  \returns the implementation (recommended only for advanced users)
+   */
+  inline Implementation& toImplementation() {
+    return static_cast<Implementation&>(*this);
+  }
+
+  /*! \brief Cast to the implementation type.
+   *  \returns the implementation (recommended only for advanced users)
+   */
+  inline const Implementation& toImplementation() const {
+    return static_cast<const Implementation&>(*this);
+  }
+
+  /*! \brief Accesses an entry of the vector.
+   *  \param index   index of the entry
+   *  \returns the value of the entry (copy)
+   */
+  Scalar operator()(int index) const {
+    return this->toImplementation()(index);
+  }
+
+  /*! \brief Accesses an entry of the vector.
+   *  \param index   index of the entry
+   *  \returns the value of the entry (reference)
+   */
+  Scalar& operator()(int index) {
+    return this->toImplementation()(index);
+  }
+
+  /*! \brief Assignment operator.
+   * \param other   other vector
+   * \returns reference
+   */
+  BoundedVector<PhysicalType_, PrimType_, MaxDimension_>& operator=(const BoundedVector<PhysicalType_, PrimType_, MaxDimension_>& other) {
+    this->toImplementation() = other.toImplementation();
+    return *this;
+  }
+
+  /*! \brief Addition of two vectors.
+   * \param other   other vector
+   * \returns sum
+   */
+  BoundedVector<PhysicalType_, PrimType_, MaxDimension_> operator+(const BoundedVector<PhysicalType_, PrimType_, MaxDimension_>& other) const {
+    return BoundedVector<PhysicalType_, PrimType_, MaxDimension_>(Implementation(this->toImplementation() + other.toImplementation()));
+  }
+
+  /*! \brief Subtraction of two vectors.
+   * \param other   other vector
+   * \returns difference
+   */
+  BoundedVector<PhysicalType_, PrimType_, MaxDimension_> operator-(const BoundedVector<PhysicalType_, PrimType_, MaxDimension_>& other) const {
+    return BoundedVector<PhysicalType_, PrimType_, MaxDimension_>(Implementation(this->toImplementation() - other.toImplementation()));
+  }
+
+  /*! \brief Multiplies vector with a scalar.
+   * \param factor   factor
+   * \returns product
+   */
+  template<typename PrimTypeFactor_>
+  BoundedVector<PhysicalType_, PrimType_, MaxDimension_> operator*(PrimTypeFactor_ factor) const {
+    return BoundedVector<PhysicalType_, PrimType_, MaxDimension_>(Implementation(this->toImplementation()*(PrimType_)factor));
+  }
+
+  /*! \brief Divides vector by a scalar.
+   * \param divisor   divisor
+   * \returns quotient
+   */
+  template<typename PrimTypeDivisor_>
+  BoundedVector<PhysicalType_, PrimType_, MaxDimension_> operator/(PrimTypeDivisor_ divisor) const {
+    return BoundedVector<PhysicalType_, PrimType_, MaxDimension_>(Implementation(this->toImplementation()/(PrimType_)divisor));
+  }
+
+  /*! \brief Addition and assignment of two vectors.
+   * \param other   other vector
+   * \returns reference
+   */
+  BoundedVector<PhysicalType_, PrimType_, MaxDimension_>& operator+=(const BoundedVector<PhysicalType_, PrimType_, MaxDimension_>& other) {
+    this->toImplementation() += other.toImplementation();
+    return *this;
+  }
+
+  /*! \brief Subtraction and assignment of two vectors.
+   * \param other   other vector
+   * \returns reference
+   */
+  BoundedVector<PhysicalType_, PrimType_, MaxDimension_>& operator-=(const BoundedVector<PhysicalType_, PrimType_, MaxDimension_>& other) {
+    this->toImplementation() -= other.toImplementation();
+    return *this;
+  }
+
+  /*! \brief Multiplication with a scalar and assignment.
+   * \param factor   factor
+   * \returns reference
+   */
+  template<typename PrimTypeFactor_>
+  BoundedVector<PhysicalType_, PrimType_, MaxDimension_>& operator*=(PrimTypeFactor_ factor) {
+    this->toImplementation() *= (PrimType_)factor;
+    return *this;
+  }
+
+  /*! \brief Division by a scalar and assignment.
+   * \param divisor   divisor
+   * \returns reference
+   */
+  template<typename PrimTypeDivisor_>
+  BoundedVector<PhysicalType_, PrimType_, MaxDimension_>& operator/=(PrimTypeDivisor_ divisor) {
+    this->toImplementation() /= (PrimType_)divisor;
+    return *this;
+  }
+
+  /*! \brief Negation of a vector.
+   * \returns negative vector
+   */
+  BoundedVector<PhysicalType_, PrimType_, MaxDimension_> operator-() const {
+    return BoundedVector<PhysicalType_, PrimType_, MaxDimension_>(Implementation(-this->toImplementation()));
+  }
+
+  /*! \brief Comparison operator.
+   * \param other   other vector
+   * \returns true if equal
+   */
+  bool operator==(const BoundedVector<PhysicalType_, PrimType_, MaxDimension_>& other) const {
+    return this->toImplementation() == other.toImplementation();
+  }
+
+  /*! \brief Norm of the vector.
+   *  \returns norm.
+   */
+  Scalar norm() const {
+    return this->toImplementation().norm();
+  }
+
+  /*! \brief Squared norm of the vector.
+   *  \returns norm.
+   */
+  Scalar squaredNorm() const {
+    return this->toImplementation().squaredNorm();
+  }
+
+  /*! \brief Dot product with other vector.
+   *  \param other   other vector
+   *  \returns dot product.
+   */
+  template<enum PhysicalType PhysicalTypeOther_>
+  Scalar dot(const BoundedVector<PhysicalTypeOther_, PrimType_, MaxDimension_>& other) const {
+    return this->toImplementation().dot(other.toImplementation());
+  }
+
+  /*! \brief Sum of the components.
+   *  \returns sum.
+   */
+  Scalar sum() const {
+    return this->toImplementation().sum();
+  }
+
+  /*! \brief Used for printing the object with std::cout.
+   *  \returns std::stream object
+   */
+  friend std::ostream& operator << (std::ostream& out, const BoundedVector<PhysicalType_, PrimType_, MaxDimension_>& vector) {
+    out << vector.toImplementation().transpose();
+    return out;
+  }
+};
+
+/*! \brief Multiplies a vector with a scalar.
+ * \param factor   factor
+ * \returns product
+ */
+template<enum PhysicalType PhysicalType_, typename PrimTypeFactor_, typename PrimType_, int MaxDimension_>
+BoundedVector<PhysicalType_, PrimType_, MaxDimension_> operator*(PrimTypeFactor_ factor, const BoundedVector<PhysicalType_, PrimType_, MaxDimension_>& vector) {
+  return vector*(PrimType_)factor;
+}
+
+namespace internal {
+
+/*! \brief Gets the primitive type of the vector
+ */
+template<enum PhysicalType PhysicalType_, typename PrimType_, int MaxDimension_>
+class get_scalar<BoundedVector<PhysicalType_, PrimType_, MaxDimension_>> {
+ public:
+  typedef PrimType_ Scalar;
+};
+
+/*! \brief Gets the dimension of the vector (dynamic, since the size is chosen at run time)
+ */
+template<enum PhysicalType PhysicalType_, typename PrimType_, int MaxDimension_>
+class get_dimension<BoundedVector<PhysicalType_, PrimType_, MaxDimension_>> {
+ public:
+  static constexpr int Dimension = Eigen::Dynamic;
+};
+
+} // namespace internal
+} // namespace kindr
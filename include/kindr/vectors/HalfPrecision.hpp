@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/poses/Pose.hpp"
+
+namespace kindr {
+
+/*! \file HalfPrecision.hpp
+ *  \brief Half-precision (IEEE 754 binary16) storage with float compute for vector batches.
+ *
+ *  Dense batches of float positions are memory-bandwidth-bound: the arithmetic per
+ *  point is trivial next to the cost of streaming the arrays through the cache
+ *  hierarchy. Storing the payload as binary16 halves the bytes moved; the kernels
+ *  widen a tile to float, compute in float, and narrow the result, so no arithmetic
+ *  ever happens in half precision. The ~3 decimal digits of binary16 are plenty for
+ *  depth-map payloads in metric range.
+ */
+
+namespace internal {
+
+//! \brief Converts a single float to its binary16 bit pattern (round to nearest even).
+inline std::uint16_t encodeHalf(float value) {
+  std::uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  const std::uint16_t sign = static_cast<std::uint16_t>((bits >> 16u) & 0x8000u);
+  const std::uint32_t exponent = (bits >> 23u) & 0xFFu;
+  std::uint32_t mantissa = bits & 0x007FFFFFu;
+
+  if (exponent >= 0x8Fu) {  // overflows half range, or inf/nan
+    if (exponent == 0xFFu) {
+      return static_cast<std::uint16_t>(sign | 0x7C00u | (mantissa != 0u ? 0x0200u : 0u));
+    }
+    return static_cast<std::uint16_t>(sign | 0x7C00u);  // +/- infinity
+  }
+  if (exponent <= 0x70u) {  // subnormal in half precision
+    if (exponent < 0x66u) {
+      return sign;  // underflows to signed zero
+    }
+    mantissa |= 0x00800000u;
+    const std::uint32_t shift = 0x7Eu - exponent;
+    const std::uint32_t rounded = mantissa + (1u << (shift - 1u)) - 1u + ((mantissa >> shift) & 1u);
+    return static_cast<std::uint16_t>(sign | (rounded >> shift));
+  }
+  // normal case: rebias exponent, round mantissa to 10 bits (nearest even)
+  std::uint32_t half = ((exponent - 0x70u) << 10u) | (mantissa >> 13u);
+  const std::uint32_t remainder = mantissa & 0x1FFFu;
+  if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) {
+    half++;  // a mantissa carry correctly bumps the exponent, up to infinity
+  }
+  return static_cast<std::uint16_t>(sign | half);
+}
+
+//! \brief Converts a binary16 bit pattern back to float.
+inline float decodeHalf(std::uint16_t half) {
+  const std::uint32_t sign = static_cast<std::uint32_t>(half & 0x8000u) << 16u;
+  const std::uint32_t exponent = (half >> 10u) & 0x1Fu;
+  std::uint32_t mantissa = half & 0x03FFu;
+  std::uint32_t bits;
+
+  if (exponent == 0x1Fu) {  // inf/nan
+    bits = sign | 0x7F800000u | (mantissa << 13u);
+  } else if (exponent != 0u) {  // normal
+    bits = sign | ((exponent + 0x70u) << 23u) | (mantissa << 13u);
+  } else if (mantissa != 0u) {  // subnormal: renormalize
+    std::uint32_t shiftedExponent = 0x71u;
+    while ((mantissa & 0x0400u) == 0u) {
+      mantissa <<= 1u;
+      shiftedExponent--;
+    }
+    bits = sign | (shiftedExponent << 23u) | ((mantissa & 0x03FFu) << 13u);
+  } else {
+    bits = sign;  // signed zero
+  }
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+} // namespace internal
+
+/*! \class HalfMatrix3X
+ * \brief Batch of 3D vectors stored as binary16, widened to float on access.
+ *
+ *  Column-major like Eigen::Matrix3Xf, at half the bytes. Whole-batch accessors
+ *  widen/narrow through float; the rotate/transform kernels below work tile-wise
+ *  so the widened copy stays cache-resident.
+ */
+class HalfMatrix3X {
+ public:
+  HalfMatrix3X() = default;
+
+  explicit HalfMatrix3X(const Eigen::Matrix3Xf& matrix) {
+    setFromMatrix(matrix);
+  }
+
+  //! \brief Narrows a float batch into half-precision storage.
+  void setFromMatrix(const Eigen::Matrix3Xf& matrix) {
+    data_.resize(static_cast<std::size_t>(3*matrix.cols()));
+    for (std::size_t k = 0; k < data_.size(); k++) {
+      data_[k] = internal::encodeHalf(matrix(static_cast<Eigen::Index>(k % 3u), static_cast<Eigen::Index>(k/3u)));
+    }
+  }
+
+  //! \brief Widens the whole batch back to float.
+  Eigen::Matrix3Xf toMatrix() const {
+    Eigen::Matrix3Xf matrix(3, cols());
+    for (std::size_t k = 0; k < data_.size(); k++) {
+      matrix(static_cast<Eigen::Index>(k % 3u), static_cast<Eigen::Index>(k/3u)) = internal::decodeHalf(data_[k]);
+    }
+    return matrix;
+  }
+
+  Eigen::Vector3f col(Eigen::Index index) const {
+    return Eigen::Vector3f(internal::decodeHalf(data_[static_cast<std::size_t>(3*index)]),
+                           internal::decodeHalf(data_[static_cast<std::size_t>(3*index + 1)]),
+                           internal::decodeHalf(data_[static_cast<std::size_t>(3*index + 2)]));
+  }
+
+  void setCol(Eigen::Index index, const Eigen::Vector3f& value) {
+    data_[static_cast<std::size_t>(3*index)] = internal::encodeHalf(value.x());
+    data_[static_cast<std::size_t>(3*index + 1)] = internal::encodeHalf(value.y());
+    data_[static_cast<std::size_t>(3*index + 2)] = internal::encodeHalf(value.z());
+  }
+
+  void resize(Eigen::Index numCols) {
+    data_.resize(static_cast<std::size_t>(3*numCols));
+  }
+
+  Eigen::Index cols() const {
+    return static_cast<Eigen::Index>(data_.size()/3u);
+  }
+
+  //! \brief Bytes held by the payload (half of the equivalent Matrix3Xf).
+  std::size_t bytes() const {
+    return data_.size()*sizeof(std::uint16_t);
+  }
+
+ private:
+  std::vector<std::uint16_t> data_;
+};
+
+/*! \brief Rotates a half-precision batch; widens tiles to float, computes in float, narrows the result.
+ *  \param rotation  rotation in any parameterization (float scalar)
+ *  \param points    half-precision input batch
+ *  \param rotatedPoints  half-precision output batch; resized to match the input
+ */
+template<typename Rotation_>
+void rotateHalfBatch(const RotationBase<Rotation_>& rotation, const HalfMatrix3X& points, HalfMatrix3X& rotatedPoints) {
+  const Eigen::Matrix3f rotationMatrix = RotationMatrix<float>(rotation.derived()).matrix();
+  const Eigen::Index numCols = points.cols();
+  rotatedPoints.resize(numCols);
+  // a float tile of 1024 points is 12 KB in and out: comfortably L1/L2 resident
+  const Eigen::Index tileSize = 1024;
+  Eigen::Matrix3Xf tile(3, std::min(tileSize, numCols));
+  for (Eigen::Index begin = 0; begin < numCols; begin += tileSize) {
+    const Eigen::Index count = std::min(tileSize, numCols - begin);
+    for (Eigen::Index k = 0; k < count; k++) {
+      tile.col(k) = points.col(begin + k);
+    }
+    tile.leftCols(count) = rotationMatrix*tile.leftCols(count);
+    for (Eigen::Index k = 0; k < count; k++) {
+      rotatedPoints.setCol(begin + k, tile.col(k));
+    }
+  }
+}
+
+/*! \brief Transforms a half-precision batch through a pose; same widening scheme as rotateHalfBatch(). */
+template<typename Pose_>
+void transformHalfBatch(const PoseBase<Pose_>& pose, const HalfMatrix3X& points, HalfMatrix3X& transformedPoints) {
+  const Eigen::Matrix3f rotationMatrix = RotationMatrix<float>(pose.derived().getRotation()).matrix();
+  const Eigen::Vector3f translation = pose.derived().getPosition().toImplementation().template cast<float>();
+  const Eigen::Index numCols = points.cols();
+  transformedPoints.resize(numCols);
+  const Eigen::Index tileSize = 1024;
+  Eigen::Matrix3Xf tile(3, std::min(tileSize, numCols));
+  for (Eigen::Index begin = 0; begin < numCols; begin += tileSize) {
+    const Eigen::Index count = std::min(tileSize, numCols - begin);
+    for (Eigen::Index k = 0; k < count; k++) {
+      tile.col(k) = points.col(begin + k);
+    }
+    tile.leftCols(count) = (rotationMatrix*tile.leftCols(count)).colwise() + translation;
+    for (Eigen::Index k = 0; k < count; k++) {
+      transformedPoints.setCol(begin + k, tile.col(k));
+    }
+  }
+}
+
+} // namespace kindr
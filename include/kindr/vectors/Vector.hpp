@@ -38,6 +38,9 @@
 
 namespace kindr {
 
+template<enum PhysicalType PhysicalType_, typename PrimType_, int Dimension_, typename EigenExpression_>
+class VectorExpression;
+
 /*! \class Vector
  * \brief Vector in n-dimensional-space.
  *
@@ -113,6 +116,17 @@ class Vector : public VectorBase<Vector<PhysicalType_, PrimType_, Dimension_> >,
     : Implementation(other) {
   }
 
+  /*! \brief Constructor using a fused arithmetic expression.
+   *
+   *  The expression collapses into a single loop while this vector is filled,
+   *  so no intermediate vectors are materialized (see VectorExpression.hpp).
+   *  \param expression   expression with the same physical type and dimension
+   */
+  template<typename EigenExpression_>
+  Vector(const VectorExpression<PhysicalType_, PrimType_, Dimension_, EigenExpression_>& expression)
+    : Implementation(expression.expression()) {
+  }
+
   /*! \brief Constructor using three scalars.
    *  \param x x-Component
    *  \param y y-Component
@@ -333,6 +347,19 @@ class Vector : public VectorBase<Vector<PhysicalType_, PrimType_, Dimension_> >,
     return *this;
   }
 
+  /*! \brief Assignment of a fused arithmetic expression.
+   *
+   *  Evaluates the expression directly into this vector's storage in a single
+   *  loop (see VectorExpression.hpp).
+   * \param expression   expression with the same physical type and dimension
+   * \returns reference
+   */
+  template<typename EigenExpression_>
+  Vector<PhysicalType_, PrimType_, Dimension_>& operator=(const VectorExpression<PhysicalType_, PrimType_, Dimension_, EigenExpression_>& expression) {
+    this->toImplementation() = expression.expression();
+    return *this;
+  }
+
   /*! \brief Addition of two vectors.
    * \param other   other vector
    * \returns sum
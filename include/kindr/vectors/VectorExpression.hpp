@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include "kindr/vectors/Vector.hpp"
+
+namespace kindr {
+
+/*! \class VectorExpression
+ * \brief Lazy arithmetic expression over vectors with a physical type.
+ *
+ * Every eager operator on Vector materializes a new Vector, so a chain like
+ * a + b - c*dt constructs one temporary per operator. This wrapper keeps the
+ * underlying Eigen expression unevaluated while carrying the PhysicalType
+ * bookkeeping at compile time; the chain collapses into a single loop when it
+ * is assigned to a Vector. Usage:
+ *
+ *   result = expr(a) + expr(b) - expr(c)*dt;
+ *
+ * The expression holds references into its operands, so it must be assigned
+ * within the same statement and must not be stored.
+ *
+ * \tparam PhysicalType_     Physical type of the expression.
+ * \tparam PrimType_         Primitive type of the coordinates.
+ * \tparam Dimension_        Dimension of the expression.
+ * \tparam EigenExpression_  Underlying Eigen expression type.
+ * \ingroup vectors
+ */
+template<enum PhysicalType PhysicalType_, typename PrimType_, int Dimension_, typename EigenExpression_>
+class VectorExpression {
+ public:
+  //! The vector type the expression evaluates to
+  typedef Vector<PhysicalType_, PrimType_, Dimension_> VectorType;
+
+  //! The primitive type of the coordinates
+  typedef PrimType_ Scalar;
+
+  explicit VectorExpression(const EigenExpression_& expression)
+    : expression_(expression) {
+  }
+
+  /*! \brief Returns the underlying Eigen expression.
+   *  \returns unevaluated Eigen expression
+   */
+  const EigenExpression_& expression() const {
+    return expression_;
+  }
+
+  /*! \brief Evaluates the expression.
+   *  \returns the evaluated vector
+   */
+  VectorType eval() const {
+    return VectorType(*this);
+  }
+
+ private:
+  EigenExpression_ expression_;
+};
+
+namespace internal {
+
+//! Builds a VectorExpression around an Eigen expression, deducing the expression type
+template<enum PhysicalType PhysicalType_, typename PrimType_, int Dimension_, typename EigenExpression_>
+inline VectorExpression<PhysicalType_, PrimType_, Dimension_, EigenExpression_> makeVectorExpression(const EigenExpression_& expression) {
+  return VectorExpression<PhysicalType_, PrimType_, Dimension_, EigenExpression_>(expression);
+}
+
+} // namespace internal
+
+/*! \brief Enters the lazy expression layer for a vector.
+ *  \param vector   vector to wrap
+ *  \returns expression referencing the vector's storage
+ */
+template<enum PhysicalType PhysicalType_, typename PrimType_, int Dimension_>
+inline VectorExpression<PhysicalType_, PrimType_, Dimension_, const typename Vector<PhysicalType_, PrimType_, Dimension_>::Implementation&>
+expr(const Vector<PhysicalType_, PrimType_, Dimension_>& vector) {
+  return VectorExpression<PhysicalType_, PrimType_, Dimension_, const typename Vector<PhysicalType_, PrimType_, Dimension_>::Implementation&>(vector.toImplementation());
+}
+
+/*! \brief Addition of two expressions. */
+template<enum PhysicalType PhysicalType_, typename PrimType_, int Dimension_, typename Left_, typename Right_>
+inline auto operator+(const VectorExpression<PhysicalType_, PrimType_, Dimension_, Left_>& lhs, const VectorExpression<PhysicalType_, PrimType_, Dimension_, Right_>& rhs)
+    -> decltype(internal::makeVectorExpression<PhysicalType_, PrimType_, Dimension_>(lhs.expression() + rhs.expression())) {
+  return internal::makeVectorExpression<PhysicalType_, PrimType_, Dimension_>(lhs.expression() + rhs.expression());
+}
+
+/*! \brief Subtraction of two expressions. */
+template<enum PhysicalType PhysicalType_, typename PrimType_, int Dimension_, typename Left_, typename Right_>
+inline auto operator-(const VectorExpression<PhysicalType_, PrimType_, Dimension_, Left_>& lhs, const VectorExpression<PhysicalType_, PrimType_, Dimension_, Right_>& rhs)
+    -> decltype(internal::makeVectorExpression<PhysicalType_, PrimType_, Dimension_>(lhs.expression() - rhs.expression())) {
+  return internal::makeVectorExpression<PhysicalType_, PrimType_, Dimension_>(lhs.expression() - rhs.expression());
+}
+
+/*! \brief Addition of an expression and a vector. */
+template<enum PhysicalType PhysicalType_, typename PrimType_, int Dimension_, typename Left_>
+inline auto operator+(const VectorExpression<PhysicalType_, PrimType_, Dimension_, Left_>& lhs, const Vector<PhysicalType_, PrimType_, Dimension_>& rhs)
+    -> decltype(internal::makeVectorExpression<PhysicalType_, PrimType_, Dimension_>(lhs.expression() + rhs.toImplementation())) {
+  return internal::makeVectorExpression<PhysicalType_, PrimType_, Dimension_>(lhs.expression() + rhs.toImplementation());
+}
+
+/*! \brief Addition of a vector and an expression. */
+template<enum PhysicalType PhysicalType_, typename PrimType_, int Dimension_, typename Right_>
+inline auto operator+(const Vector<PhysicalType_, PrimType_, Dimension_>& lhs, const VectorExpression<PhysicalType_, PrimType_, Dimension_, Right_>& rhs)
+    -> decltype(internal::makeVectorExpression<PhysicalType_, PrimType_, Dimension_>(lhs.toImplementation() + rhs.expression())) {
+  return internal::makeVectorExpression<PhysicalType_, PrimType_, Dimension_>(lhs.toImplementation() + rhs.expression());
+}
+
+/*! \brief Subtraction of a vector from an expression. */
+template<enum PhysicalType PhysicalType_, typename PrimType_, int Dimension_, typename Left_>
+inline auto operator-(const VectorExpression<PhysicalType_, PrimType_, Dimension_, Left_>& lhs, const Vector<PhysicalType_, PrimType_, Dimension_>& rhs)
+    -> decltype(internal::makeVectorExpression<PhysicalType_, PrimType_, Dimension_>(lhs.expression() - rhs.toImplementation())) {
+  return internal::makeVectorExpression<PhysicalType_, PrimType_, Dimension_>(lhs.expression() - rhs.toImplementation());
+}
+
+/*! \brief Subtraction of an expression from a vector. */
+template<enum PhysicalType PhysicalType_, typename PrimType_, int Dimension_, typename Right_>
+inline auto operator-(const Vector<PhysicalType_, PrimType_, Dimension_>& lhs, const VectorExpression<PhysicalType_, PrimType_, Dimension_, Right_>& rhs)
+    -> decltype(internal::makeVectorExpression<PhysicalType_, PrimType_, Dimension_>(lhs.toImplementation() - rhs.expression())) {
+  return internal::makeVectorExpression<PhysicalType_, PrimType_, Dimension_>(lhs.toImplementation() - rhs.expression());
+}
+
+/*! \brief Multiplication of an expression with a scalar. */
+template<enum PhysicalType PhysicalType_, typename PrimType_, int Dimension_, typename Expression_, typename PrimTypeFactor_>
+inline auto operator*(const VectorExpression<PhysicalType_, PrimType_, Dimension_, Expression_>& expression, PrimTypeFactor_ factor)
+    -> decltype(internal::makeVectorExpression<PhysicalType_, PrimType_, Dimension_>(expression.expression()*PrimType_(1))) {
+  return internal::makeVectorExpression<PhysicalType_, PrimType_, Dimension_>(expression.expression()*(PrimType_)factor);
+}
+
+/*! \brief Multiplication of a scalar with an expression. */
+template<enum PhysicalType PhysicalType_, typename PrimType_, int Dimension_, typename Expression_, typename PrimTypeFactor_>
+inline auto operator*(PrimTypeFactor_ factor, const VectorExpression<PhysicalType_, PrimType_, Dimension_, Expression_>& expression)
+    -> decltype(internal::makeVectorExpression<PhysicalType_, PrimType_, Dimension_>(expression.expression()*PrimType_(1))) {
+  return internal::makeVectorExpression<PhysicalType_, PrimType_, Dimension_>(expression.expression()*(PrimType_)factor);
+}
+
+/*! \brief Division of an expression by a scalar. */
+template<enum PhysicalType PhysicalType_, typename PrimType_, int Dimension_, typename Expression_, typename PrimTypeDivisor_>
+inline auto operator/(const VectorExpression<PhysicalType_, PrimType_, Dimension_, Expression_>& expression, PrimTypeDivisor_ divisor)
+    -> decltype(internal::makeVectorExpression<PhysicalType_, PrimType_, Dimension_>(expression.expression()/PrimType_(1))) {
+  return internal::makeVectorExpression<PhysicalType_, PrimType_, Dimension_>(expression.expression()/(PrimType_)divisor);
+}
+
+/*! \brief Negation of an expression. */
+template<enum PhysicalType PhysicalType_, typename PrimType_, int Dimension_, typename Expression_>
+inline auto operator-(const VectorExpression<PhysicalType_, PrimType_, Dimension_, Expression_>& expression)
+    -> decltype(internal::makeVectorExpression<PhysicalType_, PrimType_, Dimension_>(-expression.expression())) {
+  return internal::makeVectorExpression<PhysicalType_, PrimType_, Dimension_>(-expression.expression());
+}
+
+} // namespace kindr
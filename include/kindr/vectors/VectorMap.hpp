@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#pragma once
+
+#include <Eigen/Core>
+
+#include "kindr/vectors/Vector.hpp"
+
+namespace kindr {
+
+/*! \class Map
+ * \brief View on a kindr type placed over caller-owned memory, analogous to Eigen::Map.
+ *
+ *  The primary template is not defined; specializations exist for the types
+ *  that support zero-copy mapping.
+ * \tparam Type_ the mapped kindr type
+ */
+template<typename Type_>
+class Map;
+
+/*! \brief View on a Vector over caller-owned memory.
+ *
+ *  Wraps an external coordinate buffer without copying it. Reads and writes go
+ *  directly to the buffer; conversion to a Vector and assignment from a Vector
+ *  copy through it, which makes ingestion from DDS/ROS messages or mmapped
+ *  sensor blocks zero-copy.
+ *
+ * \tparam PhysicalType_    Physical type of the vector.
+ * \tparam PrimType_        Primitive type of the coordinates.
+ * \tparam Dimension_       Dimension of the vector.
+ * \ingroup vectors
+ */
+template<enum PhysicalType PhysicalType_, typename PrimType_, int Dimension_>
+class Map<Vector<PhysicalType_, PrimType_, Dimension_>> {
+ public:
+  //! The mapped kindr type
+  typedef Vector<PhysicalType_, PrimType_, Dimension_> VectorType;
+  //! The implementation type of the mapped kindr type
+  typedef typename VectorType::Implementation Implementation;
+  //! The Eigen map over the external buffer
+  typedef Eigen::Map<Implementation> ImplementationMap;
+  //! The Eigen map over a constant external buffer
+  typedef Eigen::Map<const Implementation> ConstImplementationMap;
+  //! The primitive type of the coordinates
+  typedef PrimType_ Scalar;
+
+  /*! \brief Constructor for static-dimension vectors.
+   *  \param data   external buffer of Dimension_ coordinates, must outlive the map
+   */
+  template<int DimensionCopy_ = Dimension_>
+  explicit Map(PrimType_* data, typename std::enable_if<DimensionCopy_ != Eigen::Dynamic>::type* = nullptr)
+    : map_(data) {
+  }
+
+  /*! \brief Constructor for dynamic-dimension vectors.
+   *  \param data   external buffer, must outlive the map
+   *  \param size   number of coordinates in the buffer
+   */
+  template<int DimensionCopy_ = Dimension_>
+  Map(PrimType_* data, int size, typename std::enable_if<DimensionCopy_ == Eigen::Dynamic>::type* = nullptr)
+    : map_(data, size) {
+  }
+
+  /*! \brief Cast to the Eigen map.
+   *  \returns the map for direct manipulation (recommended only for advanced users)
+   */
+  ImplementationMap& toImplementation() {
+    return map_;
+  }
+
+  /*! \brief Cast to the Eigen map.
+   *  \returns the map for direct manipulation (recommended only for advanced users)
+   */
+  const ImplementationMap& toImplementation() const {
+    return map_;
+  }
+
+  /*! \brief Copies the mapped coordinates into an owning vector.
+   *  \returns owning vector with the mapped coordinates
+   */
+  operator VectorType() const {
+    return VectorType(Implementation(map_));
+  }
+
+  /*! \brief Writes an owning vector through the map into the external buffer.
+   *  \returns reference
+   */
+  Map& operator =(const VectorType& other) {
+    map_ = other.toImplementation();
+    return *this;
+  }
+
+  /*! \brief Accesses an entry of the mapped vector.
+   *  \param index   index of the entry
+   *  \returns reference to the coordinate in the external buffer
+   */
+  PrimType_& operator ()(int index) {
+    return map_(index);
+  }
+
+  /*! \brief Accesses an entry of the mapped vector.
+   *  \param index   index of the entry
+   *  \returns coordinate in the external buffer
+   */
+  PrimType_ operator ()(int index) const {
+    return map_(index);
+  }
+
+ private:
+  //! Eigen map over the external buffer
+  ImplementationMap map_;
+};
+
+} // namespace kindr
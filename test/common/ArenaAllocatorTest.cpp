@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "kindr/common/ArenaAllocator.hpp"
+#include "kindr/poses/Pose.hpp"
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
+
+TEST(ArenaAllocatorTest, testCreateIsContiguous) {
+  typedef kindr::HomogeneousTransformationPosition3RotationQuaternionD Pose;
+  kindr::MemoryArena arena;
+  std::vector<Pose*> nodes;
+  for (int i = 0; i < 100; i++) {
+    nodes.push_back(arena.create<Pose>(Pose::Position(1.0*i, 0.0, 0.0), Pose::Rotation()));
+  }
+  // nodes allocated together sit back to back in one block
+  for (std::size_t i = 1; i < nodes.size(); i++) {
+    const std::ptrdiff_t distance = reinterpret_cast<char*>(nodes[i]) - reinterpret_cast<char*>(nodes[i - 1]);
+    EXPECT_GT(distance, 0);
+    EXPECT_LE(distance, static_cast<std::ptrdiff_t>(sizeof(Pose) + alignof(Pose)));
+  }
+  for (int i = 0; i < 100; i++) {
+    EXPECT_EQ(1.0*i, nodes[i]->getPosition().x());
+  }
+  EXPECT_EQ(100u*sizeof(Pose), arena.getAllocatedBytes());
+}
+
+TEST(ArenaAllocatorTest, testAlignment) {
+  kindr::MemoryArena arena(256u);
+  for (int i = 0; i < 50; i++) {
+    void* pointer = arena.allocate(13u, 32u);
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(pointer) % 32u);
+  }
+}
+
+TEST(ArenaAllocatorTest, testResetRecyclesBlocks) {
+  kindr::MemoryArena arena(1024u);
+  void* first = arena.allocate(64u, 16u);
+  for (int i = 0; i < 100; i++) {
+    arena.allocate(64u, 16u);
+  }
+  const std::size_t capacity = arena.getCapacityBytes();
+  arena.reset();
+  EXPECT_EQ(0u, arena.getAllocatedBytes());
+  // the blocks survive the reset and are handed out again
+  EXPECT_EQ(first, arena.allocate(64u, 16u));
+  for (int i = 0; i < 100; i++) {
+    arena.allocate(64u, 16u);
+  }
+  EXPECT_EQ(capacity, arena.getCapacityBytes());
+}
+
+TEST(ArenaAllocatorTest, testGrowsBeyondOneBlock) {
+  kindr::MemoryArena arena(128u);
+  std::vector<void*> pointers;
+  for (int i = 0; i < 64; i++) {
+    pointers.push_back(arena.allocate(48u, 16u));
+  }
+  for (std::size_t i = 0; i < pointers.size(); i++) {
+    for (std::size_t k = i + 1; k < pointers.size(); k++) {
+      EXPECT_NE(pointers[i], pointers[k]);
+    }
+  }
+  // an allocation larger than the block size gets its own block
+  EXPECT_NE(nullptr, arena.allocate(1000u, 16u));
+}
+
+TEST(ArenaAllocatorTest, testStlAdapter) {
+  typedef kindr::HomogeneousTransformationPosition3RotationQuaternionD Pose;
+  kindr::MemoryArena arena;
+  std::vector<Pose, kindr::ArenaAllocator<Pose>> poses{kindr::ArenaAllocator<Pose>(arena)};
+  for (int i = 0; i < 20; i++) {
+    poses.push_back(Pose(Pose::Position(0.0, 1.0*i, 0.0), Pose::Rotation()));
+  }
+  for (int i = 0; i < 20; i++) {
+    EXPECT_EQ(1.0*i, poses[i].getPosition().y());
+  }
+  EXPECT_TRUE(kindr::ArenaAllocator<Pose>(arena) == poses.get_allocator());
+}
+
+TEST(ArenaAllocatorTest, testAlignedVector) {
+  kindr::aligned_vector<kindr::HomogeneousTransformationPosition3RotationQuaternionD> poses;
+  kindr::aligned_vector<kindr::Force3D> forces;
+  kindr::aligned_vector<kindr::Position3D> positions;
+  for (int i = 0; i < 10; i++) {
+    poses.emplace_back();
+    forces.emplace_back(1.0*i, 0.0, 0.0);
+    positions.emplace_back(0.0, 0.0, 1.0*i);
+  }
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(poses.data()) % 16u);
+  EXPECT_EQ(10u, poses.size());
+  EXPECT_EQ(9.0, forces.back().x());
+  EXPECT_EQ(9.0, positions.back().z());
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+// This translation unit is compiled with KINDR_USE_ASSUME_ASSERTS and
+// KINDR_ASSERT_SAMPLING_RATE=2 (see test/CMakeLists.txt): the always-on
+// asserts become optimizer hints and every second call per call site still
+// validates and throws. A violated invariant on an unsampled call is undefined
+// behavior in this mode, so all unsampled calls below satisfy their condition.
+
+#include <gtest/gtest.h>
+
+#include "kindr/common/assert_macros_eigen.hpp"
+#include "kindr/rotations/Rotation.hpp"
+
+TEST(AssumeAssertTest, testSatisfiedAssertsDoNotThrow) {
+  EXPECT_NO_THROW({
+    KINDR_ASSERT_TRUE(std::runtime_error, 1 + 1 == 2, "true");
+    KINDR_ASSERT_FALSE(std::runtime_error, 1 + 1 == 3, "false");
+    KINDR_ASSERT_GE_LT(std::runtime_error, 0.5, 0.0, 1.0, "range");
+    KINDR_ASSERT_LT(std::runtime_error, 0.5, 1.0, "lt");
+    KINDR_ASSERT_GE(std::runtime_error, 0.5, 0.0, "ge");
+    KINDR_ASSERT_LE(std::runtime_error, 0.5, 1.0, "le");
+    KINDR_ASSERT_GT(std::runtime_error, 0.5, 0.0, "gt");
+    KINDR_ASSERT_EQ(std::runtime_error, 2, 2, "eq");
+    KINDR_ASSERT_NE(std::runtime_error, 2, 3, "ne");
+    KINDR_ASSERT_NEAR(std::runtime_error, 1.0, 1.0 + 1e-12, 1e-6, "near");
+  });
+}
+
+TEST(AssumeAssertTest, testSamplingValidatesEverySecondCall) {
+  auto guardedCall = [](int value) {
+    KINDR_ASSERT_TRUE(std::runtime_error, value > 0, "value must be positive");
+  };
+  int caught = 0;
+  for (int k = 0; k < 8; k++) {
+    // odd calls are unsampled and valid; even calls are sampled and violated
+    const int value = (k % 2 == 0) ? 1 : -1;
+    try {
+      guardedCall(value);
+    } catch (const std::runtime_error&) {
+      caught++;
+    }
+  }
+  EXPECT_EQ(4, caught);
+}
+
+TEST(AssumeAssertTest, testSampledComparisonAssertsThrow) {
+  auto upperBounded = [](double value) {
+    KINDR_ASSERT_LT(std::runtime_error, value, 1.0, "upper bound");
+  };
+  upperBounded(0.5); // unsampled, valid
+  EXPECT_THROW(upperBounded(2.0), std::runtime_error);
+
+  auto equalityChecked = [](int value) {
+    KINDR_ASSERT_EQ(std::runtime_error, value, 7, "must be seven");
+  };
+  equalityChecked(7); // unsampled, valid
+  EXPECT_THROW(equalityChecked(8), std::runtime_error);
+
+  auto nearChecked = [](double value) {
+    KINDR_ASSERT_NEAR(std::runtime_error, value, 1.0, 1e-6, "must be one");
+  };
+  nearChecked(1.0); // unsampled, valid
+  EXPECT_THROW(nearChecked(2.0), std::runtime_error);
+}
+
+TEST(AssumeAssertTest, testRotationCodeRunsWithAssumedInvariants) {
+  // exercise headers whose debug asserts now expand to assume hints
+  const kindr::RotationQuaternionD rotation(kindr::EulerAnglesZyxD(0.4, -0.7, 1.1));
+  const kindr::RotationQuaternionD composed = rotation*rotation.inverted();
+  EXPECT_TRUE(composed.isNear(kindr::RotationQuaternionD(), 1e-12));
+}
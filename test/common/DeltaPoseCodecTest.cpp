@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "kindr/packed/DeltaPoseCodec.hpp"
+
+namespace packed = kindr::packed;
+
+namespace {
+
+typedef packed::DeltaPoseEncoderD::PoseType Pose;
+typedef Pose::Position Position;
+typedef Pose::Rotation Rotation;
+
+/*! Generates a smooth 1 kHz-like trajectory: small frame-to-frame increments
+ *  around a random walk, the regime the codec is built for. */
+std::vector<Pose, Eigen::aligned_allocator<Pose>> makeTrajectory(std::size_t size) {
+  std::vector<Pose, Eigen::aligned_allocator<Pose>> poses;
+  Pose pose(Position(0.5, -0.2, 1.0), Rotation(kindr::AngleAxisD(0.3, 0.0, 0.0, 1.0)));
+  for (std::size_t i = 0; i < size; i++) {
+    poses.push_back(pose);
+    const Eigen::Vector3d positionStep(1e-3*std::sin(0.01*i), 1e-3*std::cos(0.013*i), 5e-4);
+    const Eigen::Vector3d rotationStep(2e-3*std::cos(0.02*i), -1e-3, 1.5e-3*std::sin(0.017*i));
+    pose = Pose(Position(pose.getPosition().toImplementation() + positionStep),
+                pose.getRotation().boxPlus(rotationStep));
+  }
+  return poses;
+}
+
+} // namespace
+
+TEST(DeltaPoseCodecTest, testRoundTripWithinPrecision) {
+  const double positionPrecision = 1e-6;
+  const double rotationPrecision = 1e-7;
+  const auto poses = makeTrajectory(500u);
+  packed::DeltaPoseEncoderD encoder(positionPrecision, rotationPrecision, 64u);
+  for (const Pose& pose : poses) {
+    encoder.addPose(pose);
+  }
+  ASSERT_EQ(500u, encoder.getNumPoses());
+
+  packed::DeltaPoseDecoderD decoder(encoder.getBuffer());
+  for (std::size_t i = 0; i < poses.size(); i++) {
+    ASSERT_TRUE(decoder.hasNext());
+    const Pose restored = decoder.decodeNext();
+    // quantization bounds: half a step per axis, and no drift between keyframes
+    for (int k = 0; k < 3; k++) {
+      EXPECT_NEAR(poses[i].getPosition()(k), restored.getPosition()(k), positionPrecision);
+    }
+    EXPECT_TRUE(restored.getRotation().isNear(poses[i].getRotation(), 2.0*rotationPrecision));
+  }
+  EXPECT_FALSE(decoder.hasNext());
+}
+
+TEST(DeltaPoseCodecTest, testCompressionRatio) {
+  const auto poses = makeTrajectory(1000u);
+  packed::DeltaPoseEncoderD encoder;
+  for (const Pose& pose : poses) {
+    encoder.addPose(pose);
+  }
+  const std::size_t rawSize = poses.size()*sizeof(packed::Pose<double>);
+  // small deltas fit in a couple of varint bytes each; require a substantial win
+  EXPECT_LT(encoder.getBuffer().size(), rawSize/3u);
+}
+
+TEST(DeltaPoseCodecTest, testKeyframeSeek) {
+  const auto poses = makeTrajectory(300u);
+  packed::DeltaPoseEncoderD encoder(1e-6, 1e-7, 50u);
+  for (const Pose& pose : poses) {
+    encoder.addPose(pose);
+  }
+  const auto& keyframes = encoder.getKeyframeEntries();
+  ASSERT_EQ(6u, keyframes.size());
+
+  packed::DeltaPoseDecoderD decoder(encoder.getBuffer());
+  decoder.seek(keyframes[4].byteOffset);
+  ASSERT_EQ(200u, keyframes[4].poseIndex);
+  for (std::size_t i = 200u; i < poses.size(); i++) {
+    const Pose restored = decoder.decodeNext();
+    for (int k = 0; k < 3; k++) {
+      EXPECT_NEAR(poses[i].getPosition()(k), restored.getPosition()(k), 1e-6);
+    }
+    EXPECT_TRUE(restored.getRotation().isNear(poses[i].getRotation(), 2e-7));
+  }
+}
+
+TEST(DeltaPoseCodecTest, testNoDriftOverLongStream) {
+  // one keyframe only: the encoder must track the dequantized predecessor, so
+  // the error stays at the quantization step instead of accumulating
+  const auto poses = makeTrajectory(2000u);
+  packed::DeltaPoseEncoderD encoder(1e-6, 1e-7, 100000u);
+  for (const Pose& pose : poses) {
+    encoder.addPose(pose);
+  }
+  packed::DeltaPoseDecoderD decoder(encoder.getBuffer());
+  Pose restored;
+  for (std::size_t i = 0; i < poses.size(); i++) {
+    restored = decoder.decodeNext();
+  }
+  for (int k = 0; k < 3; k++) {
+    EXPECT_NEAR(poses.back().getPosition()(k), restored.getPosition()(k), 1e-6);
+  }
+  EXPECT_TRUE(restored.getRotation().isNear(poses.back().getRotation(), 2e-7));
+}
+
+TEST(DeltaPoseCodecTest, testLargeJumpStaysExact) {
+  packed::DeltaPoseEncoderD encoder(1e-6, 1e-7, 10u);
+  Rotation rotation;
+  rotation.setRandom();
+  encoder.addPose(Pose(Position(0.0, 0.0, 0.0), Rotation()));
+  encoder.addPose(Pose(Position(123.0, -45.0, 6.0), rotation));
+  packed::DeltaPoseDecoderD decoder(encoder.getBuffer());
+  decoder.decodeNext();
+  const Pose restored = decoder.decodeNext();
+  for (int k = 0; k < 3; k++) {
+    EXPECT_NEAR(123.0*(k == 0) - 45.0*(k == 1) + 6.0*(k == 2), restored.getPosition()(k), 1e-6);
+  }
+  EXPECT_TRUE(restored.getRotation().isNear(rotation, 1e-6));
+}
+
+TEST(DeltaPoseCodecTest, testRejectsCorruptVarint) {
+  packed::DeltaPoseEncoderD encoder;
+  std::vector<uint8_t> stream = encoder.getBuffer(); // header only
+  stream.push_back(0x44u); // delta record tag
+  for (int i = 0; i < 11; i++) {
+    stream.push_back(0xFFu); // endless continuation bytes
+  }
+  packed::DeltaPoseDecoderD decoder(stream);
+  ASSERT_ANY_THROW(decoder.decodeNext());
+}
+
+TEST(DeltaPoseCodecTest, testRejectsWrongScalar) {
+  packed::DeltaPoseEncoderD encoder;
+  encoder.addPose(Pose());
+  ASSERT_ANY_THROW(packed::DeltaPoseDecoderF(encoder.getBuffer().data(), encoder.getBuffer().size()));
+}
+
+TEST(DeltaPoseCodecTest, testFloat) {
+  typedef packed::DeltaPoseEncoderF::PoseType PoseF;
+  packed::DeltaPoseEncoderF encoder(1e-4f, 1e-4f, 16u);
+  std::vector<PoseF, Eigen::aligned_allocator<PoseF>> poses;
+  PoseF pose;
+  for (int i = 0; i < 100; i++) {
+    poses.push_back(pose);
+    encoder.addPose(pose);
+    pose = PoseF(PoseF::Position(pose.getPosition().toImplementation() + Eigen::Vector3f(1e-3f, -5e-4f, 2e-3f)),
+                 pose.getRotation().boxPlus(Eigen::Vector3f(1e-3f, 2e-3f, -1e-3f)));
+  }
+  packed::DeltaPoseDecoderF decoder(encoder.getBuffer());
+  for (int i = 0; i < 100; i++) {
+    const PoseF restored = decoder.decodeNext();
+    for (int k = 0; k < 3; k++) {
+      EXPECT_NEAR(poses[i].getPosition()(k), restored.getPosition()(k), 2e-4f);
+    }
+    EXPECT_TRUE(restored.getRotation().isNear(poses[i].getRotation(), 5e-4f));
+  }
+}
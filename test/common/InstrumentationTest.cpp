@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+// This test target is compiled with KINDR_ENABLE_CONVERSION_COUNTERS (see CMakeLists.txt);
+// all other targets verify that the hooks compile to nothing by default.
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/Rotation.hpp"
+
+namespace rot = kindr;
+
+TEST(InstrumentationTest, testConversionCounters) {
+  rot::resetConversionCounters();
+
+  const rot::EulerAnglesZyxD eulerAngles(0.1, 0.2, 0.3);
+  for (int k = 0; k < 3; k++) {
+    const rot::RotationQuaternionD quaternion(eulerAngles);
+    (void)quaternion;
+  }
+
+  const auto& counter = rot::instrumentation::conversionCounter<rot::RotationQuaternionD, rot::EulerAnglesZyxD>();
+  EXPECT_EQ(3u, counter.count.load());
+
+  // assignment runs the same conversion
+  rot::RotationQuaternionD quaternion;
+  quaternion = eulerAngles;
+  EXPECT_EQ(4u, counter.count.load());
+}
+
+TEST(InstrumentationTest, testOperationCounters) {
+  rot::resetConversionCounters();
+
+  rot::RotationQuaternionD rotation;
+  rotation.setRandom();
+  const Eigen::Vector3d vector(1.0, 2.0, 3.0);
+  for (int k = 0; k < 5; k++) {
+    (void)rotation.rotate(vector);
+  }
+  (void)rotation.inverseRotate(vector);
+  (void)(rotation*rotation);
+
+  EXPECT_EQ(5u, rot::instrumentation::operationCounter<rot::RotationQuaternionD>("rotate").count.load());
+  EXPECT_EQ(1u, rot::instrumentation::operationCounter<rot::RotationQuaternionD>("inverseRotate").count.load());
+  EXPECT_EQ(1u, rot::instrumentation::operationCounter<rot::RotationQuaternionD>("multiply").count.load());
+}
+
+TEST(InstrumentationTest, testTableExport) {
+  rot::resetConversionCounters();
+  EXPECT_EQ(std::string(), rot::getConversionCountTable());
+
+  const rot::RotationQuaternionD quaternion(rot::EulerAnglesZyxD(0.1, 0.2, 0.3));
+  (void)quaternion;
+
+  const std::string table = rot::getConversionCountTable();
+  EXPECT_NE(std::string::npos, table.find("EulerAnglesZyx"));
+  EXPECT_NE(std::string::npos, table.find("RotationQuaternion"));
+
+  rot::resetConversionCounters();
+  EXPECT_EQ(std::string(), rot::getConversionCountTable());
+}
+
+TEST(InstrumentationTest, testHiddenConversionChains) {
+  rot::resetConversionCounters();
+
+  // the generic rotation-vector conversion runs through angle-axis internally;
+  // the counters expose such hidden chains
+  const rot::RotationVectorD rotationVector(rot::EulerAnglesZyxD(0.1, 0.2, 0.3));
+  (void)rotationVector;
+  const std::string table = rot::getConversionCountTable();
+  EXPECT_NE(std::string(), table);
+  EXPECT_NE(std::string::npos, table.find("RotationVector"));
+}
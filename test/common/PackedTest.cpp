@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+#include "kindr/packed/Packed.hpp"
+
+namespace packed = kindr::packed;
+
+TEST(PackedTest, testHeader) {
+  const packed::Header header = packed::makeHeader<double>();
+  EXPECT_EQ(packed::packedMagic, header.magic);
+  EXPECT_EQ(packed::packedLayoutVersion, header.version);
+  EXPECT_EQ(8u, header.scalarSize);
+  EXPECT_EQ(4u, packed::makeHeader<float>().scalarSize);
+}
+
+TEST(PackedTest, testPoseRoundTrip) {
+  typedef kindr::HomogeneousTransformationPosition3RotationQuaternionD Pose;
+  typedef Pose::Position Position;
+  typedef Pose::Rotation Rotation;
+
+  Rotation rotation;
+  rotation.setRandom();
+  const Pose pose(Position(1.0, -2.0, 3.0), rotation);
+
+  const packed::Pose<double> packedPose = kindr::toPacked(pose);
+  EXPECT_EQ(1.0, packedPose.position.x);
+  EXPECT_EQ(-2.0, packedPose.position.y);
+  EXPECT_EQ(3.0, packedPose.position.z);
+  EXPECT_EQ(rotation.w(), packedPose.rotation.w);
+
+  const Pose restored = kindr::fromPacked(packedPose);
+  for (int k = 0; k < 3; k++) {
+    EXPECT_EQ(pose.getPosition()(k), restored.getPosition()(k));
+  }
+  EXPECT_TRUE(pose.getRotation().isNear(restored.getRotation(), 1e-12));
+}
+
+TEST(PackedTest, testWrenchRoundTrip) {
+  typedef kindr::WrenchD Wrench;
+
+  const Wrench wrench(Wrench::Force(0.1, 0.2, 0.3), Wrench::Torque(-1.0, -2.0, -3.0));
+  const packed::Wrench<double> packedWrench = kindr::toPacked(wrench);
+  EXPECT_EQ(0.1, packedWrench.force[0]);
+  EXPECT_EQ(-3.0, packedWrench.torque[2]);
+
+  const Wrench restored = kindr::fromPacked(packedWrench);
+  EXPECT_TRUE(wrench == restored);
+}
+
+TEST(PackedTest, testMemcpyRoundTrip) {
+  // a log record written with memcpy must replay bit-exactly
+  typedef kindr::HomogeneousTransformationPosition3RotationQuaternionD Pose;
+  typedef Pose::Position Position;
+  typedef Pose::Rotation Rotation;
+
+  Rotation rotation;
+  rotation.setRandom();
+  const Pose pose(Position(4.0, 5.0, -6.0), rotation);
+  const packed::Pose<double> record = kindr::toPacked(pose);
+
+  unsigned char buffer[sizeof(packed::Pose<double>)];
+  std::memcpy(buffer, &record, sizeof(record));
+
+  packed::Pose<double> replayed;
+  std::memcpy(&replayed, buffer, sizeof(replayed));
+  const Pose restored = kindr::fromPacked(replayed);
+  for (int k = 0; k < 3; k++) {
+    EXPECT_EQ(pose.getPosition()(k), restored.getPosition()(k));
+  }
+  EXPECT_EQ(pose.getRotation().w(), restored.getRotation().w());
+  EXPECT_EQ(pose.getRotation().x(), restored.getRotation().x());
+}
+
+TEST(PackedTest, testFloatLayouts) {
+  EXPECT_EQ(7u*sizeof(float), sizeof(packed::Pose<float>));
+  EXPECT_EQ(6u*sizeof(float), sizeof(packed::Wrench<float>));
+  EXPECT_EQ(4u*sizeof(float), sizeof(packed::RotationQuaternion<float>));
+
+  kindr::RotationQuaternionF rotation;
+  rotation.setRandom();
+  const kindr::RotationQuaternionF restored = kindr::fromPacked(kindr::toPacked(rotation));
+  EXPECT_TRUE(rotation.isNear(restored, 1e-6));
+}
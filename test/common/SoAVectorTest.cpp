@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include "kindr/common/SoAVector.hpp"
+
+namespace kindr_test = kindr;
+
+TEST(SoAVectorTest, testQuaternionPushAndAccess) {
+  kindr_test::SoAVector<kindr_test::RotationQuaternionD> batch;
+  EXPECT_TRUE(batch.empty());
+  for (int k = 0; k < 100; k++) {
+    batch.push_back(kindr_test::RotationQuaternionD(kindr_test::EulerAnglesZyxD(0.03*k, -0.01*k, 0.02*k)));
+  }
+  ASSERT_EQ(100u, batch.size());
+  for (int k = 0; k < 100; k += 13) {
+    const kindr_test::RotationQuaternionD expected(kindr_test::EulerAnglesZyxD(0.03*k, -0.01*k, 0.02*k));
+    EXPECT_TRUE(batch.get(k).isNear(expected, 1e-12)) << "element " << k;
+  }
+}
+
+TEST(SoAVectorTest, testQuaternionProxyAssignment) {
+  kindr_test::SoAVector<kindr_test::RotationQuaternionD> batch(10);
+  // resize fills with identity
+  EXPECT_TRUE(batch.get(3).isNear(kindr_test::RotationQuaternionD(), 1e-12));
+
+  const kindr_test::RotationQuaternionD rotation(kindr_test::AngleAxisD(1.2, Eigen::Vector3d::UnitZ()));
+  batch[3] = rotation;
+  const kindr_test::RotationQuaternionD readBack = batch[3];
+  EXPECT_TRUE(readBack.isNear(rotation, 1e-12));
+  EXPECT_TRUE(batch.get(4).isNear(kindr_test::RotationQuaternionD(), 1e-12));
+}
+
+TEST(SoAVectorTest, testQuaternionIterationAndAlignment) {
+  kindr_test::SoAVector<kindr_test::RotationQuaternionD> batch;
+  for (int k = 0; k < 33; k++) {
+    batch.push_back(kindr_test::RotationQuaternionD(kindr_test::EulerAnglesZyxD(0.1*k, 0.0, 0.0)));
+  }
+  // iteration yields the elements in order with the normal kindr API
+  std::size_t index = 0;
+  for (const kindr_test::RotationQuaternionD rotation : static_cast<const kindr_test::SoAVector<kindr_test::RotationQuaternionD>&>(batch)) {
+    EXPECT_TRUE(rotation.isNear(batch.get(index), 1e-12));
+    index++;
+  }
+  EXPECT_EQ(batch.size(), index);
+
+  // each component array is 64-byte aligned and contiguous per component
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(batch.wData()) % 64u);
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(batch.xData()) % 64u);
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(batch.yData()) % 64u);
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(batch.zData()) % 64u);
+  EXPECT_EQ(batch.get(7).w(), batch.wData()[7]);
+}
+
+TEST(SoAVectorTest, testPositionContainer) {
+  kindr_test::SoAVector<kindr_test::Position3D> batch;
+  batch.reserve(50);
+  for (int k = 0; k < 50; k++) {
+    batch.push_back(kindr_test::Position3D(1.0*k, -2.0*k, 0.5*k));
+  }
+  ASSERT_EQ(50u, batch.size());
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(batch.xData()) % 64u);
+  EXPECT_EQ(-2.0*17, batch.yData()[17]);
+
+  batch[17] = kindr_test::Position3D(9.0, 8.0, 7.0);
+  const kindr_test::Position3D readBack = batch[17];
+  EXPECT_EQ(9.0, readBack.x());
+  EXPECT_EQ(8.0, readBack.y());
+  EXPECT_EQ(7.0, readBack.z());
+}
+
+TEST(SoAVectorTest, testPoseContainer) {
+  typedef kindr_test::HomogeneousTransformationPosition3RotationQuaternionD Pose;
+  kindr_test::SoAVector<Pose> batch;
+  for (int k = 0; k < 20; k++) {
+    batch.push_back(Pose(kindr_test::Position3D(0.1*k, 0.2*k, -0.3*k),
+                         kindr_test::RotationQuaternionD(kindr_test::EulerAnglesZyxD(0.05*k, 0.0, 0.1*k))));
+  }
+  ASSERT_EQ(20u, batch.size());
+
+  const Pose readBack = batch.get(11);
+  EXPECT_NEAR(1.1, readBack.getPosition().x(), 1e-12);
+  EXPECT_TRUE(readBack.getRotation().isNear(
+      kindr_test::RotationQuaternionD(kindr_test::EulerAnglesZyxD(0.55, 0.0, 1.1)), 1e-12));
+
+  // the component sub-containers feed the batch kernels directly
+  EXPECT_EQ(20u, batch.positions().size());
+  EXPECT_EQ(20u, batch.rotations().size());
+  EXPECT_EQ(batch.get(5).getPosition().z(), batch.positions().zData()[5]);
+  EXPECT_EQ(batch.get(5).getRotation().w(), batch.rotations().wData()[5]);
+
+  batch[11] = Pose(kindr_test::Position3D(1.0, 2.0, 3.0), kindr_test::RotationQuaternionD());
+  EXPECT_EQ(3.0, batch.positions().zData()[11]);
+}
+
+TEST(SoAVectorTest, testResizeAndClear) {
+  kindr_test::SoAVector<kindr_test::RotationQuaternionF> batch(5);
+  EXPECT_EQ(5u, batch.size());
+  batch.resize(8);
+  EXPECT_EQ(8u, batch.size());
+  EXPECT_TRUE(batch.get(7).isNear(kindr_test::RotationQuaternionF(), 1e-6f));
+  batch.clear();
+  EXPECT_TRUE(batch.empty());
+}
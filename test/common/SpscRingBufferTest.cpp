@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "kindr/common/SpscRingBuffer.hpp"
+#include "kindr/poses/Pose.hpp"
+#include "kindr/poses/Twist.hpp"
+
+namespace kindr_test = kindr;
+
+typedef kindr_test::HomogeneousTransformationPosition3RotationQuaternionD PoseD;
+
+TEST(SpscRingBufferTest, testPushPopFifoOrder) {
+  kindr_test::SpscRingBuffer<PoseD, 8> buffer;
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_EQ(8u, buffer.capacity());
+
+  for (int k = 0; k < 5; k++) {
+    const PoseD pose(kindr_test::Position3D(k, 2.0*k, -k),
+                     kindr_test::RotationQuaternionD(kindr_test::EulerAnglesZyxD(0.1*k, 0.0, 0.0)));
+    EXPECT_TRUE(buffer.push(pose));
+  }
+  EXPECT_EQ(5u, buffer.size());
+
+  for (int k = 0; k < 5; k++) {
+    PoseD pose;
+    ASSERT_TRUE(buffer.pop(pose));
+    EXPECT_EQ(double(k), pose.getPosition().x());
+    EXPECT_EQ(2.0*k, pose.getPosition().y());
+  }
+  EXPECT_TRUE(buffer.empty());
+  PoseD pose;
+  EXPECT_FALSE(buffer.pop(pose));
+}
+
+TEST(SpscRingBufferTest, testFullBufferDropsWithoutBlocking) {
+  kindr_test::SpscRingBuffer<double, 3> buffer;
+  EXPECT_TRUE(buffer.push(1.0));
+  EXPECT_TRUE(buffer.push(2.0));
+  EXPECT_TRUE(buffer.push(3.0));
+  // a full buffer rejects the element instead of blocking the producer
+  EXPECT_FALSE(buffer.push(4.0));
+  EXPECT_EQ(3u, buffer.size());
+
+  double value = 0.0;
+  EXPECT_TRUE(buffer.pop(value));
+  EXPECT_EQ(1.0, value);
+  EXPECT_TRUE(buffer.push(4.0));
+  EXPECT_FALSE(buffer.push(5.0));
+}
+
+TEST(SpscRingBufferTest, testWrapAround) {
+  kindr_test::SpscRingBuffer<int, 4> buffer;
+  int value = 0;
+  for (int k = 0; k < 100; k++) {
+    EXPECT_TRUE(buffer.push(k));
+    EXPECT_TRUE(buffer.push(k + 1000));
+    ASSERT_TRUE(buffer.pop(value));
+    EXPECT_EQ(k, value);
+    ASSERT_TRUE(buffer.pop(value));
+    EXPECT_EQ(k + 1000, value);
+  }
+  EXPECT_TRUE(buffer.empty());
+}
+
+TEST(SpscRingBufferTest, testEmplaceConstructsInPlace) {
+  kindr_test::SpscRingBuffer<PoseD, 4> buffer;
+  EXPECT_TRUE(buffer.emplace(kindr_test::Position3D(1.0, 2.0, 3.0),
+                             kindr_test::RotationQuaternionD()));
+  PoseD pose;
+  ASSERT_TRUE(buffer.pop(pose));
+  EXPECT_EQ(1.0, pose.getPosition().x());
+  EXPECT_EQ(3.0, pose.getPosition().z());
+}
+
+TEST(SpscRingBufferTest, testTwistStream) {
+  kindr_test::SpscRingBuffer<kindr_test::TwistLocalD, 16> buffer;
+  kindr_test::TwistLocalD twist;
+  twist.getTranslationalVelocity() = kindr_test::Velocity3D(1.0, 0.0, -2.0);
+  EXPECT_TRUE(buffer.push(twist));
+  kindr_test::TwistLocalD received;
+  ASSERT_TRUE(buffer.pop(received));
+  EXPECT_EQ(1.0, received.getTranslationalVelocity().x());
+  EXPECT_EQ(-2.0, received.getTranslationalVelocity().z());
+}
+
+TEST(SpscRingBufferTest, testConcurrentProducerConsumer) {
+  kindr_test::SpscRingBuffer<PoseD, 64> buffer;
+  const int numMessages = 100000;
+
+  std::thread producer([&]() {
+    for (int k = 0; k < numMessages; k++) {
+      const PoseD pose(kindr_test::Position3D(k, 0.0, 0.0), kindr_test::RotationQuaternionD());
+      while (!buffer.push(pose)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  int received = 0;
+  PoseD pose;
+  while (received < numMessages) {
+    if (buffer.pop(pose)) {
+      // messages arrive in publication order without loss or duplication
+      ASSERT_EQ(double(received), pose.getPosition().x());
+      received++;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  EXPECT_TRUE(buffer.empty());
+}
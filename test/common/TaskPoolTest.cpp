@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "kindr/common/TaskPool.hpp"
+#include "kindr/rotations/RotationBatch.hpp"
+
+namespace rot = kindr;
+
+TEST(TaskPoolTest, testSequentialDefault) {
+  // without an installed executor the range runs inline as one chunk
+  ASSERT_TRUE(&kindr::getDefaultExecutor() != nullptr);
+  std::size_t calls = 0u;
+  std::size_t covered = 0u;
+  kindr::parallelFor(3u, 17u, 4u, [&](std::size_t chunkBegin, std::size_t chunkEnd) {
+    calls++;
+    covered += chunkEnd - chunkBegin;
+    EXPECT_EQ(3u, chunkBegin);
+    EXPECT_EQ(17u, chunkEnd);
+  });
+  EXPECT_EQ(1u, calls);
+  EXPECT_EQ(14u, covered);
+}
+
+TEST(TaskPoolTest, testEmptyRange) {
+  kindr::parallelFor(5u, 5u, 1u, [&](std::size_t, std::size_t) {
+    FAIL() << "Task must not run for an empty range.";
+  });
+}
+
+TEST(TaskPoolTest, testPoolCoversRangeExactlyOnce) {
+  kindr::WorkStealingTaskPool pool(4u);
+  ASSERT_EQ(4u, pool.getNumThreads());
+  const std::size_t size = 100000u;
+  std::vector<std::atomic<std::uint32_t>> hits(size);
+  for (auto& hit : hits) {
+    hit.store(0u);
+  }
+  pool.parallelFor(0u, size, 64u, [&](std::size_t chunkBegin, std::size_t chunkEnd) {
+    for (std::size_t i = chunkBegin; i < chunkEnd; i++) {
+      hits[i].fetch_add(1u);
+    }
+  });
+  for (std::size_t i = 0; i < size; i++) {
+    ASSERT_EQ(1u, hits[i].load()) << "index " << i;
+  }
+}
+
+TEST(TaskPoolTest, testStealingBalancesUnevenWork) {
+  // the first slice carries nearly all the work; stealing must still finish it
+  kindr::WorkStealingTaskPool pool(4u);
+  std::atomic<std::uint64_t> sum(0u);
+  pool.parallelFor(0u, 10000u, 16u, [&](std::size_t chunkBegin, std::size_t chunkEnd) {
+    std::uint64_t local = 0u;
+    for (std::size_t i = chunkBegin; i < chunkEnd; i++) {
+      const std::size_t spins = (i < 1000u) ? 2000u : 1u;
+      for (std::size_t k = 0; k < spins; k++) {
+        local += i ^ k;
+      }
+    }
+    sum.fetch_add(local ^ local, std::memory_order_relaxed);
+    sum.fetch_add(chunkEnd - chunkBegin, std::memory_order_relaxed);
+  });
+  EXPECT_EQ(10000u, sum.load());
+}
+
+TEST(TaskPoolTest, testSmallRangeRunsInline) {
+  kindr::WorkStealingTaskPool pool(4u);
+  std::size_t calls = 0u;
+  pool.parallelFor(0u, 10u, 100u, [&](std::size_t chunkBegin, std::size_t chunkEnd) {
+    calls++;
+    EXPECT_EQ(0u, chunkBegin);
+    EXPECT_EQ(10u, chunkEnd);
+  });
+  EXPECT_EQ(1u, calls);
+}
+
+TEST(TaskPoolTest, testRepeatedLoopsReuseWorkers) {
+  kindr::WorkStealingTaskPool pool(3u);
+  for (int repeat = 0; repeat < 50; repeat++) {
+    std::atomic<std::size_t> covered(0u);
+    pool.parallelFor(0u, 5000u, 32u, [&](std::size_t chunkBegin, std::size_t chunkEnd) {
+      covered.fetch_add(chunkEnd - chunkBegin, std::memory_order_relaxed);
+    });
+    ASSERT_EQ(5000u, covered.load());
+  }
+}
+
+TEST(TaskPoolTest, testBatchKernelsUseInstalledPool) {
+  // the batch sweeps must produce identical results sequentially and on a pool
+  rot::VectorBatch3D tangents;
+  for (int i = 0; i < 9000; i++) {
+    tangents.append(Eigen::Vector3d(0.001*i, -0.0005*i, 0.1));
+  }
+  rot::QuaternionBatch<double> sequentialResult;
+  rot::expMapBatch(tangents, sequentialResult);
+
+  kindr::WorkStealingTaskPool pool(4u);
+  kindr::setDefaultExecutor(&pool);
+  rot::QuaternionBatch<double> pooledResult;
+  rot::expMapBatch(tangents, pooledResult);
+  rot::QuaternionBatch<double> composed;
+  rot::composeBatch(pooledResult, pooledResult, composed);
+  kindr::setDefaultExecutor(nullptr);
+
+  rot::QuaternionBatch<double> composedSequential;
+  rot::composeBatch(sequentialResult, sequentialResult, composedSequential);
+  ASSERT_EQ(sequentialResult.size(), pooledResult.size());
+  for (std::size_t i = 0; i < sequentialResult.size(); i++) {
+    EXPECT_EQ(sequentialResult.w()[i], pooledResult.w()[i]);
+    EXPECT_EQ(sequentialResult.x()[i], pooledResult.x()[i]);
+    EXPECT_EQ(composedSequential.w()[i], composed.w()[i]);
+    EXPECT_EQ(composedSequential.z()[i], composed.z()[i]);
+  }
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "kindr/common/TextFormat.hpp"
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
+
+TEST(TextFormatTest, testScalarRoundTripIsExact) {
+  std::srand(7u);
+  for (int sample = 0; sample < 2000; sample++) {
+    const double exponent = -300.0 + 600.0*(std::rand()/static_cast<double>(RAND_MAX));
+    const double mantissa = -1.0 + 2.0*(std::rand()/static_cast<double>(RAND_MAX));
+    const double value = mantissa*std::pow(10.0, exponent);
+    char buffer[64];
+    kindr::TextWriter writer(buffer, sizeof(buffer));
+    ASSERT_TRUE(writer.writeScalar(value));
+    const std::size_t length = writer.finish();
+    kindr::TextReader reader(buffer, length);
+    double parsed = 0.0;
+    ASSERT_TRUE(reader.readScalar(parsed));
+    EXPECT_EQ(value, parsed) << buffer;
+  }
+}
+
+TEST(TextFormatTest, testParserMatchesStrtod) {
+  const char* inputs[] = {"0", "-0", "1", "3.25", "-17.0625", "0.1", "123456789.123456789",
+                          "1e10", "-2.5e-7", "9.999999999999999e22", "1e-300", "4.9e300",
+                          "12345678901234567890123.5", "0.000000000000000000001", "2", "-inf", "inf"};
+  for (const char* input : inputs) {
+    kindr::TextReader reader(input, std::strlen(input));
+    double parsed = 0.0;
+    ASSERT_TRUE(reader.readScalar(parsed)) << input;
+    EXPECT_EQ(std::strtod(input, nullptr), parsed) << input;
+    EXPECT_TRUE(reader.isAtEnd()) << input;
+  }
+}
+
+TEST(TextFormatTest, testSpecialValues) {
+  char buffer[64];
+  kindr::TextWriter writer(buffer, sizeof(buffer));
+  ASSERT_TRUE(writer.writeScalar(std::numeric_limits<double>::quiet_NaN()));
+  ASSERT_TRUE(writer.writeScalar(-std::numeric_limits<double>::infinity()));
+  const std::size_t length = writer.finish();
+  kindr::TextReader reader(buffer, length);
+  double value = 0.0;
+  ASSERT_TRUE(reader.readScalar(value));
+  EXPECT_TRUE(std::isnan(value));
+  ASSERT_TRUE(reader.readScalar(value));
+  EXPECT_EQ(-std::numeric_limits<double>::infinity(), value);
+}
+
+TEST(TextFormatTest, testTypedRoundTrip) {
+  const kindr::Position3D position(1.25, -3.5e-4, 7.0);
+  kindr::RotationQuaternionD rotation;
+  rotation.setRandom();
+  const kindr::HomogeneousTransformationPosition3RotationQuaternionD pose(
+      kindr::Position3D(0.5, -0.25, 12.0), rotation);
+
+  char buffer[512];
+  kindr::TextWriter writer(buffer, sizeof(buffer));
+  ASSERT_TRUE(kindr::writeText(writer, position));
+  ASSERT_TRUE(kindr::writeText(writer, rotation));
+  ASSERT_TRUE(kindr::writeText(writer, pose));
+  const std::size_t length = writer.finish();
+  ASSERT_FALSE(writer.hasOverflowed());
+
+  kindr::TextReader reader(buffer, length);
+  kindr::Position3D parsedPosition;
+  kindr::RotationQuaternionD parsedRotation;
+  kindr::HomogeneousTransformationPosition3RotationQuaternionD parsedPose;
+  ASSERT_TRUE(kindr::readText(reader, parsedPosition));
+  ASSERT_TRUE(kindr::readText(reader, parsedRotation));
+  ASSERT_TRUE(kindr::readText(reader, parsedPose));
+  EXPECT_TRUE(reader.isAtEnd());
+  for (int i = 0; i < 3; i++) {
+    EXPECT_EQ(position(i), parsedPosition(i));
+    EXPECT_EQ(pose.getPosition()(i), parsedPose.getPosition()(i));
+  }
+  EXPECT_EQ(rotation.w(), parsedRotation.w());
+  EXPECT_EQ(rotation.x(), parsedRotation.x());
+  EXPECT_EQ(pose.getRotation().w(), parsedPose.getRotation().w());
+  EXPECT_EQ(pose.getRotation().z(), parsedPose.getRotation().z());
+}
+
+TEST(TextFormatTest, testParseCsvLine) {
+  const char* line = "0.5, -1.25,3e2 ,\t4,5.5";
+  double values[8];
+  EXPECT_EQ(5u, kindr::parseCsvLine(line, std::strlen(line), values, 8u));
+  EXPECT_EQ(0.5, values[0]);
+  EXPECT_EQ(-1.25, values[1]);
+  EXPECT_EQ(300.0, values[2]);
+  EXPECT_EQ(4.0, values[3]);
+  EXPECT_EQ(5.5, values[4]);
+  // capacity caps the scan, a malformed field stops it
+  EXPECT_EQ(3u, kindr::parseCsvLine(line, std::strlen(line), values, 3u));
+  const char* malformed = "1.0,oops,3.0";
+  EXPECT_EQ(1u, kindr::parseCsvLine(malformed, std::strlen(malformed), values, 8u));
+  float floats[4];
+  const char* floatLine = "0.25,0.75";
+  EXPECT_EQ(2u, kindr::parseCsvLine(floatLine, std::strlen(floatLine), floats, 4u));
+  EXPECT_EQ(0.25f, floats[0]);
+}
+
+TEST(TextFormatTest, testWriterOverflow) {
+  char buffer[8];
+  kindr::TextWriter writer(buffer, sizeof(buffer));
+  EXPECT_TRUE(writer.writeScalar(1.5));
+  EXPECT_FALSE(writer.writeScalar(123456.789));
+  EXPECT_TRUE(writer.hasOverflowed());
+  const std::size_t length = writer.finish();
+  // the partial scalar was dropped, not truncated mid-number
+  EXPECT_EQ(std::string("1.5"), std::string(buffer));
+  EXPECT_EQ(3u, length);
+}
+
+TEST(TextFormatTest, testReaderRejectsMalformedInput) {
+  const char* garbage = "hello";
+  kindr::TextReader reader(garbage, std::strlen(garbage));
+  double value = 0.0;
+  EXPECT_FALSE(reader.readScalar(value));
+  const char* missingDelimiter = "1.0 2.0";
+  kindr::TextReader reader2(missingDelimiter, std::strlen(missingDelimiter));
+  EXPECT_TRUE(reader2.readScalar(value));
+  EXPECT_FALSE(reader2.readScalar(value));
+}
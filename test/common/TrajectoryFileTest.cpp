@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <cstdio>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "kindr/packed/TrajectoryFile.hpp"
+
+namespace packed = kindr::packed;
+
+struct TrajectoryFileTest : public ::testing::Test {
+  typedef packed::TrajectoryFile<double>::PoseType Pose;
+  typedef Pose::Position Position;
+  typedef Pose::Rotation Rotation;
+
+  void SetUp() override {
+    fileName_ = std::string(::testing::TempDir()) + "kindr_trajectory_test.bin";
+    packed::TrajectoryFileWriter<double> writer(fileName_);
+    for (int i = 0; i < 50; i++) {
+      Rotation rotation;
+      rotation.setRandom();
+      poses_.push_back(Pose(Position(1.0*i, -0.5*i, 0.25*i), rotation));
+      writer.addPose(0.1*i, poses_.back());
+    }
+    writer.close();
+  }
+
+  void TearDown() override {
+    std::remove(fileName_.c_str());
+  }
+
+  std::string fileName_;
+  std::vector<Pose, Eigen::aligned_allocator<Pose>> poses_;
+};
+
+TEST_F(TrajectoryFileTest, testRoundTrip) {
+  packed::TrajectoryFile<double> file(fileName_);
+  ASSERT_EQ(50u, file.getNumberOfPoses());
+
+  for (std::size_t i = 0; i < file.getNumberOfPoses(); i++) {
+    EXPECT_EQ(0.1*i, file.getTime(i));
+    const Pose restored = file.getPose(i);
+    for (int k = 0; k < 3; k++) {
+      EXPECT_EQ(poses_[i].getPosition()(k), restored.getPosition()(k));
+    }
+    EXPECT_EQ(poses_[i].getRotation().w(), restored.getRotation().w());
+    EXPECT_EQ(poses_[i].getRotation().x(), restored.getRotation().x());
+  }
+}
+
+TEST_F(TrajectoryFileTest, testViews) {
+  packed::TrajectoryFile<double> file(fileName_);
+
+  // zero-copy position view over the mapped scalars
+  const auto positionView = file.getPositionView(7);
+  EXPECT_EQ(7.0, positionView(0));
+  EXPECT_EQ(-3.5, positionView(1));
+
+  const kindr::RotationQuaternionD rotation = file.getRotation(7);
+  EXPECT_TRUE(poses_[7].getRotation().isNear(rotation, 1e-12));
+
+  // raw packed record access
+  EXPECT_EQ(0.1*7, file.getRecord(7).time);
+}
+
+TEST_F(TrajectoryFileTest, testSeekTime) {
+  packed::TrajectoryFile<double> file(fileName_);
+
+  EXPECT_EQ(0u, file.seekTime(-1.0));
+  EXPECT_EQ(0u, file.seekTime(0.05));
+  EXPECT_EQ(1u, file.seekTime(0.1));
+  EXPECT_EQ(25u, file.seekTime(2.55));
+  EXPECT_EQ(49u, file.seekTime(100.0));
+}
+
+TEST_F(TrajectoryFileTest, testRejectsWrongScalar) {
+  EXPECT_THROW(packed::TrajectoryFile<float> file(fileName_), std::runtime_error);
+}
+
+TEST_F(TrajectoryFileTest, testRejectsCorruptCount) {
+  // a count this large wraps the 64-bit product count*sizeof(record)
+  const uint64_t corruptCount = uint64_t(1) << 58;
+  std::FILE* file = std::fopen(fileName_.c_str(), "rb+");
+  ASSERT_TRUE(file != nullptr);
+  std::fseek(file, sizeof(packed::Header), SEEK_SET);
+  std::fwrite(&corruptCount, sizeof(corruptCount), 1u, file);
+  std::fclose(file);
+  EXPECT_THROW(packed::TrajectoryFile<double> reader(fileName_), std::runtime_error);
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <kindr/math/LinearAlgebra.hpp>
+
+TEST (PseudoInverseTest, testFixedSizeFullRank) {
+  Eigen::Matrix3d matrix;
+  matrix << 2, -1, 0, -1, 2, -1, 0, -1, 2;
+  Eigen::Matrix3d result;
+  ASSERT_TRUE(kindr::pseudoInverse(matrix, result));
+  const Eigen::Matrix3d identity = matrix*result;
+  for (int i = 0; i < 3; i++) {
+    for (int k = 0; k < 3; k++) {
+      EXPECT_NEAR(i == k ? 1.0 : 0.0, identity(i, k), 1e-10);
+    }
+  }
+}
+
+TEST (PseudoInverseTest, testFixedSizeRankDeficient) {
+  // rank 1: the pseudoinverse must satisfy the Moore-Penrose condition A*A+*A = A
+  Eigen::Matrix3d matrix;
+  matrix << 1, 2, 3, 2, 4, 6, 3, 6, 9;
+  Eigen::Matrix3d result;
+  ASSERT_TRUE(kindr::pseudoInverse(matrix, result, 1e-9));
+  const Eigen::Matrix3d reconstructed = matrix*result*matrix;
+  for (int i = 0; i < 3; i++) {
+    for (int k = 0; k < 3; k++) {
+      EXPECT_NEAR(matrix(i, k), reconstructed(i, k), 1e-9);
+    }
+  }
+}
+
+TEST (PseudoInverseTest, testFixedSizeSixBySix) {
+  Eigen::Matrix<double, 6, 6> matrix = Eigen::Matrix<double, 6, 6>::Identity();
+  matrix(0, 3) = 0.5;
+  matrix(2, 5) = -1.5;
+  matrix(4, 1) = 2.0;
+  Eigen::Matrix<double, 6, 6> result;
+  ASSERT_TRUE(kindr::pseudoInverse(matrix, result));
+  const Eigen::Matrix<double, 6, 6> identity = matrix*result;
+  for (int i = 0; i < 6; i++) {
+    for (int k = 0; k < 6; k++) {
+      EXPECT_NEAR(i == k ? 1.0 : 0.0, identity(i, k), 1e-10);
+    }
+  }
+}
+
+TEST (PseudoInverseTest, testPreallocatedWorkspace) {
+  kindr::PseudoInverseWorkspace<Eigen::MatrixXd> workspace;
+  Eigen::MatrixXd result;
+  for (int iter = 0; iter < 3; iter++) {
+    Eigen::MatrixXd matrix = Eigen::MatrixXd::Identity(4, 4);
+    matrix(0, 1) = 0.25*(iter + 1);
+    matrix(3, 2) = -0.5*iter;
+    ASSERT_TRUE(kindr::pseudoInverse(matrix, result, workspace));
+    const Eigen::MatrixXd identity = matrix*result;
+    for (int i = 0; i < 4; i++) {
+      for (int k = 0; k < 4; k++) {
+        EXPECT_NEAR(i == k ? 1.0 : 0.0, identity(i, k), 1e-10);
+      }
+    }
+  }
+}
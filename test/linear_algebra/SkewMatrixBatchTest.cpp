@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <Eigen/Geometry>
+#include <kindr/math/LinearAlgebra.hpp>
+
+TEST (SkewMatrixBatchTest, testSkewMatrixRoundTrip) {
+  const int size = 11;
+  Eigen::Matrix<double, 3, Eigen::Dynamic> vectors(3, size);
+  for (int i = 0; i < size; i++) {
+    vectors.col(i) = Eigen::Vector3d(0.3*i, -0.7*i + 1.0, 0.1*i - 2.0);
+  }
+
+  std::vector<Eigen::Matrix3d, Eigen::aligned_allocator<Eigen::Matrix3d>> skewMatrices;
+  kindr::getSkewMatrixFromVectorBatch(vectors, skewMatrices);
+  ASSERT_EQ(static_cast<std::size_t>(size), skewMatrices.size());
+  for (int i = 0; i < size; i++) {
+    EXPECT_EQ(kindr::getSkewMatrixFromVector<double>(vectors.col(i)), skewMatrices[i]);
+  }
+
+  const Eigen::Matrix<double, 3, Eigen::Dynamic> recovered = kindr::getVectorFromSkewMatrixBatch(skewMatrices);
+  ASSERT_EQ(size, recovered.cols());
+  EXPECT_EQ(vectors, recovered);
+}
+
+TEST (SkewMatrixBatchTest, testCrossBatchMatchesCross) {
+  const int size = 23; // odd size to exercise the scalar remainder of the kernel
+  Eigen::Matrix<double, 3, Eigen::Dynamic> lhs(3, size);
+  Eigen::Matrix<double, 3, Eigen::Dynamic> rhs(3, size);
+  for (int i = 0; i < size; i++) {
+    lhs.col(i) = Eigen::Vector3d(0.2*i - 1.0, 0.5*i, -0.3*i + 2.0);
+    rhs.col(i) = Eigen::Vector3d(-0.4*i, 0.1*i + 1.0, 0.6*i - 3.0);
+  }
+
+  Eigen::Matrix<double, 3, Eigen::Dynamic> output;
+  kindr::crossBatch(lhs, rhs, output);
+  ASSERT_EQ(size, output.cols());
+  for (int i = 0; i < size; i++) {
+    const Eigen::Vector3d expected = Eigen::Vector3d(lhs.col(i)).cross(Eigen::Vector3d(rhs.col(i)));
+    for (int k = 0; k < 3; k++) {
+      EXPECT_NEAR(expected(k), output(k, i), 1e-12);
+    }
+  }
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "kindr/math/VectorizedTrigonometry.hpp"
+
+namespace {
+
+// absolute tolerance of n double ulps at magnitude one
+double ulps(double n) {
+  return n*std::numeric_limits<double>::epsilon();
+}
+
+} // namespace
+
+TEST(VectorizedTrigonometryTest, testSincosAgainstLibm) {
+  for (int k = -20000; k <= 20000; k++) {
+    const double angle = 0.5*k; // covers |x| <= 1e4
+    double sine, cosine;
+    kindr::internal::sincosBranchless(angle, sine, cosine);
+    EXPECT_NEAR(std::sin(angle), sine, ulps(4.0)) << "angle " << angle;
+    EXPECT_NEAR(std::cos(angle), cosine, ulps(4.0)) << "angle " << angle;
+  }
+}
+
+TEST(VectorizedTrigonometryTest, testSincosSpecialAngles) {
+  const double halfPi = 1.57079632679489661923;
+  for (int q = -8; q <= 8; q++) {
+    double sine, cosine;
+    kindr::internal::sincosBranchless(q*halfPi, sine, cosine);
+    EXPECT_NEAR(std::sin(q*halfPi), sine, ulps(2.0)) << "quadrant " << q;
+    EXPECT_NEAR(std::cos(q*halfPi), cosine, ulps(2.0)) << "quadrant " << q;
+  }
+}
+
+TEST(VectorizedTrigonometryTest, testAtan2AgainstLibm) {
+  for (int i = -50; i <= 50; i++) {
+    for (int j = -50; j <= 50; j++) {
+      const double y = 0.13*i;
+      const double x = 0.07*j;
+      if (i == 0 && j == 0) {
+        continue;
+      }
+      EXPECT_NEAR(std::atan2(y, x), kindr::internal::atan2Branchless(y, x), ulps(8.0))
+          << "y " << y << " x " << x;
+    }
+  }
+}
+
+TEST(VectorizedTrigonometryTest, testAtan2SignedZeroConventions) {
+  const double pi = 3.14159265358979323846;
+  EXPECT_EQ(0.0, kindr::internal::atan2Branchless(0.0, 1.0));
+  EXPECT_NEAR(pi, kindr::internal::atan2Branchless(0.0, -1.0), ulps(2.0));
+  EXPECT_NEAR(-pi, kindr::internal::atan2Branchless(-0.0, -1.0), ulps(2.0));
+  EXPECT_NEAR(0.5*pi, kindr::internal::atan2Branchless(1.0, 0.0), ulps(2.0));
+  EXPECT_NEAR(-0.5*pi, kindr::internal::atan2Branchless(-1.0, 0.0), ulps(2.0));
+  EXPECT_NEAR(pi, kindr::internal::atan2Branchless(0.0, -0.0), ulps(2.0));
+  EXPECT_NEAR(-pi, kindr::internal::atan2Branchless(-0.0, -0.0), ulps(2.0));
+  EXPECT_NEAR(0.5*pi, kindr::internal::atan2Branchless(1.0, -0.0), ulps(2.0));
+  EXPECT_EQ(0.0, kindr::internal::atan2Branchless(0.0, 0.0));
+}
+
+TEST(VectorizedTrigonometryTest, testAsinAgainstLibm) {
+  for (int k = -1000; k <= 1000; k++) {
+    const double value = 0.001*k;
+    EXPECT_NEAR(std::asin(value), kindr::internal::asinBranchless(value), ulps(16.0))
+        << "value " << value;
+  }
+  // out-of-domain inputs from rounding drift are clamped, not NaN
+  EXPECT_NEAR(std::asin(1.0), kindr::internal::asinBranchless(1.0 + 1e-12), ulps(2.0));
+  EXPECT_NEAR(std::asin(-1.0), kindr::internal::asinBranchless(-1.0 - 1e-12), ulps(2.0));
+}
+
+TEST(VectorizedTrigonometryTest, testPackedKernels) {
+  std::vector<double> angles, sines, cosines;
+  for (int k = 0; k < 257; k++) {
+    angles.push_back(0.37*k - 40.0);
+  }
+  sines.resize(angles.size());
+  cosines.resize(angles.size());
+  kindr::internal::sincosPacked(angles.data(), sines.data(), cosines.data(), angles.size());
+  for (std::size_t k = 0; k < angles.size(); k++) {
+    EXPECT_NEAR(std::sin(angles[k]), sines[k], ulps(4.0));
+    EXPECT_NEAR(std::cos(angles[k]), cosines[k], ulps(4.0));
+  }
+
+  std::vector<double> out(angles.size());
+  kindr::internal::atan2Packed(sines.data(), cosines.data(), out.data(), angles.size());
+  for (std::size_t k = 0; k < angles.size(); k++) {
+    EXPECT_NEAR(std::atan2(sines[k], cosines[k]), out[k], ulps(8.0));
+  }
+
+  kindr::internal::asinPacked(sines.data(), out.data(), angles.size());
+  for (std::size_t k = 0; k < angles.size(); k++) {
+    EXPECT_NEAR(std::asin(sines[k]), out[k], ulps(16.0));
+  }
+}
+
+TEST(VectorizedTrigonometryTest, testFloatTypes) {
+  for (int k = -300; k <= 300; k++) {
+    const float angle = 0.21f*k;
+    float sine, cosine;
+    kindr::internal::sincosBranchless(angle, sine, cosine);
+    EXPECT_NEAR(std::sin(angle), sine, 4e-7f) << "angle " << angle;
+    EXPECT_NEAR(std::cos(angle), cosine, 4e-7f) << "angle " << angle;
+    EXPECT_NEAR(std::atan2(sine, cosine), kindr::internal::atan2Branchless(sine, cosine), 4e-7f);
+  }
+}
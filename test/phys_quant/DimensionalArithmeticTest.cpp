@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
+#include "kindr/phys_quant/DimensionalArithmetic.hpp"
+
+namespace phys_quant = kindr;
+
+// Mass and Angle have no typedefs in PhysicalQuantities.hpp yet
+typedef kindr::Vector<kindr::PhysicalType::Mass, double, 3> Mass3D;
+typedef kindr::Vector<kindr::PhysicalType::Angle, float, 3> Angle3F;
+
+TEST(DimensionalArithmeticTest, testVelocityTimesTimeIsPosition) {
+  const phys_quant::Velocity3D velocity(1.0, -2.0, 3.0);
+  const phys_quant::Time3D time(0.5, 0.5, 0.5);
+  const phys_quant::Position3D position = velocity*time;
+  static_assert(std::is_same<decltype(velocity*time), phys_quant::Position3D>::value,
+                "Velocity*Time must yield Position");
+  EXPECT_EQ(0.5, position.x());
+  EXPECT_EQ(-1.0, position.y());
+  EXPECT_EQ(1.5, position.z());
+}
+
+TEST(DimensionalArithmeticTest, testProductsCommute) {
+  const phys_quant::Acceleration3D acceleration(2.0, 0.0, -4.0);
+  const phys_quant::Time3D time(0.25, 0.5, 1.0);
+  const phys_quant::Velocity3D first = acceleration*time;
+  const phys_quant::Velocity3D second = time*acceleration;
+  for (int k = 0; k < 3; k++) {
+    EXPECT_EQ(first(k), second(k));
+  }
+}
+
+TEST(DimensionalArithmeticTest, testNewtonSecondLaw) {
+  const Mass3D mass(2.0, 2.0, 2.0);
+  const phys_quant::Acceleration3D acceleration(1.0, -3.0, 9.81);
+  const phys_quant::Force3D force = mass*acceleration;
+  EXPECT_EQ(2.0, force.x());
+  EXPECT_EQ(-6.0, force.y());
+  EXPECT_EQ(19.62, force.z());
+  // and back: the quotient inverts the product
+  const phys_quant::Acceleration3D recovered = force/mass;
+  for (int k = 0; k < 3; k++) {
+    EXPECT_EQ(acceleration(k), recovered(k));
+  }
+}
+
+TEST(DimensionalArithmeticTest, testQuotients) {
+  const phys_quant::Position3D position(4.0, -2.0, 8.0);
+  const phys_quant::Time3D time(2.0, 2.0, 2.0);
+  static_assert(std::is_same<decltype(position/time), phys_quant::Velocity3D>::value,
+                "Position/Time must yield Velocity");
+  static_assert(std::is_same<decltype(position/position), phys_quant::VectorTypeless3D>::value,
+                "a quantity divided by itself must be typeless");
+  const phys_quant::Velocity3D velocity = position/time;
+  EXPECT_EQ(2.0, velocity.x());
+  EXPECT_EQ(-1.0, velocity.y());
+  EXPECT_EQ(4.0, velocity.z());
+  const phys_quant::VectorTypeless3D ratio = position/position;
+  for (int k = 0; k < 3; k++) {
+    EXPECT_EQ(1.0, ratio(k));
+  }
+}
+
+TEST(DimensionalArithmeticTest, testTypelessIsNeutral) {
+  const phys_quant::VectorTypeless3D gains(2.0, 0.5, 1.0);
+  const phys_quant::Force3D force(10.0, 10.0, 10.0);
+  static_assert(std::is_same<decltype(gains*force), phys_quant::Force3D>::value,
+                "Typeless*Force must stay Force");
+  static_assert(std::is_same<decltype(force*gains), phys_quant::Force3D>::value,
+                "Force*Typeless must stay Force");
+  static_assert(std::is_same<decltype(force/gains), phys_quant::Force3D>::value,
+                "Force/Typeless must stay Force");
+  const phys_quant::Force3D scaled = gains*force;
+  EXPECT_EQ(20.0, scaled.x());
+  EXPECT_EQ(5.0, scaled.y());
+  EXPECT_EQ(10.0, scaled.z());
+}
+
+TEST(DimensionalArithmeticTest, testScalarOperatorsStillApply) {
+  // the existing scalar overloads must not be shadowed by the typed operators
+  const phys_quant::Velocity3D velocity(1.0, 2.0, 3.0);
+  const phys_quant::Velocity3D doubled = velocity*2.0;
+  EXPECT_EQ(2.0, doubled.x());
+  EXPECT_EQ(4.0, doubled.y());
+  EXPECT_EQ(6.0, doubled.z());
+  const phys_quant::Velocity3D halved = velocity/2.0;
+  EXPECT_EQ(0.5, halved.x());
+  EXPECT_EQ(1.0, halved.y());
+  EXPECT_EQ(1.5, halved.z());
+}
+
+TEST(DimensionalArithmeticTest, testFloatTypes) {
+  const phys_quant::AngularVelocity3F angularVelocity(0.1f, -0.2f, 0.3f);
+  const phys_quant::Time3F time(2.0f, 2.0f, 2.0f);
+  static_assert(std::is_same<decltype(angularVelocity*time), Angle3F>::value,
+                "AngularVelocity*Time must yield Angle");
+  const Angle3F angle = angularVelocity*time;
+  EXPECT_FLOAT_EQ(0.2f, angle.x());
+  EXPECT_FLOAT_EQ(-0.4f, angle.y());
+  EXPECT_FLOAT_EQ(0.6f, angle.z());
+}
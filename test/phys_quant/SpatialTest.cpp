@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2017, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/phys_quant/Spatial.hpp"
+
+template <typename PrimType_>
+struct SpatialTest : public ::testing::Test {
+  typedef PrimType_ Scalar;
+  typedef kindr::SpatialTransform<Scalar> SpatialTransform;
+  typedef kindr::SpatialInertia<Scalar> SpatialInertia;
+  typedef typename SpatialTransform::Vector3 Vector3;
+  typedef typename SpatialTransform::Vector6 Vector6;
+  typedef typename SpatialTransform::Matrix3 Matrix3;
+  typedef typename SpatialTransform::Matrix6 Matrix6;
+};
+
+typedef ::testing::Types<double, float> PrimTypes;
+TYPED_TEST_CASE(SpatialTest, PrimTypes);
+
+TYPED_TEST(SpatialTest, testTransformMotionMatchesDenseMatrix) {
+  typedef typename TestFixture::SpatialTransform SpatialTransform;
+  typedef typename TestFixture::Vector3 Vector3;
+  typedef typename TestFixture::Vector6 Vector6;
+  typedef typename TestFixture::Scalar Scalar;
+
+  kindr::RotationQuaternion<Scalar> rotation;
+  rotation.setRandom();
+  const SpatialTransform transform(rotation, Vector3(0.5, -1.0, 2.0));
+
+  Vector6 motion;
+  motion << 0.1, -0.2, 0.3, 1.0, -2.0, 3.0;
+  const Vector6 fused = transform.transformMotion(motion);
+  const Vector6 dense = transform.getMatrix()*motion;
+  for (int k = 0; k < 6; k++) {
+    EXPECT_NEAR(dense(k), fused(k), 1e-4);
+  }
+}
+
+TYPED_TEST(SpatialTest, testTransformForceMatchesDenseMatrix) {
+  typedef typename TestFixture::SpatialTransform SpatialTransform;
+  typedef typename TestFixture::Vector3 Vector3;
+  typedef typename TestFixture::Vector6 Vector6;
+  typedef typename TestFixture::Matrix6 Matrix6;
+  typedef typename TestFixture::Scalar Scalar;
+
+  kindr::RotationQuaternion<Scalar> rotation;
+  rotation.setRandom();
+  const SpatialTransform transform(rotation, Vector3(-0.3, 0.8, 1.5));
+
+  Vector6 force;
+  force << 2.0, -1.0, 0.5, -0.4, 0.2, 1.2;
+  const Vector6 fused = transform.transformForce(force);
+  // force transform is the inverse transpose of the motion transform
+  const Matrix6 dense = transform.getMatrix().inverse().transpose();
+  const Vector6 expected = dense*force;
+  for (int k = 0; k < 6; k++) {
+    EXPECT_NEAR(expected(k), fused(k), 1e-3);
+  }
+}
+
+TYPED_TEST(SpatialTest, testComposeAndInvert) {
+  typedef typename TestFixture::SpatialTransform SpatialTransform;
+  typedef typename TestFixture::Vector3 Vector3;
+  typedef typename TestFixture::Matrix6 Matrix6;
+  typedef typename TestFixture::Scalar Scalar;
+
+  kindr::RotationQuaternion<Scalar> rotation1, rotation2;
+  rotation1.setRandom();
+  rotation2.setRandom();
+  const SpatialTransform transform1(rotation1, Vector3(0.2, 0.4, -0.6));
+  const SpatialTransform transform2(rotation2, Vector3(-1.0, 0.1, 0.9));
+
+  const Matrix6 composed = (transform2*transform1).getMatrix();
+  const Matrix6 denseProduct = transform2.getMatrix()*transform1.getMatrix();
+  for (int i = 0; i < 6; i++) {
+    for (int k = 0; k < 6; k++) {
+      EXPECT_NEAR(denseProduct(i, k), composed(i, k), 1e-4);
+    }
+  }
+
+  const Matrix6 identity = (transform1.inverted()*transform1).getMatrix();
+  for (int i = 0; i < 6; i++) {
+    for (int k = 0; k < 6; k++) {
+      EXPECT_NEAR(i == k ? 1.0 : 0.0, identity(i, k), 1e-4);
+    }
+  }
+}
+
+TYPED_TEST(SpatialTest, testInertiaApplyMatchesDenseMatrix) {
+  typedef typename TestFixture::SpatialInertia SpatialInertia;
+  typedef typename TestFixture::Vector3 Vector3;
+  typedef typename TestFixture::Vector6 Vector6;
+  typedef typename TestFixture::Matrix3 Matrix3;
+  typedef typename TestFixture::Scalar Scalar;
+
+  Matrix3 inertia;
+  inertia << 2.0, 0.1, -0.2,
+             0.1, 3.0, 0.3,
+            -0.2, 0.3, 4.0;
+  const SpatialInertia spatialInertia(Scalar(5.0), Vector3(0.1, -0.2, 0.3), inertia);
+
+  EXPECT_NEAR(5.0, spatialInertia.getMass(), 1e-6);
+  EXPECT_NEAR(0.1, spatialInertia.getCenterOfMass()(0), 1e-6);
+
+  Vector6 motion;
+  motion << 0.5, -0.1, 0.8, 1.5, 2.5, -0.5;
+  const Vector6 fused = spatialInertia.apply(motion);
+  const Vector6 dense = spatialInertia.getMatrix()*motion;
+  for (int k = 0; k < 6; k++) {
+    EXPECT_NEAR(dense(k), fused(k), 1e-4);
+  }
+}
+
+TYPED_TEST(SpatialTest, testInertiaAddition) {
+  typedef typename TestFixture::SpatialInertia SpatialInertia;
+  typedef typename TestFixture::Vector3 Vector3;
+  typedef typename TestFixture::Matrix3 Matrix3;
+  typedef typename TestFixture::Scalar Scalar;
+
+  const SpatialInertia first(Scalar(2.0), Vector3(0.1, 0.0, -0.1), Matrix3::Identity());
+  const SpatialInertia second(Scalar(3.0), Vector3(-0.2, 0.1, 0.0), Scalar(2.0)*Matrix3::Identity());
+  const SpatialInertia sum = first + second;
+
+  EXPECT_NEAR(5.0, sum.getMass(), 1e-6);
+  const Eigen::Matrix<Scalar, 6, 6> expected = first.getMatrix() + second.getMatrix();
+  const Eigen::Matrix<Scalar, 6, 6> actual = sum.getMatrix();
+  for (int i = 0; i < 6; i++) {
+    for (int k = 0; k < 6; k++) {
+      EXPECT_NEAR(expected(i, k), actual(i, k), 1e-5);
+    }
+  }
+}
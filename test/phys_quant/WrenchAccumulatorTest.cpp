@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2017, Christian Gehring
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/phys_quant/WrenchAccumulator.hpp"
+
+TEST(WrenchAccumulatorTest, testEmptySumIsZero) {
+  kindr::WrenchAccumulatorD accumulator;
+  EXPECT_TRUE(accumulator.empty());
+  EXPECT_NEAR(0.0, accumulator.sum().getVector().norm(), 1e-14);
+}
+
+TEST(WrenchAccumulatorTest, testMatchesChainedWrenchAdditions) {
+  typedef kindr::WrenchD::Force Force;
+  typedef kindr::WrenchD::Torque Torque;
+  kindr::WrenchAccumulatorD accumulator;
+  accumulator.reserve(16);
+  kindr::WrenchD expected;
+  for (int k = 0; k < 16; k++) {
+    const kindr::Position3D position(0.3*k - 1.0, -0.7 + 0.2*k, 1.1 - 0.05*k);
+    const Force force(1.0 - 0.1*k, 0.5*k, -2.0 + 0.3*k);
+    accumulator.addContact(position, force);
+    const Torque torque(Torque(position.toImplementation().cross(force.toImplementation())));
+    expected += kindr::WrenchD(force, torque);
+  }
+  EXPECT_EQ(16u, accumulator.size());
+  EXPECT_NEAR(0.0, (accumulator.sum().getVector() - expected.getVector()).norm(), 1e-12);
+}
+
+TEST(WrenchAccumulatorTest, testAddWrenchAndClear) {
+  typedef kindr::WrenchD::Force Force;
+  typedef kindr::WrenchD::Torque Torque;
+  const kindr::WrenchD wrench(Force(1.0, -2.0, 3.0), Torque(0.5, 4.0, -1.5));
+  kindr::WrenchAccumulatorD accumulator;
+  accumulator.addWrench(wrench);
+  accumulator.addWrench(wrench);
+  EXPECT_NEAR(0.0, (accumulator.sum().getVector() - (wrench + wrench).getVector()).norm(), 1e-14);
+  accumulator.clear();
+  EXPECT_TRUE(accumulator.empty());
+  EXPECT_NEAR(0.0, accumulator.sum().getVector().norm(), 1e-14);
+}
+
+TEST(WrenchAccumulatorTest, testMixedContactsAndWrenches) {
+  typedef kindr::WrenchD::Force Force;
+  typedef kindr::WrenchD::Torque Torque;
+  kindr::WrenchAccumulatorD accumulator;
+  const kindr::Position3D position(0.3, -1.2, 2.5);
+  const Force force(1.7, 0.2, -0.9);
+  const kindr::WrenchD pure(Force(0.0, 0.0, 0.0), Torque(0.1, -0.2, 0.3));
+  accumulator.addContact(position, force);
+  accumulator.addWrench(pure);
+  const kindr::WrenchD expected = kindr::WrenchD(force, Torque(position.toImplementation().cross(force.toImplementation()))) + pure;
+  EXPECT_NEAR(0.0, (accumulator.sum().getVector() - expected.getVector()).norm(), 1e-14);
+}
+
+TEST(WrenchAccumulatorTest, testFloatTypes) {
+  typedef kindr::Wrench6<float> WrenchF;
+  kindr::WrenchAccumulatorF accumulator;
+  accumulator.addContact(kindr::Position<float, 3>(0.3f, -1.2f, 2.5f), WrenchF::Force(1.7f, 0.2f, -0.9f));
+  EXPECT_NEAR(1.7f, accumulator.sum().getForce().x(), 1e-6f);
+}
@@ -33,6 +33,7 @@
 #include <gtest/gtest.h>
 
 #include "kindr/phys_quant/Wrench.hpp"
+#include "kindr/poses/Pose.hpp"
 #include "kindr/common/gtest_eigen.hpp"
 
 template <typename PrimType_>
@@ -253,3 +254,42 @@ TYPED_TEST(WrenchTest, math)
   KINDR_ASSERT_DOUBLE_MX_EQ(torque1DivideByScalar.toImplementation(), wrenchDivideAssign.getTorque().toImplementation(), Scalar(0.5), "divide and assign");
 
 }
+
+TYPED_TEST(WrenchTest, transform)
+{
+  typedef typename TestFixture::Wrench Wrench;
+  typedef typename TestFixture::Force Force;
+  typedef typename TestFixture::Torque Torque;
+  typedef typename TestFixture::Vector3 Vector3;
+  typedef typename TestFixture::Scalar Scalar;
+  typedef kindr::HomogeneousTransformationPosition3RotationQuaternion<Scalar> Pose;
+  typedef typename Pose::Position Position;
+  typedef typename Pose::Rotation Rotation;
+
+  Rotation rotation;
+  rotation.setRandom();
+  const Position position(0.5, -1.2, 2.0);
+  const Pose pose(position, rotation);
+
+  const Force force(0.1, -0.2, 0.3);
+  const Torque torque(1.1, 2.2, -3.3);
+  const Wrench wrench(force, torque);
+
+  const Wrench transformed = wrench.transform(pose);
+
+  // adjoint map: f' = R*f, tau' = R*tau + p x (R*f)
+  const Vector3 expectedForce = rotation.rotate(force.toImplementation());
+  const Vector3 expectedTorque = Vector3(rotation.rotate(torque.toImplementation()))
+      + Vector3(position.toImplementation()).cross(expectedForce);
+  for (int k = 0; k < 3; k++) {
+    EXPECT_NEAR(expectedForce(k), transformed.getForce()(k), 1e-4);
+    EXPECT_NEAR(expectedTorque(k), transformed.getTorque()(k), 1e-4);
+  }
+
+  // identity pose leaves the wrench unchanged
+  const Wrench unchanged = wrench.transform(Pose());
+  for (int k = 0; k < 3; k++) {
+    EXPECT_NEAR(force(k), unchanged.getForce()(k), 1e-6);
+    EXPECT_NEAR(torque(k), unchanged.getTorque()(k), 1e-6);
+  }
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <vector>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include <gtest/gtest.h>
+
+#include "kindr/poses/ChainVelocityPropagation.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+namespace rot = kindr;
+namespace pose = kindr;
+
+template <typename PrimType_>
+struct ChainVelocityPropagationTest : public ::testing::Test {
+  typedef PrimType_ Scalar;
+  typedef pose::HomogeneousTransformationPosition3RotationQuaternion<Scalar> Pose;
+  typedef pose::TwistLinearVelocityLocalAngularVelocity<Scalar> Twist;
+  typedef pose::Wrench6<Scalar> Wrench;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+  typedef Eigen::Matrix<Scalar, 3, 3> Matrix3;
+  typedef std::vector<Pose, Eigen::aligned_allocator<Pose>> PoseVector;
+  typedef std::vector<Twist, Eigen::aligned_allocator<Twist>> TwistVector;
+  typedef std::vector<Wrench, Eigen::aligned_allocator<Wrench>> WrenchVector;
+
+  static PoseVector buildChain() {
+    PoseVector transforms;
+    transforms.push_back(Pose(typename Pose::Position(0.3, 0.0, 0.1),
+                              typename Pose::Rotation(rot::AngleAxis<Scalar>(0.4, Vector3(0.0, 0.0, 1.0)))));
+    transforms.push_back(Pose(typename Pose::Position(0.0, 0.25, 0.0),
+                              typename Pose::Rotation(rot::AngleAxis<Scalar>(-0.7, Vector3(0.0, 1.0, 0.0)))));
+    transforms.push_back(Pose(typename Pose::Position(0.2, -0.1, 0.05),
+                              typename Pose::Rotation(rot::AngleAxis<Scalar>(1.1, Vector3(1.0, 0.0, 0.0)))));
+    return transforms;
+  }
+};
+
+typedef ::testing::Types<double, float> Types;
+
+TYPED_TEST_CASE(ChainVelocityPropagationTest, Types);
+
+TYPED_TEST(ChainVelocityPropagationTest, testVelocitySweepAgainstReference) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Vector3 Vector3;
+  typedef typename TestFixture::Matrix3 Matrix3;
+  typedef typename TestFixture::Twist Twist;
+  const Scalar tol = std::is_same<Scalar, float>::value ? Scalar(1e-5) : Scalar(1e-12);
+
+  const typename TestFixture::PoseVector transforms = TestFixture::buildChain();
+  std::vector<Vector3> axes;
+  axes.push_back(Vector3(0.0, 0.0, 1.0));
+  axes.push_back(Vector3(0.0, 1.0, 0.0));
+  axes.push_back(Vector3(1.0, 0.0, 0.0));
+  std::vector<Scalar> rates;
+  rates.push_back(Scalar(0.8));
+  rates.push_back(Scalar(-1.3));
+  rates.push_back(Scalar(0.5));
+  const Twist baseTwist(Vector3(0.1, -0.2, 0.3), Vector3(0.05, 0.1, -0.15));
+
+  typename TestFixture::TwistVector twists;
+  pose::propagateChainVelocities(transforms, axes, rates, baseTwist, twists);
+  ASSERT_EQ(transforms.size(), twists.size());
+
+  // hand-rolled reference recursion on raw Eigen types
+  Vector3 linear = baseTwist.getTranslationalVelocity().toImplementation();
+  Vector3 angular = baseTwist.getRotationalVelocity().toImplementation();
+  for (std::size_t i = 0; i < transforms.size(); i++) {
+    const Matrix3 rotation = rot::RotationMatrix<Scalar>(transforms[i].getRotation()).toImplementation();
+    const Vector3 offset = transforms[i].getPosition().toImplementation();
+    const Vector3 newLinear = rotation.transpose()*(linear + angular.cross(offset));
+    const Vector3 newAngular = rotation.transpose()*angular + axes[i]*rates[i];
+    KINDR_ASSERT_DOUBLE_MX_EQ(newLinear, twists[i].getTranslationalVelocity().toImplementation(), tol, "linear");
+    KINDR_ASSERT_DOUBLE_MX_EQ(newAngular, twists[i].getRotationalVelocity().toImplementation(), tol, "angular");
+    linear = newLinear;
+    angular = newAngular;
+  }
+}
+
+TYPED_TEST(ChainVelocityPropagationTest, testVelocitySweepIdentityChain) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Vector3 Vector3;
+  typedef typename TestFixture::Pose Pose;
+  typedef typename TestFixture::Twist Twist;
+  const Scalar tol = Scalar(1e-6);
+
+  // identity transforms and zero rates: the base twist passes through unchanged
+  typename TestFixture::PoseVector transforms(2, Pose());
+  std::vector<Vector3> axes(2, Vector3(0.0, 0.0, 1.0));
+  std::vector<Scalar> rates(2, Scalar(0.0));
+  const Twist baseTwist(Vector3(1.0, 2.0, 3.0), Vector3(0.0, 0.0, 0.0));
+
+  typename TestFixture::TwistVector twists;
+  pose::propagateChainVelocities(transforms, axes, rates, baseTwist, twists);
+  for (std::size_t i = 0; i < twists.size(); i++) {
+    KINDR_ASSERT_DOUBLE_MX_EQ(baseTwist.getTranslationalVelocity().toImplementation(),
+                              twists[i].getTranslationalVelocity().toImplementation(), tol, "linear");
+    KINDR_ASSERT_DOUBLE_MX_EQ(baseTwist.getRotationalVelocity().toImplementation(),
+                              twists[i].getRotationalVelocity().toImplementation(), tol, "angular");
+  }
+}
+
+TYPED_TEST(ChainVelocityPropagationTest, testWrenchSweepAgainstReference) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Vector3 Vector3;
+  typedef typename TestFixture::Matrix3 Matrix3;
+  typedef typename TestFixture::Wrench Wrench;
+  const Scalar tol = std::is_same<Scalar, float>::value ? Scalar(1e-5) : Scalar(1e-12);
+
+  const typename TestFixture::PoseVector transforms = TestFixture::buildChain();
+  typename TestFixture::WrenchVector wrenches;
+  wrenches.push_back(Wrench(Vector3(1.0, 0.0, -2.0), Vector3(0.1, 0.2, 0.3)));
+  wrenches.push_back(Wrench(Vector3(0.0, 3.0, 1.0), Vector3(-0.4, 0.0, 0.2)));
+  wrenches.push_back(Wrench(Vector3(-1.5, 0.5, 0.0), Vector3(0.0, 0.6, -0.1)));
+
+  typename TestFixture::WrenchVector netWrenches;
+  pose::propagateChainWrenches(transforms, wrenches, netWrenches);
+  ASSERT_EQ(transforms.size(), netWrenches.size());
+
+  // hand-rolled reference recursion from tip to base
+  std::vector<Vector3> refForce(3), refTorque(3);
+  for (std::size_t k = transforms.size(); k > 0; k--) {
+    const std::size_t i = k - 1;
+    refForce[i] = wrenches[i].getForce().toImplementation();
+    refTorque[i] = wrenches[i].getTorque().toImplementation();
+    if (i + 1 < transforms.size()) {
+      const Matrix3 childRotation = rot::RotationMatrix<Scalar>(transforms[i + 1].getRotation()).toImplementation();
+      const Vector3 childOffset = transforms[i + 1].getPosition().toImplementation();
+      const Vector3 childForce = childRotation*refForce[i + 1];
+      refForce[i] += childForce;
+      refTorque[i] += childRotation*refTorque[i + 1] + childOffset.cross(childForce);
+    }
+  }
+  for (std::size_t i = 0; i < transforms.size(); i++) {
+    KINDR_ASSERT_DOUBLE_MX_EQ(refForce[i], netWrenches[i].getForce().toImplementation(), tol, "force");
+    KINDR_ASSERT_DOUBLE_MX_EQ(refTorque[i], netWrenches[i].getTorque().toImplementation(), tol, "torque");
+  }
+}
+
+TYPED_TEST(ChainVelocityPropagationTest, testWrenchSweepIdentityChain) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Vector3 Vector3;
+  typedef typename TestFixture::Pose Pose;
+  typedef typename TestFixture::Wrench Wrench;
+
+  // identity transforms: the net wrench at the base is the plain sum of forces
+  // and of torques shifted by nothing
+  typename TestFixture::PoseVector transforms(3, Pose());
+  typename TestFixture::WrenchVector wrenches;
+  wrenches.push_back(Wrench(Vector3(1.0, 0.0, 0.0), Vector3(0.0, 0.1, 0.0)));
+  wrenches.push_back(Wrench(Vector3(0.0, 2.0, 0.0), Vector3(0.0, 0.0, 0.2)));
+  wrenches.push_back(Wrench(Vector3(0.0, 0.0, 3.0), Vector3(0.3, 0.0, 0.0)));
+
+  typename TestFixture::WrenchVector netWrenches;
+  pose::propagateChainWrenches(transforms, wrenches, netWrenches);
+  KINDR_ASSERT_DOUBLE_MX_EQ(Vector3(1.0, 2.0, 3.0), netWrenches[0].getForce().toImplementation(), Scalar(1e-6), "force");
+  KINDR_ASSERT_DOUBLE_MX_EQ(Vector3(0.3, 0.1, 0.2), netWrenches[0].getTorque().toImplementation(), Scalar(1e-6), "torque");
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/poses/DualQuaternion.hpp"
+
+namespace pose = kindr;
+namespace pos = kindr;
+namespace rot = kindr;
+
+typedef pose::HomogeneousTransformationPosition3RotationQuaternionD PoseD;
+
+static pose::DualQuaternionD samplePose(int seed) {
+  return pose::DualQuaternionD(pos::Position3D(1.0 + seed, -2.0, 0.5*seed),
+                               rot::RotationQuaternionD(rot::EulerAnglesZyxD(0.3*seed, -0.4, 0.2 + 0.1*seed)));
+}
+
+TEST(DualQuaternionTest, testIdentity) {
+  pose::DualQuaternionD identity;
+  EXPECT_NEAR(0.0, identity.getPosition().toImplementation().norm(), 1e-15);
+  EXPECT_TRUE(identity.getRotation().isNear(rot::RotationQuaternionD(), 1e-15));
+  const pos::Position3D point(1.0, 2.0, 3.0);
+  EXPECT_NEAR(0.0, (identity.transform(point) - point).toImplementation().norm(), 1e-15);
+
+  pose::DualQuaternionD pose = samplePose(1);
+  pose.setIdentity();
+  EXPECT_NEAR(0.0, pose.getPosition().toImplementation().norm(), 1e-15);
+}
+
+TEST(DualQuaternionTest, testPositionRotationRoundTrip) {
+  const pos::Position3D position(1.0, -2.0, 3.0);
+  const rot::RotationQuaternionD rotation(rot::EulerAnglesZyxD(0.4, -0.7, 1.1));
+  const pose::DualQuaternionD pose(position, rotation);
+  EXPECT_NEAR(0.0, (pose.getPosition() - position).toImplementation().norm(), 1e-12);
+  EXPECT_TRUE(pose.getRotation().isNear(rotation, 1e-12));
+
+  pose::DualQuaternionD modified = pose;
+  modified.setPosition(pos::Position3D(5.0, 6.0, 7.0));
+  EXPECT_NEAR(5.0, modified.getPosition().x(), 1e-12);
+  EXPECT_TRUE(modified.getRotation().isNear(rotation, 1e-12));
+}
+
+TEST(DualQuaternionTest, testTransformMatchesHomogeneousTransformation) {
+  const pose::DualQuaternionD dualQuaternion = samplePose(2);
+  const PoseD homogeneous(dualQuaternion);
+  const pos::Position3D point(0.3, -1.2, 2.5);
+  EXPECT_NEAR(0.0, (dualQuaternion.transform(point) - homogeneous.transform(point)).toImplementation().norm(), 1e-12);
+  EXPECT_NEAR(0.0, (dualQuaternion.inverseTransform(point) - homogeneous.inverseTransform(point)).toImplementation().norm(), 1e-12);
+}
+
+TEST(DualQuaternionTest, testComposition) {
+  const pose::DualQuaternionD poseA = samplePose(1);
+  const pose::DualQuaternionD poseB = samplePose(3);
+  const pose::DualQuaternionD composed = poseA*poseB;
+  const PoseD expected = PoseD(poseA)*PoseD(poseB);
+  EXPECT_NEAR(0.0, (composed.getPosition() - expected.getPosition()).toImplementation().norm(), 1e-12);
+  EXPECT_TRUE(composed.getRotation().isNear(expected.getRotation(), 1e-12));
+}
+
+TEST(DualQuaternionTest, testInverse) {
+  const pose::DualQuaternionD pose = samplePose(2);
+  const pose::DualQuaternionD identity = pose*pose.inverted();
+  EXPECT_NEAR(0.0, identity.getPosition().toImplementation().norm(), 1e-12);
+  EXPECT_TRUE(identity.getRotation().isNear(rot::RotationQuaternionD(), 1e-12));
+
+  // relative pose matches the homogeneous transformation result
+  const pose::DualQuaternionD other = samplePose(4);
+  const pose::DualQuaternionD relative = pose.inverseCompose(other);
+  const PoseD expected = PoseD(pose).inverseCompose(PoseD(other));
+  EXPECT_NEAR(0.0, (relative.getPosition() - expected.getPosition()).toImplementation().norm(), 1e-12);
+  EXPECT_TRUE(relative.getRotation().isNear(expected.getRotation(), 1e-12));
+}
+
+TEST(DualQuaternionTest, testBlendWeightRecoversPose) {
+  std::vector<pose::DualQuaternionD> poses{samplePose(1), samplePose(3)};
+  const pose::DualQuaternionD blended = pose::blendDualQuaternions(poses, std::vector<double>{1.0, 0.0});
+  EXPECT_NEAR(0.0, (blended.getPosition() - poses[0].getPosition()).toImplementation().norm(), 1e-12);
+  EXPECT_TRUE(blended.getRotation().isNear(poses[0].getRotation(), 1e-12));
+}
+
+TEST(DualQuaternionTest, testBlendIsRigidAndBetween) {
+  std::vector<pose::DualQuaternionD> poses{samplePose(1), samplePose(3), samplePose(5)};
+  const pose::DualQuaternionD blended = pose::blendDualQuaternions(poses, std::vector<double>{0.5, 0.3, 0.2});
+  // the result is normalized: unit real part, dual part orthogonal to it
+  EXPECT_NEAR(1.0, blended.norm(), 1e-14);
+  EXPECT_NEAR(0.0, blended.getReal().coeffs().dot(blended.getDual().coeffs()), 1e-14);
+  // blending identical poses reproduces the pose
+  std::vector<pose::DualQuaternionD> equal{samplePose(2), samplePose(2)};
+  const pose::DualQuaternionD average = pose::blendDualQuaternions(equal, std::vector<double>{0.5, 0.5});
+  EXPECT_NEAR(0.0, (average.getPosition() - equal[0].getPosition()).toImplementation().norm(), 1e-12);
+  EXPECT_TRUE(average.getRotation().isNear(equal[0].getRotation(), 1e-12));
+}
+
+TEST(DualQuaternionTest, testBlendHandlesAntipodalRepresentation) {
+  const pose::DualQuaternionD pose = samplePose(2);
+  // the negated dual quaternion encodes the same rigid transformation
+  const pose::DualQuaternionD antipodal(pose::DualQuaternionD::Quaternion(-pose.getReal().coeffs()),
+                                        pose::DualQuaternionD::Quaternion(-pose.getDual().coeffs()));
+  std::vector<pose::DualQuaternionD> poses{pose, antipodal};
+  const pose::DualQuaternionD blended = pose::blendDualQuaternions(poses, std::vector<double>{0.5, 0.5});
+  EXPECT_NEAR(0.0, (blended.getPosition() - pose.getPosition()).toImplementation().norm(), 1e-12);
+  EXPECT_TRUE(blended.getRotation().isNear(pose.getRotation(), 1e-12));
+}
+
+TEST(DualQuaternionTest, testExponentialAndLogarithmicMap) {
+  const pose::DualQuaternionD pose = samplePose(3);
+  const Eigen::Matrix<double, 6, 1> logarithm = pose.logarithmicMap();
+  const pose::DualQuaternionD reconstructed = pose::DualQuaternionD::exponentialMap(logarithm);
+  EXPECT_NEAR(0.0, (reconstructed.getPosition() - pose.getPosition()).toImplementation().norm(), 1e-10);
+  EXPECT_TRUE(reconstructed.getRotation().isNear(pose.getRotation(), 1e-10));
+  EXPECT_NEAR(0.0, (PoseD(pose).logarithmicMap() - logarithm).norm(), 1e-12);
+}
+
+TEST(DualQuaternionTest, testFloatTypes) {
+  const pose::DualQuaternionF pose(pos::Position3F(1.0f, -2.0f, 3.0f),
+                                   rot::RotationQuaternionF(rot::EulerAnglesZyxF(0.4f, -0.7f, 1.1f)));
+  EXPECT_NEAR(0.0f, (pose.getPosition() - pos::Position3F(1.0f, -2.0f, 3.0f)).toImplementation().norm(), 1e-5f);
+  EXPECT_EQ(8u*sizeof(float), sizeof(pose::DualQuaternionF));
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/poses/FramedTransform.hpp"
+
+namespace pose = kindr;
+
+// frame tags are plain empty structs defined by the user
+struct MapFrame {};
+struct BodyFrame {};
+struct CameraFrame {};
+
+typedef pose::HomogeneousTransformationPosition3RotationQuaternionD PoseD;
+
+TEST(FramedTransformTest, testZeroOverhead) {
+  // the wrapper holds exactly the underlying pose
+  static_assert(sizeof(pose::FramedTransform<MapFrame, BodyFrame>) == sizeof(PoseD),
+                "frame tags must not add storage");
+  static_assert(sizeof(pose::FramedPosition<MapFrame>) == sizeof(pose::Position3D),
+                "frame tags must not add storage");
+}
+
+TEST(FramedTransformTest, testChainedComposition) {
+  const pose::FramedTransform<MapFrame, BodyFrame> mapFromBody(
+      PoseD(pose::Position3D(1.0, -2.0, 0.5),
+            pose::RotationQuaternionD(pose::EulerAnglesZyxD(0.4, -0.7, 1.1))));
+  const pose::FramedTransform<BodyFrame, CameraFrame> bodyFromCamera(
+      PoseD(pose::Position3D(0.1, 0.0, 0.2),
+            pose::RotationQuaternionD(pose::EulerAnglesZyxD(-0.2, 0.9, 0.1))));
+
+  // frames chain: (map<-body)*(body<-camera) = map<-camera
+  const pose::FramedTransform<MapFrame, CameraFrame> mapFromCamera = mapFromBody*bodyFromCamera;
+
+  const PoseD expected = mapFromBody.get()*bodyFromCamera.get();
+  EXPECT_NEAR(0.0, (expected.getPosition().toImplementation()
+                    - mapFromCamera.get().getPosition().toImplementation()).norm(), 1e-12);
+  EXPECT_TRUE(expected.getRotation().isNear(mapFromCamera.get().getRotation(), 1e-12));
+}
+
+TEST(FramedTransformTest, testInversionSwapsFrames) {
+  const pose::FramedTransform<MapFrame, BodyFrame> mapFromBody(
+      PoseD(pose::Position3D(1.0, 2.0, 3.0),
+            pose::RotationQuaternionD(pose::EulerAnglesZyxD(0.3, 0.2, -0.5))));
+  const pose::FramedTransform<BodyFrame, MapFrame> bodyFromMap = mapFromBody.inverted();
+
+  // round trip through the inverse is the identity
+  const pose::FramedTransform<MapFrame, MapFrame> identity = mapFromBody*bodyFromMap;
+  EXPECT_NEAR(0.0, identity.get().getPosition().toImplementation().norm(), 1e-12);
+  EXPECT_TRUE(identity.get().getRotation().isNear(pose::RotationQuaternionD(), 1e-12));
+}
+
+TEST(FramedTransformTest, testTransformPositions) {
+  const pose::FramedTransform<MapFrame, BodyFrame> mapFromBody(
+      PoseD(pose::Position3D(1.0, -2.0, 0.5),
+            pose::RotationQuaternionD(pose::EulerAnglesZyxD(0.4, -0.7, 1.1))));
+  const pose::FramedPosition<BodyFrame> positionInBody(pose::Position3D(0.5, -1.0, 2.0));
+
+  const pose::FramedPosition<MapFrame> positionInMap = mapFromBody.transform(positionInBody);
+  const pose::Position3D expected = mapFromBody.get().transform(positionInBody.get());
+  for (int k = 0; k < 3; k++) {
+    EXPECT_NEAR(expected(k), positionInMap.get()(k), 1e-12);
+  }
+
+  const pose::FramedPosition<BodyFrame> roundTrip = mapFromBody.inverseTransform(positionInMap);
+  for (int k = 0; k < 3; k++) {
+    EXPECT_NEAR(positionInBody.get()(k), roundTrip.get()(k), 1e-12);
+  }
+}
+
+TEST(FramedTransformTest, testFramedRotation) {
+  const pose::FramedRotation<MapFrame, BodyFrame> mapFromBody(
+      pose::RotationQuaternionD(pose::EulerAnglesZyxD(0.4, -0.7, 1.1)));
+  const pose::FramedRotation<BodyFrame, CameraFrame> bodyFromCamera(
+      pose::RotationQuaternionD(pose::EulerAnglesZyxD(-0.2, 0.9, 0.1)));
+
+  const pose::FramedRotation<MapFrame, CameraFrame> mapFromCamera = mapFromBody*bodyFromCamera;
+  EXPECT_TRUE(mapFromCamera.get().isNear(mapFromBody.get()*bodyFromCamera.get(), 1e-12));
+
+  const pose::FramedPosition<BodyFrame> vectorInBody(pose::Position3D(1.0, 0.0, 0.0));
+  const pose::FramedPosition<MapFrame> vectorInMap = mapFromBody.rotate(vectorInBody);
+  const pose::Position3D expected = mapFromBody.get().rotate(vectorInBody.get());
+  for (int k = 0; k < 3; k++) {
+    EXPECT_NEAR(expected(k), vectorInMap.get()(k), 1e-12);
+  }
+
+  const pose::FramedRotation<BodyFrame, MapFrame> inverse = mapFromBody.inverted();
+  EXPECT_TRUE((inverse*mapFromBody).get().isNear(pose::RotationQuaternionD(), 1e-12));
+}
+
+TEST(FramedTransformTest, testFramedPositionArithmetic) {
+  const pose::FramedPosition<MapFrame> first(pose::Position3D(1.0, 2.0, 3.0));
+  const pose::FramedPosition<MapFrame> second(pose::Position3D(0.5, -1.0, 0.25));
+  const pose::FramedPosition<MapFrame> sum = first + second;
+  EXPECT_EQ(1.5, sum.get().x());
+  EXPECT_EQ(1.0, sum.get().y());
+  EXPECT_EQ(3.25, sum.get().z());
+  const pose::FramedPosition<MapFrame> difference = sum - second;
+  EXPECT_NEAR(0.0, (difference.get() - first.get()).toImplementation().norm(), 1e-15);
+}
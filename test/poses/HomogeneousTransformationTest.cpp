@@ -183,3 +183,27 @@ TYPED_TEST(HomogeneousTransformationTest, testGenericRotateVectorCompilable)
   kindr::Velocity<Scalar, 3> vel(-1,2,3);
   test.getRotation().rotate(vel);
 }
+
+TYPED_TEST(HomogeneousTransformationTest, testInverseCompose)
+{
+  typedef typename TestFixture::Pose Pose;
+  typedef typename TestFixture::Position Position;
+  typedef typename TestFixture::Rotation Rotation;
+  typedef typename TestFixture::Scalar Scalar;
+
+  Pose poseA(Position(1.0,2.0,3.0), Rotation(kindr::EulerAnglesZyx<Scalar>(0.5,1.2,-1.7)));
+  Pose poseB(Position(-2.0,0.5,1.0), Rotation(kindr::EulerAnglesZyx<Scalar>(-1.1,0.4,0.2)));
+
+  // The relative pose concatenated onto poseA must reproduce poseB.
+  Pose relative = poseA.inverseCompose(poseB);
+  Pose reproduced = poseA*relative;
+  ASSERT_TRUE(reproduced.getRotation().isNear(poseB.getRotation(), 1e-4));
+  ASSERT_NEAR(reproduced.getPosition().x(), poseB.getPosition().x(), 1e-4);
+  ASSERT_NEAR(reproduced.getPosition().y(), poseB.getPosition().y(), 1e-4);
+  ASSERT_NEAR(reproduced.getPosition().z(), poseB.getPosition().z(), 1e-4);
+
+  // betweenPoses is a free-function alias of the same operation.
+  Pose relative2 = kindr::betweenPoses(poseA, poseB);
+  ASSERT_TRUE(relative.getRotation().isNear(relative2.getRotation(), 1e-6));
+  ASSERT_NEAR(relative.getPosition().x(), relative2.getPosition().x(), 1e-6);
+}
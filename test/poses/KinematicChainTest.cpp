@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/poses/KinematicChain.hpp"
+
+namespace pose = kindr;
+
+template <typename PrimType_>
+struct KinematicChainTest : public ::testing::Test {
+  typedef PrimType_ Scalar;
+  typedef pose::KinematicChain<Scalar> KinematicChain;
+  typedef typename KinematicChain::Pose Pose;
+  typedef typename Pose::Position Position;
+  typedef typename Pose::Rotation Rotation;
+
+  static Pose getRandomPose() {
+    Rotation rotation;
+    rotation.setRandom();
+    Position position;
+    position.toImplementation().setRandom();
+    return Pose(position, rotation);
+  }
+
+  static void expectPosesNear(const Pose& expected, const Pose& actual, double tolerance) {
+    for (int k = 0; k < 3; k++) {
+      EXPECT_NEAR(expected.getPosition()(k), actual.getPosition()(k), tolerance);
+    }
+    EXPECT_TRUE(expected.getRotation().isNear(actual.getRotation(), tolerance));
+  }
+};
+
+typedef ::testing::Types<double, float> PrimTypes;
+TYPED_TEST_CASE(KinematicChainTest, PrimTypes);
+
+TYPED_TEST(KinematicChainTest, testForwardKinematicsMatchesFold) {
+  typedef typename TestFixture::KinematicChain KinematicChain;
+  typedef typename TestFixture::Pose Pose;
+
+  KinematicChain chain;
+  ASSERT_EQ(0u, chain.getNumberOfLinks());
+
+  const std::size_t numberOfLinks = 8;
+  std::vector<Pose, Eigen::aligned_allocator<Pose>> links;
+  for (std::size_t i = 0; i < numberOfLinks; i++) {
+    links.push_back(TestFixture::getRandomPose());
+    chain.appendLink(links.back());
+  }
+  ASSERT_EQ(numberOfLinks, chain.getNumberOfLinks());
+
+  Pose folded;
+  for (std::size_t i = 0; i < numberOfLinks; i++) {
+    folded = Pose(folded*links[i]);
+    TestFixture::expectPosesNear(folded, chain.getTransformToLink(i), 1e-4);
+  }
+  TestFixture::expectPosesNear(folded, chain.getEndEffectorTransform(), 1e-4);
+}
+
+TYPED_TEST(KinematicChainTest, testIncrementalUpdate) {
+  typedef typename TestFixture::KinematicChain KinematicChain;
+  typedef typename TestFixture::Pose Pose;
+
+  KinematicChain chain;
+  const std::size_t numberOfLinks = 6;
+  std::vector<Pose, Eigen::aligned_allocator<Pose>> links;
+  for (std::size_t i = 0; i < numberOfLinks; i++) {
+    links.push_back(TestFixture::getRandomPose());
+    chain.appendLink(links.back());
+  }
+  // populate the cache
+  chain.getEndEffectorTransform();
+
+  // move a middle joint; the suffix must be recomputed, the prefix kept
+  links[3] = TestFixture::getRandomPose();
+  chain.setLinkTransform(3, links[3]);
+  EXPECT_TRUE(links[3].getRotation().isNear(chain.getLinkTransform(3).getRotation(), 1e-6));
+
+  Pose folded;
+  for (std::size_t i = 0; i < numberOfLinks; i++) {
+    folded = Pose(folded*links[i]);
+  }
+  TestFixture::expectPosesNear(folded, chain.getEndEffectorTransform(), 1e-4);
+
+  // updating the root invalidates everything
+  links[0] = TestFixture::getRandomPose();
+  chain.setLinkTransform(0, links[0]);
+  folded = Pose();
+  for (std::size_t i = 0; i < numberOfLinks; i++) {
+    folded = Pose(folded*links[i]);
+  }
+  TestFixture::expectPosesNear(folded, chain.getEndEffectorTransform(), 1e-4);
+
+  chain.clear();
+  EXPECT_EQ(0u, chain.getNumberOfLinks());
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/poses/Pose.hpp"
+#include "kindr/poses/PoseExpression.hpp"
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
+
+namespace pose = kindr;
+
+TEST(PoseExpressionTest, testTransformMatchesEagerComposition) {
+  pose::HomTransformQuatD poseA(pose::Position3D(1.0, 2.0, 3.0), pose::RotationQuaternionD(pose::EulerAnglesZyxPD(0.3, -0.2, 0.5)));
+  pose::HomTransformQuatD poseB(pose::Position3D(-2.0, 0.5, 1.0), pose::RotationQuaternionD(pose::EulerAnglesZyxPD(-1.1, 0.4, 0.2)));
+  pose::HomTransformQuatD poseC(pose::Position3D(0.1, -0.7, 2.5), pose::RotationQuaternionD(pose::EulerAnglesZyxPD(0.9, 1.2, -0.4)));
+  const pose::Position3D position(0.3, -1.5, 0.6);
+
+  const pose::Position3D expected = (poseA*poseB*poseC).transform(position);
+  const pose::Position3D fused = (pose::lazy(poseA)*poseB*poseC).transform(position);
+  for (int i = 0; i < 3; i++) {
+    EXPECT_NEAR(expected(i), fused(i), 1e-10);
+  }
+}
+
+TEST(PoseExpressionTest, testEvaluationIntoPose) {
+  pose::HomTransformQuatD poseA(pose::Position3D(1.0, 2.0, 3.0), pose::RotationQuaternionD(pose::EulerAnglesZyxPD(0.3, -0.2, 0.5)));
+  pose::HomTransformQuatD poseB(pose::Position3D(-2.0, 0.5, 1.0), pose::RotationQuaternionD(pose::EulerAnglesZyxPD(-1.1, 0.4, 0.2)));
+
+  const pose::HomTransformQuatD expected = poseA*poseB;
+  const pose::HomTransformQuatD evaluated = pose::lazy(poseA)*poseB;
+  EXPECT_TRUE(expected.getRotation().isNear(evaluated.getRotation(), 1e-10));
+  for (int i = 0; i < 3; i++) {
+    EXPECT_NEAR(expected.getPosition()(i), evaluated.getPosition()(i), 1e-10);
+  }
+}
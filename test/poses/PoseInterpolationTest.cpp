@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/poses/PoseInterpolation.hpp"
+
+namespace pose = kindr;
+
+template <typename PrimType_>
+struct PoseInterpolationTest : public ::testing::Test {
+  typedef PrimType_ Scalar;
+  typedef pose::HomogeneousTransformationPosition3RotationQuaternion<Scalar> Pose;
+  typedef typename Pose::Position Position;
+  typedef typename Pose::Rotation Rotation;
+};
+
+typedef ::testing::Types<double, float> PrimTypes;
+TYPED_TEST_CASE(PoseInterpolationTest, PrimTypes);
+
+TYPED_TEST(PoseInterpolationTest, testSlerp) {
+  typedef typename TestFixture::Rotation Rotation;
+  typedef typename TestFixture::Scalar Scalar;
+
+  const Rotation start; // identity
+  const Rotation end(kindr::EulerAnglesZyx<Scalar>(M_PI/2.0, 0.0, 0.0));
+
+  // endpoints are reproduced
+  EXPECT_TRUE(start.isNear(start.slerp(end, Scalar(0.0)), 1e-5));
+  EXPECT_TRUE(end.isNear(start.slerp(end, Scalar(1.0)), 1e-5));
+
+  // midpoint lies on the geodesic
+  const Rotation expected(kindr::EulerAnglesZyx<Scalar>(M_PI/4.0, 0.0, 0.0));
+  EXPECT_TRUE(expected.isNear(start.slerp(end, Scalar(0.5)), 1e-5));
+
+  // slerp between random rotations agrees with the box operations
+  Rotation randomStart, randomEnd;
+  randomStart.setRandom();
+  randomEnd.setRandom();
+  const Scalar alpha(0.3);
+  const Eigen::Matrix<Scalar, 3, 1> scaledDifference = alpha*randomEnd.boxMinus(randomStart);
+  const Rotation viaBox = randomStart.boxPlus(scaledDifference);
+  EXPECT_TRUE(viaBox.isNear(randomStart.slerp(randomEnd, alpha), 1e-5));
+}
+
+TYPED_TEST(PoseInterpolationTest, testInterpolateLinear) {
+  typedef typename TestFixture::Pose Pose;
+  typedef typename TestFixture::Position Position;
+  typedef typename TestFixture::Rotation Rotation;
+  typedef typename TestFixture::Scalar Scalar;
+
+  const Pose start(Position(1.0, 2.0, 3.0), Rotation());
+  const Pose end(Position(3.0, -2.0, 5.0), Rotation(kindr::EulerAnglesZyx<Scalar>(M_PI/2.0, 0.0, 0.0)));
+
+  const Pose middle = pose::interpolateLinear(start, end, Scalar(0.5));
+  EXPECT_NEAR(2.0, middle.getPosition()(0), 1e-5);
+  EXPECT_NEAR(0.0, middle.getPosition()(1), 1e-5);
+  EXPECT_NEAR(4.0, middle.getPosition()(2), 1e-5);
+  const Rotation expectedRotation(kindr::EulerAnglesZyx<Scalar>(M_PI/4.0, 0.0, 0.0));
+  EXPECT_TRUE(expectedRotation.isNear(middle.getRotation(), 1e-5));
+}
+
+TYPED_TEST(PoseInterpolationTest, testPoseInterpolatorMatchesInterpolateLinear) {
+  typedef typename TestFixture::Pose Pose;
+  typedef typename TestFixture::Position Position;
+  typedef typename TestFixture::Rotation Rotation;
+  typedef typename TestFixture::Scalar Scalar;
+
+  Rotation startRotation, endRotation;
+  startRotation.setRandom();
+  endRotation.setRandom();
+  const Pose start(Position(0.5, -1.0, 2.0), startRotation);
+  const Pose end(Position(-2.5, 4.0, 0.0), endRotation);
+
+  const pose::PoseInterpolator<Pose> interpolator(start, end);
+  for (int i = 0; i <= 10; i++) {
+    const Scalar alpha = Scalar(0.1)*Scalar(i);
+    const Pose expected = pose::interpolateLinear(start, end, alpha);
+    const Pose actual = interpolator.evaluate(alpha);
+    for (int k = 0; k < 3; k++) {
+      EXPECT_NEAR(expected.getPosition()(k), actual.getPosition()(k), 1e-4);
+    }
+    EXPECT_TRUE(expected.getRotation().isNear(actual.getRotation(), 1e-4));
+  }
+}
+
+TYPED_TEST(PoseInterpolationTest, testRotationInterpolator) {
+  typedef typename TestFixture::Rotation Rotation;
+  typedef typename TestFixture::Scalar Scalar;
+
+  Rotation start, end;
+  start.setRandom();
+  end.setRandom();
+  const pose::RotationInterpolator<Rotation> interpolator(start, end);
+  EXPECT_TRUE(start.isNear(interpolator.evaluate(Scalar(0.0)), 1e-5));
+  EXPECT_TRUE(end.isNear(interpolator.evaluate(Scalar(1.0)), 1e-5));
+  EXPECT_TRUE(start.slerp(end, Scalar(0.25)).isNear(interpolator.evaluate(Scalar(0.25)), 1e-5));
+}
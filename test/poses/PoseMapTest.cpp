@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/poses/Pose.hpp"
+
+namespace pose = kindr;
+
+typedef pose::HomogeneousTransformationPosition3RotationQuaternionD PoseD;
+typedef pose::HomogeneousTransformationPosition3RotationQuaternionF PoseF;
+
+TEST(PoseMapTest, testExponentialMapOfZeroIsIdentity) {
+  const PoseD transform = PoseD::exponentialMap(Eigen::Matrix<double, 6, 1>::Zero());
+  EXPECT_NEAR(0.0, transform.getPosition().toImplementation().norm(), 1e-15);
+  EXPECT_TRUE(transform.getRotation().isNear(pose::RotationQuaternionD(), 1e-15));
+}
+
+TEST(PoseMapTest, testPureTranslation) {
+  // zero rotation: V is the identity and the twist translation passes through
+  Eigen::Matrix<double, 6, 1> vector;
+  vector << 1.0, -2.0, 0.5, 0.0, 0.0, 0.0;
+  const PoseD transform = PoseD::exponentialMap(vector);
+  EXPECT_NEAR(1.0, transform.getPosition().x(), 1e-15);
+  EXPECT_NEAR(-2.0, transform.getPosition().y(), 1e-15);
+  EXPECT_NEAR(0.5, transform.getPosition().z(), 1e-15);
+  EXPECT_TRUE(transform.getRotation().isNear(pose::RotationQuaternionD(), 1e-15));
+}
+
+TEST(PoseMapTest, testRotationMatchesSo3Map) {
+  Eigen::Matrix<double, 6, 1> vector;
+  vector << 0.3, -0.1, 0.8, 0.4, -0.7, 1.1;
+  const PoseD transform = PoseD::exponentialMap(vector);
+  pose::RotationQuaternionD so3;
+  so3 = so3.exponentialMap(Eigen::Vector3d(vector.tail<3>()));
+  EXPECT_TRUE(transform.getRotation().isNear(so3, 1e-12));
+}
+
+TEST(PoseMapTest, testLogExpRoundTrip) {
+  for (int k = 0; k < 20; k++) {
+    Eigen::Matrix<double, 6, 1> vector;
+    vector << 0.3*k, -0.1*k, 0.05*k, 0.2*std::sin(0.7*k), 0.15*std::cos(1.3*k), 0.1*k - 1.0;
+    if (vector.tail<3>().norm() > M_PI) {
+      continue;  // log only recovers rotation vectors inside the principal branch
+    }
+    const PoseD transform = PoseD::exponentialMap(vector);
+    const Eigen::Matrix<double, 6, 1> logarithm = transform.logarithmicMap();
+    for (int i = 0; i < 6; i++) {
+      EXPECT_NEAR(vector(i), logarithm(i), 1e-10) << "sample " << k << " component " << i;
+    }
+  }
+}
+
+TEST(PoseMapTest, testExpLogRoundTripOnPoses) {
+  const PoseD transform(pose::Position3D(1.0, -2.0, 0.5),
+                        pose::RotationQuaternionD(pose::EulerAnglesZyxD(0.4, -0.7, 1.1)));
+  const PoseD roundTrip = PoseD::exponentialMap(transform.logarithmicMap());
+  EXPECT_NEAR(0.0, (transform.getPosition().toImplementation()
+                    - roundTrip.getPosition().toImplementation()).norm(), 1e-12);
+  EXPECT_TRUE(transform.getRotation().isNear(roundTrip.getRotation(), 1e-12));
+}
+
+TEST(PoseMapTest, testSmallAngleBranch) {
+  // angles straddling the series threshold must stay continuous
+  for (double angle : {0.0, 1e-12, 1e-8, 1e-6, 1e-4}) {
+    Eigen::Matrix<double, 6, 1> vector;
+    vector << 0.5, -0.2, 0.1, angle, 0.0, 0.0;
+    const PoseD transform = PoseD::exponentialMap(vector);
+    const Eigen::Matrix<double, 6, 1> logarithm = transform.logarithmicMap();
+    for (int i = 0; i < 6; i++) {
+      EXPECT_NEAR(vector(i), logarithm(i), 1e-12) << "angle = " << angle;
+    }
+  }
+}
+
+TEST(PoseMapTest, testScalingConsistency) {
+  // exp(2v) == exp(v)*exp(v) along a fixed twist direction
+  Eigen::Matrix<double, 6, 1> vector;
+  vector << 0.2, -0.3, 0.15, 0.3, 0.1, -0.25;
+  const PoseD once = PoseD::exponentialMap(vector);
+  const PoseD twice = PoseD::exponentialMap(Eigen::Matrix<double, 6, 1>(2.0*vector));
+  const PoseD composed = once*once;
+  EXPECT_NEAR(0.0, (twice.getPosition().toImplementation()
+                    - composed.getPosition().toImplementation()).norm(), 1e-12);
+  EXPECT_TRUE(twice.getRotation().isNear(composed.getRotation(), 1e-12));
+}
+
+TEST(PoseMapTest, testFloatTypes) {
+  Eigen::Matrix<float, 6, 1> vector;
+  vector << 0.3f, -0.1f, 0.8f, 0.4f, -0.7f, 1.1f;
+  const PoseF transform = PoseF::exponentialMap(vector);
+  const Eigen::Matrix<float, 6, 1> logarithm = transform.logarithmicMap();
+  for (int i = 0; i < 6; i++) {
+    EXPECT_NEAR(vector(i), logarithm(i), 1e-5f);
+  }
+}
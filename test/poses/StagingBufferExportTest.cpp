@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "kindr/poses/StagingBufferExport.hpp"
+
+namespace pose = kindr;
+
+namespace {
+
+typedef kindr::HomogeneousTransformationPosition3RotationQuaternionD Pose;
+
+kindr::aligned_vector<Pose> makePoses(std::size_t size) {
+  kindr::aligned_vector<Pose> poses;
+  for (std::size_t i = 0; i < size; i++) {
+    Pose::Rotation rotation;
+    rotation.setRandom();
+    poses.push_back(Pose(Pose::Position(0.5*i, -0.25*i, 2.0), rotation));
+  }
+  return poses;
+}
+
+} // namespace
+
+TEST(StagingBufferExportTest, testColumnMajorMatchesTransformationMatrix) {
+  const auto poses = makePoses(40u);
+  std::vector<float> buffer(poses.size()*16u);
+  kindr::exportTransformationMatrices(poses, buffer.data(), kindr::MatrixExportLayout::ColumnMajor4x4);
+  for (std::size_t i = 0; i < poses.size(); i++) {
+    const Eigen::Matrix4d expected = poses[i].getTransformationMatrix();
+    for (int row = 0; row < 4; row++) {
+      for (int col = 0; col < 4; col++) {
+        EXPECT_NEAR(static_cast<float>(expected(row, col)), buffer[i*16u + col*4u + row], 1e-6f);
+      }
+    }
+  }
+}
+
+TEST(StagingBufferExportTest, testRowMajorMatchesTransformationMatrix) {
+  const auto poses = makePoses(25u);
+  std::vector<float> buffer(poses.size()*16u);
+  kindr::exportTransformationMatrices(poses, buffer.data(), kindr::MatrixExportLayout::RowMajor4x4);
+  for (std::size_t i = 0; i < poses.size(); i++) {
+    const Eigen::Matrix4d expected = poses[i].getTransformationMatrix();
+    for (int row = 0; row < 4; row++) {
+      for (int col = 0; col < 4; col++) {
+        EXPECT_NEAR(static_cast<float>(expected(row, col)), buffer[i*16u + row*4u + col], 1e-6f);
+      }
+    }
+  }
+}
+
+TEST(StagingBufferExportTest, testRowMajor3x4DropsBottomRow) {
+  const auto poses = makePoses(10u);
+  ASSERT_EQ(12u, kindr::getMatrixExportSize(kindr::MatrixExportLayout::RowMajor3x4));
+  std::vector<float> buffer(poses.size()*12u);
+  kindr::exportTransformationMatrices(poses, buffer.data(), kindr::MatrixExportLayout::RowMajor3x4);
+  for (std::size_t i = 0; i < poses.size(); i++) {
+    const Eigen::Matrix4d expected = poses[i].getTransformationMatrix();
+    for (int row = 0; row < 3; row++) {
+      for (int col = 0; col < 4; col++) {
+        EXPECT_NEAR(static_cast<float>(expected(row, col)), buffer[i*12u + row*4u + col], 1e-6f);
+      }
+    }
+  }
+}
+
+TEST(StagingBufferExportTest, testStridePadding) {
+  const auto poses = makePoses(8u);
+  const std::size_t stride = 20u; // e.g. 256-bit aligned rows in the staging buffer
+  std::vector<float> buffer(poses.size()*stride, -7.0f);
+  kindr::exportTransformationMatrices(poses, buffer.data(), kindr::MatrixExportLayout::ColumnMajor4x4, stride);
+  for (std::size_t i = 0; i < poses.size(); i++) {
+    EXPECT_NEAR(static_cast<float>(poses[i].getPosition().x()), buffer[i*stride + 12u], 1e-6f);
+    // the padding between matrices is untouched
+    for (std::size_t k = 16u; k < stride; k++) {
+      EXPECT_EQ(-7.0f, buffer[i*stride + k]);
+    }
+  }
+}
+
+TEST(StagingBufferExportTest, testDoubleOutput) {
+  const auto poses = makePoses(15u);
+  std::vector<double> buffer(poses.size()*16u);
+  kindr::exportTransformationMatrices(poses.data(), poses.size(), buffer.data(), kindr::MatrixExportLayout::RowMajor4x4);
+  for (std::size_t i = 0; i < poses.size(); i++) {
+    const Eigen::Matrix4d expected = poses[i].getTransformationMatrix();
+    for (int row = 0; row < 4; row++) {
+      for (int col = 0; col < 4; col++) {
+        EXPECT_NEAR(expected(row, col), buffer[i*16u + row*4u + col], 1e-14);
+      }
+    }
+  }
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/poses/StaticTransform.hpp"
+
+namespace pose = kindr;
+
+// sqrt(0.5): quarter turn about z
+static constexpr double kHalfSqrt2 = 0.70710678118654752440;
+
+TEST(StaticTransformTest, testConstexprComposition) {
+  // two quarter turns about z fold into a half turn at compile time
+  constexpr pose::StaticRotationD quarterTurn(kHalfSqrt2, 0.0, 0.0, kHalfSqrt2);
+  constexpr pose::StaticRotationD halfTurn = quarterTurn*quarterTurn;
+  static_assert(halfTurn.z > 0.999999 && halfTurn.z < 1.000001, "composition must fold to a half turn");
+  static_assert(halfTurn.w < 1e-12 && halfTurn.w > -1e-12, "composition must fold to a half turn");
+
+  // q * q^-1 folds to identity
+  constexpr pose::StaticRotationD identity = quarterTurn*quarterTurn.inverted();
+  static_assert(identity.w > 0.999999, "inverse composition must fold to identity");
+
+  // rotating a point at compile time
+  constexpr pose::StaticVectorD rotated = quarterTurn.rotate(pose::StaticVectorD(1.0, 0.0, 0.0));
+  static_assert(rotated.y > 0.999999 && rotated.y < 1.000001, "quarter turn must map x to y");
+  static_assert(rotated.x < 1e-9 && rotated.x > -1e-9, "quarter turn must map x to y");
+}
+
+TEST(StaticTransformTest, testConstexprTransformChain) {
+  constexpr pose::StaticTransformD cameraToImu(pose::StaticVectorD(0.1, -0.02, 0.05),
+                                               pose::StaticRotationD(kHalfSqrt2, 0.0, 0.0, kHalfSqrt2));
+  constexpr pose::StaticTransformD imuToBody(pose::StaticVectorD(0.0, 0.3, -0.1),
+                                             pose::StaticRotationD(kHalfSqrt2, kHalfSqrt2, 0.0, 0.0));
+  constexpr pose::StaticTransformD cameraToBody = imuToBody*cameraToImu;
+  constexpr pose::StaticTransformD roundTrip = cameraToBody*cameraToBody.inverted();
+  static_assert(roundTrip.position.x < 1e-12 && roundTrip.position.x > -1e-12, "T*T^-1 must fold to identity");
+  static_assert(roundTrip.rotation.w > 0.999999, "T*T^-1 must fold to identity");
+
+  // the folded chain matches the runtime composition of the kindr poses
+  const kindr::HomogeneousTransformationPosition3RotationQuaternionD runtimeChain =
+      imuToBody.toPose()*cameraToImu.toPose();
+  const kindr::HomogeneousTransformationPosition3RotationQuaternionD foldedChain = cameraToBody.toPose();
+  for (int k = 0; k < 3; k++) {
+    EXPECT_NEAR(runtimeChain.getPosition()(k), foldedChain.getPosition()(k), 1e-12);
+  }
+  EXPECT_TRUE(runtimeChain.getRotation().isNear(foldedChain.getRotation(), 1e-12));
+}
+
+TEST(StaticTransformTest, testMatchesKindrTransform) {
+  constexpr pose::StaticTransformD transform(pose::StaticVectorD(1.0, 2.0, 3.0),
+                                             pose::StaticRotationD(kHalfSqrt2, 0.0, kHalfSqrt2, 0.0));
+  constexpr pose::StaticVectorD transformed = transform.transform(pose::StaticVectorD(0.5, -1.0, 2.0));
+
+  const kindr::Position3D expected = transform.toPose().transform(kindr::Position3D(0.5, -1.0, 2.0));
+  EXPECT_NEAR(expected(0), transformed.x, 1e-12);
+  EXPECT_NEAR(expected(1), transformed.y, 1e-12);
+  EXPECT_NEAR(expected(2), transformed.z, 1e-12);
+}
+
+TEST(StaticTransformTest, testFloatTypes) {
+  constexpr pose::StaticRotationF rotation(1.0f, 0.0f, 0.0f, 0.0f);
+  constexpr pose::StaticTransformF transform(pose::StaticVectorF(1.0f, 0.0f, 0.0f), rotation);
+  constexpr pose::StaticVectorF shifted = transform.transform(pose::StaticVectorF(0.0f, 1.0f, 0.0f));
+  static_assert(shifted.x > 0.999999f, "identity rotation must only translate");
+  EXPECT_NEAR(1.0f, shifted.y, 1e-6f);
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "kindr/poses/TimedPoseBuffer.hpp"
+
+namespace pose = kindr;
+
+TEST(TimedPoseBufferTest, testEmptyAndSize) {
+  pose::TimedPoseBufferD buffer(8);
+  EXPECT_EQ(8u, buffer.getCapacity());
+  EXPECT_EQ(0u, buffer.getSize());
+
+  pose::TimedPoseBufferD::Pose result;
+  EXPECT_FALSE(buffer.getPoseAtTime(1.0, result));
+
+  buffer.addPose(0.0, pose::TimedPoseBufferD::Pose());
+  EXPECT_EQ(1u, buffer.getSize());
+  EXPECT_TRUE(buffer.getPoseAtTime(1.0, result));
+}
+
+TEST(TimedPoseBufferTest, testInterpolatedLookup) {
+  typedef pose::TimedPoseBufferD::Pose Pose;
+  typedef Pose::Position Position;
+  typedef Pose::Rotation Rotation;
+
+  pose::TimedPoseBufferD buffer(16);
+  for (int i = 0; i <= 10; i++) {
+    buffer.addPose(0.1*i, Pose(Position(1.0*i, -2.0*i, 0.5*i), Rotation()));
+  }
+
+  Pose result;
+  // exact sample
+  ASSERT_TRUE(buffer.getPoseAtTime(0.5, result));
+  EXPECT_NEAR(5.0, result.getPosition()(0), 1e-9);
+
+  // midpoint between two samples
+  ASSERT_TRUE(buffer.getPoseAtTime(0.45, result));
+  EXPECT_NEAR(4.5, result.getPosition()(0), 1e-9);
+  EXPECT_NEAR(-9.0, result.getPosition()(1), 1e-9);
+
+  // clamped below and above the stored range
+  ASSERT_TRUE(buffer.getPoseAtTime(-1.0, result));
+  EXPECT_NEAR(0.0, result.getPosition()(0), 1e-9);
+  ASSERT_TRUE(buffer.getPoseAtTime(100.0, result));
+  EXPECT_NEAR(10.0, result.getPosition()(0), 1e-9);
+}
+
+TEST(TimedPoseBufferTest, testRotationInterpolation) {
+  typedef pose::TimedPoseBufferD::Pose Pose;
+  typedef Pose::Position Position;
+  typedef Pose::Rotation Rotation;
+
+  pose::TimedPoseBufferD buffer(4);
+  const Rotation first; // identity
+  const Rotation second(kindr::EulerAnglesZyxD(M_PI/2.0, 0.0, 0.0)); // quarter turn about z
+  buffer.addPose(0.0, Pose(Position(), first));
+  buffer.addPose(1.0, Pose(Position(), second));
+
+  Pose result;
+  ASSERT_TRUE(buffer.getPoseAtTime(0.5, result));
+  const Rotation expected(kindr::EulerAnglesZyxD(M_PI/4.0, 0.0, 0.0));
+  EXPECT_TRUE(expected.isNear(result.getRotation(), 1e-6));
+}
+
+TEST(TimedPoseBufferTest, testOverwriteKeepsNewestEntries) {
+  typedef pose::TimedPoseBufferD::Pose Pose;
+  typedef Pose::Position Position;
+  typedef Pose::Rotation Rotation;
+
+  pose::TimedPoseBufferD buffer(4);
+  for (int i = 0; i < 10; i++) {
+    buffer.addPose(1.0*i, Pose(Position(1.0*i, 0.0, 0.0), Rotation()));
+  }
+  EXPECT_EQ(4u, buffer.getSize());
+
+  Pose result;
+  // times older than the ring now clamp to the oldest surviving entry (t = 6)
+  ASSERT_TRUE(buffer.getPoseAtTime(0.0, result));
+  EXPECT_NEAR(6.0, result.getPosition()(0), 1e-9);
+  ASSERT_TRUE(buffer.getPoseAtTime(7.5, result));
+  EXPECT_NEAR(7.5, result.getPosition()(0), 1e-9);
+}
+
+TEST(TimedPoseBufferTest, testConcurrentReadersSeeConsistentEntries) {
+  typedef pose::TimedPoseBufferD::Pose Pose;
+  typedef Pose::Position Position;
+  typedef Pose::Rotation Rotation;
+
+  pose::TimedPoseBufferD buffer(64);
+  std::atomic<bool> done(false);
+  std::atomic<int> failures(0);
+
+  // the writer keeps position.x == timestamp, so any torn read shows up as a mismatch
+  std::thread writer([&]() {
+    for (int i = 0; i < 20000; i++) {
+      buffer.addPose(1.0*i, Pose(Position(1.0*i, 0.0, 0.0), Rotation()));
+    }
+    done.store(true);
+  });
+
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 4; r++) {
+    readers.emplace_back([&]() {
+      Pose result;
+      double queryTime = 0.0;
+      while (!done.load()) {
+        if (buffer.getPoseAtTime(queryTime, result)) {
+          // interpolation of collinear samples must stay on the line x == t within the window
+          const double positionX = result.getPosition()(0);
+          if (positionX != static_cast<int64_t>(positionX) && std::abs(positionX - queryTime) > 1e-9) {
+            failures++;
+          }
+        }
+        queryTime += 0.37;
+      }
+    });
+  }
+
+  writer.join();
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(0, failures.load());
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/poses/TransformEngine.hpp"
+
+namespace pose = kindr;
+
+static Eigen::Matrix3Xd makePoints(int count) {
+  Eigen::Matrix3Xd points(3, count);
+  for (int k = 0; k < count; k++) {
+    points.col(k) = Eigen::Vector3d(0.01*k, -0.02*k + 1.0, 0.005*k - 2.0);
+  }
+  return points;
+}
+
+TEST(TransformEngineTest, testRotateMatchesRotationBase) {
+  const pose::RotationQuaternionD rotation(pose::EulerAnglesZyxD(0.4, -0.7, 1.1));
+  // more points than one block to exercise the multithreaded path
+  const Eigen::Matrix3Xd points = makePoints(10000);
+  const Eigen::Matrix3Xd expected = rotation.rotate(points);
+
+  pose::TransformEngineD engine(4, 1024);
+  Eigen::Matrix3Xd rotated;
+  engine.rotate(rotation, points, rotated);
+  ASSERT_EQ(points.cols(), rotated.cols());
+  EXPECT_NEAR(0.0, (expected - rotated).lpNorm<Eigen::Infinity>(), 1e-12);
+}
+
+TEST(TransformEngineTest, testRotateInPlace) {
+  const pose::AngleAxisD rotation(1.3, Eigen::Vector3d(0.0, 0.0, 1.0));
+  Eigen::Matrix3Xd points = makePoints(5000);
+  const Eigen::Matrix3Xd expected = rotation.rotate(points);
+
+  pose::TransformEngineD engine(2, 512);
+  engine.rotateInPlace(rotation, points);
+  EXPECT_NEAR(0.0, (expected - points).lpNorm<Eigen::Infinity>(), 1e-12);
+}
+
+TEST(TransformEngineTest, testTransformMatchesPose) {
+  pose::HomogeneousTransformationPosition3RotationQuaternionD transform(
+      pose::Position3D(1.0, -2.0, 0.5),
+      pose::RotationQuaternionD(pose::EulerAnglesZyxD(-0.3, 0.9, 0.2)));
+  const Eigen::Matrix3Xd points = makePoints(8000);
+
+  pose::TransformEngineD engine(3, 1000);
+  Eigen::Matrix3Xd transformed;
+  engine.transform(transform, points, transformed);
+
+  for (int k = 0; k < points.cols(); k += 997) {
+    const pose::Position3D expected = transform.transform(pose::Position3D(points.col(k)));
+    for (int i = 0; i < 3; i++) {
+      EXPECT_NEAR(expected(i), transformed(i, k), 1e-12) << "point " << k;
+    }
+  }
+}
+
+TEST(TransformEngineTest, testTransformInPlace) {
+  pose::HomogeneousTransformationPosition3RotationQuaternionD transform(
+      pose::Position3D(0.1, 0.2, -0.3),
+      pose::RotationQuaternionD(pose::EulerAnglesZyxD(2.0, -0.5, 0.8)));
+  Eigen::Matrix3Xd points = makePoints(3000);
+  Eigen::Matrix3Xd expected;
+
+  pose::TransformEngineD engine(4, 256);
+  engine.transform(transform, points, expected);
+  engine.transformInPlace(transform, points);
+  EXPECT_NEAR(0.0, (expected - points).lpNorm<Eigen::Infinity>(), 1e-12);
+}
+
+TEST(TransformEngineTest, testSmallBatchAndEdgeSizes) {
+  const pose::RotationQuaternionD rotation(pose::EulerAnglesZyxD(0.4, -0.7, 1.1));
+  pose::TransformEngineD engine(4, 128);
+  // empty batch, single point, exactly one block, one block plus one point
+  for (int count : {0, 1, 128, 129}) {
+    const Eigen::Matrix3Xd points = makePoints(count);
+    Eigen::Matrix3Xd rotated;
+    engine.rotate(rotation, points, rotated);
+    ASSERT_EQ(count, rotated.cols());
+    if (count > 0) {
+      EXPECT_NEAR(0.0, (rotation.rotate(points) - rotated).lpNorm<Eigen::Infinity>(), 1e-12);
+    }
+  }
+}
+
+TEST(TransformEngineTest, testDefaultThreadCount) {
+  pose::TransformEngineD engine;
+  EXPECT_GE(engine.getNumThreads(), 1u);
+  EXPECT_EQ(4096u, engine.getBlockSize());
+}
+
+TEST(TransformEngineTest, testFloatTypes) {
+  const pose::RotationQuaternionF rotation(pose::EulerAnglesZyxF(0.4f, -0.7f, 1.1f));
+  Eigen::Matrix3Xf points(3, 1000);
+  points.setRandom();
+  const Eigen::Matrix3Xf expected = rotation.rotate(points);
+
+  pose::TransformEngineF engine(2, 100);
+  Eigen::Matrix3Xf rotated;
+  engine.rotate(rotation, points, rotated);
+  EXPECT_NEAR(0.f, (expected - rotated).lpNorm<Eigen::Infinity>(), 1e-6f);
+}
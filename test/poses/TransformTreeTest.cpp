@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <atomic>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "kindr/poses/TransformTree.hpp"
+
+namespace pose = kindr;
+
+typedef kindr::TransformTreeD::Pose Pose;
+
+static Pose samplePose(double seed) {
+  return Pose(Pose::Position(0.3*seed, -1.2 + 0.1*seed, 2.5*seed),
+              Pose::Rotation(kindr::EulerAnglesZyxD(0.4*seed, -0.2*seed, 0.1 + 0.3*seed)));
+}
+
+TEST(TransformTreeTest, testLookupMatchesManualComposition) {
+  kindr::TransformTreeD tree;
+  const auto world = tree.addFrame("world");
+  const auto base = tree.addFrame("base", world, samplePose(1.0));
+  const auto cam = tree.addFrame("cam", base, samplePose(2.0));
+  const auto lidar = tree.addFrame("lidar", base, samplePose(3.0));
+  EXPECT_EQ(4u, tree.getNumFrames());
+  EXPECT_EQ(cam, tree.getFrameId("cam"));
+
+  const Pose poseWorldCam = samplePose(1.0)*samplePose(2.0);
+  const Eigen::Vector3d pointInCam(0.3, -1.2, 2.5);
+
+  // cam -> world
+  const Pose lookup = tree.getTransform(cam, world);
+  EXPECT_NEAR(0.0, (lookup.transform(Pose::Position(pointInCam)).toImplementation()
+                    - poseWorldCam.transform(Pose::Position(pointInCam)).toImplementation()).norm(), 1e-12);
+
+  // cam -> lidar through the common parent
+  const Pose poseWorldLidar = samplePose(1.0)*samplePose(3.0);
+  const Pose camToLidar = tree.getTransform(cam, lidar);
+  const Pose::Position expected = poseWorldLidar.inverseTransform(poseWorldCam.transform(Pose::Position(pointInCam)));
+  EXPECT_NEAR(0.0, (camToLidar.transform(Pose::Position(pointInCam)).toImplementation() - expected.toImplementation()).norm(), 1e-12);
+}
+
+TEST(TransformTreeTest, testIdentityAndInverseLookups) {
+  kindr::TransformTreeD tree;
+  const auto world = tree.addFrame("world");
+  const auto base = tree.addFrame("base", world, samplePose(1.5));
+  const Pose identity = tree.getTransform(base, base);
+  EXPECT_NEAR(0.0, identity.getPosition().toImplementation().norm(), 1e-12);
+  EXPECT_TRUE(identity.getRotation().isNear(Pose::Rotation(), 1e-12));
+
+  const Pose forward = tree.getTransform(base, world);
+  const Pose backward = tree.getTransform(world, base);
+  const Pose::Position point(0.3, -1.2, 2.5);
+  EXPECT_NEAR(0.0, (backward.transform(forward.transform(point)).toImplementation() - point.toImplementation()).norm(), 1e-12);
+}
+
+TEST(TransformTreeTest, testSnapshotCachingAndEpoch) {
+  kindr::TransformTreeD tree;
+  const auto world = tree.addFrame("world");
+  const auto base = tree.addFrame("base", world, samplePose(1.0));
+  const auto cam = tree.addFrame("cam", base, samplePose(2.0));
+
+  const kindr::TransformTreeD::Snapshot snapshot = tree.snapshot();
+  EXPECT_TRUE(snapshot.isCurrent());
+  const Pose before = snapshot.getTransform(cam, world);
+
+  tree.setEdge(base, samplePose(4.0));
+  EXPECT_FALSE(snapshot.isCurrent());
+
+  // the old snapshot keeps returning the state it was taken at
+  const Pose again = snapshot.getTransform(cam, world);
+  EXPECT_NEAR(0.0, (again.getPosition().toImplementation() - before.getPosition().toImplementation()).norm(), 1e-12);
+
+  // a fresh lookup sees the new edge
+  const Pose updated = tree.getTransform(cam, world);
+  const Pose expected = samplePose(4.0)*samplePose(2.0);
+  EXPECT_NEAR(0.0, (updated.getPosition().toImplementation() - expected.getPosition().toImplementation()).norm(), 1e-12);
+}
+
+TEST(TransformTreeTest, testConcurrentReadersSeeConsistentEdges) {
+  kindr::TransformTreeD tree;
+  const auto world = tree.addFrame("world");
+  // writer keeps x and y of the edge position equal; a torn read would break that
+  const auto base = tree.addFrame("base", world, Pose(Pose::Position(0.0, 0.0, 0.0), Pose::Rotation()));
+
+  std::atomic<bool> stop(false);
+  std::atomic<int> inconsistent(0);
+  std::thread reader([&]() {
+    while (!stop.load()) {
+      const Pose pose = tree.getTransform(base, world);
+      if (pose.getPosition().x() != pose.getPosition().y()) {
+        inconsistent++;
+      }
+    }
+  });
+  for (int k = 0; k < 20000; k++) {
+    const double value = 0.001*k;
+    tree.setEdge(base, Pose(Pose::Position(value, value, 0.0), Pose::Rotation()));
+  }
+  stop = true;
+  reader.join();
+  EXPECT_EQ(0, inconsistent.load());
+}
+
+TEST(TransformTreeTest, testSnapshotUnderConcurrentWriter) {
+  kindr::TransformTreeD tree;
+  const auto world = tree.addFrame("world");
+  // writer keeps x and y of the edge position equal; a torn snapshot would break that
+  const auto base = tree.addFrame("base", world, Pose(Pose::Position(0.0, 0.0, 0.0), Pose::Rotation()));
+
+  std::atomic<bool> stop(false);
+  std::thread writer([&]() {
+    double value = 0.0;
+    while (!stop.load()) {
+      value += 0.001;
+      tree.setEdge(base, Pose(Pose::Position(value, value, 0.0), Pose::Rotation()));
+    }
+  });
+  int inconsistent = 0;
+  for (int k = 0; k < 5000; k++) {
+    const kindr::TransformTreeD::Snapshot snapshot = tree.snapshot();
+    const Pose pose = snapshot.getTransform(base, world);
+    if (pose.getPosition().x() != pose.getPosition().y()) {
+      inconsistent++;
+    }
+  }
+  stop = true;
+  writer.join();
+  EXPECT_EQ(0, inconsistent);
+}
+
+TEST(TransformTreeTest, testFloatTypes) {
+  kindr::TransformTreeF tree;
+  const auto world = tree.addFrame("world");
+  const auto base = tree.addFrame("base", world,
+      kindr::TransformTreeF::Pose(kindr::TransformTreeF::Pose::Position(1.0f, 2.0f, 3.0f), kindr::TransformTreeF::Pose::Rotation()));
+  const kindr::TransformTreeF::Pose lookup = tree.getTransform(base, world);
+  EXPECT_NEAR(1.0f, lookup.getPosition().x(), 1e-6f);
+}
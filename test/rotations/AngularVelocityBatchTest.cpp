@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/RotationBatch.hpp"
+#include "kindr/rotations/RotationDiff.hpp"
+
+namespace rot = kindr;
+
+TEST(AngularVelocityBatchTest, testSharedRotationMatchesTraits) {
+  const rot::RotationQuaternionD rotation(rot::AngleAxisD(1.2, Eigen::Vector3d(0.3, -0.8, 0.5).normalized()));
+
+  rot::VectorBatch3D localVelocities;
+  for (int k = 0; k < 30; k++) {
+    localVelocities.append(Eigen::Vector3d(0.1*k, -0.07*k + 0.4, 0.02*k - 0.3));
+  }
+
+  rot::VectorBatch3D globalVelocities;
+  rot::convertToGlobalAngularVelocityBatch(rotation, localVelocities, globalVelocities);
+  ASSERT_EQ(localVelocities.size(), globalVelocities.size());
+
+  for (std::size_t k = 0; k < localVelocities.size(); k++) {
+    // matches the per-element trait conversion
+    const rot::GlobalAngularVelocityD expected(rotation, rot::LocalAngularVelocityD(localVelocities.getVector(k)));
+    EXPECT_NEAR(expected.x(), globalVelocities.getVector(k)(0), 1e-12);
+    EXPECT_NEAR(expected.y(), globalVelocities.getVector(k)(1), 1e-12);
+    EXPECT_NEAR(expected.z(), globalVelocities.getVector(k)(2), 1e-12);
+  }
+}
+
+TEST(AngularVelocityBatchTest, testSharedRotationRoundTrip) {
+  const rot::RotationQuaternionD rotation(rot::AngleAxisD(-0.7, Eigen::Vector3d(0.9, 0.1, -0.4).normalized()));
+
+  rot::VectorBatch3D globalVelocities;
+  for (int k = 0; k < 17; k++) {
+    globalVelocities.append(Eigen::Vector3d(-0.2*k + 0.5, 0.03*k, 0.11*k - 0.6));
+  }
+
+  rot::VectorBatch3D localVelocities;
+  rot::convertToLocalAngularVelocityBatch(rotation, globalVelocities, localVelocities);
+
+  for (std::size_t k = 0; k < globalVelocities.size(); k++) {
+    // matches the per-element trait conversion
+    const rot::LocalAngularVelocityD expected(rotation, rot::GlobalAngularVelocityD(globalVelocities.getVector(k)));
+    EXPECT_NEAR(expected.x(), localVelocities.getVector(k)(0), 1e-12);
+    EXPECT_NEAR(expected.y(), localVelocities.getVector(k)(1), 1e-12);
+    EXPECT_NEAR(expected.z(), localVelocities.getVector(k)(2), 1e-12);
+  }
+
+  // converting back recovers the input
+  rot::VectorBatch3D recovered;
+  rot::convertToGlobalAngularVelocityBatch(rotation, localVelocities, recovered);
+  for (std::size_t k = 0; k < globalVelocities.size(); k++) {
+    EXPECT_NEAR(globalVelocities.getVector(k)(0), recovered.getVector(k)(0), 1e-12);
+    EXPECT_NEAR(globalVelocities.getVector(k)(1), recovered.getVector(k)(1), 1e-12);
+    EXPECT_NEAR(globalVelocities.getVector(k)(2), recovered.getVector(k)(2), 1e-12);
+  }
+}
+
+TEST(AngularVelocityBatchTest, testPerBodyRotationsMatchTraits) {
+  rot::QuaternionBatchD rotations(25);
+  rot::setRandomBatch(rotations);
+
+  rot::VectorBatch3D localVelocities;
+  for (int k = 0; k < 25; k++) {
+    localVelocities.append(Eigen::Vector3d(0.04*k - 0.2, 0.5 - 0.03*k, 0.08*k));
+  }
+
+  rot::VectorBatch3D globalVelocities;
+  rot::convertToGlobalAngularVelocityBatch(rotations, localVelocities, globalVelocities);
+  ASSERT_EQ(localVelocities.size(), globalVelocities.size());
+
+  for (std::size_t k = 0; k < localVelocities.size(); k++) {
+    // each body is converted with its own rotation
+    const rot::GlobalAngularVelocityD expected(rotations.getRotationQuaternion(k),
+                                               rot::LocalAngularVelocityD(localVelocities.getVector(k)));
+    EXPECT_NEAR(expected.x(), globalVelocities.getVector(k)(0), 1e-12);
+    EXPECT_NEAR(expected.y(), globalVelocities.getVector(k)(1), 1e-12);
+    EXPECT_NEAR(expected.z(), globalVelocities.getVector(k)(2), 1e-12);
+  }
+
+  // the per-body inverse conversion recovers the local velocities
+  rot::VectorBatch3D recovered;
+  rot::convertToLocalAngularVelocityBatch(rotations, globalVelocities, recovered);
+  for (std::size_t k = 0; k < localVelocities.size(); k++) {
+    EXPECT_NEAR(localVelocities.getVector(k)(0), recovered.getVector(k)(0), 1e-12);
+    EXPECT_NEAR(localVelocities.getVector(k)(1), recovered.getVector(k)(1), 1e-12);
+    EXPECT_NEAR(localVelocities.getVector(k)(2), recovered.getVector(k)(2), 1e-12);
+  }
+}
+
+TEST(AngularVelocityBatchTest, testNonQuaternionRotationTypes) {
+  // the shared-rotation API accepts any rotation parameterization
+  const rot::EulerAnglesZyxD eulerAngles(0.4, -0.2, 1.0);
+
+  rot::VectorBatch3D localVelocities;
+  localVelocities.append(Eigen::Vector3d(0.3, -0.6, 0.9));
+  localVelocities.append(Eigen::Vector3d(-0.1, 0.8, 0.2));
+
+  rot::VectorBatch3D globalVelocities;
+  rot::convertToGlobalAngularVelocityBatch(eulerAngles, localVelocities, globalVelocities);
+
+  for (std::size_t k = 0; k < localVelocities.size(); k++) {
+    const Eigen::Vector3d expected = eulerAngles.rotate(Eigen::Vector3d(localVelocities.getVector(k)));
+    EXPECT_NEAR(expected(0), globalVelocities.getVector(k)(0), 1e-12);
+    EXPECT_NEAR(expected(1), globalVelocities.getVector(k)(1), 1e-12);
+    EXPECT_NEAR(expected(2), globalVelocities.getVector(k)(2), 1e-12);
+  }
+}
+
+TEST(AngularVelocityBatchTest, testFloatTypes) {
+  const rot::RotationQuaternionF rotation(rot::AngleAxisF(0.6f, Eigen::Vector3f(0.0f, 0.0f, 1.0f)));
+
+  rot::VectorBatch3F localVelocities;
+  for (int k = 0; k < 9; k++) {
+    localVelocities.append(Eigen::Vector3f(0.1f*k, -0.2f*k, 0.3f));
+  }
+
+  rot::VectorBatch3F globalVelocities;
+  rot::convertToGlobalAngularVelocityBatch(rotation, localVelocities, globalVelocities);
+  for (std::size_t k = 0; k < localVelocities.size(); k++) {
+    const rot::GlobalAngularVelocityF expected(rotation, rot::LocalAngularVelocityF(localVelocities.getVector(k)));
+    EXPECT_NEAR(expected.x(), globalVelocities.getVector(k)(0), 1e-6f);
+    EXPECT_NEAR(expected.y(), globalVelocities.getVector(k)(1), 1e-6f);
+    EXPECT_NEAR(expected.z(), globalVelocities.getVector(k)(2), 1e-6f);
+  }
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/CachedRotation.hpp"
+
+namespace rot = kindr;
+
+template <typename PrimType_>
+struct CachedRotationTest : public ::testing::Test {
+  typedef rot::CachedRotation<PrimType_> CachedRotation;
+  typedef typename CachedRotation::Rotation Rotation;
+  typedef typename CachedRotation::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector;
+};
+
+typedef ::testing::Types<double, float> Types;
+
+TYPED_TEST_CASE(CachedRotationTest, Types);
+
+TYPED_TEST(CachedRotationTest, testConstruction) {
+  typedef typename TestFixture::CachedRotation CachedRotation;
+  typedef typename TestFixture::Rotation Rotation;
+
+  const CachedRotation identity;
+  EXPECT_TRUE(identity.isMatrixCached());
+  EXPECT_TRUE(identity.getRotationQuaternion().isNear(Rotation(), 1e-6));
+
+  Rotation rotation;
+  rotation.setRandom();
+  const CachedRotation cached(rotation);
+  EXPECT_FALSE(cached.isMatrixCached());
+  EXPECT_TRUE(cached.getRotationQuaternion().isNear(rotation, 1e-6));
+
+  // conversion from and to other parameterizations routes through the quaternion
+  const rot::EulerAnglesZyx<typename TestFixture::Scalar> eulerAngles(rotation);
+  const CachedRotation fromEuler(eulerAngles);
+  EXPECT_TRUE(fromEuler.isNear(cached, 1e-4));
+  EXPECT_TRUE(rot::AngleAxis<typename TestFixture::Scalar>(cached).isNear(rot::AngleAxis<typename TestFixture::Scalar>(rotation), 1e-4));
+}
+
+TYPED_TEST(CachedRotationTest, testRotateUsesCache) {
+  typedef typename TestFixture::CachedRotation CachedRotation;
+  typedef typename TestFixture::Rotation Rotation;
+  typedef typename TestFixture::Vector Vector;
+
+  Rotation rotation;
+  rotation.setRandom();
+  CachedRotation cached(rotation);
+  const Vector vector(0.25, -1.5, 2.0);
+
+  // first rotate fills the cache, further rotates reuse it
+  EXPECT_FALSE(cached.isMatrixCached());
+  const Vector rotated = cached.rotate(vector);
+  EXPECT_TRUE(cached.isMatrixCached());
+  const Vector expected = rotation.rotate(vector);
+  for (int k = 0; k < 3; k++) {
+    EXPECT_NEAR(expected(k), rotated(k), 1e-4);
+    EXPECT_NEAR(expected(k), cached.rotate(vector)(k), 1e-4);
+  }
+
+  // updating the rotation invalidates the cache
+  rotation.setRandom();
+  cached.setRotationQuaternion(rotation);
+  EXPECT_FALSE(cached.isMatrixCached());
+  const Vector inverseRotated = cached.inverseRotate(rotation.rotate(vector));
+  for (int k = 0; k < 3; k++) {
+    EXPECT_NEAR(vector(k), inverseRotated(k), 1e-4);
+  }
+
+  // column-wise matrix rotation
+  Eigen::Matrix<typename TestFixture::Scalar, 3, 4> columns;
+  columns.setRandom();
+  const Eigen::Matrix<typename TestFixture::Scalar, 3, 4> rotatedColumns = cached.rotate(columns);
+  for (int k = 0; k < 4; k++) {
+    const Vector expectedColumn = rotation.rotate(Vector(columns.col(k)));
+    for (int j = 0; j < 3; j++) {
+      EXPECT_NEAR(expectedColumn(j), rotatedColumns(j, k), 1e-4);
+    }
+  }
+}
+
+TYPED_TEST(CachedRotationTest, testCachePropagation) {
+  typedef typename TestFixture::CachedRotation CachedRotation;
+  typedef typename TestFixture::Rotation Rotation;
+  typedef typename TestFixture::Vector Vector;
+
+  Rotation rotation;
+  rotation.setRandom();
+  CachedRotation cached(rotation);
+  cached.getCachedRotationMatrix();
+
+  // inversion transposes a valid cache instead of recomputing it
+  const CachedRotation inverse = cached.inverted();
+  EXPECT_TRUE(inverse.isMatrixCached());
+  const Vector vector(1.0, 2.0, 3.0);
+  const Vector roundTrip = inverse.rotate(cached.rotate(vector));
+  for (int k = 0; k < 3; k++) {
+    EXPECT_NEAR(vector(k), roundTrip(k), 1e-4);
+  }
+
+  // q and -q share the same matrix, so getUnique() keeps the cache
+  EXPECT_TRUE(cached.getUnique().isMatrixCached());
+  EXPECT_TRUE(cached.getUnique().isNear(cached, 1e-6));
+
+  // setIdentity() refills the cache directly
+  CachedRotation modified(rotation);
+  modified.setIdentity();
+  EXPECT_TRUE(modified.isMatrixCached());
+  EXPECT_NEAR(0.0, modified.rotate(vector)(0) - vector(0), 1e-6);
+}
+
+TYPED_TEST(CachedRotationTest, testGenericOperations) {
+  typedef typename TestFixture::CachedRotation CachedRotation;
+  typedef typename TestFixture::Rotation Rotation;
+  typedef typename TestFixture::Vector Vector;
+
+  Rotation rotationA;
+  rotationA.setRandom();
+  Rotation rotationB;
+  rotationB.setRandom();
+  const CachedRotation cachedA(rotationA);
+  const CachedRotation cachedB(rotationB);
+
+  // concatenation matches the quaternion result
+  const CachedRotation product = cachedA*cachedB;
+  EXPECT_FALSE(product.isMatrixCached());
+  EXPECT_TRUE(product.getRotationQuaternion().isNear(rotationA*rotationB, 1e-4));
+
+  // box operations fall back to the generic quaternion path
+  const Eigen::Matrix<typename TestFixture::Scalar, 3, 1> difference = cachedA.boxMinus(cachedB);
+  const Eigen::Matrix<typename TestFixture::Scalar, 3, 1> expectedDifference = rotationA.boxMinus(rotationB);
+  for (int k = 0; k < 3; k++) {
+    EXPECT_NEAR(expectedDifference(k), difference(k), 1e-4);
+  }
+  EXPECT_TRUE(cachedB.boxPlus(difference).isNear(cachedA, 1e-4));
+
+  // fix() renormalizes the quaternion and invalidates the cache
+  CachedRotation fixed(rotationA);
+  fixed.getCachedRotationMatrix();
+  fixed.fix();
+  EXPECT_FALSE(fixed.isMatrixCached());
+  EXPECT_NEAR(1.0, fixed.getRotationQuaternion().toImplementation().norm(), 1e-6);
+
+  // setRandom() uses the generic random trait
+  CachedRotation random;
+  random.setRandom();
+  EXPECT_FALSE(random.isNear(CachedRotation(), 1e-3));
+
+  (void)Vector();
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/Rotation.hpp"
+
+namespace rot = kindr;
+
+TEST(ComposeAllTest, testSingleRotation) {
+  const rot::RotationQuaternionD rotation(rot::EulerAnglesZyxD(0.3, -0.8, 1.2));
+  const rot::RotationQuaternionD composed = rot::composeAll(rotation);
+  EXPECT_TRUE(composed.isNear(rotation, 1e-12));
+}
+
+TEST(ComposeAllTest, testMatchesChainedMultiplication) {
+  const rot::RotationQuaternionD r1(rot::EulerAnglesZyxD(0.3, -0.8, 1.2));
+  const rot::RotationQuaternionD r2(rot::EulerAnglesZyxD(-1.1, 0.2, 0.7));
+  const rot::RotationQuaternionD r3(rot::EulerAnglesZyxD(2.0, 0.5, -0.4));
+
+  const rot::RotationQuaternionD chained = r3*r2*r1;
+  const rot::RotationQuaternionD folded = rot::composeAll(r3, r2, r1);
+  EXPECT_TRUE(folded.isNear(chained, 1e-12));
+}
+
+TEST(ComposeAllTest, testMixedRepresentations) {
+  const rot::EulerAnglesZyxD euler(0.3, -0.8, 1.2);
+  const rot::AngleAxisD angleAxis(1.3, Eigen::Vector3d(0.0, 1.0, 0.0));
+  const rot::RotationMatrixD rotationMatrix(rot::EulerAnglesXyzD(-0.2, 0.9, 0.1));
+  const rot::RotationQuaternionD quaternion(rot::RotationVectorD(Eigen::Vector3d(0.1, 0.2, -0.3)));
+
+  const rot::RotationQuaternionD chained =
+      rot::RotationQuaternionD(euler)*rot::RotationQuaternionD(angleAxis)*rot::RotationQuaternionD(rotationMatrix)*quaternion;
+  const rot::RotationQuaternionD folded = rot::composeAll(euler, angleAxis, rotationMatrix, quaternion);
+  EXPECT_TRUE(folded.isNear(chained, 1e-12));
+}
+
+TEST(ComposeAllTest, testLongChainStaysNormalized) {
+  // 25-link chain: the fold defers all normalization to the very end
+  std::vector<rot::RotationQuaternionD> links;
+  for (int k = 0; k < 5; k++) {
+    links.push_back(rot::RotationQuaternionD(rot::EulerAnglesZyxD(0.3*k, -0.1*k, 0.05*k + 0.2)));
+  }
+  rot::RotationQuaternionD chained;
+  chained.setIdentity();
+  for (int k = 0; k < 25; k++) {
+    chained = links[k % 5]*chained;
+  }
+
+  const rot::RotationQuaternionD folded = rot::composeAll(
+      links[4], links[3], links[2], links[1], links[0],
+      links[4], links[3], links[2], links[1], links[0],
+      links[4], links[3], links[2], links[1], links[0],
+      links[4], links[3], links[2], links[1], links[0],
+      links[4], links[3], links[2], links[1], links[0]);
+  EXPECT_TRUE(folded.isNear(chained, 1e-10));
+  EXPECT_NEAR(1.0, folded.toImplementation().norm(), 1e-14);
+}
+
+TEST(ComposeAllTest, testFloatTypes) {
+  const rot::RotationQuaternionF r1(rot::EulerAnglesZyxF(0.3f, -0.8f, 1.2f));
+  const rot::RotationQuaternionF r2(rot::EulerAnglesZyxF(-1.1f, 0.2f, 0.7f));
+  const rot::RotationQuaternionF folded = rot::composeAll(r2, r1);
+  EXPECT_TRUE(folded.isNear(r2*r1, 1e-5f));
+}
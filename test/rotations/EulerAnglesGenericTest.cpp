@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/EulerAnglesGeneric.hpp"
+
+namespace rot = kindr;
+
+typedef rot::RotationAxis Axis;
+
+// round-trips matrix -> angles -> matrix over an angle grid for one sequence
+template<Axis Axis1_, Axis Axis2_, Axis Axis3_>
+static void checkRoundTrip() {
+  typedef rot::EulerAnglesGeneric<Axis1_, Axis2_, Axis3_, double> Sequence;
+  for (double angle1 = -2.8; angle1 < 3.0; angle1 += 0.7) {
+    for (double angle2 = -1.4; angle2 < 1.5; angle2 += 0.35) {
+      for (double angle3 = -2.8; angle3 < 3.0; angle3 += 0.7) {
+        const Sequence original(angle1, angle2, angle3);
+        const rot::RotationQuaternionD rotation = original.getRotationQuaternion();
+        Sequence extracted;
+        extracted.setFromRotation(rotation);
+        // the extracted angles represent the same rotation
+        EXPECT_TRUE(extracted.getRotationQuaternion().isNear(rotation, 1e-10))
+            << "sequence " << int(Axis1_) << int(Axis2_) << int(Axis3_)
+            << " angles " << angle1 << " " << angle2 << " " << angle3;
+      }
+    }
+  }
+}
+
+TEST(EulerAnglesGenericTest, testMatchesHandWrittenZyx) {
+  const rot::EulerAnglesZyxD handWritten(0.4, -0.7, 1.1);
+  const rot::EulerAnglesGeneric<Axis::Z, Axis::Y, Axis::X, double> generic(0.4, -0.7, 1.1);
+  EXPECT_TRUE(generic.getRotationQuaternion().isNear(rot::RotationQuaternionD(handWritten), 1e-12));
+  EXPECT_NEAR(0.0, (generic.getRotationMatrix().matrix() - rot::RotationMatrixD(handWritten).matrix()).norm(), 1e-12);
+}
+
+TEST(EulerAnglesGenericTest, testMatchesHandWrittenXyz) {
+  const rot::EulerAnglesXyzD handWritten(-0.3, 0.8, 2.1);
+  const rot::EulerAnglesGeneric<Axis::X, Axis::Y, Axis::Z, double> generic(-0.3, 0.8, 2.1);
+  EXPECT_TRUE(generic.getRotationQuaternion().isNear(rot::RotationQuaternionD(handWritten), 1e-12));
+  EXPECT_NEAR(0.0, (generic.getRotationMatrix().matrix() - rot::RotationMatrixD(handWritten).matrix()).norm(), 1e-12);
+}
+
+TEST(EulerAnglesGenericTest, testQuaternionAndMatrixConversionsAgree) {
+  const rot::EulerAnglesZxzD zxz(0.5, 1.2, -0.8);
+  EXPECT_NEAR(0.0, (zxz.getRotationMatrix().matrix()
+                    - rot::RotationMatrixD(zxz.getRotationQuaternion()).matrix()).norm(), 1e-12);
+}
+
+TEST(EulerAnglesGenericTest, testRoundTripTaitBryanSequences) {
+  checkRoundTrip<Axis::X, Axis::Y, Axis::Z>();
+  checkRoundTrip<Axis::X, Axis::Z, Axis::Y>();
+  checkRoundTrip<Axis::Y, Axis::X, Axis::Z>();
+  checkRoundTrip<Axis::Y, Axis::Z, Axis::X>();
+  checkRoundTrip<Axis::Z, Axis::X, Axis::Y>();
+  checkRoundTrip<Axis::Z, Axis::Y, Axis::X>();
+}
+
+TEST(EulerAnglesGenericTest, testRoundTripProperEulerSequences) {
+  // proper Euler: second angle in (0, pi), shift the grid accordingly
+  typedef rot::RotationQuaternionD Quaternion;
+  auto checkProper = [](const Quaternion& rotation, const Quaternion& back, const char* name) {
+    EXPECT_TRUE(back.isNear(rotation, 1e-10)) << name;
+  };
+  for (double angle1 = -2.8; angle1 < 3.0; angle1 += 0.7) {
+    for (double angle2 = 0.3; angle2 < 3.0; angle2 += 0.5) {
+      for (double angle3 = -2.8; angle3 < 3.0; angle3 += 0.7) {
+        {
+          const rot::EulerAnglesZxzD original(angle1, angle2, angle3);
+          rot::EulerAnglesZxzD extracted(original.getRotationQuaternion());
+          checkProper(original.getRotationQuaternion(), extracted.getRotationQuaternion(), "ZXZ");
+        }
+        {
+          const rot::EulerAnglesYxyD original(angle1, angle2, angle3);
+          rot::EulerAnglesYxyD extracted(original.getRotationQuaternion());
+          checkProper(original.getRotationQuaternion(), extracted.getRotationQuaternion(), "YXY");
+        }
+        {
+          const rot::EulerAnglesGeneric<Axis::X, Axis::Z, Axis::X, double> original(angle1, angle2, angle3);
+          rot::EulerAnglesGeneric<Axis::X, Axis::Z, Axis::X, double> extracted(original.getRotationQuaternion());
+          checkProper(original.getRotationQuaternion(), extracted.getRotationQuaternion(), "XZX");
+        }
+        {
+          const rot::EulerAnglesGeneric<Axis::Y, Axis::Z, Axis::Y, double> original(angle1, angle2, angle3);
+          rot::EulerAnglesGeneric<Axis::Y, Axis::Z, Axis::Y, double> extracted(original.getRotationQuaternion());
+          checkProper(original.getRotationQuaternion(), extracted.getRotationQuaternion(), "YZY");
+        }
+        {
+          const rot::EulerAnglesGeneric<Axis::X, Axis::Y, Axis::X, double> original(angle1, angle2, angle3);
+          rot::EulerAnglesGeneric<Axis::X, Axis::Y, Axis::X, double> extracted(original.getRotationQuaternion());
+          checkProper(original.getRotationQuaternion(), extracted.getRotationQuaternion(), "XYX");
+        }
+        {
+          const rot::EulerAnglesGeneric<Axis::Z, Axis::Y, Axis::Z, double> original(angle1, angle2, angle3);
+          rot::EulerAnglesGeneric<Axis::Z, Axis::Y, Axis::Z, double> extracted(original.getRotationQuaternion());
+          checkProper(original.getRotationQuaternion(), extracted.getRotationQuaternion(), "ZYZ");
+        }
+      }
+    }
+  }
+}
+
+TEST(EulerAnglesGenericTest, testDegenerateConfigurations) {
+  // Tait-Bryan gimbal lock: second angle at pi/2
+  const rot::EulerAnglesGeneric<Axis::Z, Axis::Y, Axis::X, double> locked(0.7, M_PI/2.0, 0.4);
+  const rot::RotationQuaternionD rotation = locked.getRotationQuaternion();
+  rot::EulerAnglesGeneric<Axis::Z, Axis::Y, Axis::X, double> extracted(rotation);
+  EXPECT_TRUE(extracted.getRotationQuaternion().isNear(rotation, 1e-10));
+  EXPECT_EQ(0.0, extracted.angle3());
+
+  // proper Euler degeneracy: second angle at 0
+  const rot::EulerAnglesZxzD properLocked(0.7, 0.0, 0.4);
+  const rot::RotationQuaternionD properRotation = properLocked.getRotationQuaternion();
+  rot::EulerAnglesZxzD properExtracted(properRotation);
+  EXPECT_TRUE(properExtracted.getRotationQuaternion().isNear(properRotation, 1e-10));
+  EXPECT_EQ(0.0, properExtracted.angle3());
+}
+
+TEST(EulerAnglesGenericTest, testAccessorsAndIdentity) {
+  rot::EulerAnglesYxyD angles(0.1, 0.2, 0.3);
+  EXPECT_EQ(0.1, angles.angle1());
+  EXPECT_EQ(0.2, angles.angle2());
+  EXPECT_EQ(0.3, angles.angle3());
+  angles.setIdentity();
+  EXPECT_TRUE(angles.getRotationQuaternion().isNear(rot::RotationQuaternionD(), 1e-15));
+}
+
+TEST(EulerAnglesGenericTest, testFloatTypes) {
+  const rot::EulerAnglesZxzF original(0.4f, 1.1f, -0.7f);
+  const rot::RotationQuaternionF rotation = original.getRotationQuaternion();
+  rot::EulerAnglesZxzF extracted(rotation);
+  EXPECT_TRUE(extracted.getRotationQuaternion().isNear(rotation, 1e-5f));
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/rotations/RotationBatch.hpp"
+
+namespace rot = kindr;
+
+TEST(EulerAnglesUniqueFastTest, testZyxMatchesGetUnique) {
+  for (double yaw = -7.0; yaw < 7.0; yaw += 0.61) {
+    for (double pitch = -7.0; pitch < 7.0; pitch += 0.37) {
+      for (double roll = -7.0; roll < 7.0; roll += 0.61) {
+        const rot::EulerAnglesZyxD angles(yaw, pitch, roll);
+        const rot::EulerAnglesZyxD unique = angles.getUnique();
+        const rot::EulerAnglesZyxD fast = angles.getUniqueFast();
+        EXPECT_NEAR(unique.z(), fast.z(), 1e-12) << "angles " << yaw << " " << pitch << " " << roll;
+        EXPECT_NEAR(unique.y(), fast.y(), 1e-12) << "angles " << yaw << " " << pitch << " " << roll;
+        EXPECT_NEAR(unique.x(), fast.x(), 1e-12) << "angles " << yaw << " " << pitch << " " << roll;
+      }
+    }
+  }
+}
+
+TEST(EulerAnglesUniqueFastTest, testXyzMatchesGetUnique) {
+  for (double roll = -7.0; roll < 7.0; roll += 0.61) {
+    for (double pitch = -7.0; pitch < 7.0; pitch += 0.37) {
+      for (double yaw = -7.0; yaw < 7.0; yaw += 0.61) {
+        const rot::EulerAnglesXyzD angles(roll, pitch, yaw);
+        const rot::EulerAnglesXyzD unique = angles.getUnique();
+        const rot::EulerAnglesXyzD fast = angles.getUniqueFast();
+        EXPECT_NEAR(unique.x(), fast.x(), 1e-12) << "angles " << roll << " " << pitch << " " << yaw;
+        EXPECT_NEAR(unique.y(), fast.y(), 1e-12) << "angles " << roll << " " << pitch << " " << yaw;
+        EXPECT_NEAR(unique.z(), fast.z(), 1e-12) << "angles " << roll << " " << pitch << " " << yaw;
+      }
+    }
+  }
+}
+
+TEST(EulerAnglesUniqueFastTest, testGimbalLockBand) {
+  // within the 1e-3 band around +-pi/2 the roll angle folds into the yaw angle
+  const double offsets[] = {-1e-3, -1e-4, 0.0, 1e-4, 1e-3};
+  for (double sign : {-1.0, 1.0}) {
+    for (double offset : offsets) {
+      const rot::EulerAnglesZyxD angles(0.7, sign*M_PI/2.0 + offset, -0.4);
+      const rot::EulerAnglesZyxD unique = angles.getUnique();
+      const rot::EulerAnglesZyxD fast = angles.getUniqueFast();
+      EXPECT_EQ(0.0, fast.x());
+      EXPECT_NEAR(unique.z(), fast.z(), 1e-12);
+      EXPECT_NEAR(unique.y(), fast.y(), 1e-12);
+    }
+  }
+}
+
+TEST(EulerAnglesUniqueFastTest, testRepresentsSameRotation) {
+  for (double yaw = -3.0; yaw < 3.1; yaw += 0.73) {
+    for (double pitch = -3.0; pitch < 3.1; pitch += 0.47) {
+      for (double roll = -3.0; roll < 3.1; roll += 0.73) {
+        const rot::EulerAnglesZyxD angles(yaw, pitch, roll);
+        // outside the gimbal-lock band the canonical angles describe the same rotation
+        if (std::fabs(std::fabs(rot::wrapPosNegPI(pitch)) - M_PI/2.0) > 2e-3) {
+          EXPECT_TRUE(angles.getUniqueFast().isNear(angles, 1e-9))
+              << "angles " << yaw << " " << pitch << " " << roll;
+        }
+      }
+    }
+  }
+}
+
+TEST(EulerAnglesUniqueFastTest, testSetUniqueFast) {
+  rot::EulerAnglesZyxD angles(4.0, 2.0, -5.0);
+  angles.setUniqueFast();
+  const rot::EulerAnglesZyxD expected = rot::EulerAnglesZyxD(4.0, 2.0, -5.0).getUnique();
+  EXPECT_NEAR(expected.z(), angles.z(), 1e-12);
+  EXPECT_NEAR(expected.y(), angles.y(), 1e-12);
+  EXPECT_NEAR(expected.x(), angles.x(), 1e-12);
+}
+
+TEST(EulerAnglesUniqueFastTest, testBatchMatchesPerTriple) {
+  rot::VectorBatch3<double> batch;
+  std::vector<rot::EulerAnglesZyxD> scalars;
+  for (int k = 0; k < 200; k++) {
+    const double yaw = -6.0 + 0.37*k;
+    const double pitch = -5.0 + 0.29*k;
+    const double roll = -4.0 + 0.41*k;
+    // batch components hold the angles in rotation-sequence order
+    batch.append(Eigen::Vector3d(yaw, pitch, roll));
+    scalars.push_back(rot::EulerAnglesZyxD(yaw, pitch, roll));
+  }
+  rot::setUniqueEulerAnglesBatch(batch);
+  ASSERT_EQ(scalars.size(), batch.size());
+  for (std::size_t k = 0; k < scalars.size(); k++) {
+    const rot::EulerAnglesZyxD fast = scalars[k].getUniqueFast();
+    EXPECT_EQ(fast.z(), batch.x()[k]);
+    EXPECT_EQ(fast.y(), batch.y()[k]);
+    EXPECT_EQ(fast.x(), batch.z()[k]);
+  }
+}
+
+TEST(EulerAnglesUniqueFastTest, testFloatTypes) {
+  const rot::EulerAnglesZyxF angles(4.0f, 2.0f, -5.0f);
+  const rot::EulerAnglesZyxF unique = angles.getUnique();
+  const rot::EulerAnglesZyxF fast = angles.getUniqueFast();
+  EXPECT_NEAR(unique.z(), fast.z(), 1e-5f);
+  EXPECT_NEAR(unique.y(), fast.y(), 1e-5f);
+  EXPECT_NEAR(unique.x(), fast.x(), 1e-5f);
+}
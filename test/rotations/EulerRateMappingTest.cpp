@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/EulerRateMapping.hpp"
+
+namespace rot = kindr;
+
+TEST(EulerRateMappingTest, testZyxMatchesUncachedMappings) {
+  const rot::EulerAnglesZyxD eulerAngles(0.4, -0.7, 1.1);
+  const rot::EulerRateMappingZyxD mapping(eulerAngles);
+
+  const Eigen::Matrix3d expectedDiffToLocal = eulerAngles.getMappingFromDiffToLocalAngularVelocity();
+  const Eigen::Matrix3d expectedLocalToDiff = eulerAngles.getMappingFromLocalAngularVelocityToDiff();
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      EXPECT_NEAR(expectedDiffToLocal(i, j), mapping.getMappingFromDiffToLocalAngularVelocity()(i, j), 1e-12);
+      EXPECT_NEAR(expectedLocalToDiff(i, j), mapping.getMappingFromLocalAngularVelocityToDiff()(i, j), 1e-12);
+    }
+  }
+}
+
+TEST(EulerRateMappingTest, testXyzMatchesUncachedMappings) {
+  const rot::EulerAnglesXyzD eulerAngles(-0.9, 0.3, 2.0);
+  const rot::EulerRateMappingXyzD mapping(eulerAngles);
+
+  const Eigen::Matrix3d expectedDiffToLocal = eulerAngles.getMappingFromDiffToLocalAngularVelocity();
+  const Eigen::Matrix3d expectedLocalToDiff = eulerAngles.getMappingFromLocalAngularVelocityToDiff();
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      EXPECT_NEAR(expectedDiffToLocal(i, j), mapping.getMappingFromDiffToLocalAngularVelocity()(i, j), 1e-12);
+      EXPECT_NEAR(expectedLocalToDiff(i, j), mapping.getMappingFromLocalAngularVelocityToDiff()(i, j), 1e-12);
+    }
+  }
+}
+
+TEST(EulerRateMappingTest, testZyxConversionsRoundTrip) {
+  rot::EulerRateMappingZyxD mapping;
+  mapping.setAttitude(rot::EulerAnglesZyxD(1.2, 0.5, -0.3));
+
+  // many velocities at the same attitude, converted with the cached matrices
+  for (int k = 0; k < 10; k++) {
+    const rot::LocalAngularVelocityD angularVelocity(0.1*k, -0.2*k, 0.05*k + 0.3);
+    const rot::EulerAnglesZyxDiffD diff = mapping.convertToDiff(angularVelocity);
+
+    // matches the per-call trait conversion
+    const rot::EulerAnglesZyxDiffD expected(rot::EulerAnglesZyxD(1.2, 0.5, -0.3), angularVelocity);
+    EXPECT_NEAR(expected.yaw(), diff.yaw(), 1e-12);
+    EXPECT_NEAR(expected.pitch(), diff.pitch(), 1e-12);
+    EXPECT_NEAR(expected.roll(), diff.roll(), 1e-12);
+
+    // round trip through the inverse mapping
+    const rot::LocalAngularVelocityD roundTrip = mapping.convertToLocalAngularVelocity(diff);
+    for (int i = 0; i < 3; i++) {
+      EXPECT_NEAR(angularVelocity.vector()(i), roundTrip.vector()(i), 1e-12);
+    }
+  }
+}
+
+TEST(EulerRateMappingTest, testXyzConversionsRoundTrip) {
+  rot::EulerRateMappingXyzD mapping;
+  mapping.setAttitude(rot::EulerAnglesXyzD(-0.4, 0.8, 0.6));
+
+  for (int k = 0; k < 10; k++) {
+    const rot::LocalAngularVelocityD angularVelocity(0.3 - 0.1*k, 0.2*k, -0.07*k);
+    const rot::EulerAnglesXyzDiffD diff = mapping.convertToDiff(angularVelocity);
+
+    const rot::EulerAnglesXyzDiffD expected(rot::EulerAnglesXyzD(-0.4, 0.8, 0.6), angularVelocity);
+    EXPECT_NEAR(expected.roll(), diff.roll(), 1e-12);
+    EXPECT_NEAR(expected.pitch(), diff.pitch(), 1e-12);
+    EXPECT_NEAR(expected.yaw(), diff.yaw(), 1e-12);
+
+    const rot::LocalAngularVelocityD roundTrip = mapping.convertToLocalAngularVelocity(diff);
+    for (int i = 0; i < 3; i++) {
+      EXPECT_NEAR(angularVelocity.vector()(i), roundTrip.vector()(i), 1e-12);
+    }
+  }
+}
+
+TEST(EulerRateMappingTest, testZyxMappingDerivative) {
+  const rot::EulerAnglesZyxD eulerAngles(0.7, -0.2, 0.9);
+  const rot::EulerAnglesZyxDiffD diff(0.4, -0.8, 0.6);
+  const rot::EulerRateMappingZyxD mapping(eulerAngles);
+  const Eigen::Matrix3d analytic = mapping.getTimeDerivativeOfMappingFromDiffToLocalAngularVelocity(diff);
+
+  // central finite difference of the mapping over time
+  const double dt = 1e-6;
+  const rot::EulerAnglesZyxD plus(eulerAngles.yaw() + dt*diff.yaw(),
+                                  eulerAngles.pitch() + dt*diff.pitch(),
+                                  eulerAngles.roll() + dt*diff.roll());
+  const rot::EulerAnglesZyxD minus(eulerAngles.yaw() - dt*diff.yaw(),
+                                   eulerAngles.pitch() - dt*diff.pitch(),
+                                   eulerAngles.roll() - dt*diff.roll());
+  const Eigen::Matrix3d numeric = (plus.getMappingFromDiffToLocalAngularVelocity()
+                                 - minus.getMappingFromDiffToLocalAngularVelocity())/(2.0*dt);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      EXPECT_NEAR(numeric(i, j), analytic(i, j), 1e-7) << "entry (" << i << "," << j << ")";
+    }
+  }
+}
+
+TEST(EulerRateMappingTest, testXyzMappingDerivative) {
+  const rot::EulerAnglesXyzD eulerAngles(0.3, 0.5, -1.0);
+  const rot::EulerAnglesXyzDiffD diff(-0.6, 0.2, 0.9);
+  const rot::EulerRateMappingXyzD mapping(eulerAngles);
+  const Eigen::Matrix3d analytic = mapping.getTimeDerivativeOfMappingFromDiffToLocalAngularVelocity(diff);
+
+  const double dt = 1e-6;
+  const rot::EulerAnglesXyzD plus(eulerAngles.roll() + dt*diff.roll(),
+                                  eulerAngles.pitch() + dt*diff.pitch(),
+                                  eulerAngles.yaw() + dt*diff.yaw());
+  const rot::EulerAnglesXyzD minus(eulerAngles.roll() - dt*diff.roll(),
+                                   eulerAngles.pitch() - dt*diff.pitch(),
+                                   eulerAngles.yaw() - dt*diff.yaw());
+  const Eigen::Matrix3d numeric = (plus.getMappingFromDiffToLocalAngularVelocity()
+                                 - minus.getMappingFromDiffToLocalAngularVelocity())/(2.0*dt);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      EXPECT_NEAR(numeric(i, j), analytic(i, j), 1e-7) << "entry (" << i << "," << j << ")";
+    }
+  }
+}
+
+TEST(EulerRateMappingTest, testFloatTypes) {
+  const rot::EulerAnglesZyxF eulerAngles(0.4f, -0.7f, 1.1f);
+  const rot::EulerRateMappingZyxF mapping(eulerAngles);
+  const rot::LocalAngularVelocityF angularVelocity(0.1f, -0.2f, 0.3f);
+  const rot::EulerAnglesZyxDiffF diff = mapping.convertToDiff(angularVelocity);
+  const rot::EulerAnglesZyxDiffF expected(eulerAngles, angularVelocity);
+  EXPECT_NEAR(expected.yaw(), diff.yaw(), 1e-5f);
+  EXPECT_NEAR(expected.pitch(), diff.pitch(), 1e-5f);
+  EXPECT_NEAR(expected.roll(), diff.roll(), 1e-5f);
+}
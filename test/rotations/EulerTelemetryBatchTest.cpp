@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/RotationBatch.hpp"
+
+namespace rot = kindr;
+
+TEST(EulerTelemetryBatchTest, testMatchesScalarConversion) {
+  rot::QuaternionBatchD quaternions(200);
+  rot::setRandomBatch(quaternions);
+
+  rot::VectorBatch3D angles;
+  rot::convertToEulerAnglesZyxBatch(quaternions, angles);
+  ASSERT_EQ(quaternions.size(), angles.size());
+
+  for (std::size_t k = 0; k < quaternions.size(); k++) {
+    // matches the per-element ConversionTraits construction
+    const rot::EulerAnglesZyxD expected(quaternions.getRotationQuaternion(k));
+    EXPECT_NEAR(expected.yaw(), angles.getVector(k)(0), 1e-12) << "index " << k;
+    EXPECT_NEAR(expected.pitch(), angles.getVector(k)(1), 1e-12) << "index " << k;
+    EXPECT_NEAR(expected.roll(), angles.getVector(k)(2), 1e-12) << "index " << k;
+  }
+}
+
+TEST(EulerTelemetryBatchTest, testRoundTripThroughQuaternion) {
+  rot::QuaternionBatchD quaternions(64);
+  rot::setRandomBatch(quaternions);
+
+  rot::VectorBatch3D angles;
+  rot::convertToEulerAnglesZyxBatch(quaternions, angles);
+
+  for (std::size_t k = 0; k < quaternions.size(); k++) {
+    const rot::EulerAnglesZyxD decoded(angles.getVector(k)(0), angles.getVector(k)(1), angles.getVector(k)(2));
+    EXPECT_TRUE(rot::RotationQuaternionD(decoded).isNear(quaternions.getRotationQuaternion(k), 1e-10)) << "index " << k;
+  }
+}
+
+TEST(EulerTelemetryBatchTest, testGimbalLock) {
+  rot::QuaternionBatchD quaternions;
+  // pitch of +-pi/2 combined with a rotation about the locked axis
+  quaternions.append(rot::RotationQuaternionD(rot::EulerAnglesZyxD(0.3, M_PI/2.0, -0.8)));
+  quaternions.append(rot::RotationQuaternionD(rot::EulerAnglesZyxD(-1.1, -M_PI/2.0, 0.4)));
+  quaternions.append(rot::RotationQuaternionD(rot::EulerAnglesZyxD(0.0, M_PI/2.0, 0.0)));
+
+  rot::VectorBatch3D angles;
+  rot::convertToEulerAnglesZyxBatch(quaternions, angles);
+
+  for (std::size_t k = 0; k < quaternions.size(); k++) {
+    // the scalar conversion sets yaw to zero and lets roll carry the rest
+    const rot::EulerAnglesZyxD expected(quaternions.getRotationQuaternion(k));
+    EXPECT_NEAR(expected.yaw(), angles.getVector(k)(0), 1e-6) << "index " << k;
+    EXPECT_NEAR(expected.pitch(), angles.getVector(k)(1), 1e-6) << "index " << k;
+    EXPECT_NEAR(expected.roll(), angles.getVector(k)(2), 1e-6) << "index " << k;
+    // and the decoded rotation still matches
+    const rot::EulerAnglesZyxD decoded(angles.getVector(k)(0), angles.getVector(k)(1), angles.getVector(k)(2));
+    EXPECT_TRUE(rot::RotationQuaternionD(decoded).isNear(quaternions.getRotationQuaternion(k), 1e-6)) << "index " << k;
+  }
+}
+
+TEST(EulerTelemetryBatchTest, testCanonicalRanges) {
+  rot::QuaternionBatchD quaternions(128);
+  rot::setRandomBatch(quaternions);
+
+  rot::VectorBatch3D angles;
+  rot::convertToEulerAnglesZyxBatch(quaternions, angles);
+
+  for (std::size_t k = 0; k < quaternions.size(); k++) {
+    EXPECT_LE(std::fabs(angles.getVector(k)(0)), M_PI);
+    EXPECT_LE(std::fabs(angles.getVector(k)(1)), M_PI/2.0 + 1e-12);
+    EXPECT_LE(std::fabs(angles.getVector(k)(2)), M_PI);
+  }
+}
+
+TEST(EulerTelemetryBatchTest, testFloatTypes) {
+  rot::QuaternionBatchF quaternions(50);
+  rot::setRandomBatch(quaternions);
+
+  rot::VectorBatch3F angles;
+  rot::convertToEulerAnglesZyxBatch(quaternions, angles);
+
+  for (std::size_t k = 0; k < quaternions.size(); k++) {
+    const rot::EulerAnglesZyxF expected(quaternions.getRotationQuaternion(k));
+    EXPECT_NEAR(expected.yaw(), angles.getVector(k)(0), 1e-5f) << "index " << k;
+    EXPECT_NEAR(expected.pitch(), angles.getVector(k)(1), 1e-5f) << "index " << k;
+    EXPECT_NEAR(expected.roll(), angles.getVector(k)(2), 1e-5f) << "index " << k;
+  }
+}
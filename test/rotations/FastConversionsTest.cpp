@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/FastConversions.hpp"
+
+namespace rot = kindr;
+
+// angles spanning both sides of the small-angle branch threshold
+static const double kTestAngles[] = {0.0, 1e-12, 1e-9, 1e-6, 1e-4, 1e-3, 0.1, 1.0, 3.0, M_PI - 1e-3};
+
+static rot::RotationVectorD makeRotationVector(double angle, int axisSeed) {
+  Eigen::Vector3d axis(std::cos(0.9*axisSeed), std::sin(1.7*axisSeed), std::cos(0.3*axisSeed + 1.0));
+  axis.normalize();
+  return rot::RotationVectorD(Eigen::Vector3d(axis*angle));
+}
+
+TEST(FastConversionsTest, testRotationVectorToQuaternion) {
+  int axisSeed = 0;
+  for (double angle : kTestAngles) {
+    const rot::RotationVectorD rotationVector = makeRotationVector(angle, axisSeed++);
+    const rot::RotationQuaternionD fast = rot::convertToRotationQuaternionFast(rotationVector);
+    const rot::RotationQuaternionD reference(rotationVector);
+    EXPECT_TRUE(fast.isNear(reference, 1e-10)) << "angle = " << angle;
+    EXPECT_NEAR(1.0, fast.toImplementation().norm(), 1e-12) << "angle = " << angle;
+  }
+}
+
+TEST(FastConversionsTest, testAngleAxisToQuaternion) {
+  int axisSeed = 0;
+  for (double angle : kTestAngles) {
+    Eigen::Vector3d axis(std::cos(0.9*axisSeed), std::sin(1.7*axisSeed), std::cos(0.3*axisSeed + 1.0));
+    axis.normalize();
+    axisSeed++;
+    const rot::AngleAxisD angleAxis(angle, axis);
+    const rot::RotationQuaternionD fast = rot::convertToRotationQuaternionFast(angleAxis);
+    const rot::RotationQuaternionD reference(angleAxis);
+    EXPECT_TRUE(fast.isNear(reference, 1e-10)) << "angle = " << angle;
+  }
+}
+
+TEST(FastConversionsTest, testQuaternionToRotationVector) {
+  int axisSeed = 0;
+  for (double angle : kTestAngles) {
+    const rot::RotationVectorD expected = makeRotationVector(angle, axisSeed++);
+    const rot::RotationQuaternionD quaternion(expected);
+    const rot::RotationVectorD fast = rot::convertToRotationVectorFast(quaternion);
+    for (int k = 0; k < 3; k++) {
+      EXPECT_NEAR(expected.toImplementation()(k), fast.toImplementation()(k), 1e-10) << "angle = " << angle;
+    }
+    // the canonicalization makes -q yield the same (shortest) rotation vector
+    const rot::RotationQuaternionD negated(-quaternion.w(), -quaternion.x(), -quaternion.y(), -quaternion.z());
+    const rot::RotationVectorD fastNegated = rot::convertToRotationVectorFast(negated);
+    for (int k = 0; k < 3; k++) {
+      EXPECT_NEAR(expected.toImplementation()(k), fastNegated.toImplementation()(k), 1e-10) << "angle = " << angle;
+    }
+  }
+}
+
+TEST(FastConversionsTest, testQuaternionToAngleAxis) {
+  int axisSeed = 0;
+  for (double angle : kTestAngles) {
+    const rot::RotationVectorD rotationVector = makeRotationVector(angle, axisSeed++);
+    const rot::RotationQuaternionD quaternion(rotationVector);
+    const rot::AngleAxisD fast = rot::convertToAngleAxisFast(quaternion);
+    const rot::AngleAxisD reference(quaternion);
+    EXPECT_TRUE(fast.isNear(reference, 1e-8)) << "angle = " << angle;
+    EXPECT_GE(fast.angle(), 0.0);
+    EXPECT_NEAR(1.0, fast.axis().norm(), 1e-12);
+  }
+}
+
+TEST(FastConversionsTest, testRotationVectorToAngleAxis) {
+  int axisSeed = 0;
+  for (double angle : kTestAngles) {
+    const rot::RotationVectorD rotationVector = makeRotationVector(angle, axisSeed++);
+    const rot::AngleAxisD fast = rot::convertToAngleAxisFast(rotationVector);
+    const rot::AngleAxisD reference(rotationVector);
+    EXPECT_TRUE(fast.isNear(reference, 1e-10)) << "angle = " << angle;
+  }
+}
+
+TEST(FastConversionsTest, testUnsafeVariantsMatchOnCanonicalInput) {
+  int axisSeed = 0;
+  for (double angle : kTestAngles) {
+    const rot::RotationVectorD rotationVector = makeRotationVector(angle, axisSeed++);
+    // quaternions from the exponential map have w >= 0 for angles in [0, pi]
+    const rot::RotationQuaternionD quaternion = rot::convertToRotationQuaternionFast(rotationVector);
+    ASSERT_GE(quaternion.w(), 0.0);
+
+    const rot::RotationVectorD safeVector = rot::convertToRotationVectorFast(quaternion);
+    const rot::RotationVectorD unsafeVector = rot::convertToRotationVectorFastUnsafe(quaternion);
+    for (int k = 0; k < 3; k++) {
+      EXPECT_EQ(safeVector.toImplementation()(k), unsafeVector.toImplementation()(k)) << "angle = " << angle;
+    }
+
+    const rot::AngleAxisD safeAngleAxis = rot::convertToAngleAxisFast(quaternion);
+    const rot::AngleAxisD unsafeAngleAxis = rot::convertToAngleAxisFastUnsafe(quaternion);
+    EXPECT_EQ(safeAngleAxis.angle(), unsafeAngleAxis.angle()) << "angle = " << angle;
+  }
+}
+
+TEST(FastConversionsTest, testFloatPrecision) {
+  for (float angle : {1e-6f, 1e-3f, 0.5f}) {
+    const rot::RotationVectorF rotationVector(Eigen::Vector3f(angle, 0.f, 0.f));
+    const rot::RotationQuaternionF fast = rot::convertToRotationQuaternionFast(rotationVector);
+    const rot::RotationQuaternionF reference(rotationVector);
+    EXPECT_TRUE(fast.isNear(reference, 1e-5f));
+  }
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/Rotation.hpp"
+
+namespace rot = kindr;
+
+TEST(FixOrthonormalTest, testRecoversFromScaleAndShearDrift) {
+  const rot::RotationMatrixD reference(rot::EulerAnglesZyxD(0.4, -0.7, 1.1));
+
+  // perturbation with both scale and orthogonality error, as accumulated by integration drift
+  Eigen::Matrix3d drift;
+  drift << 1e-3, 2e-4, -1e-4,
+           -3e-4, -2e-3, 1e-4,
+           2e-4, -1e-4, 1.5e-3;
+  rot::RotationMatrixD drifted;
+  drifted.toImplementation() = reference.matrix()*(Eigen::Matrix3d::Identity() + drift);
+
+  drifted.fixOrthonormal();
+  EXPECT_NEAR(0.0, (drifted.matrix().transpose()*drifted.matrix() - Eigen::Matrix3d::Identity()).norm(), 1e-12);
+  EXPECT_NEAR(1.0, drifted.determinant(), 1e-12);
+  EXPECT_TRUE(drifted.isNear(reference, 1e-2));
+}
+
+TEST(FixOrthonormalTest, testNearestOrthogonalMatchesSvd) {
+  Eigen::Matrix3d drift;
+  drift << 2e-2, -1e-2, 3e-3,
+           5e-3, 1e-2, -2e-2,
+           -1e-2, 4e-3, 1.2e-2;
+  const Eigen::Matrix3d perturbed = rot::RotationMatrixD(rot::EulerAnglesZyxD(-1.3, 0.5, 0.8)).matrix() + drift;
+
+  rot::RotationMatrixD fixednMatrix;
+  fixednMatrix.toImplementation() = perturbed;
+  fixednMatrix.fixOrthonormal();
+
+  // the polar factor of the SVD is the nearest orthogonal matrix
+  Eigen::JacobiSVD<Eigen::Matrix3d> svd(perturbed, Eigen::ComputeFullU | Eigen::ComputeFullV);
+  const Eigen::Matrix3d polar = svd.matrixU()*svd.matrixV().transpose();
+  EXPECT_NEAR(0.0, (fixednMatrix.matrix() - polar).norm(), 1e-9);
+}
+
+TEST(FixOrthonormalTest, testAlreadyOrthonormalUnchanged) {
+  const rot::RotationMatrixD reference(rot::EulerAnglesZyxD(0.9, -0.2, 1.4));
+  rot::RotationMatrixD rotation = reference;
+  rotation.fixOrthonormal();
+  EXPECT_NEAR(0.0, (rotation.matrix() - reference.matrix()).norm(), 1e-14);
+}
+
+TEST(FixOrthonormalTest, testFloatTypes) {
+  const rot::RotationMatrixF reference(rot::EulerAnglesZyxF(0.4f, -0.7f, 1.1f));
+  rot::RotationMatrixF drifted;
+  drifted.toImplementation() = reference.matrix()*(Eigen::Matrix3f::Identity()*1.001f);
+  drifted.fixOrthonormal();
+  EXPECT_NEAR(0.0f, (drifted.matrix().transpose()*drifted.matrix() - Eigen::Matrix3f::Identity()).norm(), 1e-5f);
+  EXPECT_TRUE(drifted.isNear(reference, 1e-4f));
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/rotations/CachedRotation.hpp"
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
+
+namespace rot = kindr;
+
+template<typename Rotation_>
+struct InverseRotateTest : public ::testing::Test {
+  typedef Rotation_ Rotation;
+  typedef typename Rotation_::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+};
+
+typedef ::testing::Types<
+    rot::RotationQuaternionD,
+    rot::RotationMatrixD,
+    rot::AngleAxisD,
+    rot::RotationVectorD,
+    rot::EulerAnglesZyxD,
+    rot::EulerAnglesXyzD,
+    rot::CachedRotationD
+> Types;
+
+TYPED_TEST_CASE(InverseRotateTest, Types);
+
+TYPED_TEST(InverseRotateTest, testMatchesInvertedRotate) {
+  typedef typename TestFixture::Vector3 Vector3;
+  const typename TestFixture::Rotation rotation(rot::RotationQuaternionD(rot::EulerAnglesZyxD(0.4, -0.7, 1.1)));
+  const Vector3 vector(0.3, -1.2, 2.5);
+  const Vector3 direct = rotation.inverseRotate(vector);
+  const Vector3 viaInverse = rotation.inverted().rotate(vector);
+  EXPECT_NEAR(0.0, (direct - viaInverse).norm(), 1e-12);
+}
+
+TYPED_TEST(InverseRotateTest, testRoundTrip) {
+  typedef typename TestFixture::Vector3 Vector3;
+  const typename TestFixture::Rotation rotation(rot::RotationQuaternionD(rot::EulerAnglesZyxD(-1.3, 0.5, 0.8)));
+  const Vector3 vector(1.7, 0.2, -0.9);
+  EXPECT_NEAR(0.0, (rotation.inverseRotate(rotation.rotate(vector)) - vector).norm(), 1e-12);
+  EXPECT_NEAR(0.0, (rotation.rotate(rotation.inverseRotate(vector)) - vector).norm(), 1e-12);
+}
+
+TYPED_TEST(InverseRotateTest, testMultipleColumns) {
+  Eigen::Matrix<double, 3, 4> matrix;
+  matrix << 0.3, -1.2, 2.5, 0.0,
+            1.7, 0.2, -0.9, 1.0,
+            -0.4, 0.8, 1.1, 2.0;
+  const typename TestFixture::Rotation rotation(rot::RotationQuaternionD(rot::EulerAnglesZyxD(0.9, -0.2, 1.4)));
+  const Eigen::Matrix<double, 3, 4> direct = rotation.inverseRotate(matrix);
+  const Eigen::Matrix<double, 3, 4> viaInverse = rotation.inverted().rotate(matrix);
+  EXPECT_NEAR(0.0, (direct - viaInverse).norm(), 1e-12);
+}
+
+TYPED_TEST(InverseRotateTest, testPhysicalVector) {
+  const typename TestFixture::Rotation rotation(rot::RotationQuaternionD(rot::EulerAnglesZyxD(0.4, -0.7, 1.1)));
+  const rot::Position3D position(0.3, -1.2, 2.5);
+  const rot::Position3D direct = rotation.inverseRotate(position);
+  const rot::Position3D viaInverse = rotation.inverted().rotate(position);
+  EXPECT_NEAR(0.0, (direct.toImplementation() - viaInverse.toImplementation()).norm(), 1e-12);
+}
+
+TEST(InverseRotateTest, testFloatTypes) {
+  const rot::RotationQuaternionF rotation(rot::EulerAnglesZyxF(0.4f, -0.7f, 1.1f));
+  const Eigen::Vector3f vector(0.3f, -1.2f, 2.5f);
+  EXPECT_NEAR(0.0f, (rotation.inverseRotate(vector) - rotation.inverted().rotate(vector)).norm(), 1e-6f);
+  EXPECT_NEAR(0.0f, (rot::RotationMatrixF(rotation).inverseRotate(vector) - rotation.inverted().rotate(vector)).norm(), 1e-5f);
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/NeonKernels.hpp"
+
+namespace rot = kindr;
+
+TEST(NeonKernelsTest, testMultiplyMatchesOperator) {
+  for (double angle1 = -2.8; angle1 < 3.0; angle1 += 0.57) {
+    for (double angle2 = -2.8; angle2 < 3.0; angle2 += 0.57) {
+      const rot::RotationQuaternionD lhs(rot::EulerAnglesZyxD(angle1, -0.4, 0.9));
+      const rot::RotationQuaternionD rhs(rot::EulerAnglesZyxD(0.2, angle2, -1.1));
+      const rot::RotationQuaternionD fast = rot::multiplyQuaternionsFast(lhs, rhs);
+      const rot::RotationQuaternionD expected = lhs*rhs;
+      EXPECT_TRUE(fast.isNear(expected, 1e-12)) << "angles " << angle1 << " " << angle2;
+    }
+  }
+}
+
+TEST(NeonKernelsTest, testMultiplyIdentity) {
+  const rot::RotationQuaternionD rotation(rot::EulerAnglesZyxD(0.4, -0.7, 1.1));
+  EXPECT_TRUE(rot::multiplyQuaternionsFast(rotation, rot::RotationQuaternionD()).isNear(rotation, 1e-14));
+  EXPECT_TRUE(rot::multiplyQuaternionsFast(rot::RotationQuaternionD(), rotation).isNear(rotation, 1e-14));
+  EXPECT_TRUE(rot::multiplyQuaternionsFast(rotation, rotation.inverted()).isNear(rot::RotationQuaternionD(), 1e-14));
+}
+
+TEST(NeonKernelsTest, testConvertToMatrixMatchesConversionTraits) {
+  for (double angle = -2.8; angle < 3.0; angle += 0.37) {
+    const rot::RotationQuaternionD quaternion(rot::EulerAnglesZyxD(angle, 0.7*angle, -0.3));
+    const rot::RotationMatrixD fast = rot::convertToRotationMatrixFast(quaternion);
+    const rot::RotationMatrixD expected(quaternion);
+    EXPECT_NEAR(0.0, (fast.matrix() - expected.matrix()).norm(), 1e-14) << "angle " << angle;
+  }
+}
+
+TEST(NeonKernelsTest, testConvertedMatrixRotatesLikeQuaternion) {
+  const rot::RotationQuaternionD quaternion(rot::EulerAnglesZyxD(0.9, -0.2, 1.4));
+  const Eigen::Vector3d vector(0.3, -1.2, 2.5);
+  EXPECT_NEAR(0.0, (rot::convertToRotationMatrixFast(quaternion).rotate(vector) - quaternion.rotate(vector)).norm(), 1e-13);
+}
+
+TEST(NeonKernelsTest, testFloatTypes) {
+  const rot::RotationQuaternionF lhs(rot::EulerAnglesZyxF(0.4f, -0.7f, 1.1f));
+  const rot::RotationQuaternionF rhs(rot::EulerAnglesZyxF(-1.2f, 0.3f, 0.9f));
+  EXPECT_TRUE(rot::multiplyQuaternionsFast(lhs, rhs).isNear(lhs*rhs, 1e-5f));
+  EXPECT_NEAR(0.0f, (rot::convertToRotationMatrixFast(lhs).matrix() - rot::RotationMatrixF(lhs).matrix()).norm(), 1e-6f);
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/QuaternionRateMapping.hpp"
+
+namespace rot = kindr;
+
+TEST(QuaternionRateMappingTest, testMatchesUncachedMappings) {
+  const rot::RotationQuaternionD rotation(rot::AngleAxisD(0.9, Eigen::Vector3d(1.0, -2.0, 0.5).normalized()));
+  const rot::QuaternionRateMappingD mapping(rotation);
+
+  const Eigen::Matrix<double, 4, 3> expectedLocal = 0.5*rotation.getLocalQuaternionDiffMatrix().transpose();
+  const Eigen::Matrix<double, 4, 3> expectedGlobal = 0.5*rotation.getGlobalQuaternionDiffMatrix().transpose();
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 3; j++) {
+      EXPECT_NEAR(expectedLocal(i, j), mapping.getLocalMappingFromAngularVelocityToDiff()(i, j), 1e-12);
+      EXPECT_NEAR(expectedGlobal(i, j), mapping.getGlobalMappingFromAngularVelocityToDiff()(i, j), 1e-12);
+      EXPECT_NEAR(4.0*expectedLocal(i, j), mapping.getLocalMappingFromDiffToAngularVelocity()(j, i), 1e-12);
+      EXPECT_NEAR(4.0*expectedGlobal(i, j), mapping.getGlobalMappingFromDiffToAngularVelocity()(j, i), 1e-12);
+    }
+  }
+}
+
+TEST(QuaternionRateMappingTest, testConversionsMatchTraits) {
+  const rot::RotationQuaternionD rotation(rot::AngleAxisD(-1.3, Eigen::Vector3d(0.2, 0.9, -0.4).normalized()));
+  rot::QuaternionRateMappingD mapping;
+  mapping.setAttitude(rotation);
+
+  // many velocities at the same attitude, converted with the cached matrices
+  for (int k = 0; k < 10; k++) {
+    const rot::LocalAngularVelocityD localVelocity(0.1*k, -0.2*k, 0.05*k + 0.3);
+    const rot::GlobalAngularVelocityD globalVelocity(-0.3*k, 0.1*k + 0.2, 0.07*k);
+
+    // matches the per-call trait conversion
+    const rot::RotationQuaternionDiffD expectedLocal(rotation, localVelocity);
+    const rot::RotationQuaternionDiffD diffLocal = mapping.convertToDiff(localVelocity);
+    EXPECT_NEAR(expectedLocal.w(), diffLocal.w(), 1e-12);
+    EXPECT_NEAR(expectedLocal.x(), diffLocal.x(), 1e-12);
+    EXPECT_NEAR(expectedLocal.y(), diffLocal.y(), 1e-12);
+    EXPECT_NEAR(expectedLocal.z(), diffLocal.z(), 1e-12);
+
+    const rot::RotationQuaternionDiffD expectedGlobal(rotation, globalVelocity);
+    const rot::RotationQuaternionDiffD diffGlobal = mapping.convertToDiff(globalVelocity);
+    EXPECT_NEAR(expectedGlobal.w(), diffGlobal.w(), 1e-12);
+    EXPECT_NEAR(expectedGlobal.x(), diffGlobal.x(), 1e-12);
+    EXPECT_NEAR(expectedGlobal.y(), diffGlobal.y(), 1e-12);
+    EXPECT_NEAR(expectedGlobal.z(), diffGlobal.z(), 1e-12);
+  }
+}
+
+TEST(QuaternionRateMappingTest, testAdjointRoundTrip) {
+  const rot::RotationQuaternionD rotation(rot::AngleAxisD(0.6, Eigen::Vector3d(-0.5, 0.3, 0.8).normalized()));
+  const rot::QuaternionRateMappingD mapping(rotation);
+
+  // the quaternion rate of a valid angular velocity maps back to that velocity
+  const rot::LocalAngularVelocityD localVelocity(0.4, -0.9, 0.2);
+  const rot::LocalAngularVelocityD localRecovered = mapping.convertToLocalAngularVelocity(mapping.convertToDiff(localVelocity));
+  EXPECT_NEAR(localVelocity.x(), localRecovered.x(), 1e-12);
+  EXPECT_NEAR(localVelocity.y(), localRecovered.y(), 1e-12);
+  EXPECT_NEAR(localVelocity.z(), localRecovered.z(), 1e-12);
+
+  const rot::GlobalAngularVelocityD globalVelocity(-0.1, 0.7, 0.5);
+  const rot::GlobalAngularVelocityD globalRecovered = mapping.convertToGlobalAngularVelocity(mapping.convertToDiff(globalVelocity));
+  EXPECT_NEAR(globalVelocity.x(), globalRecovered.x(), 1e-12);
+  EXPECT_NEAR(globalVelocity.y(), globalRecovered.y(), 1e-12);
+  EXPECT_NEAR(globalVelocity.z(), globalRecovered.z(), 1e-12);
+}
+
+TEST(QuaternionRateMappingTest, testBatchConversions) {
+  const rot::RotationQuaternionD rotation(rot::AngleAxisD(2.1, Eigen::Vector3d(0.3, -0.6, 0.7).normalized()));
+  const rot::QuaternionRateMappingD mapping(rotation);
+
+  Eigen::Matrix<double, 3, Eigen::Dynamic> velocities(3, 12);
+  for (int k = 0; k < velocities.cols(); k++) {
+    velocities.col(k) = Eigen::Vector3d(0.1*k, -0.05*k + 0.2, 0.03*k - 0.4);
+  }
+
+  Eigen::Matrix<double, 4, Eigen::Dynamic> diffs;
+  mapping.convertToDiff(velocities, diffs);
+  ASSERT_EQ(velocities.cols(), diffs.cols());
+  for (int k = 0; k < velocities.cols(); k++) {
+    const rot::RotationQuaternionDiffD expected = mapping.convertToDiff(rot::LocalAngularVelocityD(velocities.col(k)));
+    EXPECT_NEAR(expected.w(), diffs(0, k), 1e-12);
+    EXPECT_NEAR(expected.x(), diffs(1, k), 1e-12);
+    EXPECT_NEAR(expected.y(), diffs(2, k), 1e-12);
+    EXPECT_NEAR(expected.z(), diffs(3, k), 1e-12);
+  }
+
+  // batch adjoint maps the rates back onto the input velocities
+  Eigen::Matrix<double, 3, Eigen::Dynamic> recovered;
+  mapping.convertToLocalAngularVelocities(diffs, recovered);
+  ASSERT_EQ(velocities.cols(), recovered.cols());
+  for (int k = 0; k < velocities.cols(); k++) {
+    EXPECT_NEAR(velocities(0, k), recovered(0, k), 1e-12);
+    EXPECT_NEAR(velocities(1, k), recovered(1, k), 1e-12);
+    EXPECT_NEAR(velocities(2, k), recovered(2, k), 1e-12);
+  }
+
+  Eigen::Matrix<double, 4, Eigen::Dynamic> globalDiffs;
+  mapping.convertToDiffGlobal(velocities, globalDiffs);
+  Eigen::Matrix<double, 3, Eigen::Dynamic> globalRecovered;
+  mapping.convertToGlobalAngularVelocities(globalDiffs, globalRecovered);
+  for (int k = 0; k < velocities.cols(); k++) {
+    EXPECT_NEAR(velocities(0, k), globalRecovered(0, k), 1e-12);
+    EXPECT_NEAR(velocities(1, k), globalRecovered(1, k), 1e-12);
+    EXPECT_NEAR(velocities(2, k), globalRecovered(2, k), 1e-12);
+  }
+}
+
+TEST(QuaternionRateMappingTest, testFloatTypes) {
+  const rot::RotationQuaternionF rotation(rot::AngleAxisF(0.8f, Eigen::Vector3f(0.0f, 1.0f, 0.0f)));
+  const rot::QuaternionRateMappingF mapping(rotation);
+
+  const rot::LocalAngularVelocityF angularVelocity(0.3f, -0.1f, 0.6f);
+  const rot::RotationQuaternionDiffF expected(rotation, angularVelocity);
+  const rot::RotationQuaternionDiffF diff = mapping.convertToDiff(angularVelocity);
+  EXPECT_NEAR(expected.w(), diff.w(), 1e-6f);
+  EXPECT_NEAR(expected.x(), diff.x(), 1e-6f);
+  EXPECT_NEAR(expected.y(), diff.y(), 1e-6f);
+  EXPECT_NEAR(expected.z(), diff.z(), 1e-6f);
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/rotations/RotationBatch.hpp"
+
+namespace rot = kindr;
+
+static Eigen::Matrix3d sampleCovariance(int seed) {
+  Eigen::Matrix3d square;
+  square << 1.0 + 0.1*seed, 0.2, -0.3,
+            0.4, 2.0 - 0.05*seed, 0.1,
+            -0.2, 0.3, 0.5 + 0.2*seed;
+  return Eigen::Matrix3d(square*square.transpose());
+}
+
+TEST(RotateCovarianceTest, testMatchesTwoGemmReference) {
+  const rot::RotationQuaternionD rotation(rot::EulerAnglesZyxD(0.4, -0.7, 1.1));
+  const Eigen::Matrix3d covariance = sampleCovariance(1);
+  const Eigen::Matrix3d rotated = rotation.rotateCovariance(covariance);
+  const Eigen::Matrix3d rotationMatrix = rot::RotationMatrixD(rotation).matrix();
+  const Eigen::Matrix3d expected = rotationMatrix*covariance*rotationMatrix.transpose();
+  EXPECT_NEAR(0.0, (rotated - expected).norm(), 1e-12);
+}
+
+TEST(RotateCovarianceTest, testResultIsExactlySymmetric) {
+  const rot::RotationQuaternionD rotation(rot::EulerAnglesZyxD(-1.2, 0.3, 0.9));
+  const Eigen::Matrix3d rotated = rotation.rotateCovariance(sampleCovariance(2));
+  // the kernel mirrors the upper triangle, so symmetry holds bit-exactly
+  EXPECT_EQ(rotated(1,0), rotated(0,1));
+  EXPECT_EQ(rotated(2,0), rotated(0,2));
+  EXPECT_EQ(rotated(2,1), rotated(1,2));
+}
+
+TEST(RotateCovarianceTest, testIdentityRotation) {
+  const rot::RotationQuaternionD identity;
+  const Eigen::Matrix3d covariance = sampleCovariance(3);
+  EXPECT_NEAR(0.0, (identity.rotateCovariance(covariance) - covariance).norm(), 1e-14);
+}
+
+TEST(RotateCovarianceTest, testAllRepresentationsAgree) {
+  const rot::EulerAnglesZyxD euler(0.5, -0.2, 0.8);
+  const Eigen::Matrix3d covariance = sampleCovariance(4);
+  const Eigen::Matrix3d fromQuaternion = rot::RotationQuaternionD(euler).rotateCovariance(covariance);
+  EXPECT_NEAR(0.0, (euler.rotateCovariance(covariance) - fromQuaternion).norm(), 1e-12);
+  EXPECT_NEAR(0.0, (rot::AngleAxisD(euler).rotateCovariance(covariance) - fromQuaternion).norm(), 1e-12);
+  EXPECT_NEAR(0.0, (rot::RotationMatrixD(euler).rotateCovariance(covariance) - fromQuaternion).norm(), 1e-12);
+}
+
+TEST(RotateCovarianceTest, testBatchMatchesPerCovariance) {
+  const rot::RotationQuaternionD rotation(rot::EulerAnglesZyxD(0.9, 0.1, -0.4));
+  std::vector<Eigen::Matrix3d, Eigen::aligned_allocator<Eigen::Matrix3d>> covariances;
+  for (int k = 0; k < 37; k++) {
+    covariances.push_back(sampleCovariance(k));
+  }
+  std::vector<Eigen::Matrix3d, Eigen::aligned_allocator<Eigen::Matrix3d>> rotated;
+  rot::rotateCovarianceBatch(rotation, covariances, rotated);
+  ASSERT_EQ(covariances.size(), rotated.size());
+  for (std::size_t k = 0; k < covariances.size(); k++) {
+    EXPECT_NEAR(0.0, (rotated[k] - rotation.rotateCovariance(covariances[k])).norm(), 1e-14);
+  }
+
+  // an empty batch resizes the output to zero
+  covariances.clear();
+  rot::rotateCovarianceBatch(rotation, covariances, rotated);
+  EXPECT_EQ(0u, rotated.size());
+}
+
+TEST(RotateCovarianceTest, testFloatTypes) {
+  const rot::RotationQuaternionF rotation(rot::EulerAnglesZyxF(0.4f, -0.7f, 1.1f));
+  const Eigen::Matrix3f covariance = sampleCovariance(5).cast<float>();
+  const Eigen::Matrix3f rotationMatrix = rot::RotationMatrixF(rotation).matrix();
+  const Eigen::Matrix3f expected = rotationMatrix*covariance*rotationMatrix.transpose();
+  EXPECT_NEAR(0.0f, (rotation.rotateCovariance(covariance) - expected).norm(), 1e-5f);
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/rotations/CachedRotation.hpp"
+
+namespace rot = kindr;
+
+template<typename Rotation_>
+struct RotateInPlaceTest : public ::testing::Test {
+  typedef Rotation_ Rotation;
+  typedef typename Rotation_::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar, 3, Eigen::Dynamic> Matrix3X;
+
+  static Matrix3X sampleMatrix(int cols) {
+    Matrix3X matrix(3, cols);
+    for (int i = 0; i < cols; i++) {
+      matrix.col(i) = Eigen::Vector3d(0.3*i - 1.0, -0.7 + 0.2*i, 1.1 - 0.5*i).cast<Scalar>();
+    }
+    return matrix;
+  }
+};
+
+typedef ::testing::Types<
+    rot::RotationQuaternionD,
+    rot::RotationMatrixD,
+    rot::AngleAxisD,
+    rot::RotationVectorD,
+    rot::EulerAnglesZyxD,
+    rot::EulerAnglesXyzD,
+    rot::CachedRotationD
+> Types;
+
+TYPED_TEST_CASE(RotateInPlaceTest, Types);
+
+TYPED_TEST(RotateInPlaceTest, testCallerBufferMatchesByValue) {
+  typedef typename TestFixture::Matrix3X Matrix3X;
+  const typename TestFixture::Rotation rotation(rot::RotationQuaternionD(rot::EulerAnglesZyxD(0.4, -0.7, 1.1)));
+  const Matrix3X input = TestFixture::sampleMatrix(7);
+  const Matrix3X expected = rotation.rotate(input);
+
+  Matrix3X output(3, 7);
+  const double* data = output.data();
+  rotation.rotate(input, output);
+  EXPECT_EQ(data, output.data()); // correctly sized buffer is reused, not reallocated
+  EXPECT_NEAR(0.0, (output - expected).norm(), 1e-12);
+
+  Matrix3X resized;
+  rotation.rotate(input, resized);
+  EXPECT_EQ(7, resized.cols());
+  EXPECT_NEAR(0.0, (resized - expected).norm(), 1e-12);
+}
+
+TYPED_TEST(RotateInPlaceTest, testInPlaceMatchesByValue) {
+  typedef typename TestFixture::Matrix3X Matrix3X;
+  const typename TestFixture::Rotation rotation(rot::RotationQuaternionD(rot::EulerAnglesZyxD(-1.3, 0.5, 0.8)));
+  Matrix3X matrix = TestFixture::sampleMatrix(5);
+  const Matrix3X expected = rotation.rotate(matrix);
+  const double* data = matrix.data();
+  rotation.rotateInPlace(matrix);
+  EXPECT_EQ(data, matrix.data());
+  EXPECT_NEAR(0.0, (matrix - expected).norm(), 1e-12);
+}
+
+TYPED_TEST(RotateInPlaceTest, testInverseVariants) {
+  typedef typename TestFixture::Matrix3X Matrix3X;
+  const typename TestFixture::Rotation rotation(rot::RotationQuaternionD(rot::EulerAnglesZyxD(0.9, -0.2, 1.4)));
+  const Matrix3X input = TestFixture::sampleMatrix(6);
+  const Matrix3X expected = rotation.inverseRotate(input);
+
+  Matrix3X output;
+  rotation.inverseRotate(input, output);
+  EXPECT_NEAR(0.0, (output - expected).norm(), 1e-12);
+
+  Matrix3X matrix = input;
+  rotation.inverseRotateInPlace(matrix);
+  EXPECT_NEAR(0.0, (matrix - expected).norm(), 1e-12);
+
+  rotation.rotateInPlace(matrix);
+  EXPECT_NEAR(0.0, (matrix - input).norm(), 1e-12); // round trip
+}
+
+TEST(RotateInPlaceTest, testFixedWidth) {
+  const rot::RotationQuaternionD rotation(rot::EulerAnglesZyxD(0.4, -0.7, 1.1));
+  Eigen::Matrix<double, 3, 4> matrix;
+  matrix << 0.3, -1.2, 2.5, 0.0,
+            1.7, 0.2, -0.9, 1.0,
+            -0.4, 0.8, 1.1, 2.0;
+  const Eigen::Matrix<double, 3, 4> expected = rotation.rotate(matrix);
+  Eigen::Matrix<double, 3, 4> output;
+  rotation.rotate(matrix, output);
+  EXPECT_NEAR(0.0, (output - expected).norm(), 1e-12);
+  rotation.rotateInPlace(matrix);
+  EXPECT_NEAR(0.0, (matrix - expected).norm(), 1e-12);
+}
+
+TEST(RotateInPlaceTest, testFloatTypes) {
+  const rot::RotationQuaternionF rotation(rot::EulerAnglesZyxF(0.4f, -0.7f, 1.1f));
+  Eigen::Matrix<float, 3, Eigen::Dynamic> matrix(3, 3);
+  matrix << 0.3f, -1.2f, 2.5f,
+            1.7f, 0.2f, -0.9f,
+            -0.4f, 0.8f, 1.1f;
+  const Eigen::Matrix<float, 3, Eigen::Dynamic> expected = rotation.rotate(matrix);
+  rotation.rotateInPlace(matrix);
+  EXPECT_NEAR(0.0f, (matrix - expected).norm(), 1e-6f);
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/RotationAverage.hpp"
+
+namespace rot = kindr;
+
+TEST(RotationAverageTest, testSingleSample) {
+  const rot::RotationQuaternionD rotation(rot::EulerAnglesZyxD(0.4, -0.7, 1.1));
+  rot::RotationAverageD average;
+  average.add(rotation);
+  EXPECT_EQ(1u, average.getNumSamples());
+  EXPECT_EQ(1.0, average.getWeightSum());
+  EXPECT_TRUE(average.get().isNear(rotation, 1e-10));
+}
+
+TEST(RotationAverageTest, testIdenticalSamplesAndSignInvariance) {
+  const rot::RotationQuaternionD rotation(rot::AngleAxisD(1.2, Eigen::Vector3d(0.0, 1.0, 0.0)));
+  const rot::RotationQuaternionD negated(-rotation.w(), -rotation.x(), -rotation.y(), -rotation.z());
+  rot::RotationAverageD average;
+  // q and -q represent the same rotation and must contribute identically
+  average.add(rotation);
+  average.add(negated);
+  average.add(rotation);
+  EXPECT_TRUE(average.get().isNear(rotation, 1e-10));
+}
+
+TEST(RotationAverageTest, testEqualWeightsMatchInterpolationMidpoint) {
+  const rot::RotationQuaternionD first(rot::AngleAxisD(0.4, Eigen::Vector3d(0.0, 0.0, 1.0)));
+  const rot::RotationQuaternionD second(rot::AngleAxisD(1.0, Eigen::Vector3d(0.0, 0.0, 1.0)));
+  rot::RotationAverageD average;
+  average.add(first);
+  average.add(second);
+  // same axis: the chordal mean is the rotation about the mean angle
+  const rot::RotationQuaternionD expected(rot::AngleAxisD(0.7, Eigen::Vector3d(0.0, 0.0, 1.0)));
+  EXPECT_TRUE(average.get().isNear(expected, 1e-10));
+}
+
+TEST(RotationAverageTest, testWeightsShiftTheMean) {
+  const rot::RotationQuaternionD first(rot::AngleAxisD(0.0, Eigen::Vector3d(1.0, 0.0, 0.0)));
+  const rot::RotationQuaternionD second(rot::AngleAxisD(0.8, Eigen::Vector3d(1.0, 0.0, 0.0)));
+  rot::RotationAverageD average;
+  average.add(first, 3.0);
+  average.add(second, 1.0);
+  EXPECT_EQ(4.0, average.getWeightSum());
+
+  const rot::AngleAxisD mean(average.get());
+  // mean angle is pulled towards the heavier sample: below the midpoint 0.4
+  EXPECT_LT(mean.angle(), 0.4);
+  EXPECT_GT(mean.angle(), 0.0);
+}
+
+TEST(RotationAverageTest, testNoisySamplesRecoverTruth) {
+  const rot::RotationQuaternionD truth(rot::EulerAnglesZyxD(0.9, -0.3, 0.5));
+  rot::RotationAverageD average;
+  // 8 samples perturbed symmetrically around the truth (multi-IMU setting)
+  for (int k = 0; k < 8; k++) {
+    const int pair = k/2;
+    const double sign = (k % 2 == 0) ? 1.0 : -1.0;
+    const Eigen::Vector3d perturbation = sign*0.05*Eigen::Vector3d(std::cos(0.7*pair), std::sin(1.3*pair), std::cos(2.1*pair));
+    average.add(truth.boxPlus(perturbation));
+  }
+  EXPECT_EQ(8u, average.getNumSamples());
+  const Eigen::Vector3d error = average.get().boxMinus(truth);
+  EXPECT_LT(error.norm(), 5e-3);
+}
+
+TEST(RotationAverageTest, testResetAndMixedRepresentations) {
+  rot::RotationAverageD average;
+  average.add(rot::RotationQuaternionD(rot::EulerAnglesZyxD(0.5, 0.0, 0.0)));
+  average.reset();
+  EXPECT_EQ(0u, average.getNumSamples());
+  EXPECT_EQ(0.0, average.getWeightSum());
+
+  // any RotationBase parameterization can be accumulated
+  const rot::EulerAnglesZyxD euler(0.3, -0.2, 0.1);
+  average.add(euler);
+  average.add(rot::RotationMatrixD(euler));
+  average.add(rot::AngleAxisD(euler));
+  EXPECT_TRUE(average.get().isNear(rot::RotationQuaternionD(euler), 1e-10));
+}
+
+TEST(RotationAverageTest, testFloatTypes) {
+  const rot::RotationQuaternionF rotation(rot::EulerAnglesZyxF(0.4f, -0.7f, 1.1f));
+  rot::RotationAverageF average;
+  for (int k = 0; k < 4; k++) {
+    average.add(rotation, 0.25f);
+  }
+  EXPECT_TRUE(average.get().isNear(rotation, 1e-5f));
+}
@@ -0,0 +1,390 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/rotations/RotationBatch.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+namespace rot = kindr;
+
+template <typename PrimType_>
+struct RotationBatchTest : public ::testing::Test {
+  typedef PrimType_ Scalar;
+  typedef rot::RotationQuaternion<Scalar> RotationQuaternion;
+  typedef rot::VectorBatch3<Scalar> VectorBatch3;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector;
+  typedef Eigen::Matrix<Scalar, 3, Eigen::Dynamic> Matrix3X;
+};
+
+typedef ::testing::Types<double, float> PrimTypes;
+TYPED_TEST_CASE(RotationBatchTest, PrimTypes);
+
+TYPED_TEST(RotationBatchTest, testVectorBatchStorage) {
+  typedef typename TestFixture::VectorBatch3 VectorBatch3;
+  typedef typename TestFixture::Vector Vector;
+
+  VectorBatch3 batch;
+  ASSERT_EQ(0u, batch.size());
+  batch.append(Vector(1.0, 2.0, 3.0));
+  batch.append(Vector(-4.0, 5.0, -6.0));
+  ASSERT_EQ(2u, batch.size());
+  EXPECT_NEAR(1.0, batch.getVector(0)(0), 1e-6);
+  EXPECT_NEAR(2.0, batch.getVector(0)(1), 1e-6);
+  EXPECT_NEAR(3.0, batch.getVector(0)(2), 1e-6);
+  EXPECT_NEAR(-4.0, batch.getVector(1)(0), 1e-6);
+  EXPECT_NEAR(5.0, batch.getVector(1)(1), 1e-6);
+  EXPECT_NEAR(-6.0, batch.getVector(1)(2), 1e-6);
+
+  typename TestFixture::Matrix3X matrix = batch.toImplementation();
+  VectorBatch3 batch2(matrix);
+  ASSERT_EQ(batch.size(), batch2.size());
+  for (int i = 0; i < 3; i++) {
+    EXPECT_NEAR(batch.getVector(1)(i), batch2.getVector(1)(i), 1e-6);
+  }
+}
+
+TYPED_TEST(RotationBatchTest, testRotateBatchMatchesRotate) {
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+  typedef typename TestFixture::VectorBatch3 VectorBatch3;
+  typedef typename TestFixture::Vector Vector;
+  typedef typename TestFixture::Scalar Scalar;
+
+  RotationQuaternion rotQuat;
+  rotQuat.setRandom();
+
+  const std::size_t size = 37; // odd size to exercise the scalar remainder of the kernels
+  VectorBatch3 input(size);
+  for (std::size_t i = 0; i < size; i++) {
+    input.x()[i] = Scalar(0.1)*Scalar(i);
+    input.y()[i] = Scalar(-0.2)*Scalar(i) + Scalar(1.0);
+    input.z()[i] = Scalar(0.3)*Scalar(i) - Scalar(2.0);
+  }
+
+  VectorBatch3 output;
+  rot::rotateBatch(rotQuat, input, output);
+  ASSERT_EQ(size, output.size());
+  for (std::size_t i = 0; i < size; i++) {
+    const Vector expected = rotQuat.rotate(input.getVector(i));
+    for (int k = 0; k < 3; k++) {
+      EXPECT_NEAR(expected(k), output.getVector(i)(k), 1e-4);
+    }
+  }
+
+  VectorBatch3 reversed;
+  rot::inverseRotateBatch(rotQuat, output, reversed);
+  for (std::size_t i = 0; i < size; i++) {
+    for (int k = 0; k < 3; k++) {
+      EXPECT_NEAR(input.getVector(i)(k), reversed.getVector(i)(k), 1e-3);
+    }
+  }
+}
+
+TYPED_TEST(RotationBatchTest, testRotateBatchInPlace) {
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+  typedef typename TestFixture::VectorBatch3 VectorBatch3;
+  typedef typename TestFixture::Vector Vector;
+  typedef typename TestFixture::Scalar Scalar;
+
+  RotationQuaternion rotQuat;
+  rotQuat.setRandom();
+
+  const std::size_t size = 131; // larger than a kernel block, with a remainder
+  VectorBatch3 batch(size);
+  for (std::size_t i = 0; i < size; i++) {
+    batch.x()[i] = Scalar(0.1)*Scalar(i);
+    batch.y()[i] = Scalar(-0.2)*Scalar(i) + Scalar(1.0);
+    batch.z()[i] = Scalar(0.3)*Scalar(i) - Scalar(2.0);
+  }
+  const VectorBatch3 input = batch;
+
+  // the documented contract allows the output to alias the input
+  rot::rotateBatch(rotQuat, batch, batch);
+  ASSERT_EQ(size, batch.size());
+  for (std::size_t i = 0; i < size; i++) {
+    const Vector expected = rotQuat.rotate(input.getVector(i));
+    for (int k = 0; k < 3; k++) {
+      EXPECT_NEAR(expected(k), batch.getVector(i)(k), 1e-4);
+    }
+  }
+}
+
+TYPED_TEST(RotationBatchTest, testComposeBatchMatchesOperator) {
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+  typedef rot::QuaternionBatch<typename TestFixture::Scalar> QuaternionBatch;
+
+  const std::size_t size = 13;
+  QuaternionBatch lhs, rhs;
+  for (std::size_t i = 0; i < size; i++) {
+    RotationQuaternion rotQuat1, rotQuat2;
+    lhs.append(rotQuat1.setRandom());
+    rhs.append(rotQuat2.setRandom());
+  }
+
+  QuaternionBatch products;
+  rot::composeBatch(lhs, rhs, products);
+  ASSERT_EQ(size, products.size());
+  for (std::size_t i = 0; i < size; i++) {
+    const RotationQuaternion expected = lhs.getRotationQuaternion(i)*rhs.getRotationQuaternion(i);
+    EXPECT_TRUE(expected.isNear(products.getRotationQuaternion(i), 1e-4));
+  }
+
+  // In-place accumulation chains the same products without a second output batch.
+  rot::accumulateBatch(lhs, rhs);
+  for (std::size_t i = 0; i < size; i++) {
+    EXPECT_TRUE(products.getRotationQuaternion(i).isNear(lhs.getRotationQuaternion(i), 1e-4));
+  }
+}
+
+TYPED_TEST(RotationBatchTest, testQuaternionBatchIdentityFill) {
+  typedef rot::QuaternionBatch<typename TestFixture::Scalar> QuaternionBatch;
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+
+  QuaternionBatch batch(5);
+  ASSERT_EQ(5u, batch.size());
+  for (std::size_t i = 0; i < batch.size(); i++) {
+    EXPECT_TRUE(RotationQuaternion().isNear(batch.getRotationQuaternion(i), 1e-6));
+  }
+}
+
+TYPED_TEST(RotationBatchTest, testExpMapBatchMatchesExponentialMap) {
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+  typedef typename TestFixture::VectorBatch3 VectorBatch3;
+  typedef typename TestFixture::Scalar Scalar;
+  typedef rot::QuaternionBatch<Scalar> QuaternionBatch;
+
+  const std::size_t size = 21;
+  VectorBatch3 tangents(size);
+  for (std::size_t i = 0; i < size; i++) {
+    tangents.x()[i] = Scalar(0.05)*Scalar(i) - Scalar(0.4);
+    tangents.y()[i] = Scalar(-0.03)*Scalar(i) + Scalar(0.2);
+    tangents.z()[i] = Scalar(0.07)*Scalar(i) - Scalar(0.6);
+  }
+  // include the small-angle branch
+  tangents.x()[3] = Scalar(1e-9); tangents.y()[3] = Scalar(0.0); tangents.z()[3] = Scalar(0.0);
+  tangents.x()[4] = Scalar(0.0); tangents.y()[4] = Scalar(0.0); tangents.z()[4] = Scalar(0.0);
+
+  QuaternionBatch output;
+  rot::expMapBatch(tangents, output);
+  ASSERT_EQ(size, output.size());
+  for (std::size_t i = 0; i < size; i++) {
+    RotationQuaternion expected;
+    expected = expected.exponentialMap(tangents.getVector(i));
+    EXPECT_TRUE(expected.isNear(output.getRotationQuaternion(i), 1e-4));
+  }
+
+  VectorBatch3 reversed;
+  rot::logMapBatch(output, reversed);
+  for (std::size_t i = 0; i < size; i++) {
+    for (int k = 0; k < 3; k++) {
+      EXPECT_NEAR(tangents.getVector(i)(k), reversed.getVector(i)(k), 1e-4);
+    }
+  }
+}
+
+TYPED_TEST(RotationBatchTest, testBoxOperationsBatchMatchBoxPlusBoxMinus) {
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+  typedef typename TestFixture::VectorBatch3 VectorBatch3;
+  typedef typename TestFixture::Scalar Scalar;
+  typedef rot::QuaternionBatch<Scalar> QuaternionBatch;
+
+  const std::size_t size = 17;
+  QuaternionBatch rotations, others;
+  VectorBatch3 tangents(size);
+  for (std::size_t i = 0; i < size; i++) {
+    RotationQuaternion rotQuat1, rotQuat2;
+    rotations.append(rotQuat1.setRandom());
+    others.append(rotQuat2.setRandom());
+    tangents.x()[i] = Scalar(0.04)*Scalar(i) - Scalar(0.3);
+    tangents.y()[i] = Scalar(-0.02)*Scalar(i) + Scalar(0.1);
+    tangents.z()[i] = Scalar(0.06)*Scalar(i) - Scalar(0.5);
+  }
+
+  QuaternionBatch retracted = rotations;
+  rot::boxPlusBatch(retracted, tangents);
+  for (std::size_t i = 0; i < size; i++) {
+    const RotationQuaternion expected = rotations.getRotationQuaternion(i).boxPlus(tangents.getVector(i));
+    EXPECT_TRUE(expected.isNear(retracted.getRotationQuaternion(i), 1e-4));
+  }
+
+  VectorBatch3 differences;
+  rot::boxMinusBatch(rotations, others, differences);
+  ASSERT_EQ(size, differences.size());
+  for (std::size_t i = 0; i < size; i++) {
+    const typename TestFixture::Vector expected = rotations.getRotationQuaternion(i).boxMinus(others.getRotationQuaternion(i));
+    for (int k = 0; k < 3; k++) {
+      EXPECT_NEAR(expected(k), differences.getVector(i)(k), 1e-3);
+    }
+  }
+}
+
+TYPED_TEST(RotationBatchTest, testSetRandomBatch) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef rot::QuaternionBatch<Scalar> QuaternionBatch;
+
+  QuaternionBatch batch(64);
+  rot::setRandomBatch(batch);
+  bool allIdentity = true;
+  for (std::size_t i = 0; i < batch.size(); i++) {
+    const Scalar norm = sqrt(batch.w()[i]*batch.w()[i] + batch.x()[i]*batch.x()[i] +
+                             batch.y()[i]*batch.y()[i] + batch.z()[i]*batch.z()[i]);
+    EXPECT_NEAR(1.0, norm, 1e-5);
+    allIdentity = allIdentity && (batch.w()[i] > Scalar(1.0 - 1e-6));
+  }
+  EXPECT_FALSE(allIdentity);
+}
+
+TYPED_TEST(RotationBatchTest, testConvertToRotationMatrixBatch) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef rot::QuaternionBatch<Scalar> QuaternionBatch;
+  typedef rot::RotationQuaternion<Scalar> RotationQuaternion;
+  typedef rot::RotationMatrix<Scalar> RotationMatrix;
+
+  const std::size_t size = 37;  // not a multiple of any vector width
+  QuaternionBatch batch;
+  for (std::size_t i = 0; i < size; i++) {
+    batch.append(RotationQuaternion(rot::EulerAnglesZyx<Scalar>(Scalar(0.05)*Scalar(i),
+                                                                Scalar(-0.03)*Scalar(i),
+                                                                Scalar(0.07)*Scalar(i))));
+  }
+
+  Eigen::Matrix<Scalar, 9, Eigen::Dynamic> packed;
+  rot::convertToRotationMatrixBatch(batch, packed);
+  ASSERT_EQ(static_cast<Eigen::Index>(size), packed.cols());
+
+  for (std::size_t i = 0; i < size; i++) {
+    const Eigen::Matrix<Scalar, 3, 3> expected = RotationMatrix(batch.getRotationQuaternion(i)).matrix();
+    const Eigen::Map<const Eigen::Matrix<Scalar, 3, 3>> actual(packed.col(i).data());
+    for (int r = 0; r < 3; r++) {
+      for (int c = 0; c < 3; c++) {
+        EXPECT_NEAR(expected(r, c), actual(r, c), 1e-6) << "matrix " << i;
+      }
+    }
+  }
+}
+
+TYPED_TEST(RotationBatchTest, testConvertToRotationMatrixBatchEdgeCases) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef rot::QuaternionBatch<Scalar> QuaternionBatch;
+
+  // empty batch resizes the output to zero columns
+  QuaternionBatch empty;
+  Eigen::Matrix<Scalar, 9, Eigen::Dynamic> packed(9, 3);
+  rot::convertToRotationMatrixBatch(empty, packed);
+  EXPECT_EQ(0, packed.cols());
+
+  // q and -q map to the same rotation matrix
+  QuaternionBatch batch(2);
+  const rot::RotationQuaternion<Scalar> rotation(rot::AngleAxis<Scalar>(Scalar(1.2), 0, 1, 0));
+  batch.w()[0] = rotation.w(); batch.x()[0] = rotation.x();
+  batch.y()[0] = rotation.y(); batch.z()[0] = rotation.z();
+  batch.w()[1] = -rotation.w(); batch.x()[1] = -rotation.x();
+  batch.y()[1] = -rotation.y(); batch.z()[1] = -rotation.z();
+  rot::convertToRotationMatrixBatch(batch, packed);
+  for (int k = 0; k < 9; k++) {
+    EXPECT_NEAR(packed(k, 0), packed(k, 1), 1e-6);
+  }
+}
+
+TYPED_TEST(RotationBatchTest, testSetFromVectorsBatch) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Vector Vector;
+  typedef rot::VectorBatch3<Scalar> VectorBatch3;
+  typedef rot::QuaternionBatch<Scalar> QuaternionBatch;
+
+  const std::size_t size = 41;
+  VectorBatch3 from(size), to(size);
+  for (std::size_t i = 0; i < size; i++) {
+    // non-unit inputs: the kernel normalizes internally
+    const Vector u(Scalar(2.0)*cos(Scalar(0.4)*Scalar(i)), sin(Scalar(0.9)*Scalar(i)), Scalar(0.5));
+    const Vector v(sin(Scalar(1.1)*Scalar(i)), Scalar(1.5), cos(Scalar(0.3)*Scalar(i)));
+    from.x()[i] = u(0); from.y()[i] = u(1); from.z()[i] = u(2);
+    to.x()[i] = v(0); to.y()[i] = v(1); to.z()[i] = v(2);
+  }
+
+  QuaternionBatch rotations;
+  rot::setFromVectorsBatch(from, to, rotations);
+  ASSERT_EQ(size, rotations.size());
+  for (std::size_t i = 0; i < size; i++) {
+    const Vector u = from.getVector(i).normalized();
+    const Vector v = to.getVector(i).normalized();
+    const Vector rotated = rotations.getRotationQuaternion(i).rotate(u);
+    for (int k = 0; k < 3; k++) {
+      EXPECT_NEAR(v(k), rotated(k), 1e-5) << "pair " << i;
+    }
+  }
+}
+
+TYPED_TEST(RotationBatchTest, testSetFromVectorsBatchAntiparallel) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Vector Vector;
+  typedef rot::VectorBatch3<Scalar> VectorBatch3;
+  typedef rot::QuaternionBatch<Scalar> QuaternionBatch;
+
+  // exactly antiparallel pairs along each axis and a skew direction
+  VectorBatch3 from, to;
+  const Vector directions[4] = {Vector(1, 0, 0), Vector(0, 1, 0), Vector(0, 0, 1),
+                                Vector(Scalar(0.6), Scalar(-0.8), 0)};
+  for (const Vector& direction : directions) {
+    from.append(direction);
+    to.append(Vector(-direction));
+  }
+
+  QuaternionBatch rotations;
+  rot::setFromVectorsBatch(from, to, rotations);
+  for (std::size_t i = 0; i < from.size(); i++) {
+    const Vector rotated = rotations.getRotationQuaternion(i).rotate(from.getVector(i));
+    for (int k = 0; k < 3; k++) {
+      EXPECT_NEAR(to.getVector(i)(k), rotated(k), 1e-5) << "pair " << i;
+    }
+    // a half turn has zero real part
+    EXPECT_NEAR(0.0, rotations.getRotationQuaternion(i).w(), 1e-6);
+  }
+}
+
+TYPED_TEST(RotationBatchTest, testSetFromUnitVectorsBatchMatchesGeneral) {
+  typedef typename TestFixture::Scalar Scalar;
+  typedef typename TestFixture::Vector Vector;
+  typedef rot::VectorBatch3<Scalar> VectorBatch3;
+  typedef rot::QuaternionBatch<Scalar> QuaternionBatch;
+
+  const std::size_t size = 16;
+  VectorBatch3 from(size), to(size);
+  for (std::size_t i = 0; i < size; i++) {
+    const Vector u = Vector(cos(Scalar(0.4)*Scalar(i)), sin(Scalar(0.9)*Scalar(i)), Scalar(0.5)).normalized();
+    const Vector v = Vector(sin(Scalar(1.1)*Scalar(i)), Scalar(1.5), cos(Scalar(0.3)*Scalar(i))).normalized();
+    from.x()[i] = u(0); from.y()[i] = u(1); from.z()[i] = u(2);
+    to.x()[i] = v(0); to.y()[i] = v(1); to.z()[i] = v(2);
+  }
+
+  QuaternionBatch general, unit;
+  rot::setFromVectorsBatch(from, to, general);
+  rot::setFromUnitVectorsBatch(from, to, unit);
+  for (std::size_t i = 0; i < size; i++) {
+    EXPECT_TRUE(general.getRotationQuaternion(i).isNear(unit.getRotationQuaternion(i), 1e-5));
+  }
+}
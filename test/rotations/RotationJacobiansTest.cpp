@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include "kindr/rotations/RotationJacobians.hpp"
+#include "kindr/common/gtest_eigen.hpp"
+
+namespace rot = kindr;
+
+typedef Eigen::Vector3d Vector3;
+typedef Eigen::Vector4d Vector4;
+
+// Homogeneous rotation expression the quaternion Jacobian differentiates:
+// coincides with rotate() for unit quaternions but is defined for any 4-vector.
+static Vector3 rotateHomogeneous(const Vector4& quat, const Vector3& vector) {
+  const double w = quat(0);
+  const Vector3 imag = quat.tail<3>();
+  return (w*w - imag.squaredNorm())*vector + 2.0*imag.dot(vector)*imag + 2.0*w*imag.cross(vector);
+}
+
+TEST(RotationJacobiansTest, testJacobianOfRotateWrtQuaternion) {
+  rot::RotationQuaternionD rotQuat;
+  rotQuat.setRandom();
+  const Vector3 vector(0.4, -1.2, 2.1);
+  const Eigen::Matrix<double, 3, 4> jacobian = rot::getJacobianOfRotateWrtQuaternion(rotQuat, vector);
+
+  const double h = 1.0e-7;
+  Vector4 quat(rotQuat.w(), rotQuat.x(), rotQuat.y(), rotQuat.z());
+  for (int i = 0; i < 4; i++) {
+    Vector4 quatPlus = quat;
+    Vector4 quatMinus = quat;
+    quatPlus(i) += h;
+    quatMinus(i) -= h;
+    const Vector3 numeric = (rotateHomogeneous(quatPlus, vector) - rotateHomogeneous(quatMinus, vector))/(2.0*h);
+    for (int k = 0; k < 3; k++) {
+      EXPECT_NEAR(numeric(k), jacobian(k, i), 1e-5);
+    }
+  }
+}
+
+TEST(RotationJacobiansTest, testJacobianOfRotateWrtRotationVector) {
+  rot::RotationVectorD rotVec(0.7, -0.3, 1.1);
+  const Vector3 vector(-0.8, 0.5, 1.7);
+  const Eigen::Matrix3d jacobian = rot::getJacobianOfRotateWrtRotationVector(rotVec, vector);
+
+  const double h = 1.0e-7;
+  for (int i = 0; i < 3; i++) {
+    Vector3 phiPlus = rotVec.toImplementation();
+    Vector3 phiMinus = rotVec.toImplementation();
+    phiPlus(i) += h;
+    phiMinus(i) -= h;
+    const Vector3 numeric = (rot::RotationVectorD(phiPlus).rotate(vector)
+                             - rot::RotationVectorD(phiMinus).rotate(vector))/(2.0*h);
+    for (int k = 0; k < 3; k++) {
+      EXPECT_NEAR(numeric(k), jacobian(k, i), 1e-5);
+    }
+  }
+}
+
+TEST(RotationJacobiansTest, testJacobianOfRotateWrtAngleAxis) {
+  const double angle = 0.9;
+  const Vector3 axis = Vector3(0.2, -1.0, 0.4).normalized();
+  const Vector3 vector(1.3, 0.2, -0.6);
+  const Eigen::Matrix<double, 3, 4> jacobian = rot::getJacobianOfRotateWrtAngleAxis(rot::AngleAxisD(angle, axis), vector);
+
+  // Rodrigues expression the Jacobian differentiates (axis treated as a free vector).
+  auto rotateRodrigues = [](double angle, const Vector3& axis, const Vector3& vector) -> Vector3 {
+    return cos(angle)*vector + sin(angle)*axis.cross(vector) + (1.0 - cos(angle))*axis.dot(vector)*axis;
+  };
+
+  const double h = 1.0e-7;
+  const Vector3 numericAngle = (rotateRodrigues(angle + h, axis, vector) - rotateRodrigues(angle - h, axis, vector))/(2.0*h);
+  for (int k = 0; k < 3; k++) {
+    EXPECT_NEAR(numericAngle(k), jacobian(k, 0), 1e-5);
+  }
+  for (int i = 0; i < 3; i++) {
+    Vector3 axisPlus = axis;
+    Vector3 axisMinus = axis;
+    axisPlus(i) += h;
+    axisMinus(i) -= h;
+    const Vector3 numeric = (rotateRodrigues(angle, axisPlus, vector) - rotateRodrigues(angle, axisMinus, vector))/(2.0*h);
+    for (int k = 0; k < 3; k++) {
+      EXPECT_NEAR(numeric(k), jacobian(k, i + 1), 1e-5);
+    }
+  }
+}
+
+TEST(RotationJacobiansTest, testJacobianOfQuaternionWrtRotationVector) {
+  const rot::RotationVectorD rotVec(0.5, -0.9, 0.3);
+  const Eigen::Matrix<double, 4, 3> jacobian = rot::getJacobianOfQuaternionWrtRotationVector(rotVec);
+
+  const double h = 1.0e-7;
+  for (int i = 0; i < 3; i++) {
+    Vector3 phiPlus = rotVec.toImplementation();
+    Vector3 phiMinus = rotVec.toImplementation();
+    phiPlus(i) += h;
+    phiMinus(i) -= h;
+    const rot::RotationVectorD rotVecPlus(phiPlus);
+    const rot::RotationVectorD rotVecMinus(phiMinus);
+    const rot::RotationQuaternionD quatPlus(rotVecPlus);
+    const rot::RotationQuaternionD quatMinus(rotVecMinus);
+    const Vector4 numeric = (Vector4(quatPlus.w(), quatPlus.x(), quatPlus.y(), quatPlus.z())
+                             - Vector4(quatMinus.w(), quatMinus.x(), quatMinus.y(), quatMinus.z()))/(2.0*h);
+    for (int k = 0; k < 4; k++) {
+      EXPECT_NEAR(numeric(k), jacobian(k, i), 1e-5);
+    }
+  }
+
+  // small-angle branch
+  const rot::RotationVectorD rotVecSmall(1.0e-6, -2.0e-6, 1.5e-6);
+  const Eigen::Matrix<double, 4, 3> jacobianSmall = rot::getJacobianOfQuaternionWrtRotationVector(rotVecSmall);
+  EXPECT_NEAR(0.5, jacobianSmall(1, 0), 1e-6);
+  EXPECT_NEAR(0.5, jacobianSmall(2, 1), 1e-6);
+  EXPECT_NEAR(0.5, jacobianSmall(3, 2), 1e-6);
+}
+
+TEST(RotationJacobiansTest, testJacobianOfRotationVectorWrtQuaternionIsInverse) {
+  // The two conversion Jacobians chained together must reproduce the identity on the tangent space.
+  const rot::RotationVectorD rotVec(0.6, 0.2, -1.0);
+  const rot::RotationQuaternionD rotQuat(rotVec);
+  const Eigen::Matrix<double, 4, 3> jacobianQuat = rot::getJacobianOfQuaternionWrtRotationVector(rotVec);
+  const Eigen::Matrix<double, 3, 4> jacobianVec = rot::getJacobianOfRotationVectorWrtQuaternion(rotQuat);
+  const Eigen::Matrix3d chained = jacobianVec*jacobianQuat;
+  for (int i = 0; i < 3; i++) {
+    for (int k = 0; k < 3; k++) {
+      EXPECT_NEAR(i == k ? 1.0 : 0.0, chained(i, k), 1e-6);
+    }
+  }
+}
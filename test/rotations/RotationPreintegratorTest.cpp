@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/RotationPreintegrator.hpp"
+
+namespace rot = kindr;
+
+TEST(RotationPreintegratorTest, testNoSamplesIsIdentity) {
+  rot::RotationPreintegratorD preintegrator;
+  EXPECT_EQ(0u, preintegrator.getNumSamples());
+  EXPECT_EQ(0.0, preintegrator.getDeltaTime());
+  EXPECT_TRUE(preintegrator.getDeltaRotation().isNear(rot::RotationQuaternionD(), 1e-15));
+  EXPECT_EQ(0.0, preintegrator.getJacobianWrtGyroBias().norm());
+}
+
+TEST(RotationPreintegratorTest, testSingleSampleMatchesExponentialMap) {
+  const double dt = 0.001;
+  const rot::LocalAngularVelocityD angularVelocity(0.4, -1.3, 2.1);
+  rot::RotationPreintegratorD preintegrator;
+  preintegrator.integrate(dt, angularVelocity);
+  EXPECT_EQ(1u, preintegrator.getNumSamples());
+  EXPECT_EQ(dt, preintegrator.getDeltaTime());
+
+  const rot::RotationQuaternionD expected =
+      rot::RotationQuaternionD().exponentialMap(angularVelocity.toImplementation()*dt);
+  EXPECT_TRUE(preintegrator.getDeltaRotation().isNear(expected, 1e-14));
+}
+
+TEST(RotationPreintegratorTest, testStreamMatchesNaiveComposition) {
+  const double dt = 1.0/8000.0;
+  rot::RotationPreintegratorD preintegrator;
+  rot::RotationQuaternionD naive;
+  for (int k = 0; k < 4000; k++) {
+    const double t = k*dt;
+    const Eigen::Vector3d omega(2.0*std::sin(5.0*t), -1.5*std::cos(3.0*t), 0.8*std::sin(7.0*t));
+    preintegrator.integrate(dt, omega);
+    // naive per-sample exp/compose loop the preintegrator replaces
+    naive = naive*rot::RotationQuaternionD().exponentialMap(omega*dt);
+  }
+  EXPECT_EQ(4000u, preintegrator.getNumSamples());
+  EXPECT_NEAR(0.5, preintegrator.getDeltaTime(), 1e-12);
+  EXPECT_TRUE(preintegrator.getDeltaRotation().isNear(naive, 1e-10));
+}
+
+TEST(RotationPreintegratorTest, testBiasSubtraction) {
+  const Eigen::Vector3d bias(0.02, -0.01, 0.03);
+  rot::RotationPreintegratorD preintegrator(bias);
+  EXPECT_EQ(bias, preintegrator.getGyroBias());
+  for (int k = 0; k < 100; k++) {
+    // measurements equal to the bias carry no rotation
+    preintegrator.integrate(0.001, bias);
+  }
+  EXPECT_TRUE(preintegrator.getDeltaRotation().isNear(rot::RotationQuaternionD(), 1e-13));
+}
+
+TEST(RotationPreintegratorTest, testBiasJacobianFirstOrderCorrection) {
+  const double dt = 0.001;
+  const Eigen::Vector3d biasDelta(2e-4, -1e-4, 3e-4);
+
+  rot::RotationPreintegratorD preintegrator;
+  rot::RotationPreintegratorD reintegrated(biasDelta);
+  for (int k = 0; k < 500; k++) {
+    const double t = k*dt;
+    const Eigen::Vector3d omega(1.2*std::sin(4.0*t), -0.7*std::cos(2.0*t), 0.5);
+    preintegrator.integrate(dt, omega);
+    reintegrated.integrate(dt, omega);
+  }
+
+  // the first-order corrected rotation matches re-integration with the shifted bias
+  const Eigen::Vector3d error = preintegrator.getDeltaRotation(biasDelta).boxMinus(reintegrated.getDeltaRotation());
+  EXPECT_LT(error.norm(), 1e-7);
+
+  // without the correction the two preintegrations differ significantly more
+  const Eigen::Vector3d uncorrectedError = preintegrator.getDeltaRotation().boxMinus(reintegrated.getDeltaRotation());
+  EXPECT_GT(uncorrectedError.norm(), 1e-5);
+}
+
+TEST(RotationPreintegratorTest, testBatchMatchesPerSample) {
+  std::vector<double> timeSteps;
+  rot::VectorBatch3<double> angularVelocities;
+  rot::RotationPreintegratorD perSample;
+  for (int k = 0; k < 256; k++) {
+    const double dt = 0.001 + 1e-5*k;
+    const Eigen::Vector3d omega(0.3*k, -0.1*k, 0.05*k);
+    timeSteps.push_back(dt);
+    angularVelocities.append(omega);
+    perSample.integrate(dt, omega);
+  }
+
+  rot::RotationPreintegratorD batch;
+  batch.integrate(timeSteps, angularVelocities);
+  EXPECT_EQ(perSample.getNumSamples(), batch.getNumSamples());
+  EXPECT_TRUE(batch.getDeltaRotation().isNear(perSample.getDeltaRotation(), 1e-14));
+  EXPECT_NEAR(0.0, (batch.getJacobianWrtGyroBias() - perSample.getJacobianWrtGyroBias()).norm(), 1e-14);
+}
+
+TEST(RotationPreintegratorTest, testFloatTypes) {
+  rot::RotationPreintegratorF preintegrator;
+  rot::RotationQuaternionF naive;
+  for (int k = 0; k < 100; k++) {
+    const Eigen::Vector3f omega(0.5f, -0.2f, 0.1f);
+    preintegrator.integrate(0.01f, omega);
+    naive = naive*rot::RotationQuaternionF().exponentialMap(omega*0.01f);
+  }
+  EXPECT_TRUE(preintegrator.getDeltaRotation().isNear(naive, 1e-5f));
+}
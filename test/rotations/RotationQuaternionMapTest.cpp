@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/rotations/RotationQuaternionMap.hpp"
+
+namespace rot = kindr;
+
+TEST(RotationQuaternionMapTest, testMapReadsBufferInEigenOrder) {
+  // Eigen storage order is [x, y, z, w].
+  double buffer[4] = {0.36, 0.48, 0.8, 0.0};
+
+  rot::Map<rot::RotationQuaternionD> map(buffer);
+  EXPECT_EQ(0.0, map.w());
+  EXPECT_EQ(0.36, map.x());
+  EXPECT_EQ(0.48, map.y());
+  EXPECT_EQ(0.8, map.z());
+
+  rot::RotationQuaternionD rotQuat(map);
+  EXPECT_TRUE(rotQuat.isNear(rot::RotationQuaternionD(0.0, 0.36, 0.48, 0.8), 1e-6));
+}
+
+TEST(RotationQuaternionMapTest, testMapWritesRotationThroughBuffer) {
+  double buffer[4] = {0.0, 0.0, 0.0, 1.0};
+
+  rot::Map<rot::RotationQuaternionD> map(buffer);
+  rot::RotationQuaternionD rotQuat;
+  rotQuat.setRandom();
+  map = rotQuat;
+  EXPECT_NEAR(rotQuat.x(), buffer[0], 1e-10);
+  EXPECT_NEAR(rotQuat.y(), buffer[1], 1e-10);
+  EXPECT_NEAR(rotQuat.z(), buffer[2], 1e-10);
+  EXPECT_NEAR(rotQuat.w(), buffer[3], 1e-10);
+
+  // Assignment from any rotation parameterization converts on the fly.
+  map = rot::EulerAnglesZyxD(0.5, -0.2, 0.3);
+  rot::RotationQuaternionD converted(rot::EulerAnglesZyxD(0.5, -0.2, 0.3));
+  EXPECT_NEAR(converted.w(), buffer[3], 1e-10);
+}
+
+TEST(RotationQuaternionMapTest, testMapRotateMatchesOwningRotate) {
+  rot::RotationQuaternionD rotQuat;
+  rotQuat.setRandom();
+  double buffer[4] = {rotQuat.x(), rotQuat.y(), rotQuat.z(), rotQuat.w()};
+
+  rot::Map<rot::RotationQuaternionD> map(buffer);
+  const Eigen::Vector3d vector(0.3, -1.5, 0.6);
+  const Eigen::Vector3d expected = rotQuat.rotate(vector);
+  const Eigen::Vector3d rotated = map.rotate(vector);
+  const Eigen::Vector3d back = map.inverseRotate(rotated);
+  for (int i = 0; i < 3; i++) {
+    EXPECT_NEAR(expected(i), rotated(i), 1e-10);
+    EXPECT_NEAR(vector(i), back(i), 1e-10);
+  }
+}
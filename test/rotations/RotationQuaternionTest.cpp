@@ -943,3 +943,36 @@ TYPED_TEST(RotationQuaternionSingleTest, testGetRandom){
   ASSERT_TRUE(rotB.isNear(rotA, 1e-4));
   ASSERT_TRUE(!rotC.isNear(rotA, 1e-4));
 }
+
+// Test the cheap comparison path that avoids getUnique() temporaries
+TYPED_TEST(RotationQuaternionSingleTest, testIsNearFast){
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+
+  // A quaternion is near itself and near its negated coefficients.
+  ASSERT_EQ(this->rotQuat1.isNearFast(this->rotQuat1, 1e-6), true);
+  RotationQuaternion rotQuatNegated(-this->rotQuat1.w(), -this->rotQuat1.x(), -this->rotQuat1.y(), -this->rotQuat1.z());
+  ASSERT_EQ(this->rotQuat1.isNearFast(rotQuatNegated, 1e-6), true);
+
+  // Clearly different rotations are rejected.
+  ASSERT_EQ(this->rotQuat1.isNearFast(this->rotQuat2, 1e-2), false);
+}
+
+// Test the first-order renormalization used in high-rate integration loops
+TYPED_TEST(RotationQuaternionSingleTest, testFixFast){
+  typedef typename TestFixture::RotationQuaternion RotationQuaternion;
+  typedef typename TestFixture::Scalar Scalar;
+
+  // Small drift is corrected to first order.
+  RotationQuaternion rotQuat = this->rotQuat1;
+  rotQuat.toImplementation().coeffs() *= Scalar(1.0 + 1e-4);
+  rotQuat.fixFast();
+  ASSERT_NEAR(rotQuat.toImplementation().norm(), 1.0, 1e-6);
+  ASSERT_EQ(rotQuat.isNear(this->rotQuat1, 1e-4), true);
+
+  // Large drift falls back to the exact normalization.
+  RotationQuaternion rotQuatDrifted = this->rotQuat2;
+  rotQuatDrifted.toImplementation().coeffs() *= Scalar(2.0);
+  rotQuatDrifted.fixFast();
+  ASSERT_NEAR(rotQuatDrifted.toImplementation().norm(), 1.0, 1e-6);
+  ASSERT_EQ(rotQuatDrifted.isNear(this->rotQuat2, 1e-4), true);
+}
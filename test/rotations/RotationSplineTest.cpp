@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/RotationSpline.hpp"
+
+namespace rot = kindr;
+
+template <typename PrimType_>
+struct RotationSplineTest : public ::testing::Test {
+  typedef PrimType_ Scalar;
+  typedef rot::RotationSpline<Scalar> RotationSpline;
+  typedef typename RotationSpline::Rotation Rotation;
+};
+
+typedef ::testing::Types<double, float> PrimTypes;
+TYPED_TEST_CASE(RotationSplineTest, PrimTypes);
+
+TYPED_TEST(RotationSplineTest, testPassesThroughKnots) {
+  typedef typename TestFixture::RotationSpline RotationSpline;
+  typedef typename TestFixture::Rotation Rotation;
+  typedef typename TestFixture::Scalar Scalar;
+
+  RotationSpline spline;
+  std::vector<Rotation, Eigen::aligned_allocator<Rotation>> knots;
+  for (int i = 0; i < 5; i++) {
+    Rotation rotation;
+    rotation.setRandom();
+    knots.push_back(rotation);
+    spline.addKnot(Scalar(0.5)*Scalar(i), rotation);
+  }
+  ASSERT_EQ(5u, spline.getNumberOfKnots());
+
+  for (int i = 0; i < 5; i++) {
+    EXPECT_TRUE(knots[i].isNear(spline.evaluate(Scalar(0.5)*Scalar(i)), 1e-4));
+  }
+
+  // clamped outside the keyframe range
+  EXPECT_TRUE(knots.front().isNear(spline.evaluate(Scalar(-1.0)), 1e-5));
+  EXPECT_TRUE(knots.back().isNear(spline.evaluate(Scalar(10.0)), 1e-5));
+}
+
+TYPED_TEST(RotationSplineTest, testTwoKnotsReduceToSlerp) {
+  typedef typename TestFixture::RotationSpline RotationSpline;
+  typedef typename TestFixture::Rotation Rotation;
+  typedef typename TestFixture::Scalar Scalar;
+
+  Rotation start, end;
+  start.setRandom();
+  end.setRandom();
+
+  RotationSpline spline;
+  spline.addKnot(Scalar(0.0), start);
+  spline.addKnot(Scalar(1.0), end);
+
+  for (int i = 0; i <= 10; i++) {
+    const Scalar alpha = Scalar(0.1)*Scalar(i);
+    EXPECT_TRUE(start.slerp(end, alpha).isNear(spline.evaluate(alpha), 1e-4));
+  }
+}
+
+TYPED_TEST(RotationSplineTest, testContinuityAcrossSegments) {
+  typedef typename TestFixture::RotationSpline RotationSpline;
+  typedef typename TestFixture::Rotation Rotation;
+  typedef typename TestFixture::Scalar Scalar;
+
+  RotationSpline spline;
+  for (int i = 0; i < 4; i++) {
+    Rotation rotation;
+    rotation.setRandom();
+    spline.addKnot(Scalar(1.0)*Scalar(i), rotation);
+  }
+
+  // the trajectory must not jump across the interior knots
+  const Scalar epsilon(1e-3);
+  for (int knot = 1; knot <= 2; knot++) {
+    const Rotation before = spline.evaluate(Scalar(knot) - epsilon);
+    const Rotation after = spline.evaluate(Scalar(knot) + epsilon);
+    EXPECT_LT(before.getDisparityAngle(after), Scalar(0.05));
+  }
+}
+
+TYPED_TEST(RotationSplineTest, testMonotonicQueriesMatchRandomAccess) {
+  typedef typename TestFixture::RotationSpline RotationSpline;
+  typedef typename TestFixture::Rotation Rotation;
+  typedef typename TestFixture::Scalar Scalar;
+
+  RotationSpline incremental;
+  RotationSpline reference;
+  for (int i = 0; i < 6; i++) {
+    Rotation rotation;
+    rotation.setRandom();
+    incremental.addKnot(Scalar(1.0)*Scalar(i), rotation);
+    reference.addKnot(Scalar(1.0)*Scalar(i), rotation);
+  }
+
+  // sweep forward on one spline (exercising the segment hint) and query the other fresh
+  for (int i = 0; i <= 100; i++) {
+    const Scalar time = Scalar(0.05)*Scalar(i);
+    const Rotation swept = incremental.evaluate(time);
+    const Rotation direct = reference.evaluate(time);
+    // jump the reference around to keep its hint cold
+    reference.evaluate(Scalar(4.9));
+    EXPECT_TRUE(direct.isNear(swept, 1e-4));
+  }
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/Rotation.hpp"
+
+namespace rot = kindr;
+
+TEST(SingleAngleExtractionTest, testQuaternionMatchesFullConversion) {
+  for (int sample = 0; sample < 200; sample++) {
+    rot::RotationQuaternionD rotation;
+    rotation.setRandom();
+    const rot::EulerAnglesZyxD expected(rotation);
+    EXPECT_NEAR(expected.yaw(), rotation.getYaw(), 1e-12);
+    EXPECT_NEAR(expected.pitch(), rotation.getPitch(), 1e-12);
+    EXPECT_NEAR(expected.roll(), rotation.getRoll(), 1e-12);
+  }
+}
+
+TEST(SingleAngleExtractionTest, testRotationMatrixMatchesFullConversion) {
+  for (int sample = 0; sample < 200; sample++) {
+    rot::RotationQuaternionD quaternion;
+    quaternion.setRandom();
+    const rot::RotationMatrixD rotation(quaternion);
+    const rot::EulerAnglesZyxD expected(rotation);
+    EXPECT_NEAR(expected.yaw(), rotation.getYaw(), 1e-12);
+    EXPECT_NEAR(expected.pitch(), rotation.getPitch(), 1e-12);
+    EXPECT_NEAR(expected.roll(), rotation.getRoll(), 1e-12);
+  }
+}
+
+TEST(SingleAngleExtractionTest, testIdentity) {
+  EXPECT_EQ(0.0, rot::RotationQuaternionD().getYaw());
+  EXPECT_EQ(0.0, rot::RotationQuaternionD().getPitch());
+  EXPECT_EQ(0.0, rot::RotationQuaternionD().getRoll());
+}
+
+TEST(SingleAngleExtractionTest, testPureRotations) {
+  EXPECT_NEAR(0.7, rot::RotationQuaternionD(rot::EulerAnglesZyxD(0.7, 0.0, 0.0)).getYaw(), 1e-12);
+  EXPECT_NEAR(-0.4, rot::RotationQuaternionD(rot::EulerAnglesZyxD(0.0, -0.4, 0.0)).getPitch(), 1e-12);
+  EXPECT_NEAR(1.2, rot::RotationQuaternionD(rot::EulerAnglesZyxD(0.0, 0.0, 1.2)).getRoll(), 1e-12);
+}
+
+TEST(SingleAngleExtractionTest, testGimbalLock) {
+  for (const double pitch : {M_PI/2.0, -M_PI/2.0}) {
+    const rot::RotationQuaternionD quaternion(rot::EulerAnglesZyxD(0.8, pitch, -0.3));
+    const rot::EulerAnglesZyxD expected(quaternion);
+    // yaw is zero in the lock and the roll carries the locked-axis rotation
+    EXPECT_NEAR(expected.yaw(), quaternion.getYaw(), 1e-6);
+    EXPECT_NEAR(expected.pitch(), quaternion.getPitch(), 1e-6);
+    EXPECT_NEAR(expected.roll(), quaternion.getRoll(), 1e-6);
+    const rot::RotationMatrixD matrix(quaternion);
+    const rot::EulerAnglesZyxD expectedFromMatrix(matrix);
+    EXPECT_NEAR(expectedFromMatrix.yaw(), matrix.getYaw(), 1e-6);
+    EXPECT_NEAR(expectedFromMatrix.pitch(), matrix.getPitch(), 1e-6);
+    EXPECT_NEAR(expectedFromMatrix.roll(), matrix.getRoll(), 1e-6);
+  }
+}
+
+TEST(SingleAngleExtractionTest, testFloat) {
+  for (int sample = 0; sample < 50; sample++) {
+    rot::RotationQuaternionF rotation;
+    rotation.setRandom();
+    const rot::EulerAnglesZyxF expected(rotation);
+    EXPECT_NEAR(expected.yaw(), rotation.getYaw(), 1e-5f);
+    EXPECT_NEAR(expected.pitch(), rotation.getPitch(), 1e-5f);
+    EXPECT_NEAR(expected.roll(), rotation.getRoll(), 1e-5f);
+  }
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/rotations/Rotation.hpp"
+#include "kindr/rotations/FastConversions.hpp"
+
+namespace rot = kindr;
+
+TEST(TrustedConstructionTest, testTrustedConstructorsMatchValidated) {
+  const rot::RotationQuaternionD reference(rot::EulerAnglesZyxD(0.4, -0.7, 1.1));
+  const double w = reference.w();
+  const Eigen::Vector3d imag(reference.x(), reference.y(), reference.z());
+  const Eigen::Vector4d vec(reference.w(), reference.x(), reference.y(), reference.z());
+
+  const rot::RotationQuaternionD fromScalars(rot::trusted, reference.w(), reference.x(), reference.y(), reference.z());
+  const rot::RotationQuaternionD fromRealImag(rot::trusted, w, imag);
+  const rot::RotationQuaternionD fromVector4(rot::trusted, vec);
+  const rot::RotationQuaternionD fromImplementation(rot::trusted, reference.toImplementation());
+  const rot::RotationQuaternionD fromUnitQuaternion(rot::trusted, reference.toUnitQuaternion());
+
+  EXPECT_TRUE(fromScalars.isNear(reference, 0.0));
+  EXPECT_TRUE(fromRealImag.isNear(reference, 0.0));
+  EXPECT_TRUE(fromVector4.isNear(reference, 0.0));
+  EXPECT_TRUE(fromImplementation.isNear(reference, 0.0));
+  EXPECT_TRUE(fromUnitQuaternion.isNear(reference, 0.0));
+}
+
+TEST(TrustedConstructionTest, testTrustedSkipsValidation) {
+  // a clearly non-unit quaternion must pass through unchanged and without any check
+  EXPECT_NO_THROW({
+    const rot::RotationQuaternionD scaled(rot::trusted, 2.0, 0.0, 0.0, 0.0);
+    EXPECT_EQ(2.0, scaled.w());
+  });
+}
+
+TEST(TrustedConstructionTest, testCompositionStillCorrect) {
+  // operator* now feeds the raw quaternion product through the trusted constructor
+  for (double angle = -2.8; angle < 3.0; angle += 0.57) {
+    const rot::RotationQuaternionD lhs(rot::EulerAnglesZyxD(angle, -0.4, 0.9));
+    const rot::RotationQuaternionD rhs(rot::EulerAnglesZyxD(0.2, angle, -1.1));
+    const rot::RotationQuaternionD product = lhs*rhs;
+    const Eigen::Quaterniond expected = lhs.toImplementation()*rhs.toImplementation();
+    EXPECT_TRUE(product.isNear(rot::RotationQuaternionD(expected), 1e-14)) << "angle " << angle;
+    EXPECT_TRUE((lhs*lhs.inverted()).isNear(rot::RotationQuaternionD(), 1e-14));
+  }
+}
+
+TEST(TrustedConstructionTest, testMixedCompositionAndExponentialMap) {
+  const rot::EulerAnglesZyxD eulerAngles(0.4, -0.7, 1.1);
+  const rot::RotationQuaternionD quaternion(eulerAngles);
+  // mixed-type multiplication also goes through the trusted quaternion product
+  EXPECT_TRUE(rot::RotationQuaternionD(eulerAngles*quaternion.inverted()).isNear(rot::RotationQuaternionD(), 1e-12));
+
+  const Eigen::Vector3d rotationVector(0.3, -1.2, 0.7);
+  const rot::RotationQuaternionD exponential = rot::RotationQuaternionD().exponentialMap(rotationVector);
+  EXPECT_NEAR(1.0, exponential.toImplementation().norm(), 1e-14);
+  EXPECT_NEAR(0.0, (exponential.logarithmicMap() - rotationVector).norm(), 1e-12);
+
+  const rot::RotationQuaternionD fast = rot::convertToRotationQuaternionFast(rot::RotationVectorD(rotationVector));
+  EXPECT_TRUE(fast.isNear(exponential, 1e-12));
+}
+
+TEST(TrustedConstructionTest, testFloatTypes) {
+  const rot::RotationQuaternionF reference(rot::EulerAnglesZyxF(0.4f, -0.7f, 1.1f));
+  const rot::RotationQuaternionF copy(rot::trusted, reference.toImplementation());
+  EXPECT_TRUE(copy.isNear(reference, 1e-6f));
+  EXPECT_EQ(reference.w(), copy.w());
+  EXPECT_TRUE((reference*reference.inverted()).isNear(rot::RotationQuaternionF(), 1e-6f));
+}
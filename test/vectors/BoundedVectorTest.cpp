@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/vectors/BoundedVector.hpp"
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
+
+namespace vec = kindr;
+
+typedef vec::BoundedVector<vec::PhysicalType::Force, double, 12> BoundedForce12D;
+typedef vec::BoundedVector<vec::PhysicalType::Force, float, 12> BoundedForce12F;
+
+TEST(BoundedVectorTest, testConstructors) {
+  const BoundedForce12D empty;
+  EXPECT_EQ(0, empty.size());
+
+  const BoundedForce12D zeros(7);
+  EXPECT_EQ(7, zeros.size());
+  for (int k = 0; k < zeros.size(); k++) {
+    EXPECT_EQ(0.0, zeros(k));
+  }
+
+  Eigen::VectorXd raw(4);
+  raw << 1.0, -2.0, 3.0, -4.0;
+  const BoundedForce12D fromEigen(raw);
+  EXPECT_EQ(4, fromEigen.size());
+  for (int k = 0; k < 4; k++) {
+    EXPECT_EQ(raw(k), fromEigen(k));
+  }
+}
+
+TEST(BoundedVectorTest, testNoHeapStorage) {
+  // the coefficients live inline: the object is at least as large as a full buffer
+  static_assert(sizeof(BoundedForce12D) >= 12*sizeof(double), "storage must be inline");
+  BoundedForce12D vector(5);
+  const unsigned char* objectBegin = reinterpret_cast<const unsigned char*>(&vector);
+  const unsigned char* dataPointer = reinterpret_cast<const unsigned char*>(vector.toImplementation().data());
+  EXPECT_GE(dataPointer, objectBegin);
+  EXPECT_LT(dataPointer, objectBegin + sizeof(BoundedForce12D));
+}
+
+TEST(BoundedVectorTest, testResizePreservesCapacitySemantics) {
+  BoundedForce12D vector(3);
+  vector(0) = 1.0;
+  vector.resize(12);
+  EXPECT_EQ(12, vector.size());
+  vector.setZero(6);
+  EXPECT_EQ(6, vector.size());
+  for (int k = 0; k < 6; k++) {
+    EXPECT_EQ(0.0, vector(k));
+  }
+}
+
+TEST(BoundedVectorTest, testArithmetic) {
+  BoundedForce12D first(3);
+  first(0) = 1.0; first(1) = -2.0; first(2) = 3.0;
+  BoundedForce12D second(3);
+  second(0) = 0.5; second(1) = 1.0; second(2) = -1.0;
+
+  const BoundedForce12D sum = first + second;
+  EXPECT_EQ(1.5, sum(0));
+  EXPECT_EQ(-1.0, sum(1));
+  EXPECT_EQ(2.0, sum(2));
+
+  const BoundedForce12D difference = sum - second;
+  for (int k = 0; k < 3; k++) {
+    EXPECT_EQ(first(k), difference(k));
+  }
+
+  const BoundedForce12D scaled = 2.0*first;
+  EXPECT_EQ(2.0, scaled(0));
+  EXPECT_EQ(-4.0, scaled(1));
+  EXPECT_EQ(6.0, scaled(2));
+  EXPECT_TRUE(first == scaled/2.0);
+
+  EXPECT_EQ(first.dot(second), 0.5 - 2.0 - 3.0);
+  EXPECT_NEAR(std::sqrt(14.0), first.norm(), 1e-12);
+  EXPECT_EQ(14.0, first.squaredNorm());
+  EXPECT_EQ(2.0, first.sum());
+
+  BoundedForce12D accumulator(3);
+  accumulator += first;
+  accumulator -= second;
+  accumulator *= 2.0;
+  accumulator /= 4.0;
+  for (int k = 0; k < 3; k++) {
+    EXPECT_EQ((first(k) - second(k))/2.0, accumulator(k));
+  }
+
+  const BoundedForce12D negated = -first;
+  for (int k = 0; k < 3; k++) {
+    EXPECT_EQ(-first(k), negated(k));
+  }
+}
+
+TEST(BoundedVectorTest, testConversionsWithVector) {
+  const vec::Force3D staticVector(1.0, 2.0, 3.0);
+  const BoundedForce12D fromStatic(staticVector);
+  EXPECT_EQ(3, fromStatic.size());
+  for (int k = 0; k < 3; k++) {
+    EXPECT_EQ(staticVector(k), fromStatic(k));
+  }
+
+  const vec::Vector<vec::PhysicalType::Force, double, Eigen::Dynamic> dynamicVector = fromStatic.toDynamic();
+  EXPECT_EQ(3, dynamicVector.toImplementation().size());
+  for (int k = 0; k < 3; k++) {
+    EXPECT_EQ(staticVector(k), dynamicVector(k));
+  }
+
+  const BoundedForce12D roundTrip(dynamicVector);
+  EXPECT_TRUE(fromStatic == roundTrip);
+}
+
+TEST(BoundedVectorTest, testFloatTypes) {
+  BoundedForce12F vector(4);
+  vector(0) = 1.0f; vector(1) = 2.0f; vector(2) = 2.0f; vector(3) = 4.0f;
+  EXPECT_FLOAT_EQ(5.0f, vector.norm());
+  EXPECT_EQ(4, vector.size());
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "kindr/vectors/HalfPrecision.hpp"
+
+namespace vec = kindr;
+
+TEST(HalfPrecisionTest, testEncodeDecodeExactValues) {
+  // values exactly representable in binary16 must round-trip bit-exactly
+  for (float value : {0.0f, -0.0f, 1.0f, -1.0f, 0.5f, 2.0f, 1024.0f, -65504.0f, 65504.0f, 0.0009765625f}) {
+    EXPECT_EQ(value, vec::internal::decodeHalf(vec::internal::encodeHalf(value))) << "value = " << value;
+  }
+}
+
+TEST(HalfPrecisionTest, testEncodeDecodeSpecialValues) {
+  const float inf = std::numeric_limits<float>::infinity();
+  EXPECT_EQ(inf, vec::internal::decodeHalf(vec::internal::encodeHalf(inf)));
+  EXPECT_EQ(-inf, vec::internal::decodeHalf(vec::internal::encodeHalf(-inf)));
+  EXPECT_TRUE(std::isnan(vec::internal::decodeHalf(vec::internal::encodeHalf(std::numeric_limits<float>::quiet_NaN()))));
+  // overflow saturates to infinity, tiny values flush to signed zero
+  EXPECT_EQ(inf, vec::internal::decodeHalf(vec::internal::encodeHalf(1e6f)));
+  EXPECT_EQ(0.0f, vec::internal::decodeHalf(vec::internal::encodeHalf(1e-9f)));
+  EXPECT_TRUE(std::signbit(vec::internal::decodeHalf(vec::internal::encodeHalf(-1e-9f))));
+}
+
+TEST(HalfPrecisionTest, testRelativePrecision) {
+  // binary16 has 11 significand bits: relative error bounded by 2^-11 for normal values
+  for (int k = 0; k < 1000; k++) {
+    const float value = 0.001f*(k + 1)*(k % 2 == 0 ? 1.0f : -1.0f);
+    const float roundTrip = vec::internal::decodeHalf(vec::internal::encodeHalf(value));
+    EXPECT_NEAR(value, roundTrip, std::fabs(value)*4.9e-4f) << "value = " << value;
+  }
+  // subnormal range degrades gracefully instead of flushing
+  const float subnormal = 3e-6f;
+  EXPECT_NEAR(subnormal, vec::internal::decodeHalf(vec::internal::encodeHalf(subnormal)), 6e-8f);
+}
+
+TEST(HalfPrecisionTest, testStorageHalvesBytes) {
+  Eigen::Matrix3Xf points(3, 1000);
+  points.setRandom();
+  const vec::HalfMatrix3X half(points);
+  EXPECT_EQ(1000, half.cols());
+  EXPECT_EQ(static_cast<std::size_t>(points.size())*sizeof(float)/2u, half.bytes());
+}
+
+TEST(HalfPrecisionTest, testMatrixRoundTrip) {
+  Eigen::Matrix3Xf points(3, 500);
+  points.setRandom();  // values in [-1, 1]: metric depth-map range
+  const vec::HalfMatrix3X half(points);
+  const Eigen::Matrix3Xf widened = half.toMatrix();
+  EXPECT_NEAR(0.f, (points - widened).lpNorm<Eigen::Infinity>(), 4.9e-4f);
+}
+
+TEST(HalfPrecisionTest, testRotateHalfBatch) {
+  const vec::RotationQuaternionF rotation(vec::EulerAnglesZyxF(0.4f, -0.7f, 1.1f));
+  Eigen::Matrix3Xf points(3, 3000);  // more than one tile
+  points.setRandom();
+  points *= 5.0f;
+
+  vec::HalfMatrix3X half(points);
+  vec::HalfMatrix3X rotated;
+  vec::rotateHalfBatch(rotation, half, rotated);
+
+  // reference: float compute on the widened storage, narrowed once at the end
+  const Eigen::Matrix3Xf expected = rotation.rotate(Eigen::Matrix3Xf(half.toMatrix()));
+  ASSERT_EQ(points.cols(), rotated.cols());
+  for (int k = 0; k < points.cols(); k += 101) {
+    const Eigen::Vector3f actual = rotated.col(k);
+    for (int i = 0; i < 3; i++) {
+      EXPECT_NEAR(expected(i, k), actual(i), std::fabs(expected(i, k))*4.9e-4f + 1e-5f) << "point " << k;
+    }
+  }
+}
+
+TEST(HalfPrecisionTest, testTransformHalfBatch) {
+  const vec::HomogeneousTransformationPosition3RotationQuaternionF transform(
+      vec::Position3F(1.0f, -2.0f, 0.5f),
+      vec::RotationQuaternionF(vec::EulerAnglesZyxF(-0.3f, 0.9f, 0.2f)));
+  Eigen::Matrix3Xf points(3, 1500);
+  points.setRandom();
+
+  vec::HalfMatrix3X half(points);
+  vec::HalfMatrix3X transformed;
+  vec::transformHalfBatch(transform, half, transformed);
+
+  for (int k = 0; k < points.cols(); k += 97) {
+    const vec::Position3F expected = transform.transform(vec::Position3F(Eigen::Vector3f(half.col(k))));
+    const Eigen::Vector3f actual = transformed.col(k);
+    for (int i = 0; i < 3; i++) {
+      EXPECT_NEAR(expected(i), actual(i), std::fabs(expected(i))*4.9e-4f + 1e-4f) << "point " << k;
+    }
+  }
+}
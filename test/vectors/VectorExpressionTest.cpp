@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/vectors/VectorExpression.hpp"
+#include "kindr/phys_quant/PhysicalQuantities.hpp"
+
+namespace vectors = kindr;
+
+TEST(VectorExpressionTest, testFusedChainMatchesEagerOperators) {
+  const kindr::Force3D a(1.0, -2.0, 3.0);
+  const kindr::Force3D b(0.5, 4.0, -1.5);
+  const kindr::Force3D c(-2.5, 1.0, 0.25);
+  const double dt = 0.01;
+
+  const kindr::Force3D eager = a + b - c*dt;
+  const kindr::Force3D fused = kindr::expr(a) + kindr::expr(b) - kindr::expr(c)*dt;
+  EXPECT_NEAR(0.0, (fused.toImplementation() - eager.toImplementation()).norm(), 1e-14);
+}
+
+TEST(VectorExpressionTest, testMixedVectorAndExpressionOperands) {
+  const kindr::Force3D a(1.0, -2.0, 3.0);
+  const kindr::Force3D b(0.5, 4.0, -1.5);
+  const kindr::Force3D c(-2.5, 1.0, 0.25);
+
+  const kindr::Force3D expected = a + b - c;
+  const kindr::Force3D sumLeft = kindr::expr(a) + b - c;
+  const kindr::Force3D sumRight = a + kindr::expr(b) - kindr::expr(c);
+  EXPECT_NEAR(0.0, (sumLeft.toImplementation() - expected.toImplementation()).norm(), 1e-14);
+  EXPECT_NEAR(0.0, (sumRight.toImplementation() - expected.toImplementation()).norm(), 1e-14);
+}
+
+TEST(VectorExpressionTest, testScalarOperatorsAndNegation) {
+  const kindr::Force3D a(1.0, -2.0, 3.0);
+  const kindr::Force3D expected = -(a*2.0)/4.0;
+  const kindr::Force3D fused = -(2.0*kindr::expr(a))/4.0;
+  EXPECT_NEAR(0.0, (fused.toImplementation() - expected.toImplementation()).norm(), 1e-14);
+  EXPECT_NEAR(0.0, ((kindr::expr(a)*3.0).eval().toImplementation() - (a*3.0).toImplementation()).norm(), 1e-14);
+}
+
+TEST(VectorExpressionTest, testAssignmentIntoExistingVector) {
+  const kindr::Force3D a(1.0, -2.0, 3.0);
+  const kindr::Force3D b(0.5, 4.0, -1.5);
+  kindr::Force3D result;
+  result = kindr::expr(a) + kindr::expr(b);
+  EXPECT_NEAR(0.0, (result.toImplementation() - (a + b).toImplementation()).norm(), 1e-14);
+}
+
+TEST(VectorExpressionTest, testDynamicDimension) {
+  typedef kindr::Vector<kindr::PhysicalType::Typeless, double, Eigen::Dynamic> VectorXd;
+  Eigen::VectorXd raw(5);
+  raw << 1.0, -2.0, 3.0, 0.5, -0.25;
+  const VectorXd a(raw);
+  const VectorXd b(Eigen::VectorXd(2.0*raw));
+  const VectorXd fused = kindr::expr(a) + kindr::expr(b)*0.5;
+  EXPECT_NEAR(0.0, (fused.toImplementation() - 2.0*raw).norm(), 1e-14);
+}
+
+TEST(VectorExpressionTest, testFloatTypes) {
+  typedef kindr::Vector<kindr::PhysicalType::Force, float, 3> Force3F;
+  const Force3F a(1.0f, -2.0f, 3.0f);
+  const Force3F b(0.5f, 4.0f, -1.5f);
+  const Force3F fused = kindr::expr(a)*0.5f + kindr::expr(b);
+  EXPECT_NEAR(0.0f, (fused.toImplementation() - (a*0.5f + b).toImplementation()).norm(), 1e-6f);
+}
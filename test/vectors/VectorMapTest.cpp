@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2013, Christian Gehring, Hannes Sommer, Paul Furgale, Remo Diethelm
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Autonomous Systems Lab, ETH Zurich nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Christian Gehring, Hannes Sommer, Paul Furgale,
+ * Remo Diethelm BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+ * OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "kindr/vectors/Vector.hpp"
+#include "kindr/vectors/VectorMap.hpp"
+
+namespace vectors = kindr;
+
+TEST(VectorMapTest, testStaticDimensionMapReadsAndWritesBuffer) {
+  typedef vectors::Vector<vectors::PhysicalType::Typeless, double, 3> Vector3;
+  double buffer[3] = {1.0, 2.0, 3.0};
+
+  vectors::Map<Vector3> map(buffer);
+  EXPECT_EQ(1.0, map(0));
+  EXPECT_EQ(3.0, map(2));
+
+  // Conversion copies out of the buffer.
+  Vector3 vector(map);
+  EXPECT_EQ(2.0, vector(1));
+
+  // Assignment writes through the map into the buffer.
+  map = Vector3(typename Vector3::Implementation(-1.0, -2.0, -3.0));
+  EXPECT_EQ(-1.0, buffer[0]);
+  EXPECT_EQ(-3.0, buffer[2]);
+
+  // Writing single entries goes directly to the buffer.
+  map(1) = 5.0;
+  EXPECT_EQ(5.0, buffer[1]);
+}
+
+TEST(VectorMapTest, testDynamicDimensionMap) {
+  typedef vectors::Vector<vectors::PhysicalType::Typeless, float, Eigen::Dynamic> VectorDyn;
+  float buffer[5] = {0.0f, 1.0f, 2.0f, 3.0f, 4.0f};
+
+  vectors::Map<VectorDyn> map(buffer, 5);
+  EXPECT_EQ(5, map.toImplementation().size());
+  EXPECT_EQ(4.0f, map(4));
+
+  map.toImplementation().setConstant(7.0f);
+  EXPECT_EQ(7.0f, buffer[0]);
+  EXPECT_EQ(7.0f, buffer[4]);
+}